@@ -13,57 +13,126 @@
 
 #include "../HAL/BUTTON/BUTTON_interface.h"
 #include "../HAL/LCD/LCD_interface.h"
-#include "../HAL/EXTI_manager/EXTI_manager_interface.h"
 #include "../HAL/MOTOR/MOTOR_interface.h"
 #include "../HAL/TIMING/TIMING_interface.h"
 #include "../HAL/ULTRASONIC/ULTRASONIC_interface.h"
+#include "../HAL/DIST_FILTER/DIST_FILTER_interface.h"
+#include "../HAL/TTC/TTC_interface.h"
 #include "../HAL/PWM/PWM_interface.h"
 #include "../HAL/CAR_CONTROL/CAR_CONTROL_interface.h"
+#include "../HAL/SCHEDULER/SCHEDULER_interface.h"
+#include "../HAL/SCAN/SCAN_interface.h"
 #include "../STD_LIB/bit_math.h"
+#include "../STD_LIB/ring_buffer.h"
 #include "../STD_LIB/std_types.h"
 
 
 
 /* Maximum measured distance for the ultrasonic sensor */
-#define APP_MAX_MEASURED_DIST              (double)99.0
+#define APP_MAX_MEASURED_DIST              HULTRASONIC_DISTANCE_CM(99)
 
-/* To get first digit of number by division */
-#define APP_SELECT_TENS_DIGIT				10
+/* Distance field on the second LCD row: "Dist: 99 cm" */
+#define APP_DIST_LABEL                     "Dist:"
+#define APP_DIST_UNIT_LABEL                "cm"
+#define APP_DIST_FIELD_COL                 LCD_COL_7
+#define APP_DIST_FIELD_WIDTH               2
+#define APP_DIST_UNIT_COL                  LCD_COL_10
 
-/* Value of zero in char */
-#define APP_0_CHAR							'0'
+/* Speed field on the first LCD row, over the digits of "Speed:30% " */
+#define APP_SPEED_FIELD_COL                LCD_COL_7
+#define APP_SPEED_FIELD_WIDTH              2
 
-/* NULL termination during the loop on string */
-#define APP_NULL_TERMINATION_STRING			'\0'
-
-/* Maximum size for the string array used for number-to-string conversion */
-#define APP_MAX_STRING_SIZE                 5
-
-/* Duration of the system tick in milliseconds */
-#define APP_SYS_TICK_DURATION               1000ul
+/* Milliseconds in a number of seconds */
+#define APP_SEC_TO_MS(SEC)                  ((uint32_t)(SEC) * 1000ul)
 
 /* Time to wait for setting direction in seconds */
 #define APP_WAIT_TO_SET_DIR_TIME            5
 
-/* Obstacle distances in centimeters */
-#define APP_DISTANCE_70_CM                 70.0
-#define APP_DISTANCE_30_CM                 30.0
-#define APP_DISTANCE_20_CM                 20.0
+/* Obstacle distances in centimeters, in the ultrasonic distance representation */
+#define APP_DISTANCE_70_CM                 HULTRASONIC_DISTANCE_CM(70)
+#define APP_DISTANCE_30_CM                 HULTRASONIC_DISTANCE_CM(30)
+#define APP_DISTANCE_20_CM                 HULTRASONIC_DISTANCE_CM(20)
+
+/* Distance the time-to-collision of the front distance counts down to, the car must have stopped before it */
+#define APP_TTC_MARGIN                     APP_DISTANCE_20_CM
+
+/* Time-to-collision with APP_TTC_MARGIN from which on the car drives at APP_CAR_SPEED_MAX_PRE, in milliseconds */
+#define APP_TTC_TARGET_MS                  1000
+
+/* Room a side needs over the other one to be chosen as escape direction */
+#define APP_SIDE_MARGIN                    HULTRASONIC_DISTANCE_CM(10)
+
+/* Age in timing ticks after which a side distance no longer counts for the escape direction */
+#define APP_SIDE_MAX_AGE                   500
+
+/* Ultrasonic sensors of the car, indices into the sensor tables */
+#define APP_SENSOR_FRONT                   0
+#define APP_SENSOR_LEFT                    1
+#define APP_SENSOR_RIGHT                   2
+#define APP_SENSORS_COUNT                  3
+
+/* Trigger slots of the sensor task, one sensor per slot: each side sensor gets one slot in
+   APP_SENSOR_SLOTS_COUNT, the front sensor all the others */
+#define APP_SENSOR_SLOTS_COUNT             8
+
+/* Side distance below which the car turns away from the side, the front sensor misses a wall met at a shallow angle */
+#define APP_SIDE_MIN_DIST                  HULTRASONIC_DISTANCE_CM(15)
+
+/* Room along the best heading of a scan the car turns towards, in whole centimetres, less makes it hold */
+#define APP_SCAN_MIN_ROOM_CM               40
+
+/* Rotation time of the car on the spot at APP_CAR_SPEED_30_PRE per 10 degrees, in milliseconds */
+#define APP_TURN_MS_PER_10_DEG             68
 
 /* Time intervals in seconds */
-#define APP_5_SEC_WITHOUT_OBSTACLES        5
 #define APP_2_SEC_TO_ROTATE                2
 #define APP_3_SEC_HOLD_MOVE                3
+#define APP_2_SEC_TO_START                 2
 
-/* PWM frequency for controlling the car */
+/* PWM frequency for controlling the car (the Timer 1 backend runs at the nearest lower prescaler step) */
+#if PWM_BACKEND == PWM_BACKEND_TIMER1
+#define APP_CAR_PWM_FREQ                   2000
+#else
 #define APP_CAR_PWM_FREQ                   20
+#endif
 
-/* Speed settings for the car */
+/* Speed settings for the car: manoeuvres and start of a forward run, and fastest forward speed (two LCD digits) */
 #define APP_CAR_SPEED_30_PRE               30
-#define APP_CAR_SPEED_50_PRE               50
+#define APP_CAR_SPEED_MAX_PRE              70
+
+/* Forward speed the time-to-collision may ask for below which the car stops and scans instead, in percent */
+#define APP_CAR_SPEED_MIN_PRE              15
+
+/* Smallest change of the time-to-collision speed the car follows, in percent */
+#define APP_CAR_SPEED_HYSTERESIS           10
+
+/* Duty cycle added per ramp task run while the car speeds up, in percent */
+#define APP_CAR_RAMP_STEP                  5
+
+/* Scheduler task periods in timing ticks (about 1 ms each) */
+#define APP_TASK_TIMERS_PERIOD             1       /* turns the timer wheel every tick */
+#define APP_TASK_DECIDE_PERIOD             1
+#define APP_TASK_SENSOR_PERIOD             30      /* one sensor per run, not below ULTRASONIC_MIN_CYCLE_TICKS so the rate limit skips no run;
+                                                      a run still skips its slot while the echo of a beyond range measurement is high */
+#define APP_TASK_BUTTON_PERIOD             BUTTON_TICK_MS  /* runs the button debouncer */
+#define APP_TASK_RAMP_PERIOD               50
+#define APP_TASK_SERVO_PERIOD              SERVO_FRAME_MS  /* one servo pulse per run */
+#define APP_TASK_LCD_PERIOD                1       /* one LCD byte per run, one nibble with fixed waits */
+
+/* Scheduler task offsets in timing ticks, spread the tasks over the ticks */
+#define APP_TASK_BUTTON_OFFSET             3
+#define APP_TASK_RAMP_OFFSET               7
+#define APP_TASK_SERVO_OFFSET              5
 
-/* Maximum number of rotations for the car */
-#define APP_MAX_CAR_ROTATE                 5
+/* Capacity of the record queues, powers of two: filled by the echo interrupt and by the tasks */
+#define APP_ISR_RECORDS_SIZE               4
+#define APP_TASK_RECORDS_SIZE              4
+
+/* Number of scheduler tasks of the application */
+#define APP_TASKS_COUNT                    7
+
+/* Maximum number of scans in a row before the car holds */
+#define APP_MAX_SCANS_IN_ROW               3
 
 /* Index values for LCD pin data */
 #define APP_LCD_PIN_DATA_INDEX_0           0
@@ -77,33 +146,76 @@
 /************************************************************************************************/
 		
 
-/* Enumeration for selecting the motor state */
+/* States of the application state machine. The states from APP_STATE_DECIDE on drive the car and range */
 typedef enum
 {
-	EN_MOTOR_START = 0,     // Motor start command
-	EN_MOTOR_STOP,          // Motor stop command
-	EN_MOTOR_STOP_V2,       // Alternate motor stop command
-	EN_MOTOR_IDLE           // Motor idle state
-} en_motorSel_t;
+	APP_STATE_NONE = 0,         // No state change, only used as next state in the transition table
+	APP_STATE_STOPPED,          // Motors stopped, waiting for the start button
+	APP_STATE_SET_DIR,          // The direction button selects the default rotation direction
+	APP_STATE_START_DELAY,      // Countdown before the motors start
+	APP_STATE_DECIDE,           // Motors stopped, waiting for the first distance measurement
+	APP_STATE_FORWARD,          // Front clear beyond 30 cm, forward at the speed the time-to-collision allows
+	APP_STATE_ROTATE,           // Side obstacle, rotating towards the side with more room until the front is clear or APP_2_SEC_TO_ROTATE passed
+	APP_STATE_ROTATE_CHECK,     // Rotation or turn done, motors stopped, waiting for the next distance measurement
+	APP_STATE_SCAN,             // Obstacle within 30-20 cm, motors stopped, the servo sweeps the front sensor
+	APP_STATE_TURN,             // Rotating towards the heading with the most room found by the scan
+	APP_STATE_BACKWARD,         // Obstacle closer than 20 cm, backward at 30%
+	APP_STATE_HOLD,             // No way out after APP_MAX_SCANS_IN_ROW scans in a row, holding for APP_3_SEC_HOLD_MOVE
+	APP_STATE_ANY,              // Matches every state, only used as current state in the transition table
+	APP_STATE_MAX
+} app_enu_state_t;
 
-/* Enumeration for different start states */
+/* Events feeding the application state machine */
 typedef enum
 {
-	EN_UPDATE_DIR = 0,      // Update car's direction
-	UPDATE_OBSTACLE_STATE   // Update obstacle detection state
-} en_start_states_t;
+	APP_EVENT_START_STOP = 0,   // Start/stop button pressed
+	APP_EVENT_DIR_BUTTON,       // Direction button pressed
+	APP_EVENT_TIMEOUT,          // Time limit of the current state passed
+	APP_EVENT_SIDE_OBSTACLE,    // Side distance measured below APP_SIDE_MIN_DIST
+	APP_EVENT_SCAN_DONE,        // Sweep of the front sensor finished
+	APP_EVENT_NO_OBSTACLES,     // Front distance measured above 70 cm
+	APP_EVENT_OBSTACLE_70_30,   // Front distance measured within 70-30 cm
+	APP_EVENT_OBSTACLE_30_20,   // Front distance measured within 30-20 cm
+	APP_EVENT_OBSTACLE_LESS_20, // Front distance measured below 20 cm
+	APP_EVENT_MAX
+} app_enu_event_t;
+
+/* One row of the transition table: in current_state, enu_event runs ptr_action and moves to next_state
+   if ptr_guard is NULL or returns true. The first matching row wins */
+typedef struct
+{
+	app_enu_state_t current_state;
+	app_enu_event_t enu_event;
+	uint8_t (*ptr_guard)(void);
+	void (*ptr_action)(void);
+	app_enu_state_t next_state;
+} app_str_transition_t;
 
-/* Enumeration for different obstacle detection states */
+/* Kinds of records the event sources queue for the state machine */
 typedef enum
 {
-	OBSTACLE_IDLE = 0,      // No obstacle detected, idle state
-	NO_OBSTACLES,           // No obstacles within safe range
-	OBSTACLE_70_30,         // Obstacle detected within 70-30 cm range
-	OBSTACLE_30_20,         // Obstacle detected within 30-20 cm range
-	OBSTACLE_LESS_20,       // Obstacle detected within less than 20 cm range
-	OBSTACLE_HOLD_MOVING,   // Obstacle detected, car on hold and moving
-	NO_DECISION             // No decision made yet
-} en_Dist_states_t;
+	APP_RECORD_SENSOR = 0,      // Completed ultrasonic measurement of one of the sensors
+	APP_RECORD_BUTTON,          // Debounced button press
+	APP_RECORD_TIMER,           // Time limit of a state passed
+	APP_RECORD_SCAN             // Sweep of the front sensor finished
+} app_enu_record_t;
+
+/* Record queued by an event source, APP_u8GetEvent turns it into an app_enu_event_t */
+typedef struct
+{
+	app_enu_record_t enu_type;
+	uint32_t u32_timestamp;                         // Timing tick the record was made at
+	union
+	{
+		struct
+		{
+			hultrasonic_distance_t distance;        // APP_RECORD_SENSOR: distance measured
+			uint8_t u8_sensor;                      // APP_RECORD_SENSOR: APP_SENSOR_* index of the sensor
+		} str_sensor;
+		const btn_str_config_t *ptr_str_button;     // APP_RECORD_BUTTON: button pressed
+		uint8_t u8_state_entry;                     // APP_RECORD_TIMER, APP_RECORD_SCAN: state entry the record belongs to
+	} uni_data;
+} app_str_record_t;
 
 
 /************************************************************************************************/
@@ -120,11 +232,30 @@ typedef enum
 void APP_vidInit(void);
 
 /**
- * @brief Start the application logic.
+ * @brief Run one pass of the application logic.
  *
- * This function handles the main application logic including decision making based on obstacle
- * distances and controlling the car's movement accordingly.
+ * This function runs the due scheduler tasks: the state machine, which dispatches the pending events
+ * of the buttons, the state timer and the ultrasonic ranging through the transition table, the sensor
+ * trigger, the direction button poll, the motor ramp, the servo pulse and the LCD flush. It never waits, so it is meant
+ * to be called from the main loop over and over. SCHED_enuGetStats reports the tasks in that order.
  */
 void APP_vidStart(void);
 
+/**
+ * @brief Worst reaction time seen so far.
+ *
+ * Measured from the end of the echo that changed the obstacle decision to the motor command
+ * of the resulting transition.
+ *
+ * @return Reaction time in timing ticks (about 1 ms each).
+ */
+uint32_t APP_u32GetMaxReactionTicks(void);
+
+/**
+ * @brief Duty cycle the motors were last set to.
+ *
+ * @return Duty cycle in percent, the PWM runs with it from the start of its next period.
+ */
+uint8_t APP_u8GetCarSpeed(void);
+
 #endif /* APP_H	*/
\ No newline at end of file
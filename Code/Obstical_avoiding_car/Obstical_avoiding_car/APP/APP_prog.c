@@ -15,6 +15,10 @@
 
 #define MOTOR_TURN_RIGHT			0
 #define MOTOR_TURN_LEFT				1
+
+#if APP_TASK_SENSOR_PERIOD < ULTRASONIC_MIN_CYCLE_TICKS
+#error "APP_TASK_SENSOR_PERIOD below ULTRASONIC_MIN_CYCLE_TICKS: the rate limit would skip sensor slots"
+#endif
 /************************************************************************************************/
 /*									extern functions											*/
 
@@ -25,45 +29,115 @@
 /************************************************************************************************/
 
 /**
- * @brief Change the motor state based on button press.
+ * @brief Request a duty cycle for every motor PWM channel.
+ *
+ * A lower duty cycle takes effect with the next CAR_* call, a higher one is reached step by
+ * step by the ramp task (at once when the car had no speed yet).
  *
- * This function toggles the motor state between start and stop when the button is pressed.
+ * @param[in] copy_u8_duty_cycle Duty cycle in percent.
  */
-static void BUTTON_vidChangeState(void);
+static void APP_vidSetCarSpeed(uint8_t copy_u8_duty_cycle);
 
 /**
- * @brief Update the car's direction based on user button input.
+ * @brief Queue a completed ultrasonic measurement for the state machine.
+ *
+ * Called from the echo interrupt, the only producer of the ISR record queue, for each of the sensors.
  *
- * This function allows the user to set the car's default rotation direction by pressing a button.
- * The user can switch between left and right directions. The function displays the selected direction
- * on an LCD screen and waits for a specific time before proceeding.
+ * @param[in] ptr_str_measurement The completed measurement.
  */
-static void APP_updateDirection(void);
+static void APP_vidDistanceReady(const hultrasonic_str_measurement_t *ptr_str_measurement);
 
 /**
- * @brief Convert an unsigned 8-bit integer to a string representation.
+ * @brief Take the next pending event.
  *
- * This function takes an unsigned 8-bit integer and converts it to its string representation.
- * The resulting string is stored in the provided buffer, and the buffer is null-terminated.
- * The function handles the special case of zero and converts each digit of the number to a character.
+ * Records of the tasks (buttons, state timer) are taken before those of the echo interrupt
+ * (measurements), each queue in order. Records that no longer apply are dropped. Measurements
+ * pass the distance filter of their sensor, only front measurements it is confident about lead to
+ * a decision. Side measurements are kept for the escape direction.
  *
- * @param[in] copy_u8_num The unsigned 8-bit integer to be converted.
- * @param[out] ptr_string Pointer to the buffer where the string representation will be stored.
+ * @param[out] ptr_enu_event Receives the event.
+ * @return U8_ONE_VALUE if an event was pending, U8_ZERO_VALUE otherwise.
  */
-static void intToString(uint8_t copy_u8_num, uint8_t *ptr_string);
+static uint8_t APP_u8GetEvent(app_enu_event_t *ptr_enu_event);
 
+/**
+ * @brief Run the first transition of the table matching the current state and an event.
+ *
+ * @param[in] copy_enu_event The event.
+ */
+static void APP_vidDispatch(app_enu_event_t copy_enu_event);
 
 /**
- * @brief Make a decision based on the distance measured by the ultrasonic sensor.
+ * @brief Make a state current and arm its time limit.
  *
- * This function reads the distance from the ultrasonic sensor, and based on the measured distance,
- * it makes a decision about the obstacles in the car's path. The decision is stored in the provided
- * pointer to an en_Dist_states_t variable.
+ * @param[in] copy_enu_state The new state.
+ */
+static void APP_vidEnterState(app_enu_state_t copy_enu_state);
+
+/**
+ * @brief Write the last measured distance to the second LCD row.
+ */
+static void APP_vidShowDistance(void);
+
+/**
+ * @brief Set the duty cycle of every motor PWM channel at once, the PWM takes it at the start of its next period.
  *
- * @param[in,out] ptr_f_distination Pointer to the variable storing the measured distance.
- * @param[in,out] ptr_enu_decision Pointer to the variable where the decision will be stored.
+ * @param[in] copy_u8_duty_cycle Duty cycle in percent.
  */
-static void APP_make_decision(float64_t *ptr_f_distination, en_Dist_states_t *ptr_enu_decision);
+static void APP_vidApplyCarSpeed(uint8_t copy_u8_duty_cycle);
+
+/* Scheduler tasks */
+static void APP_vidTaskDecide(void);
+static void APP_vidTaskSensor(void);
+static void APP_vidTaskButton(void);
+static void APP_vidTaskRamp(void);
+
+/**
+ * @brief Callback of the state timer, records that the time limit of the current state passed.
+ */
+static void APP_vidStateTimeout(void);
+
+/**
+ * @brief Pick the rotation direction, towards the side with more room.
+ *
+ * @return MOTOR_TURN_LEFT or MOTOR_TURN_RIGHT, the default rotation direction unless both sides were
+ *         measured lately and one has APP_SIDE_MARGIN more room than the other.
+ */
+static uint8_t APP_u8EscapeDirection(void);
+
+/**
+ * @brief Forward speed for the time-to-collision with APP_TTC_MARGIN.
+ *
+ * APP_CAR_SPEED_MAX_PRE is scaled by the ratio of the time-to-collision to APP_TTC_TARGET_MS, down to
+ * zero at the margin. The closing speed follows the duty cycle, so the speed falls with the square root
+ * of the room left and the car runs out of speed just before the margin whatever speed it came at.
+ *
+ * @return Duty cycle in percent, the current target speed without an estimate.
+ */
+static uint8_t APP_u8CruiseSpeed(void);
+
+/* Guards of the transition table */
+static uint8_t APP_u8CanScanAgain(void);
+static uint8_t APP_u8HasWayOut(void);
+static uint8_t APP_u8MustBrake(void);
+
+/* Actions of the transition table */
+static void APP_vidStop(void);
+static void APP_vidSetDir(void);
+static void APP_vidToggleDir(void);
+static void APP_vidStartDelay(void);
+static void APP_vidDecide(void);
+static void APP_vidForward(void);
+static void APP_vidCruise(void);
+static void APP_vidRotate(void);
+static void APP_vidRotateDone(void);
+static void APP_vidScan(void);
+static void APP_vidRescan(void);
+static void APP_vidTurn(void);
+static void APP_vidTurnDone(void);
+static void APP_vidBackward(void);
+static void APP_vidHold(void);
+
 /************************************************************************************************/
 /*									Global variables											*/
 /************************************************************************************************/
@@ -71,38 +145,149 @@ static void APP_make_decision(float64_t *ptr_f_distination, en_Dist_states_t *pt
 /* Initial direction state counter */
 uint8_t u8_g_dirStateCounter = MOTOR_TURN_RIGHT;  // Initial direction state is right
 
-/* Motor selection state */
-en_motorSel_t en_motorSel = EN_MOTOR_STOP;  // Initial motor state is stopped
-
-/* State for the application */
-en_start_states_t en_start_state = EN_UPDATE_DIR;  // Initial start state is updating direction
-
-/* Current obstacle detection state */
-en_Dist_states_t en_Dist_states = OBSTACLE_IDLE;  // Initial obstacle detection state is idle
-
-/* Static variables for storing data */
-static double gs_fl_dist;  // Stores the measured distance
-static uint8_t gs_arr_u8_string[APP_MAX_STRING_SIZE];  // Array for converting numbers to strings
-static uint8_t gs_u8_rotate_counter = 1;  // Counter for rotation iterations
+/* Transition table of the application, the first matching row wins */
+static const app_str_transition_t gs_arr_str_transitions[] = {
+	/* Start/stop button */
+	{APP_STATE_STOPPED,      APP_EVENT_START_STOP,       NULL,                 APP_vidSetDir,      APP_STATE_SET_DIR},
+	{APP_STATE_ANY,          APP_EVENT_START_STOP,       NULL,                 APP_vidStop,        APP_STATE_STOPPED},
+
+	/* Direction selection and countdown */
+	{APP_STATE_SET_DIR,      APP_EVENT_DIR_BUTTON,       NULL,                 APP_vidToggleDir,   APP_STATE_NONE},
+	{APP_STATE_SET_DIR,      APP_EVENT_TIMEOUT,          NULL,                 APP_vidStartDelay,  APP_STATE_START_DELAY},
+	{APP_STATE_START_DELAY,  APP_EVENT_TIMEOUT,          NULL,                 APP_vidDecide,      APP_STATE_DECIDE},
+
+	/* First measurement */
+	{APP_STATE_DECIDE,       APP_EVENT_NO_OBSTACLES,     NULL,                 APP_vidForward,     APP_STATE_FORWARD},
+	{APP_STATE_DECIDE,       APP_EVENT_OBSTACLE_70_30,   NULL,                 APP_vidForward,     APP_STATE_FORWARD},
+	{APP_STATE_DECIDE,       APP_EVENT_OBSTACLE_30_20,   NULL,                 APP_vidScan,        APP_STATE_SCAN},
+	{APP_STATE_DECIDE,       APP_EVENT_OBSTACLE_LESS_20, NULL,                 APP_vidBackward,    APP_STATE_BACKWARD},
+
+	/* Driving: the speed follows the time-to-collision with every front distance, the car stops and scans once it runs out of speed */
+	{APP_STATE_FORWARD,      APP_EVENT_NO_OBSTACLES,     APP_u8MustBrake,      APP_vidScan,        APP_STATE_SCAN},
+	{APP_STATE_FORWARD,      APP_EVENT_NO_OBSTACLES,     NULL,                 APP_vidCruise,      APP_STATE_NONE},
+	{APP_STATE_FORWARD,      APP_EVENT_OBSTACLE_70_30,   APP_u8MustBrake,      APP_vidScan,        APP_STATE_SCAN},
+	{APP_STATE_FORWARD,      APP_EVENT_OBSTACLE_70_30,   NULL,                 APP_vidCruise,      APP_STATE_NONE},
+	{APP_STATE_FORWARD,      APP_EVENT_OBSTACLE_30_20,   APP_u8MustBrake,      APP_vidScan,        APP_STATE_SCAN},
+	{APP_STATE_FORWARD,      APP_EVENT_OBSTACLE_30_20,   NULL,                 APP_vidCruise,      APP_STATE_NONE},
+	{APP_STATE_FORWARD,      APP_EVENT_OBSTACLE_LESS_20, NULL,                 APP_vidBackward,    APP_STATE_BACKWARD},
+
+	/* Side obstacle: turn away from it until the front is clear */
+	{APP_STATE_FORWARD,      APP_EVENT_SIDE_OBSTACLE,    NULL,                 APP_vidRotate,      APP_STATE_ROTATE},
+	{APP_STATE_ROTATE,       APP_EVENT_NO_OBSTACLES,     NULL,                 APP_vidForward,     APP_STATE_FORWARD},
+	{APP_STATE_ROTATE,       APP_EVENT_TIMEOUT,          NULL,                 APP_vidRotateDone,  APP_STATE_ROTATE_CHECK},
+
+	/* Obstacle within 30-20 cm: scan and turn towards the most room, scan again while blocked up to APP_MAX_SCANS_IN_ROW times in a row */
+	{APP_STATE_ROTATE_CHECK, APP_EVENT_NO_OBSTACLES,     NULL,                 APP_vidForward,     APP_STATE_FORWARD},
+	{APP_STATE_ROTATE_CHECK, APP_EVENT_OBSTACLE_70_30,   NULL,                 APP_vidForward,     APP_STATE_FORWARD},
+	{APP_STATE_ROTATE_CHECK, APP_EVENT_OBSTACLE_30_20,   APP_u8CanScanAgain,   APP_vidScan,        APP_STATE_SCAN},
+	{APP_STATE_ROTATE_CHECK, APP_EVENT_OBSTACLE_30_20,   NULL,                 APP_vidHold,        APP_STATE_HOLD},
+	{APP_STATE_ROTATE_CHECK, APP_EVENT_OBSTACLE_LESS_20, NULL,                 APP_vidBackward,    APP_STATE_BACKWARD},
+	{APP_STATE_SCAN,         APP_EVENT_SCAN_DONE,        APP_u8HasWayOut,      APP_vidTurn,        APP_STATE_TURN},
+	{APP_STATE_SCAN,         APP_EVENT_SCAN_DONE,        NULL,                 APP_vidHold,        APP_STATE_HOLD},
+	{APP_STATE_TURN,         APP_EVENT_TIMEOUT,          NULL,                 APP_vidTurnDone,    APP_STATE_ROTATE_CHECK},
+	{APP_STATE_HOLD,         APP_EVENT_TIMEOUT,          NULL,                 APP_vidRescan,      APP_STATE_SCAN},
+
+	/* Obstacle closer than 20 cm */
+	{APP_STATE_BACKWARD,     APP_EVENT_NO_OBSTACLES,     NULL,                 APP_vidForward,     APP_STATE_FORWARD},
+	{APP_STATE_BACKWARD,     APP_EVENT_OBSTACLE_70_30,   NULL,                 APP_vidForward,     APP_STATE_FORWARD},
+	{APP_STATE_BACKWARD,     APP_EVENT_OBSTACLE_30_20,   NULL,                 APP_vidScan,        APP_STATE_SCAN},
+};
+
+/* Scheduler task table, in priority order */
+static const sched_str_task_t gs_arr_str_tasks[APP_TASKS_COUNT] = {
+	/* Task                 Period                  Offset                  Deadline */
+	{timing_wheel_process, APP_TASK_TIMERS_PERIOD, 0,                      0},
+	{APP_vidTaskDecide,    APP_TASK_DECIDE_PERIOD, 0,                      0},
+	{APP_vidTaskSensor,    APP_TASK_SENSOR_PERIOD, 0,                      0},
+	{APP_vidTaskButton,    APP_TASK_BUTTON_PERIOD, APP_TASK_BUTTON_OFFSET, 0},
+	{APP_vidTaskRamp,      APP_TASK_RAMP_PERIOD,   APP_TASK_RAMP_OFFSET,   0},
+	{SERVO_vidTick,        APP_TASK_SERVO_PERIOD,  APP_TASK_SERVO_OFFSET,  0},
+	{LCD_vidFlushTick,     APP_TASK_LCD_PERIOD,    0,                      0},
+};
+
+/* Time limit of each state in milliseconds, 0 for none */
+static const uint32_t gs_arr_u32_state_timeout[APP_STATE_MAX] = {
+	[APP_STATE_SET_DIR]     = APP_SEC_TO_MS(APP_WAIT_TO_SET_DIR_TIME),
+	[APP_STATE_START_DELAY] = APP_SEC_TO_MS(APP_2_SEC_TO_START),
+	[APP_STATE_ROTATE]      = APP_SEC_TO_MS(APP_2_SEC_TO_ROTATE),
+	[APP_STATE_HOLD]        = APP_SEC_TO_MS(APP_3_SEC_HOLD_MOVE),
+};
+
+/* State machine */
+static app_enu_state_t gs_enu_state = APP_STATE_STOPPED;  // Current state
+static timing_str_timer_t gs_str_state_timer;  // Time limit of the current state, on the timer wheel
+static uint8_t gs_u8_state_entry = 0;  // Counts state entries, tells a timer record of an earlier entry
+
+/* Event records, each queue has a single producer context and APP_vidTaskDecide as consumer */
+static app_str_record_t gs_arr_str_isr_records[APP_ISR_RECORDS_SIZE];
+static ring_str_t gs_str_isr_records = RING_INITIALIZER(gs_arr_str_isr_records);  // Echo interrupt
+static app_str_record_t gs_arr_str_task_records[APP_TASK_RECORDS_SIZE];
+static ring_str_t gs_str_task_records = RING_INITIALIZER(gs_arr_str_task_records);  // Scheduler tasks, which never preempt each other
+
+/* Motor speed: duty cycle applied to the PWM channels and duty cycle the ramp task goes to */
+static uint8_t gs_u8_car_speed = 0;
+static uint8_t gs_u8_car_target_speed = 0;
+
+/* Ultrasonic sensors in APP_SENSOR_* order: front, left and right, their echoes share the signal pin */
+static const hultrasonic_str_config_t gs_arr_str_sensors[APP_SENSORS_COUNT] = {
+	{PORTB, PIN3},
+	{PORTB, PIN0},
+	{PORTB, PIN1},
+};
+
+/* Sensor triggered in each slot of the sensor task, the front sensor never waits more than two slots */
+static const uint8_t gs_arr_u8_sensor_slots[APP_SENSOR_SLOTS_COUNT] = {
+	APP_SENSOR_FRONT, APP_SENSOR_FRONT, APP_SENSOR_FRONT, APP_SENSOR_LEFT,
+	APP_SENSOR_FRONT, APP_SENSOR_FRONT, APP_SENSOR_FRONT, APP_SENSOR_RIGHT
+};
+static uint8_t gs_u8_sensor_slot = 0;  // Next slot of gs_arr_u8_sensor_slots
+
+/* Static variables for storing data, one entry per sensor */
+static hultrasonic_distance_t gs_arr_dist[APP_SENSORS_COUNT];  // Filtered distances, 0 until a sensor was measured
+static uint32_t gs_arr_u32_dist_timestamp[APP_SENSORS_COUNT];  // Timing tick at the end of the echo of the distance in gs_arr_dist
+static dfilter_str_t gs_arr_str_dist_filters[APP_SENSORS_COUNT];  // Median, gate and EMA between the measurements and the decisions
+static ttc_str_t gs_str_front_ttc;  // Closing speed of the filtered front distances
+static ttc_str_output_t gs_str_front_ttc_output;  // Estimate of the last front distance
+static uint8_t gs_u8_scan_counter = 0;  // Scans since the car last drove
+static uint32_t gs_u32_turn_ms = 0;  // Time limit of APP_STATE_TURN, set by APP_vidTurn
+static uint32_t gs_u32_max_reaction_ticks = 0;  // Worst time from echo end to motor command
 
 /* LCD configuration */
 static lcd_str_config_t gs_str_lcd_config;  // LCD configuration structure
 
-/* External Interrupt configuration for the button */
-static extim_str_config_t gs_str_extim_config_btn;  // External Interrupt configuration structure
-
-/* PWM configuration for controlling motor speed */
-static pwm_str_configuration_t gs_str_pwm_pin;  // PWM configuration structure
+/* LCD texts, kept in flash and read by LCD_writeString_P */
+static const uint8_t gs_arr_u8_txt_stopped[] PROGMEM = "Motor Stopped";
+static const uint8_t gs_arr_u8_txt_set_dir[] PROGMEM = "Set Def. Rot.";
+static const uint8_t gs_arr_u8_txt_left[] PROGMEM = "Left ";
+static const uint8_t gs_arr_u8_txt_right[] PROGMEM = "Right";
+static const uint8_t gs_arr_u8_txt_starts_in[] PROGMEM = "Motor starts in";
+static const uint8_t gs_arr_u8_txt_2_sec[] PROGMEM = "2 Sec.";
+static const uint8_t gs_arr_u8_txt_speed_30[] PROGMEM = "Speed:30% ";
+static const uint8_t gs_arr_u8_txt_speed_0[] PROGMEM = "Speed:0%  ";
+static const uint8_t gs_arr_u8_txt_dir_forward[] PROGMEM = "Dir:F";
+static const uint8_t gs_arr_u8_txt_dir_rotate[] PROGMEM = "Dir:R";
+static const uint8_t gs_arr_u8_txt_dir_backward[] PROGMEM = "Dir:B";
+static const uint8_t gs_arr_u8_txt_dir_scan[] PROGMEM = "Dir:S";
+static const uint8_t gs_arr_u8_txt_hold[] PROGMEM = "Hold move 3S";
+static const uint8_t gs_arr_u8_txt_dist[] PROGMEM = APP_DIST_LABEL;
+static const uint8_t gs_arr_u8_txt_dist_unit[] PROGMEM = APP_DIST_UNIT_LABEL;
+
+/* Distance on the second row, its labels are painted by APP_vidDecide */
+static const lcd_str_field_t gs_str_dist_field = {LCD_ROW_2, APP_DIST_FIELD_COL, APP_DIST_FIELD_WIDTH, LCD_BLANK_CHAR};
+
+/* Forward speed on the first row, inside the text painted by APP_vidForward */
+static const lcd_str_field_t gs_str_speed_field = {LCD_ROW_1, APP_SPEED_FIELD_COL, APP_SPEED_FIELD_WIDTH, LCD_BLANK_CHAR};
+
+/* PWM configuration for controlling motor speed, one entry per enable channel */
+static pwm_str_configuration_t gs_arr_str_pwm_pin[CAR_PWM_CHANNELS];  // PWM configuration structures
 
 /* Motor configurations */
 static motor_str_config_t gs_str_motor_1;  // Motor 1 configuration structure
 static motor_str_config_t gs_str_motor_2;  // Motor 2 configuration structure
 
-/* Button state configuration */
-static btn_str_config_t gs_btn_dir_state;  // Button configuration structure
-
-/* Button enumerated state */
-static btn_enu_state_t gs_enu_btn_dir_state;  // Button enumerated state
+/* Button configurations, registered with the debouncer of BTN_vidTick */
+static btn_str_config_t gs_btn_dir_state;  // Direction button configuration structure
+static btn_str_config_t gs_btn_start_stop;  // Start/stop button configuration structure
 
 
 /************************************************************************************************/
@@ -116,10 +301,17 @@ static btn_enu_state_t gs_enu_btn_dir_state;  // Button enumerated state
  */
 void APP_vidInit(void)
 {
-    // Initialize ultrasonic sensor and enable interrupts
+    // Initialize the ultrasonic sensors and enable interrupts
     HULTRASONIC_vidInit();
+    for(uint8_t u8_sensor = 0; u8_sensor < APP_SENSORS_COUNT; u8_sensor++){
+        (void) HULTRASONIC_enuInitSensor(&gs_arr_str_sensors[u8_sensor]);
+        (void) DFILTER_enuInit(&gs_arr_str_dist_filters[u8_sensor]);
+    }
     HULTRASONIC_vidInterruptEnable();
 
+    // The front sensor sits on the servo, looking straight ahead unless it scans
+    (void) SCAN_enuInit(&gs_arr_str_sensors[APP_SENSOR_FRONT]);
+
     /* LCD Initialization */
     // Configuration for the LCD
     gs_str_lcd_config.enu_mode = LCD_4_BIT_MODE;
@@ -153,13 +345,9 @@ void APP_vidInit(void)
     gs_btn_dir_state.enu_pin   = PIN1;
     BTN_init(&gs_btn_dir_state);
 
-    /* External Interrupt Initialization */
-    gs_str_extim_config_btn.enu_exti_interrupt_no = EXTI_0;
-    gs_str_extim_config_btn.enu_edge_detection    = EXTI_FALLING_EDGE;
-    extim_init(&gs_str_extim_config_btn, BUTTON_vidChangeState);
-
-    /* Timing Initialization */
-    timing_init_1(APP_SYS_TICK_DURATION);
+    gs_btn_start_stop.enu_port = PORTD;
+    gs_btn_start_stop.enu_pin  = PIN2;
+    BTN_init(&gs_btn_start_stop);
 
     /* Motor Initialization */
     gs_str_motor_1.port        = PORTA;
@@ -171,315 +359,680 @@ void APP_vidInit(void)
     gs_str_motor_2.pin_num2    = PIN1;
 
     // PWM Configuration for Car Control
-    gs_str_pwm_pin.frequency       = APP_CAR_PWM_FREQ;
-    gs_str_pwm_pin.duty_cycle      = APP_CAR_SPEED_30_PRE;
-    gs_str_pwm_pin.enu_pin_index   = PIN2;
-    gs_str_pwm_pin.enu_port_index  = PORTA;
-    CAR_INIT(&gs_str_motor_1, &gs_str_motor_2, &gs_str_pwm_pin);
-
-    // Start the timing system
-    timing_start_1();
+#if PWM_BACKEND == PWM_BACKEND_TIMER1
+    gs_arr_str_pwm_pin[0].enu_pin_index   = PWM_OC1A_PIN;
+    gs_arr_str_pwm_pin[0].enu_port_index  = PWM_OC1A_PORT;
+    gs_arr_str_pwm_pin[1].enu_pin_index   = PWM_OC1B_PIN;
+    gs_arr_str_pwm_pin[1].enu_port_index  = PWM_OC1B_PORT;
+#else
+    gs_arr_str_pwm_pin[0].enu_pin_index   = PIN2;
+    gs_arr_str_pwm_pin[0].enu_port_index  = PORTA;
+#endif
+    for(uint8_t u8_channel = 0; u8_channel < CAR_PWM_CHANNELS; u8_channel++){
+        gs_arr_str_pwm_pin[u8_channel].frequency = APP_CAR_PWM_FREQ;
+    }
+    APP_vidSetCarSpeed(APP_CAR_SPEED_30_PRE);
+    CAR_INIT(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
+
+    // Enter the initial state
+    (void) timing_timer_init(&gs_str_state_timer);
+    APP_vidStop();
+    APP_vidEnterState(APP_STATE_STOPPED);
+
+    // Run the application from the scheduler
+    SCHED_enuInit(gs_arr_str_tasks, APP_TASKS_COUNT);
 }
 
 
+
 /**
- * @brief Start the application logic.
+ * @brief Run one pass of the application logic.
  *
- * This function handles the main application logic including decision making based on obstacle
- * distances and controlling the car's movement accordingly.
+ * This function runs the due scheduler tasks and returns.
  */
 void APP_vidStart(void)
 {
-	// Enable external interrupt
-	extim_enable(&gs_str_extim_config_btn);
+	SCHED_vidRun();
+}
+
+
+/**
+ * @brief Worst reaction time seen so far.
+ *
+ * @return Reaction time in timing ticks.
+ */
+uint32_t APP_u32GetMaxReactionTicks(void)
+{
+	return gs_u32_max_reaction_ticks;
+}
+
+
+/**
+ * @brief Duty cycle the motors were last set to.
+ *
+ * @return Duty cycle in percent.
+ */
+uint8_t APP_u8GetCarSpeed(void)
+{
+	return gs_u8_car_speed;
+}
+
+
+
+/************************************************************************************************/
+/*									Static Function Implementation                				*/
+/************************************************************************************************/
+
+/**
+ * @brief State machine task, dispatches every pending event through the transition table.
+ */
+void APP_vidTaskDecide(void)
+{
+	app_enu_event_t enu_event;
+
+	while(APP_u8GetEvent(&enu_event) == U8_ONE_VALUE){
+		APP_vidDispatch(enu_event);
+	}
+}
+
+
+/**
+ * @brief Queue that the time limit of the current state passed.
+ */
+void APP_vidStateTimeout(void)
+{
+	app_str_record_t str_record;
+
+	str_record.enu_type = APP_RECORD_TIMER;
+	str_record.u32_timestamp = timing_get_tick_count();
+	str_record.uni_data.u8_state_entry = gs_u8_state_entry;
+	(void) RING_enuPush(&gs_str_task_records, &str_record);
+}
+
+
+/**
+ * @brief Sensor task, starts the next ultrasonic measurement while the car drives.
+ *
+ * One sensor per run in the order of gs_arr_u8_sensor_slots, so the echoes never overlap. While the
+ * car scans, the sweep pings the front sensor instead and its end is queued for the state machine.
+ */
+void APP_vidTaskSensor(void)
+{
+	app_str_record_t str_record;
+	uint8_t u8_sensor;
+
+	if(gs_enu_state == APP_STATE_SCAN){
+		if(SCAN_enuTick() == SCAN_OK){
+			str_record.enu_type = APP_RECORD_SCAN;
+			str_record.u32_timestamp = timing_get_tick_count();
+			str_record.uni_data.u8_state_entry = gs_u8_state_entry;
+			(void) RING_enuPush(&gs_str_task_records, &str_record);
+		}
+	} else if(gs_enu_state >= APP_STATE_DECIDE){
+		u8_sensor = gs_arr_u8_sensor_slots[gs_u8_sensor_slot];
+		gs_u8_sensor_slot = (gs_u8_sensor_slot + U8_ONE_VALUE) % APP_SENSOR_SLOTS_COUNT;
+		(void) HULTRASONIC_enuStartMeasurement(&gs_arr_str_sensors[u8_sensor], APP_vidDistanceReady);  // Ranging runs while the application goes on
+	}
+}
+
 
-	if(en_motorSel == EN_MOTOR_START){
+/**
+ * @brief Button task, debounces the buttons and queues their presses.
+ */
+void APP_vidTaskButton(void)
+{
+	btn_str_event_t str_event;
+	app_str_record_t str_record;
 
-		if (en_start_state == EN_UPDATE_DIR)
-		{
-			// Clear LCD and display message
-			LCD_clear (&gs_str_lcd_config);
-			LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
-			LCD_writeString (&gs_str_lcd_config, (uint8_t*) "Set Def. Rot.");
-			// Update direction based on obstacle detection
-			APP_updateDirection();
-			en_start_state = UPDATE_OBSTACLE_STATE;
+	BTN_vidTick();
+
+	while(BTN_get_event(&str_event) == BTN_E_OK){
+		if(str_event.enu_event == BTN_EVENT_PRESS){
+			str_record.enu_type = APP_RECORD_BUTTON;
+			str_record.u32_timestamp = timing_get_tick_count();
+			str_record.uni_data.ptr_str_button = str_event.ptr_str_button;
+			(void) RING_enuPush(&gs_str_task_records, &str_record);
 		}
+	}
+}
 
-		// Continuously loop while motor is started
-		while(en_motorSel == EN_MOTOR_START){
-			// Check if maximum rotation count has not been reached
-			if(gs_u8_rotate_counter < APP_MAX_CAR_ROTATE){
-				APP_make_decision(&gs_fl_dist, &en_Dist_states);
-			}
 
-			if(en_Dist_states == NO_OBSTACLES){
-				// Display speed and direction information on LCD
-				LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
-				LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Speed:30% ");
-				LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Dir:F");
-
-				// Continue moving forward for a set time period
-				while((timing_time_out(APP_5_SEC_WITHOUT_OBSTACLES) == TIMING_NOT_TIME_OUT) && (en_motorSel == EN_MOTOR_START)){
-					LCD_setCursor (&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
-					LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Dist: ");
-					intToString((uint8_t)gs_fl_dist, gs_arr_u8_string);
-					LCD_writeString (&gs_str_lcd_config, gs_arr_u8_string);
-					LCD_writeString (&gs_str_lcd_config,(uint8_t*)" cm ");
-					gs_str_pwm_pin.duty_cycle = APP_CAR_SPEED_30_PRE;
-					CAR_FORWARD(&gs_str_motor_1, &gs_str_motor_2, &gs_str_pwm_pin);
-					APP_make_decision(&gs_fl_dist, &en_Dist_states);
-				}
+/**
+ * @brief Motor ramp task, raises the duty cycle by APP_CAR_RAMP_STEP towards the requested one.
+ */
+void APP_vidTaskRamp(void)
+{
+	uint8_t u8_speed;
 
-				// Check obstacle state again after time period
-				if(en_Dist_states == NO_OBSTACLES){
-					LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
-					LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Speed:50% ");
-					gs_str_pwm_pin.duty_cycle = APP_CAR_SPEED_50_PRE;
-					CAR_FORWARD(&gs_str_motor_1, &gs_str_motor_2, &gs_str_pwm_pin);
-
-					// Continue moving forward while monitoring obstacle state
-					while((en_Dist_states == NO_OBSTACLES) && (en_motorSel == EN_MOTOR_START)){
-						LCD_setCursor (&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
-						LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Dist: ");
-						intToString((uint8_t)gs_fl_dist, gs_arr_u8_string);
-						LCD_writeString (&gs_str_lcd_config, gs_arr_u8_string);
-						LCD_writeString (&gs_str_lcd_config,(uint8_t*)" cm ");
-						APP_make_decision(&gs_fl_dist, &en_Dist_states);
-					}
-					} else {
-					// No action needed
-				}
-				} else if(en_Dist_states == OBSTACLE_70_30){
-				LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
-				LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Speed:30% ");
-				LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Dir:F");
-
-				gs_str_pwm_pin.duty_cycle = APP_CAR_SPEED_30_PRE;
-				CAR_FORWARD(&gs_str_motor_1, &gs_str_motor_2, &gs_str_pwm_pin);
-
-				while((en_Dist_states == OBSTACLE_70_30) && (en_motorSel == EN_MOTOR_START)){
-					LCD_setCursor (&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
-					LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Dist: ");
-					intToString((uint8_t)gs_fl_dist, gs_arr_u8_string);
-					LCD_writeString (&gs_str_lcd_config, gs_arr_u8_string);
-					LCD_writeString (&gs_str_lcd_config,(uint8_t*)" cm ");
-					APP_make_decision(&gs_fl_dist, &en_Dist_states);
-				}
+	if(gs_u8_car_speed < gs_u8_car_target_speed){
+		u8_speed = gs_u8_car_speed + APP_CAR_RAMP_STEP;
+		APP_vidApplyCarSpeed((u8_speed > gs_u8_car_target_speed) ? gs_u8_car_target_speed : u8_speed);
+		LCD_writeField (&gs_str_lcd_config, &gs_str_speed_field, gs_u8_car_speed);
+	}
+}
 
-				} else if(en_Dist_states == OBSTACLE_30_20){
 
-				LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
-				LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Speed:30% ");
-				LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Dir:R");
-				CAR_STOP(&gs_str_motor_1, &gs_str_motor_2, &gs_str_pwm_pin);
+/**
+ * @brief Take the next pending event.
+ *
+ * @param[out] ptr_enu_event Receives the event.
+ * @return U8_ONE_VALUE if an event was pending, U8_ZERO_VALUE otherwise.
+ */
+uint8_t APP_u8GetEvent(app_enu_event_t *ptr_enu_event)
+{
+	app_str_record_t str_record;
+	dfilter_str_output_t str_filtered;
+	hultrasonic_distance_t f_distination = APP_MAX_MEASURED_DIST;
+	uint8_t u8_sensor;
+
+	while(RING_enuPop(&gs_str_task_records, &str_record) == RING_OK){
+		if(str_record.enu_type == APP_RECORD_TIMER){
+			if(str_record.uni_data.u8_state_entry == gs_u8_state_entry){
+				*ptr_enu_event = APP_EVENT_TIMEOUT;
+				return U8_ONE_VALUE;
+			}
+			// The state was left or entered again after the timer expired
+		} else if(str_record.enu_type == APP_RECORD_SCAN){
+			if(str_record.uni_data.u8_state_entry == gs_u8_state_entry){
+				*ptr_enu_event = APP_EVENT_SCAN_DONE;
+				return U8_ONE_VALUE;
+			}
+			// Already dispatched, the sweep stays done until the next one starts
+		} else if(str_record.uni_data.ptr_str_button == &gs_btn_start_stop){
+			*ptr_enu_event = APP_EVENT_START_STOP;
+			return U8_ONE_VALUE;
+		} else if(gs_enu_state == APP_STATE_SET_DIR){
+			*ptr_enu_event = APP_EVENT_DIR_BUTTON;
+			return U8_ONE_VALUE;
+		} else {
+			// The direction button only counts while the direction can be set
+		}
+	}
 
-				gs_str_pwm_pin.duty_cycle = APP_CAR_SPEED_30_PRE;
-				if(u8_g_dirStateCounter == MOTOR_TURN_LEFT){
-					CAR_REVERSE_LEFT(&gs_str_motor_1, &gs_str_motor_2, &gs_str_pwm_pin);
-					} else {
-					CAR_REVERSE_RIGHT(&gs_str_motor_1, &gs_str_motor_2, &gs_str_pwm_pin);
+	if(gs_enu_state >= APP_STATE_DECIDE){
+		while(RING_enuPop(&gs_str_isr_records, &str_record) == RING_OK){
+			u8_sensor = str_record.uni_data.str_sensor.u8_sensor;
+			(void) DFILTER_enuUpdate(&gs_arr_str_dist_filters[u8_sensor], str_record.uni_data.str_sensor.distance, str_record.u32_timestamp, &str_filtered);
+			if(str_filtered.enu_confidence == DFILTER_CONFIDENCE_HIGH){
+				f_distination = str_filtered.distance;
+				if(f_distination > APP_MAX_MEASURED_DIST) {
+					f_distination = APP_MAX_MEASURED_DIST;  // Limit the distance to 99 cm
 				}
-				while((timing_time_out(APP_2_SEC_TO_ROTATE) == TIMING_NOT_TIME_OUT) && (en_motorSel == EN_MOTOR_START)){
-					LCD_setCursor (&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
-					LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Dist: ");
-					intToString((uint8_t)gs_fl_dist, gs_arr_u8_string);
-					LCD_writeString (&gs_str_lcd_config, gs_arr_u8_string);
-					LCD_writeString (&gs_str_lcd_config,(uint8_t*)" cm ");
-					APP_make_decision(&gs_fl_dist, &en_Dist_states);
+				gs_arr_dist[u8_sensor] = f_distination;
+				gs_arr_u32_dist_timestamp[u8_sensor] = str_record.u32_timestamp;
+				if(u8_sensor == APP_SENSOR_FRONT){
+					(void) TTC_enuUpdate(&gs_str_front_ttc, f_distination, str_record.u32_timestamp, APP_TTC_MARGIN, &gs_str_front_ttc_output);
 				}
-				CAR_STOP(&gs_str_motor_1, &gs_str_motor_2, &gs_str_pwm_pin);
-				APP_make_decision(&gs_fl_dist, &en_Dist_states);
-				if(en_Dist_states == OBSTACLE_30_20){
-					gs_u8_rotate_counter++;
-					if(gs_u8_rotate_counter >= APP_MAX_CAR_ROTATE){
-						en_Dist_states = OBSTACLE_HOLD_MOVING;
-						} else {
-						// No action needed
-					}
-					} else {
-					gs_u8_rotate_counter = U8_ONE_VALUE;
+				if((u8_sensor != APP_SENSOR_FRONT) && (f_distination < APP_SIDE_MIN_DIST)){
+					*ptr_enu_event = APP_EVENT_SIDE_OBSTACLE;  // Closing in on a wall the front sensor does not see
+					return U8_ONE_VALUE;
 				}
-
-				} else if(en_Dist_states == OBSTACLE_LESS_20){
-				LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
-				LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Speed:30% ");
-				LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Dir:B");
-				gs_str_pwm_pin.duty_cycle = APP_CAR_SPEED_30_PRE;
-				CAR_BACKWARD(&gs_str_motor_1, &gs_str_motor_2, &gs_str_pwm_pin);
-				while((en_Dist_states == OBSTACLE_LESS_20) && (en_motorSel == EN_MOTOR_START)){
-					LCD_setCursor (&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
-					LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Dist: ");
-					intToString((uint8_t)gs_fl_dist, gs_arr_u8_string);
-					LCD_writeString (&gs_str_lcd_config, gs_arr_u8_string);
-					LCD_writeString (&gs_str_lcd_config,(uint8_t*)" cm ");
-					APP_make_decision(&gs_fl_dist, &en_Dist_states);
+			}
+			if((str_filtered.enu_confidence == DFILTER_CONFIDENCE_HIGH) && (u8_sensor == APP_SENSOR_FRONT)){
+				if(gs_enu_state != APP_STATE_HOLD){
+					APP_vidShowDistance();
 				}
-			} else if(en_Dist_states == OBSTACLE_HOLD_MOVING)
-			{
-				LCD_clear(&gs_str_lcd_config);
-				LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
-				LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Hold move 3S");
-				while((timing_time_out(APP_3_SEC_HOLD_MOVE) == TIMING_NOT_TIME_OUT) && (en_motorSel == EN_MOTOR_START));
-				gs_u8_rotate_counter = U8_ONE_VALUE;
-				APP_make_decision(&gs_fl_dist, &en_Dist_states);
+
+				// Make a decision based on the measured distance
+				if(f_distination > APP_DISTANCE_70_CM) {
+					*ptr_enu_event = APP_EVENT_NO_OBSTACLES;  // No obstacles in the path
+				} else if (f_distination > APP_DISTANCE_30_CM) {
+					*ptr_enu_event = APP_EVENT_OBSTACLE_70_30;  // Obstacle at 70-30 cm distance
+				} else if (f_distination >= APP_DISTANCE_20_CM) {
+					*ptr_enu_event = APP_EVENT_OBSTACLE_30_20;  // Obstacle at 30-20 cm distance
 				} else {
-				// No action needed
+					*ptr_enu_event = APP_EVENT_OBSTACLE_LESS_20;  // Obstacle less than 20 cm distance
+				}
+				return U8_ONE_VALUE;
 			}
+			// Otherwise a side with room, or the window is still filling or a jump is not confirmed yet, no decision on it
 		}
-		} else if(en_motorSel == EN_MOTOR_STOP){/** if stop button pressed**/
+	} else {
+		RING_vidFlush(&gs_str_isr_records);  // Drop measurements of the previous run
+		for(u8_sensor = 0; u8_sensor < APP_SENSORS_COUNT; u8_sensor++){
+			(void) DFILTER_enuInit(&gs_arr_str_dist_filters[u8_sensor]);
+			gs_arr_dist[u8_sensor] = 0;
+		}
+	}
 
-		LCD_clear (&gs_str_lcd_config);
-		LCD_setCursor(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
-		LCD_writeString (&gs_str_lcd_config, (uint8_t*) "Motor Stopped");
-		CAR_STOP(&gs_str_motor_1, &gs_str_motor_2, &gs_str_pwm_pin);
-		en_start_state = EN_UPDATE_DIR;
-		timing_break_time_out();
-		while(en_motorSel == EN_MOTOR_STOP);
+	return U8_ZERO_VALUE;
+}
 
-		} else {
-		// No action needed
+
+/**
+ * @brief Run the first transition of the table matching the current state and an event.
+ *
+ * Distance events that change the state also update the worst reaction time.
+ *
+ * @param[in] copy_enu_event The event.
+ */
+void APP_vidDispatch(app_enu_event_t copy_enu_event)
+{
+	const app_str_transition_t *ptr_str_transition;
+	uint32_t u32_reaction_ticks;
+
+	for(uint8_t u8_row = U8_ZERO_VALUE; u8_row < (sizeof(gs_arr_str_transitions) / sizeof(gs_arr_str_transitions[0])); u8_row++){
+		ptr_str_transition = &gs_arr_str_transitions[u8_row];
+		if(((ptr_str_transition->current_state == gs_enu_state) || (ptr_str_transition->current_state == APP_STATE_ANY)) &&
+		   (ptr_str_transition->enu_event == copy_enu_event) &&
+		   ((ptr_str_transition->ptr_guard == NULL) || (ptr_str_transition->ptr_guard() == U8_ONE_VALUE))){
+			ptr_str_transition->ptr_action();
+			if(ptr_str_transition->next_state != APP_STATE_NONE){
+				APP_vidEnterState(ptr_str_transition->next_state);
+				if(copy_enu_event >= APP_EVENT_NO_OBSTACLES){
+					u32_reaction_ticks = timing_get_tick_count() - gs_arr_u32_dist_timestamp[APP_SENSOR_FRONT];
+					if(u32_reaction_ticks > gs_u32_max_reaction_ticks){
+						gs_u32_max_reaction_ticks = u32_reaction_ticks;
+					}
+				}
+			}
+			break;
+		}
+	}
+	// Events without a matching row are ignored in the current state
+}
+
+
+/**
+ * @brief Make a state current and arm its time limit.
+ *
+ * @param[in] copy_enu_state The new state.
+ */
+void APP_vidEnterState(app_enu_state_t copy_enu_state)
+{
+	uint32_t u32_timeout = gs_arr_u32_state_timeout[copy_enu_state];
+
+	gs_enu_state = copy_enu_state;
+	(void) timing_timer_cancel(&gs_str_state_timer);
+	gs_u8_state_entry++;  // Timer records still queued belong to the previous entry
+	if(copy_enu_state == APP_STATE_TURN){
+		u32_timeout = gs_u32_turn_ms;  // Depends on the heading the scan found
+	}
+	if(u32_timeout != U8_ZERO_VALUE){
+		(void) timing_timer_start(&gs_str_state_timer, u32_timeout, U8_ZERO_VALUE, APP_vidStateTimeout);
 	}
 }
 
 
+/**
+ * @brief Write the last measured distance to the second LCD row.
+ */
+void APP_vidShowDistance(void)
+{
+	LCD_writeField (&gs_str_lcd_config, &gs_str_dist_field, HULTRASONIC_DISTANCE_TO_CM(gs_arr_dist[APP_SENSOR_FRONT]));
+}
 
-/************************************************************************************************/
-/*									Static Function Implementation                				*/
-/************************************************************************************************/
 
 /**
- * @brief Change the motor state based on button press.
+ * @brief Pick the rotation direction, towards the side with more room.
  *
- * This function toggles the motor state between start and stop when the button is pressed.
+ * @return MOTOR_TURN_LEFT or MOTOR_TURN_RIGHT.
  */
-
-void BUTTON_vidChangeState(void)
+uint8_t APP_u8EscapeDirection(void)
 {
-	if(en_motorSel == EN_MOTOR_STOP){	
-		en_motorSel = EN_MOTOR_START;
-	}else{
-		en_motorSel = EN_MOTOR_STOP;
+	uint8_t u8_direction = u8_g_dirStateCounter;
+	uint32_t u32_now = timing_get_tick_count();
+	hultrasonic_distance_t left = gs_arr_dist[APP_SENSOR_LEFT];
+	hultrasonic_distance_t right = gs_arr_dist[APP_SENSOR_RIGHT];
+
+	if((left != 0) && (right != 0) &&
+	   ((u32_now - gs_arr_u32_dist_timestamp[APP_SENSOR_LEFT]) <= APP_SIDE_MAX_AGE) &&
+	   ((u32_now - gs_arr_u32_dist_timestamp[APP_SENSOR_RIGHT]) <= APP_SIDE_MAX_AGE)){
+		if(left > (right + APP_SIDE_MARGIN)){
+			u8_direction = MOTOR_TURN_LEFT;
+		} else if(right > (left + APP_SIDE_MARGIN)){
+			u8_direction = MOTOR_TURN_RIGHT;
+		} else {
+			// About the same room on both sides, keep the default rotation direction
+		}
 	}
-	
+	return u8_direction;
 }
 
 
 /**
- * @brief Update the car's direction based on user button input.
+ * @brief Forward speed for the time-to-collision with APP_TTC_MARGIN.
  *
- * This function allows the user to set the car's default rotation direction by pressing a button.
- * The user can switch between left and right directions. The function displays the selected direction
- * on an LCD screen and waits for a specific time before proceeding.
+ * @return Duty cycle in percent, from 0 to APP_CAR_SPEED_MAX_PRE.
  */
-void APP_updateDirection(void)
+uint8_t APP_u8CruiseSpeed(void)
 {
-	HULTRASONIC_vidInterruptDisable();
+	uint32_t u32_speed = gs_u8_car_target_speed;
 
-	LCD_setCursor(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
-	LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Right");
-	while(timing_time_out(APP_WAIT_TO_SET_DIR_TIME) == TIMING_NOT_TIME_OUT)
-	{
-		BTN_get_state(&gs_btn_dir_state, &gs_enu_btn_dir_state);
-		if(gs_enu_btn_dir_state == BTN_PUSHED){
-			if(u8_g_dirStateCounter == MOTOR_TURN_LEFT){
-				u8_g_dirStateCounter = MOTOR_TURN_RIGHT;
-				LCD_setCursor(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
-				LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Right");
-			}else{
-				u8_g_dirStateCounter = MOTOR_TURN_LEFT;
-				LCD_setCursor(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
-				LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Left ");
-			}
+	if(gs_str_front_ttc_output.enu_estimate == TTC_ESTIMATE_VALID){
+		if(gs_str_front_ttc_output.u16_ttc_ms == TTC_NEVER){
+			u32_speed = APP_CAR_SPEED_MAX_PRE;
+		} else {
+			u32_speed = ((uint32_t)APP_CAR_SPEED_MAX_PRE * gs_str_front_ttc_output.u16_ttc_ms) / APP_TTC_TARGET_MS;
 		}
-		else {
-			/* do nothing  */
+		if(u32_speed > APP_CAR_SPEED_MAX_PRE){
+			u32_speed = APP_CAR_SPEED_MAX_PRE;
 		}
 	}
+	return (uint8_t)u32_speed;
+}
+
+
+/**
+ * @brief Whether the car may scan once more before holding.
+ *
+ * @return U8_ONE_VALUE while fewer than APP_MAX_SCANS_IN_ROW scans happened since the car last drove.
+ */
+uint8_t APP_u8CanScanAgain(void)
+{
+	return (gs_u8_scan_counter < APP_MAX_SCANS_IN_ROW) ? U8_ONE_VALUE : U8_ZERO_VALUE;
+}
+
+
+/**
+ * @brief Whether the scan found a heading with room to drive.
+ *
+ * @return U8_ONE_VALUE if the best heading has at least APP_SCAN_MIN_ROOM_CM of room.
+ */
+uint8_t APP_u8HasWayOut(void)
+{
+	sint8_t s8_heading;
+	uint8_t u8_cm;
+
+	return ((SCAN_enuGetBest(&s8_heading, &u8_cm) == SCAN_OK) && (u8_cm >= APP_SCAN_MIN_ROOM_CM)) ? U8_ONE_VALUE : U8_ZERO_VALUE;
+}
+
+
+/**
+ * @brief Whether the car must stop in front of the obstacle.
+ *
+ * @return U8_ONE_VALUE if the time-to-collision asks for less than APP_CAR_SPEED_MIN_PRE, or without an
+ *         estimate yet if the front distance is APP_DISTANCE_30_CM or less.
+ */
+uint8_t APP_u8MustBrake(void)
+{
+	uint8_t u8_brake;
+
+	if(gs_str_front_ttc_output.enu_estimate == TTC_ESTIMATE_VALID){
+		u8_brake = (APP_u8CruiseSpeed() < APP_CAR_SPEED_MIN_PRE) ? U8_ONE_VALUE : U8_ZERO_VALUE;
+	} else {
+		u8_brake = (gs_arr_dist[APP_SENSOR_FRONT] <= APP_DISTANCE_30_CM) ? U8_ONE_VALUE : U8_ZERO_VALUE;
+	}
+	return u8_brake;
+}
+
+
+/**
+ * @brief Stop the car and show it.
+ */
+void APP_vidStop(void)
+{
+	LCD_clear (&gs_str_lcd_config);
+	LCD_setCursor(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_stopped);
+	CAR_STOP(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
+	APP_vidSetCarSpeed(U8_ZERO_VALUE);
+	SCAN_vidAbort();
+}
+
+
+/**
+ * @brief Show the default rotation direction for the user to change it.
+ */
+void APP_vidSetDir(void)
+{
+	LCD_clear (&gs_str_lcd_config);
+	LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_set_dir);
+	LCD_setCursor(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
+	LCD_writeString_P (&gs_str_lcd_config, (u8_g_dirStateCounter == MOTOR_TURN_LEFT) ? gs_arr_u8_txt_left : gs_arr_u8_txt_right);
+}
+
+
+/**
+ * @brief Switch the default rotation direction between left and right.
+ */
+void APP_vidToggleDir(void)
+{
+	if(u8_g_dirStateCounter == MOTOR_TURN_LEFT){
+		u8_g_dirStateCounter = MOTOR_TURN_RIGHT;
+		LCD_setCursor(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
+		LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_right);
+	}else{
+		u8_g_dirStateCounter = MOTOR_TURN_LEFT;
+		LCD_setCursor(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
+		LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_left);
+	}
+}
+
+
+/**
+ * @brief Announce the start of the motors.
+ */
+void APP_vidStartDelay(void)
+{
 	LCD_clear(&gs_str_lcd_config);
-	HULTRASONIC_vidInterruptEnable();
 	LCD_setCursor(&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
-	LCD_writeString (&gs_str_lcd_config, (uint8_t*)"Motor starts in");
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_starts_in);
 	LCD_setCursor(&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
-	LCD_writeString (&gs_str_lcd_config, (uint8_t*)"2 Sec.");
-	delay_s(2);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_2_sec);
+}
+
+
+/**
+ * @brief Wait for a fresh measurement with the motors stopped.
+ */
+void APP_vidDecide(void)
+{
 	LCD_clear (&gs_str_lcd_config);
+	LCD_setCursor (&gs_str_lcd_config, LCD_ROW_2, LCD_COL_1);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_dist);
+	LCD_setCursor (&gs_str_lcd_config, LCD_ROW_2, APP_DIST_UNIT_COL);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_dist_unit);
+	gs_u8_scan_counter = U8_ZERO_VALUE;
 }
 
 
 /**
- * @brief Convert an unsigned 8-bit integer to a string representation.
- *
- * This function takes an unsigned 8-bit integer and converts it to its string representation.
- * The resulting string is stored in the provided buffer, and the buffer is null-terminated.
- * The function handles the special case of zero and converts each digit of the number to a character.
+ * @brief Move forward at 30%, APP_vidCruise takes over with the next front distances.
+ */
+void APP_vidForward(void)
+{
+	LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_speed_30);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_dir_forward);
+	APP_vidSetCarSpeed(APP_CAR_SPEED_30_PRE);
+	CAR_FORWARD(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
+	gs_u8_scan_counter = U8_ZERO_VALUE;
+	SCAN_vidInvalidate();
+	(void) TTC_enuInit(&gs_str_front_ttc);  // Distances of a rotation or a reversal tell nothing about the closing speed
+	gs_str_front_ttc_output.enu_estimate = TTC_ESTIMATE_NONE;
+}
+
+
+/**
+ * @brief Command the forward speed from the time-to-collision, speeding up goes through the ramp.
  *
- * @param[in] copy_u8_num The unsigned 8-bit integer to be converted.
- * @param[out] ptr_string Pointer to the buffer where the string representation will be stored.
- */
-void intToString(uint8_t copy_u8_num, uint8_t *ptr_string){
-	uint8_t u8_digit_counter = U8_ZERO_VALUE;
-	
-	// Calculate the number of digits in the number
-	if (copy_u8_num == U8_ZERO_VALUE) {
-		u8_digit_counter = U8_ONE_VALUE;
+ * Changes smaller than APP_CAR_SPEED_HYSTERESIS are ignored, the estimate jitters with every measurement.
+ */
+void APP_vidCruise(void)
+{
+	uint8_t u8_speed = APP_u8CruiseSpeed();
+	uint8_t u8_change = (u8_speed > gs_u8_car_target_speed) ? (u8_speed - gs_u8_car_target_speed) : (gs_u8_car_target_speed - u8_speed);
+
+	if(u8_change >= APP_CAR_SPEED_HYSTERESIS){
+		APP_vidSetCarSpeed(u8_speed);
+		LCD_writeField (&gs_str_lcd_config, &gs_str_speed_field, gs_u8_car_speed);  // The applied speed, the ramp shows its steps
+	}
+}
+
+
+/**
+ * @brief Rotate towards the side with more room, the default rotation direction when unsure.
+ */
+void APP_vidRotate(void)
+{
+	LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_speed_30);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_dir_rotate);
+	CAR_STOP(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
+
+	APP_vidSetCarSpeed(APP_CAR_SPEED_30_PRE);
+	if(APP_u8EscapeDirection() == MOTOR_TURN_LEFT){
+		CAR_REVERSE_LEFT(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
 	} else {
-		uint8_t temp = copy_u8_num;  // Store a temporary copy of the number
-		while (temp != U8_ZERO_VALUE) {
-			temp /= APP_SELECT_TENS_DIGIT;
-			u8_digit_counter++;
-		}
+		CAR_REVERSE_RIGHT(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
 	}
-	u8_digit_counter++;
+	SCAN_vidInvalidate();  // The rotation angle is unknown
+}
+
+
+/**
+ * @brief Stop the car at the end of a rotation.
+ */
+void APP_vidRotateDone(void)
+{
+	CAR_STOP(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
+	APP_vidSetCarSpeed(U8_ZERO_VALUE);
+}
+
+
+/**
+ * @brief Stop the car and sweep the front sensor, the angles measured lately are kept.
+ */
+void APP_vidScan(void)
+{
+	LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_speed_0);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_dir_scan);
+	CAR_STOP(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
+	APP_vidSetCarSpeed(U8_ZERO_VALUE);
+	gs_u8_scan_counter++;
+	(void) SCAN_enuStart();
+}
+
+
+/**
+ * @brief Scan again at the end of a hold.
+ */
+void APP_vidRescan(void)
+{
+	APP_vidDecide();
+	APP_vidScan();
+}
 
-	uint8_t u8_string_counter = u8_digit_counter - U8_ONE_VALUE;  // Start from the end of the buffer
-	ptr_string[u8_string_counter] = APP_NULL_TERMINATION_STRING;  // Null-terminate the string
 
-	if (copy_u8_num == U8_ZERO_VALUE) {
-		ptr_string[--u8_string_counter] = APP_0_CHAR;  // Handle the special case of zero
+/**
+ * @brief Rotate on the spot towards the heading with the most room.
+ */
+void APP_vidTurn(void)
+{
+	sint8_t s8_heading = 0;
+	uint8_t u8_cm;
+	uint8_t u8_degrees;
+
+	(void) SCAN_enuGetBest(&s8_heading, &u8_cm);
+	u8_degrees = (s8_heading < 0) ? (uint8_t)(-s8_heading) : (uint8_t)s8_heading;
+	gs_u32_turn_ms = ((uint32_t)u8_degrees * APP_TURN_MS_PER_10_DEG) / 10UL;
+	if(gs_u32_turn_ms == U8_ZERO_VALUE){
+		gs_u32_turn_ms = U8_ONE_VALUE;  // Straight ahead: only measure the front again
+	}
+
+	LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_speed_30);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_dir_rotate);
+	APP_vidSetCarSpeed(APP_CAR_SPEED_30_PRE);
+	if(s8_heading > 0){
+		CAR_REVERSE_LEFT(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
+	} else if(s8_heading < 0){
+		CAR_REVERSE_RIGHT(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
 	} else {
-		while (copy_u8_num > 0 && u8_string_counter > U8_ZERO_VALUE) {
-			ptr_string[--u8_string_counter] = APP_0_CHAR + (copy_u8_num % APP_SELECT_TENS_DIGIT); // Convert the digit to character
-			copy_u8_num /= APP_SELECT_TENS_DIGIT;
-		}
+		// Already facing the way out
 	}
+	SCAN_vidRotate(s8_heading);
 }
 
 
 /**
- * @brief Make a decision based on the distance measured by the ultrasonic sensor.
- *
- * This function reads the distance from the ultrasonic sensor, and based on the measured distance,
- * it makes a decision about the obstacles in the car's path. The decision is stored in the provided
- * pointer to an en_Dist_states_t variable.
+ * @brief Stop the car at the end of a turn, the front distance starts over from the new heading.
+ */
+void APP_vidTurnDone(void)
+{
+	CAR_STOP(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
+	APP_vidSetCarSpeed(U8_ZERO_VALUE);
+	(void) DFILTER_enuInit(&gs_arr_str_dist_filters[APP_SENSOR_FRONT]);
+}
+
+
+/**
+ * @brief Move backward at 30%.
+ */
+void APP_vidBackward(void)
+{
+	LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_speed_30);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_dir_backward);
+	APP_vidSetCarSpeed(APP_CAR_SPEED_30_PRE);
+	CAR_BACKWARD(&gs_str_motor_1, &gs_str_motor_2, gs_arr_str_pwm_pin);
+	gs_u8_scan_counter = U8_ZERO_VALUE;
+	SCAN_vidInvalidate();
+}
+
+
+/**
+ * @brief Hold when the scans found no way out.
+ */
+void APP_vidHold(void)
+{
+	LCD_clear(&gs_str_lcd_config);
+	LCD_setCursor (&gs_str_lcd_config, LCD_ROW_1, LCD_COL_1);
+	LCD_writeString_P (&gs_str_lcd_config, gs_arr_u8_txt_hold);
+}
+
+
+/**
+ * @brief Request a duty cycle for every motor PWM channel.
  *
- * @param[in,out] ptr_f_distination Pointer to the variable storing the measured distance.
- * @param[in,out] ptr_enu_decision Pointer to the variable where the decision will be stored.
+ * @param[in] copy_u8_duty_cycle Duty cycle in percent.
  */
-void APP_make_decision(float64_t *ptr_f_distination, en_Dist_states_t *ptr_enu_decision){
-	double f_distination = HULTRASONIC_u8Read();  // Read distance from ultrasonic sensor
-	if(f_distination > APP_MAX_MEASURED_DIST) {
-		f_distination = APP_MAX_MEASURED_DIST;  // Limit the distance to 99.0 cm
+void APP_vidSetCarSpeed(uint8_t copy_u8_duty_cycle)
+{
+	gs_u8_car_target_speed = copy_u8_duty_cycle;
+	if((copy_u8_duty_cycle < gs_u8_car_speed) || (gs_u8_car_speed == U8_ZERO_VALUE)){
+		APP_vidApplyCarSpeed(copy_u8_duty_cycle);  // Slowing down is never delayed, it only waits for the next PWM period
 	}
-	*ptr_f_distination = f_distination;  // Update the measured distance
-
-	// Make a decision based on the measured distance
-	if(f_distination > APP_DISTANCE_70_CM) {
-		*ptr_enu_decision = NO_OBSTACLES;  // No obstacles in the path
-	} else if ((f_distination > APP_DISTANCE_30_CM) && (f_distination <= APP_DISTANCE_70_CM)) {
-		*ptr_enu_decision = OBSTACLE_70_30;  // Obstacle at 70-30 cm distance
-	} else if ((f_distination >= APP_DISTANCE_20_CM) && (f_distination <= APP_DISTANCE_30_CM)) {
-		*ptr_enu_decision = OBSTACLE_30_20;  // Obstacle at 30-20 cm distance
-	} else if (f_distination < APP_DISTANCE_20_CM) {
-		*ptr_enu_decision = OBSTACLE_LESS_20;  // Obstacle less than 20 cm distance
-	} else {
-		*ptr_enu_decision = NO_DECISION;  // No decision based on the given conditions
+}
+
+
+/**
+ * @brief Set the duty cycle of every motor PWM channel at once, the PWM takes it at the start of its next period.
+ *
+ * @param[in] copy_u8_duty_cycle Duty cycle in percent.
+ */
+void APP_vidApplyCarSpeed(uint8_t copy_u8_duty_cycle)
+{
+	gs_u8_car_speed = copy_u8_duty_cycle;
+	for(uint8_t u8_channel = 0; u8_channel < CAR_PWM_CHANNELS; u8_channel++){
+		gs_arr_str_pwm_pin[u8_channel].duty_cycle = copy_u8_duty_cycle;
+		pwm_change_frequency_or_duty_cycle(&gs_arr_str_pwm_pin[u8_channel]);
 	}
-	// Note: The last condition, 'else', covers any unexpected cases
 }
 
 
 
+
+
+/**
+ * @brief Queue a completed ultrasonic measurement for the state machine.
+ *
+ * @param[in] ptr_str_measurement The completed measurement.
+ */
+void APP_vidDistanceReady(const hultrasonic_str_measurement_t *ptr_str_measurement){
+	app_str_record_t str_record;
+
+	str_record.enu_type = APP_RECORD_SENSOR;
+	str_record.u32_timestamp = ptr_str_measurement->u32_timestamp;
+	str_record.uni_data.str_sensor.distance = ptr_str_measurement->distance;
+	str_record.uni_data.str_sensor.u8_sensor = (uint8_t)(ptr_str_measurement->ptr_str_sensor - gs_arr_str_sensors);
+	(void) RING_enuPush(&gs_str_isr_records, &str_record);  // Full: the state machine is behind, the measurement is lost
+}
+
+
 /************************************************************************************************/
 /*									END                 										*/
-/************************************************************************************************/
\ No newline at end of file
+/************************************************************************************************/
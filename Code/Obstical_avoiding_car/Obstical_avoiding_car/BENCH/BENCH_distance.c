@@ -0,0 +1,269 @@
+/**
+ * @file BENCH_distance.c
+ * @brief Benchmark of the distance pipeline: float64_t centimetres against Q8.8 fixed point.
+ *
+ * Both paths do the per-sample work of ULTRASONIC and APP: convert an ICP echo length (Timer 1
+ * counts of 4 us) to centimetres, clamp it to the 99 cm display range, classify it against the
+ * 70/30/20 cm bands of APP_make_decision and extract the whole centimetres written to the LCD.
+ *
+ * - AVR build (link this file instead of main.c): Timer 1 runs at clk/1 and each batch is timed
+ *   in CPU cycles. The results land in gs_arr_str_bench_results for the debugger watch window.
+ * - Host build (distance_bench target of CMakeLists.txt): batches are timed with the monotonic
+ *   clock and printed. The host has a hardware FPU, so only the AVR figures show the soft-float cost.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+#ifndef __AVR__
+#include <stdio.h>
+#include <time.h>
+#endif
+
+#include "../STD_LIB/std_types.h"
+#include "../HAL/ULTRASONIC/ULTRASONIC_interface.h"
+
+/*****************************************************************************************************************/
+/*											Macro Declarations													 */
+/*****************************************************************************************************************/
+
+/* Samples per timed batch, one batch must stay below 65536 cycles on the AVR */
+#define BENCH_SAMPLES               64u
+
+#ifdef __AVR__
+#define BENCH_BATCHES               16u
+#else
+#define BENCH_BATCHES               100000u
+#endif
+
+/* Largest echo length of the input set, 4000 counts = 274 cm */
+#define BENCH_MAX_TICKS             4000u
+
+/* Display clamp and bands of APP_make_decision, in centimetres */
+#define BENCH_MAX_CM                99u
+#define BENCH_70_CM                 70u
+#define BENCH_30_CM                 30u
+#define BENCH_20_CM                 20u
+
+/*****************************************************************************************************************/
+/*											Type Definitions													 */
+/*****************************************************************************************************************/
+
+typedef enum{
+	BENCH_BAND_NONE = 0,    /* farther than 70 cm */
+	BENCH_BAND_70_30,
+	BENCH_BAND_30_20,
+	BENCH_BAND_LESS_20,
+	BENCH_BAND_UNDECIDED
+}bench_enu_band_t;
+
+typedef enum{
+	BENCH_PATH_FLOAT = 0,
+	BENCH_PATH_FIXED,
+	BENCH_PATH_MAX
+}bench_enu_path_t;
+
+/**
+ * @brief Timing of one path, in CPU cycles on the AVR and nanoseconds on the host.
+ */
+typedef struct{
+	uint32_t u32_total;         /**< Sum over all batches. */
+	uint32_t u32_min_batch;     /**< Fastest batch. */
+	uint32_t u32_max_batch;     /**< Slowest batch. */
+	uint32_t u32_samples;       /**< Samples timed. */
+}bench_str_result_t;
+
+/*****************************************************************************************************************/
+/*											Global variables													 */
+/*****************************************************************************************************************/
+
+/** @brief Results per path, read them with the debugger on the AVR. */
+bench_str_result_t gs_arr_str_bench_results[BENCH_PATH_MAX];
+
+/** @brief Samples on which the two paths disagree (band or displayed centimetres). */
+uint16_t gs_u16_bench_mismatches;
+
+static uint16_t gs_arr_u16_ticks[BENCH_SAMPLES];
+
+/* Keeps the compiler from dropping the work */
+static volatile uint16_t gs_v_u16_sink;
+
+/*****************************************************************************************************************/
+/*											Static Function Prototype											 */
+/*****************************************************************************************************************/
+
+static uint16_t bench_u16FloatPath(uint16_t u16_ticks) __attribute__((noinline));
+static uint16_t bench_u16FixedPath(uint16_t u16_ticks) __attribute__((noinline));
+static uint32_t bench_u32Now(void);
+static uint32_t bench_u32Elapsed(uint32_t u32_start);
+static void bench_vidRun(bench_enu_path_t enu_path, uint16_t (*ptr_path)(uint16_t));
+
+/*****************************************************************************************************************/
+/*											Static Function Implementation										 */
+/*****************************************************************************************************************/
+
+/* Returns the band in the high byte and the displayed centimetres in the low byte */
+static uint16_t bench_u16FloatPath(uint16_t u16_ticks)
+{
+	float64_t f64_dist = (float64_t)u16_ticks * ICP_CONSTANT_TO_DISTANCE;
+	bench_enu_band_t enu_band;
+
+	if(f64_dist > (float64_t)BENCH_MAX_CM){
+		f64_dist = (float64_t)BENCH_MAX_CM;
+	}
+	if(f64_dist > (float64_t)BENCH_70_CM){
+		enu_band = BENCH_BAND_NONE;
+	}else if((f64_dist > (float64_t)BENCH_30_CM) && (f64_dist <= (float64_t)BENCH_70_CM)){
+		enu_band = BENCH_BAND_70_30;
+	}else if((f64_dist >= (float64_t)BENCH_20_CM) && (f64_dist <= (float64_t)BENCH_30_CM)){
+		enu_band = BENCH_BAND_30_20;
+	}else if(f64_dist < (float64_t)BENCH_20_CM){
+		enu_band = BENCH_BAND_LESS_20;
+	}else{
+		enu_band = BENCH_BAND_UNDECIDED;
+	}
+	return (uint16_t)(((uint16_t)enu_band << 8) | (uint8_t)f64_dist);
+}
+
+static uint16_t bench_u16FixedPath(uint16_t u16_ticks)
+{
+	uint32_t u32_dist = ((uint32_t)u16_ticks * ICP_CONSTANT_TO_DISTANCE_Q8_8) >> HULTRASONIC_Q8_8_SHIFT;
+	uint16_t u16_dist;
+	bench_enu_band_t enu_band;
+
+	u16_dist = (u32_dist > HULTRASONIC_Q8_8_MAX) ? (uint16_t)HULTRASONIC_Q8_8_MAX : (uint16_t)u32_dist;
+	if(u16_dist > (BENCH_MAX_CM << HULTRASONIC_Q8_8_SHIFT)){
+		u16_dist = (BENCH_MAX_CM << HULTRASONIC_Q8_8_SHIFT);
+	}
+	if(u16_dist > (BENCH_70_CM << HULTRASONIC_Q8_8_SHIFT)){
+		enu_band = BENCH_BAND_NONE;
+	}else if((u16_dist > (BENCH_30_CM << HULTRASONIC_Q8_8_SHIFT)) && (u16_dist <= (BENCH_70_CM << HULTRASONIC_Q8_8_SHIFT))){
+		enu_band = BENCH_BAND_70_30;
+	}else if((u16_dist >= (BENCH_20_CM << HULTRASONIC_Q8_8_SHIFT)) && (u16_dist <= (BENCH_30_CM << HULTRASONIC_Q8_8_SHIFT))){
+		enu_band = BENCH_BAND_30_20;
+	}else if(u16_dist < (BENCH_20_CM << HULTRASONIC_Q8_8_SHIFT)){
+		enu_band = BENCH_BAND_LESS_20;
+	}else{
+		enu_band = BENCH_BAND_UNDECIDED;
+	}
+	return (uint16_t)(((uint16_t)enu_band << 8) | (uint8_t)(u16_dist >> HULTRASONIC_Q8_8_SHIFT));
+}
+
+#ifdef __AVR__
+
+/* Timer 1 at clk/1: one count per CPU cycle, wraps after 65536 cycles */
+static uint32_t bench_u32Now(void)
+{
+	uint16_t u16_count = 0;
+	(void) timer1_icu_get_counter(&u16_count);
+	return u16_count;
+}
+
+static uint32_t bench_u32Elapsed(uint32_t u32_start)
+{
+	return (uint16_t)(bench_u32Now() - u32_start);
+}
+
+#else
+
+static uint32_t bench_u32Now(void)
+{
+	struct timespec str_now;
+	clock_gettime(CLOCK_MONOTONIC, &str_now);
+	return (uint32_t)(((uint64_t)str_now.tv_sec * 1000000000ull) + (uint64_t)str_now.tv_nsec);
+}
+
+static uint32_t bench_u32Elapsed(uint32_t u32_start)
+{
+	return bench_u32Now() - u32_start;
+}
+
+#endif
+
+static void bench_vidRun(bench_enu_path_t enu_path, uint16_t (*ptr_path)(uint16_t))
+{
+	bench_str_result_t *ptr_str_result = &gs_arr_str_bench_results[enu_path];
+	uint32_t u32_batch;
+	uint32_t u32_start;
+	uint32_t u32_spent;
+	uint8_t u8_sample;
+
+	ptr_str_result->u32_total = 0;
+	ptr_str_result->u32_min_batch = MAX_VALUE_UINT32;
+	ptr_str_result->u32_max_batch = 0;
+	ptr_str_result->u32_samples = 0;
+	for(u32_batch = 0; u32_batch < BENCH_BATCHES; u32_batch++){
+		u32_start = bench_u32Now();
+		for(u8_sample = 0; u8_sample < BENCH_SAMPLES; u8_sample++){
+			gs_v_u16_sink = ptr_path(gs_arr_u16_ticks[u8_sample]);
+		}
+		u32_spent = bench_u32Elapsed(u32_start);
+		ptr_str_result->u32_total += u32_spent;
+		ptr_str_result->u32_samples += BENCH_SAMPLES;
+		if(u32_spent < ptr_str_result->u32_min_batch){
+			ptr_str_result->u32_min_batch = u32_spent;
+		}
+		if(u32_spent > ptr_str_result->u32_max_batch){
+			ptr_str_result->u32_max_batch = u32_spent;
+		}
+	}
+}
+
+/*****************************************************************************************************************/
+/*											Entry point															 */
+/*****************************************************************************************************************/
+
+int main(void)
+{
+	uint32_t u32_seed = 12345u;
+	uint8_t u8_sample;
+
+#ifdef __AVR__
+	(void) timer1_icu_initialization(TIMER_PRESCALLER_0, U8_ZERO_VALUE);
+#endif
+
+	/* Pseudo random echo lengths over the whole range, plus the band edges */
+	for(u8_sample = 0; u8_sample < BENCH_SAMPLES; u8_sample++){
+		u32_seed = (u32_seed * 1103515245u) + 12345u;
+		gs_arr_u16_ticks[u8_sample] = (uint16_t)((u32_seed >> 16) % (BENCH_MAX_TICKS + 1u));
+	}
+	gs_arr_u16_ticks[0] = 0u;
+	gs_arr_u16_ticks[1] = (uint16_t)(BENCH_20_CM / ICP_CONSTANT_TO_DISTANCE);
+	gs_arr_u16_ticks[2] = (uint16_t)(BENCH_30_CM / ICP_CONSTANT_TO_DISTANCE);
+	gs_arr_u16_ticks[3] = (uint16_t)(BENCH_70_CM / ICP_CONSTANT_TO_DISTANCE);
+	gs_arr_u16_ticks[4] = BENCH_MAX_TICKS;
+
+	gs_u16_bench_mismatches = 0;
+	for(u8_sample = 0; u8_sample < BENCH_SAMPLES; u8_sample++){
+		if(bench_u16FloatPath(gs_arr_u16_ticks[u8_sample]) != bench_u16FixedPath(gs_arr_u16_ticks[u8_sample])){
+			gs_u16_bench_mismatches++;
+		}
+	}
+
+	bench_vidRun(BENCH_PATH_FLOAT, bench_u16FloatPath);
+	bench_vidRun(BENCH_PATH_FIXED, bench_u16FixedPath);
+
+#ifdef __AVR__
+	while(1){
+		/* results in gs_arr_str_bench_results */
+	}
+#else
+	{
+		static const char *const apch_names[BENCH_PATH_MAX] = {"float64_t", "Q8.8"};
+		bench_enu_path_t enu_path;
+
+		printf("== distance_bench (host, ns per sample) ==\n");
+		printf("path        mean     best batch   worst batch\n");
+		for(enu_path = BENCH_PATH_FLOAT; enu_path < BENCH_PATH_MAX; enu_path++){
+			bench_str_result_t *ptr_str_result = &gs_arr_str_bench_results[enu_path];
+			printf("%-9s %7.2f  %11.2f  %12.2f\n", apch_names[enu_path],
+			       (double)ptr_str_result->u32_total / (double)ptr_str_result->u32_samples,
+			       (double)ptr_str_result->u32_min_batch / BENCH_SAMPLES,
+			       (double)ptr_str_result->u32_max_batch / BENCH_SAMPLES);
+		}
+		printf("disagreeing samples : %u of %u (band or displayed cm)\n", (unsigned)gs_u16_bench_mismatches, (unsigned)BENCH_SAMPLES);
+		printf("note: the host has an FPU, cycle counts of the AVR soft-float path come from the target build\n");
+	}
+	return 0;
+#endif
+}
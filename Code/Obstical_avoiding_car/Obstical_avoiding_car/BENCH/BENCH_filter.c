@@ -0,0 +1,198 @@
+/**
+ * @file BENCH_filter.c
+ * @brief Benchmark of the distance filter: cost of one DFILTER_enuUpdate per sample.
+ *
+ * The input is a car closing in on a wall and backing off again, sampled every 30 ticks like the
+ * sensor task, with a multipath echo or a missed edge in every eighth sample. Each sample is timed
+ * on its own, so the figures include the call but not the loop.
+ *
+ * - AVR build (link this file and HAL/DIST_FILTER/DIST_FILTER_prog.c instead of main.c): Timer 1
+ *   runs at clk/1 and each sample is timed in CPU cycles. The results land in gs_str_bench_result
+ *   for the debugger watch window.
+ * - Host build (filter_bench target of CMakeLists.txt): samples are timed with the monotonic clock
+ *   and printed.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+#ifndef __AVR__
+#include <stdio.h>
+#include <time.h>
+#endif
+
+#include "../STD_LIB/std_types.h"
+#include "../HAL/DIST_FILTER/DIST_FILTER_interface.h"
+
+/*****************************************************************************************************************/
+/*											Macro Declarations													 */
+/*****************************************************************************************************************/
+
+/* Samples of the input set */
+#define BENCH_SAMPLES               128u
+
+#ifdef __AVR__
+#define BENCH_ROUNDS                4u
+#else
+#define BENCH_ROUNDS                20000u
+#endif
+
+/* Sensor task period in timing ticks, see APP_TASK_SENSOR_PERIOD */
+#define BENCH_PERIOD_TICKS          30u
+
+/* Every BENCH_FAULT_EVERY-th sample is a fault, alternately a close multipath echo and a missed edge */
+#define BENCH_FAULT_EVERY           8u
+#define BENCH_MULTIPATH_CM          12u
+#define BENCH_MISSED_CM             255u
+
+/* Wall distance at the start and the change per sample, in whole centimetres */
+#define BENCH_START_CM              150u
+#define BENCH_STEP_CM               2u
+
+/*****************************************************************************************************************/
+/*											Type Definitions													 */
+/*****************************************************************************************************************/
+
+/**
+ * @brief Timing of the filter, in CPU cycles on the AVR and nanoseconds on the host.
+ */
+typedef struct{
+	uint32_t u32_total;         /**< Sum over all samples. */
+	uint32_t u32_min;           /**< Cheapest sample. */
+	uint32_t u32_max;           /**< Most expensive sample. */
+	uint32_t u32_samples;       /**< Samples timed. */
+	uint16_t u16_rejected;      /**< Medians the gate held back in the last round. */
+	uint16_t u16_low;           /**< Outputs of low confidence in the last round. */
+}bench_str_result_t;
+
+/*****************************************************************************************************************/
+/*											Global variables													 */
+/*****************************************************************************************************************/
+
+/** @brief Results, read them with the debugger on the AVR. */
+bench_str_result_t gs_str_bench_result;
+
+static hultrasonic_distance_t gs_arr_distances[BENCH_SAMPLES];
+
+/* Keeps the compiler from dropping the work */
+static volatile hultrasonic_distance_t gs_v_sink;
+
+/*****************************************************************************************************************/
+/*											Static Function Prototype											 */
+/*****************************************************************************************************************/
+
+static uint32_t bench_u32Now(void);
+static uint32_t bench_u32Elapsed(uint32_t u32_start);
+
+/*****************************************************************************************************************/
+/*											Static Function Implementation										 */
+/*****************************************************************************************************************/
+
+#ifdef __AVR__
+
+/* Timer 1 at clk/1: one count per CPU cycle, wraps after 65536 cycles */
+static uint32_t bench_u32Now(void)
+{
+	uint16_t u16_count = 0;
+	(void) timer1_icu_get_counter(&u16_count);
+	return u16_count;
+}
+
+static uint32_t bench_u32Elapsed(uint32_t u32_start)
+{
+	return (uint16_t)(bench_u32Now() - u32_start);
+}
+
+#else
+
+static uint32_t bench_u32Now(void)
+{
+	struct timespec str_now;
+	clock_gettime(CLOCK_MONOTONIC, &str_now);
+	return (uint32_t)(((uint64_t)str_now.tv_sec * 1000000000ull) + (uint64_t)str_now.tv_nsec);
+}
+
+static uint32_t bench_u32Elapsed(uint32_t u32_start)
+{
+	return bench_u32Now() - u32_start;
+}
+
+#endif
+
+/*****************************************************************************************************************/
+/*											Entry point															 */
+/*****************************************************************************************************************/
+
+int main(void)
+{
+	dfilter_str_t str_filter;
+	dfilter_str_output_t str_output;
+	uint32_t u32_round;
+	uint32_t u32_timestamp = 0;
+	uint32_t u32_start;
+	uint32_t u32_spent;
+	uint16_t u16_cm = BENCH_START_CM;
+	uint8_t u8_sample;
+
+#ifdef __AVR__
+	(void) timer1_icu_initialization(TIMER_PRESCALLER_0, U8_ZERO_VALUE);
+#endif
+
+	/* Closing in over the first half, backing off over the second, with faults */
+	for(u8_sample = 0; u8_sample < BENCH_SAMPLES; u8_sample++){
+		if(u8_sample < (BENCH_SAMPLES / 2u)){
+			u16_cm = (u16_cm > BENCH_STEP_CM) ? (uint16_t)(u16_cm - BENCH_STEP_CM) : 0u;
+		}else{
+			u16_cm = (uint16_t)(u16_cm + BENCH_STEP_CM);
+		}
+		if((u8_sample % BENCH_FAULT_EVERY) == (BENCH_FAULT_EVERY - 1u)){
+			gs_arr_distances[u8_sample] = HULTRASONIC_DISTANCE_CM(((u8_sample / BENCH_FAULT_EVERY) & 1u) ? BENCH_MISSED_CM : BENCH_MULTIPATH_CM);
+		}else{
+			gs_arr_distances[u8_sample] = HULTRASONIC_DISTANCE_CM(u16_cm);
+		}
+	}
+
+	gs_str_bench_result.u32_total = 0;
+	gs_str_bench_result.u32_min = MAX_VALUE_UINT32;
+	gs_str_bench_result.u32_max = 0;
+	gs_str_bench_result.u32_samples = 0;
+	for(u32_round = 0; u32_round < BENCH_ROUNDS; u32_round++){
+		(void) DFILTER_enuInit(&str_filter);
+		gs_str_bench_result.u16_low = 0;
+		for(u8_sample = 0; u8_sample < BENCH_SAMPLES; u8_sample++){
+			u32_timestamp += BENCH_PERIOD_TICKS;
+			u32_start = bench_u32Now();
+			(void) DFILTER_enuUpdate(&str_filter, gs_arr_distances[u8_sample], u32_timestamp, &str_output);
+			u32_spent = bench_u32Elapsed(u32_start);
+			gs_v_sink = str_output.distance;
+			gs_str_bench_result.u32_total += u32_spent;
+			gs_str_bench_result.u32_samples++;
+			if(u32_spent < gs_str_bench_result.u32_min){
+				gs_str_bench_result.u32_min = u32_spent;
+			}
+			if(u32_spent > gs_str_bench_result.u32_max){
+				gs_str_bench_result.u32_max = u32_spent;
+			}
+			if(str_output.enu_confidence != DFILTER_CONFIDENCE_HIGH){
+				gs_str_bench_result.u16_low++;
+			}
+		}
+		gs_str_bench_result.u16_rejected = str_filter.u16_rejected;
+	}
+
+#ifdef __AVR__
+	while(1){
+		/* results in gs_str_bench_result */
+	}
+#else
+	printf("== filter_bench (host, ns per sample) ==\n");
+	printf("median of %u, EMA 1/%u, gate %u cm/s\n", (unsigned)DFILTER_MEDIAN_SIZE, (unsigned)(1u << DFILTER_EMA_SHIFT),
+	       (unsigned)DFILTER_MAX_RATE_CM_PER_S);
+	printf("mean %.2f  best %u  worst %u\n", (double)gs_str_bench_result.u32_total / (double)gs_str_bench_result.u32_samples,
+	       (unsigned)gs_str_bench_result.u32_min, (unsigned)gs_str_bench_result.u32_max);
+	printf("per round of %u samples (%u faults): %u held back by the gate, %u of low confidence\n", (unsigned)BENCH_SAMPLES,
+	       (unsigned)(BENCH_SAMPLES / BENCH_FAULT_EVERY), (unsigned)gs_str_bench_result.u16_rejected, (unsigned)gs_str_bench_result.u16_low);
+	printf("note: cycle counts per sample come from the target build\n");
+	return 0;
+#endif
+}
@@ -2,8 +2,8 @@
  * @file button_config.h
  * @brief Button Configuration Header File
  *
- * This header file provides configuration macros for buttons, including the debounce threshold
- * and the time for checking button state.
+ * This header file provides configuration macros for buttons: the sampling period, the debounce
+ * length, the long and double press times and the size of the event queue.
  *
  * @date 2023-08-26
  * @author Arafa Arafa
@@ -15,9 +15,13 @@
 
 
 
-#define BUTTON_DEBOUNCE_THRESHOLD    20       /**< Debounce threshold for button press. */
-#define BUTTON_CHECKING_TIME         100      /**< Time duration for checking button state. */
+#define BUTTON_MAX_BUTTONS           4        /**< Buttons BTN_init can register. */
+#define BUTTON_TICK_MS               10       /**< Period at which the application calls BTN_vidTick. */
+#define BUTTON_DEBOUNCE_SAMPLES      4        /**< Equal consecutive samples that change the debounced state (1..8). */
+#define BUTTON_LONG_PRESS_MS         1000     /**< Hold time after which BTN_EVENT_LONG_PRESS is posted. */
+#define BUTTON_DOUBLE_PRESS_MS       300      /**< Longest release between two presses of a double press. */
+#define BUTTON_EVENT_QUEUE_SIZE      8        /**< Capacity of the event queue, a power of two. */
 
 
 
-#endif
\ No newline at end of file
+#endif
@@ -11,6 +11,15 @@
 #define BUTTON_INTERFACE_H_
 #include "BUTTON_config.h"
 #include "../../MCAL/DIO/DIO_interface.h"
+#include "../../STD_LIB/ring_buffer.h"
+
+#if !RING_CAPACITY_VALID(BUTTON_EVENT_QUEUE_SIZE)
+#error "BUTTON_EVENT_QUEUE_SIZE must be a power of two up to 128"
+#endif
+
+#if BUTTON_DEBOUNCE_SAMPLES < 1 || BUTTON_DEBOUNCE_SAMPLES > 8
+#error "BUTTON_DEBOUNCE_SAMPLES must be within 1..8"
+#endif
 
 
 /************************************************************************************************/
@@ -34,9 +43,22 @@ typedef enum {
  */
 typedef enum {
 	BTN_E_OK,       /**< Button-related function executed successfully. */
-	BTN_NOT_OK      /**< Button-related function encountered an error. */
+	BTN_NOT_OK,     /**< Button-related function encountered an error. */
+	BTN_NO_EVENT    /**< The event queue is empty. */
 } btn_enu_return_state_t;
 
+/**
+ * @brief Enumeration for button events.
+ *
+ * This enumeration defines the events BTN_vidTick posts for a registered button.
+ */
+typedef enum {
+	BTN_EVENT_PRESS,        /**< The debounced state became pushed. */
+	BTN_EVENT_RELEASE,      /**< The debounced state became released. */
+	BTN_EVENT_LONG_PRESS,   /**< The button is held for BUTTON_LONG_PRESS_MS, posted once per press. */
+	BTN_EVENT_DOUBLE_PRESS  /**< Second short press within BUTTON_DOUBLE_PRESS_MS, posted after its BTN_EVENT_PRESS. */
+} btn_enu_event_t;
+
 /**
  * @brief Button configuration structure.
  *
@@ -47,6 +69,16 @@ typedef struct {
 	dio_enu_pin_t 	enu_pin;    /**< Button's connected pin. */
 } btn_str_config_t;
 
+/**
+ * @brief Button event.
+ *
+ * This structure holds an event taken from the queue with BTN_get_event.
+ */
+typedef struct {
+	const btn_str_config_t *ptr_str_button;   /**< Configuration the button was registered with. */
+	btn_enu_event_t enu_event;                /**< What happened. */
+} btn_str_event_t;
+
 
 
 
@@ -57,14 +89,17 @@ typedef struct {
  * @brief Initialize a button based on the provided configuration.
  *
  * This function initializes a button based on the provided button configuration. It sets the
- * specified pin of the specified port as an input pin, configuring it to be used as a button.
+ * specified pin of the specified port as an input pin, configuring it to be used as a button,
+ * and registers the button with the debouncer of BTN_vidTick.
  *
  * @param ptr_str_btn_config Pointer to the button configuration structure.
  * @return The initialization state of the button.
  *         - BTN_E_OK: Button initialized successfully.
- *         - BTN_NOT_OK: Button initialization failed due to a NULL configuration pointer.
+ *         - BTN_NOT_OK: Button initialization failed due to a NULL configuration pointer or
+ *           because BUTTON_MAX_BUTTONS buttons are registered already.
  *
- * @note The button configuration structure contains the port and pin information.
+ * @note The button configuration structure contains the port and pin information. It must stay
+ * valid after the call, the debouncer keeps using it and events refer to it. Buttons are active low.
  */
 btn_enu_return_state_t BTN_init(const btn_str_config_t *ptr_str_btn_config);
 
@@ -72,10 +107,8 @@ btn_enu_return_state_t BTN_init(const btn_str_config_t *ptr_str_btn_config);
 /**
  * @brief Get the state of a button based on the provided configuration.
  *
- * This function reads the state of a button based on the provided button configuration.
- * It employs a debounce mechanism to ensure accurate button state detection. The function
- * reads the button's pin state and checks it over a specified time period to account for
- * bouncing. After the debounce period, the button's state is determined as pushed or released.
+ * This function returns the debounced state BTN_vidTick keeps for a registered button. It does
+ * not wait: for a configuration that was not registered with BTN_init the pin is read once.
  *
  * @param ptr_str_btn_config Pointer to the button configuration structure.
  * @param ptr_enu_btn_state Pointer to the button state variable to be updated.
@@ -84,10 +117,34 @@ btn_enu_return_state_t BTN_init(const btn_str_config_t *ptr_str_btn_config);
  *         - BTN_NOT_OK: Button state reading failed due to NULL configuration or state pointer.
  *
  * @note The button configuration structure contains the port and pin information.
- * @note The function employs a debounce mechanism to ensure accurate button state detection.
- * @note The debounce threshold and checking time are constants defined in the module.
  */
 btn_enu_return_state_t BTN_get_state(const btn_str_config_t *ptr_str_btn_config, btn_enu_state_t *ptr_enu_btn_state);
 
+/**
+ * @brief Sample and debounce every registered button, and post their events.
+ *
+ * Each call shifts one sample per button into its history. BUTTON_DEBOUNCE_SAMPLES equal samples
+ * in a row change the debounced state and post BTN_EVENT_PRESS or BTN_EVENT_RELEASE. Long and
+ * double presses are timed in calls, so the function must run every BUTTON_TICK_MS, from a
+ * scheduler task or the timer tick. It never waits.
+ *
+ * @note Events are dropped while the queue is full.
+ */
+void BTN_vidTick(void);
+
+/**
+ * @brief Take the oldest button event from the queue.
+ *
+ * @param ptr_str_event Receives the event.
+ * @return The state of the operation.
+ *         - BTN_E_OK: An event was taken.
+ *         - BTN_NO_EVENT: The queue is empty.
+ *         - BTN_NOT_OK: ptr_str_event is NULL.
+ *
+ * @note Non-blocking. BTN_vidTick may run in an interrupt while the application takes events,
+ * the queue has a single producer and a single consumer and needs no lock.
+ */
+btn_enu_return_state_t BTN_get_event(btn_str_event_t *ptr_str_event);
+
 
 #endif 
\ No newline at end of file
@@ -9,27 +9,117 @@
 #include "BUTTON_interface.h"
 #include "BUTTON_config.h"
 #include "../../MCAL/DIO/DIO_interface.h"
+#include "../../STD_LIB/ring_buffer.h"
+
+/* Samples of the history that must agree before the debounced state changes */
+#define BUTTON_HISTORY_MASK          ((uint8_t)((1u << BUTTON_DEBOUNCE_SAMPLES) - 1u))
+#define BUTTON_LONG_PRESS_TICKS      (BUTTON_LONG_PRESS_MS / BUTTON_TICK_MS)
+#define BUTTON_DOUBLE_PRESS_TICKS    (BUTTON_DOUBLE_PRESS_MS / BUTTON_TICK_MS)
+#define BUTTON_TICKS_MAX             0xFFFFu
+
+/* Flags of button_str_runtime_t */
+#define BUTTON_FLAG_PUSHED           0x01u   /**< Debounced state is pushed. */
+#define BUTTON_FLAG_LONG_SENT        0x02u   /**< Long press of the current press was posted. */
+#define BUTTON_FLAG_DOUBLE_ARMED     0x04u   /**< Released after a short press, the next press may be a double press. */
+
+/**
+ * @brief Debouncer state of a registered button.
+ */
+typedef struct {
+	const btn_str_config_t *ptr_str_config;   /**< Registered configuration. */
+	uint8_t u8_history;                       /**< Last samples, bit 0 is the newest, 1 means pushed. */
+	uint8_t u8_flags;                         /**< BUTTON_FLAG_* bits. */
+	uint16_t u16_ticks;                       /**< Ticks since the last debounced change. */
+} button_str_runtime_t;
+
+static button_str_runtime_t gs_arr_str_buttons[BUTTON_MAX_BUTTONS];
+static volatile uint8_t gs_v_u8_buttons_count = 0;
+
+/* Event queue: BTN_vidTick is the producer, BTN_get_event the consumer */
+static btn_str_event_t gs_arr_str_events[BUTTON_EVENT_QUEUE_SIZE];
+static ring_str_t gs_str_events = RING_INITIALIZER(gs_arr_str_events);
+
+/**
+ * @brief Returns the runtime entry a configuration is registered with, NULL if there is none.
+ */
+static button_str_runtime_t *BTN_ptrFind(const btn_str_config_t *ptr_str_btn_config)
+{
+	button_str_runtime_t *ptr_str_button = NULL;
+	uint8_t u8_index;
+
+	for(u8_index = 0; u8_index < gs_v_u8_buttons_count; u8_index++) {
+		if(gs_arr_str_buttons[u8_index].ptr_str_config == ptr_str_btn_config) {
+			ptr_str_button = &gs_arr_str_buttons[u8_index];
+			break;
+		}
+	}
+
+	return ptr_str_button;
+}
+
+/**
+ * @brief Appends an event to the queue, the event is dropped when the queue is full.
+ */
+static void BTN_vidPost(const btn_str_config_t *ptr_str_btn_config, btn_enu_event_t enu_event)
+{
+	btn_str_event_t str_event;
+
+	str_event.ptr_str_button = ptr_str_btn_config;
+	str_event.enu_event = enu_event;
+	(void) RING_enuPush(&gs_str_events, &str_event);   // RING_FULL: the event is lost
+}
 
 /**
  * @brief Initialize a button based on the provided configuration.
  *
  * This function initializes a button based on the provided button configuration. It sets the
- * specified pin of the specified port as an input pin, configuring it to be used as a button.
+ * specified pin of the specified port as an input pin, configuring it to be used as a button,
+ * and registers the button with the debouncer of BTN_vidTick.
  *
  * @param ptr_str_btn_config Pointer to the button configuration structure.
  * @return The initialization state of the button.
  *         - BTN_E_OK: Button initialized successfully.
- *         - BTN_NOT_OK: Button initialization failed due to a NULL configuration pointer.
+ *         - BTN_NOT_OK: Button initialization failed due to a NULL configuration pointer or
+ *           because BUTTON_MAX_BUTTONS buttons are registered already.
  *
  * @note The button configuration structure contains the port and pin information.
  */
 btn_enu_return_state_t BTN_init(const btn_str_config_t *ptr_str_btn_config)
 {
 	btn_enu_return_state_t enu_return_state = BTN_E_OK;
+	button_str_runtime_t *ptr_str_button;
 
 	if(ptr_str_btn_config != NULL) {
-		// Initialize the specified pin of the specified port as an input pin
-		DIO_init(ptr_str_btn_config->enu_port, ptr_str_btn_config->enu_pin, DIO_PIN_INPUT);
+		ptr_str_button = BTN_ptrFind(ptr_str_btn_config);
+
+		if(ptr_str_button == NULL) {
+			if(gs_v_u8_buttons_count < BUTTON_MAX_BUTTONS) {
+				ptr_str_button = &gs_arr_str_buttons[gs_v_u8_buttons_count];
+				ptr_str_button->ptr_str_config = ptr_str_btn_config;
+			} else {
+				/* Registration table full */
+				enu_return_state = BTN_NOT_OK;
+			}
+		} else {
+			/* Re-initialization, the entry is reset below */
+		}
+
+		if(ptr_str_button != NULL) {
+			// Initialize the specified pin of the specified port as an input pin
+			DIO_init(ptr_str_btn_config->enu_port, ptr_str_btn_config->enu_pin, DIO_PIN_INPUT);
+
+			ptr_str_button->u8_history = 0;
+			ptr_str_button->u8_flags = 0;
+			ptr_str_button->u16_ticks = 0;
+
+			if(ptr_str_button == &gs_arr_str_buttons[gs_v_u8_buttons_count]) {
+				gs_v_u8_buttons_count++;   // Visible to BTN_vidTick only once the entry is set up
+			} else {
+				/* Entry registered already */
+			}
+		} else {
+			/* Nothing to initialize */
+		}
 	} else {
 		enu_return_state = BTN_NOT_OK;
 	}
@@ -40,10 +130,8 @@ btn_enu_return_state_t BTN_init(const btn_str_config_t *ptr_str_btn_config)
 /**
  * @brief Get the state of a button based on the provided configuration.
  *
- * This function reads the state of a button based on the provided button configuration.
- * It employs a debounce mechanism to ensure accurate button state detection. The function
- * reads the button's pin state and checks it over a specified time period to account for
- * bouncing. After the debounce period, the button's state is determined as pushed or released.
+ * This function returns the debounced state BTN_vidTick keeps for a registered button. It does
+ * not wait: for a configuration that was not registered with BTN_init the pin is read once.
  *
  * @param ptr_str_btn_config Pointer to the button configuration structure.
  * @param ptr_enu_btn_state Pointer to the button state variable to be updated.
@@ -52,49 +140,116 @@ btn_enu_return_state_t BTN_init(const btn_str_config_t *ptr_str_btn_config)
  *         - BTN_NOT_OK: Button state reading failed due to NULL configuration or state pointer.
  *
  * @note The button configuration structure contains the port and pin information.
- * @note The function employs a debounce mechanism to ensure accurate button state detection.
- * @note The debounce threshold and checking time are constants defined in the module.
  */
 btn_enu_return_state_t BTN_get_state(const btn_str_config_t *ptr_str_btn_config, btn_enu_state_t *ptr_enu_btn_state)
 {
 	btn_enu_return_state_t enu_return_state = BTN_E_OK;
+	button_str_runtime_t *ptr_str_button;
 	dio_enu_level_t enu_pin_state;
-	uint16_t u16_button_time_counter = 0;
-	uint16_t u16_debounceThreshold_counter = 0;
 
 	if((ptr_str_btn_config != NULL) && (ptr_enu_btn_state != NULL)) {
-		DIO_read_pin(ptr_str_btn_config->enu_port, ptr_str_btn_config->enu_pin, &enu_pin_state);
+		ptr_str_button = BTN_ptrFind(ptr_str_btn_config);
 
-		if(enu_pin_state == DIO_PIN_LOW_LEVEL) {
-			u16_debounceThreshold_counter++;
+		if(ptr_str_button != NULL) {
+			*ptr_enu_btn_state = ((ptr_str_button->u8_flags & BUTTON_FLAG_PUSHED) != 0) ? BTN_PUSHED : BTN_RELEASED;
+		} else {
+			/* Not registered, no debounce history: take the pin level as it is */
+			DIO_read_pin(ptr_str_btn_config->enu_port, ptr_str_btn_config->enu_pin, &enu_pin_state);
+			*ptr_enu_btn_state = (enu_pin_state == DIO_PIN_LOW_LEVEL) ? BTN_PUSHED : BTN_RELEASED;
+		}
+	} else {
+		/* Invalid input parameters */
+		enu_return_state = BTN_NOT_OK;
+	}
+
+	return enu_return_state;
+}
+
+/**
+ * @brief Sample and debounce every registered button, and post their events.
+ *
+ * The history of a button is a shift register of its samples. The debounced state follows it
+ * only when the last BUTTON_DEBOUNCE_SAMPLES samples agree, so a bounce resets nothing but costs
+ * one shift and one compare per button and tick.
+ */
+void BTN_vidTick(void)
+{
+	button_str_runtime_t *ptr_str_button;
+	dio_enu_level_t enu_pin_state;
+	uint8_t u8_count = gs_v_u8_buttons_count;
+	uint8_t u8_index;
+	uint8_t u8_samples;
+
+	for(u8_index = 0; u8_index < u8_count; u8_index++) {
+		ptr_str_button = &gs_arr_str_buttons[u8_index];
+
+		DIO_read_pin(ptr_str_button->ptr_str_config->enu_port, ptr_str_button->ptr_str_config->enu_pin, &enu_pin_state);
+		ptr_str_button->u8_history = (uint8_t)((ptr_str_button->u8_history << 1) | ((enu_pin_state == DIO_PIN_LOW_LEVEL) ? 1u : 0u));
+		u8_samples = ptr_str_button->u8_history & BUTTON_HISTORY_MASK;
 
-			while(u16_button_time_counter < BUTTON_CHECKING_TIME) {
-				DIO_read_pin(ptr_str_btn_config->enu_port, ptr_str_btn_config->enu_pin, &enu_pin_state);
-				
-				if(enu_pin_state == DIO_PIN_LOW_LEVEL) {
-					u16_debounceThreshold_counter++;
+		if(ptr_str_button->u16_ticks < BUTTON_TICKS_MAX) {
+			ptr_str_button->u16_ticks++;
+		} else {
+			/* Saturated, only compared against the press times */
+		}
+
+		if((ptr_str_button->u8_flags & BUTTON_FLAG_PUSHED) == 0) {
+			if(u8_samples == BUTTON_HISTORY_MASK) {
+				/* Press */
+				BTN_vidPost(ptr_str_button->ptr_str_config, BTN_EVENT_PRESS);
+				if(((ptr_str_button->u8_flags & BUTTON_FLAG_DOUBLE_ARMED) != 0) &&
+				   (ptr_str_button->u16_ticks <= BUTTON_DOUBLE_PRESS_TICKS)) {
+					BTN_vidPost(ptr_str_button->ptr_str_config, BTN_EVENT_DOUBLE_PRESS);
+					ptr_str_button->u8_flags = BUTTON_FLAG_PUSHED;   // A third press starts over
 				} else {
-					/* Button released during the checking time */
+					ptr_str_button->u8_flags = BUTTON_FLAG_PUSHED | BUTTON_FLAG_DOUBLE_ARMED;
 				}
-				
-				u16_button_time_counter++;
-			}
-			
-			if(u16_debounceThreshold_counter >= BUTTON_DEBOUNCE_THRESHOLD) {
-				*ptr_enu_btn_state = BTN_PUSHED;
+				ptr_str_button->u16_ticks = 0;
 			} else {
-				*ptr_enu_btn_state = BTN_RELEASED;
+				/* Released, or still bouncing */
 			}
 		} else {
-			/* Button is not pushed */
-			*ptr_enu_btn_state = BTN_RELEASED;
+			if(u8_samples == 0) {
+				/* Release: a short press may start a double press */
+				BTN_vidPost(ptr_str_button->ptr_str_config, BTN_EVENT_RELEASE);
+				ptr_str_button->u8_flags &= (uint8_t)~BUTTON_FLAG_PUSHED;
+				if((ptr_str_button->u8_flags & BUTTON_FLAG_LONG_SENT) != 0) {
+					ptr_str_button->u8_flags = 0;
+				} else {
+					/* Armed flag kept from the press */
+				}
+				ptr_str_button->u16_ticks = 0;
+			} else if(((ptr_str_button->u8_flags & BUTTON_FLAG_LONG_SENT) == 0) &&
+			          (ptr_str_button->u16_ticks >= BUTTON_LONG_PRESS_TICKS)) {
+				BTN_vidPost(ptr_str_button->ptr_str_config, BTN_EVENT_LONG_PRESS);
+				ptr_str_button->u8_flags |= BUTTON_FLAG_LONG_SENT;
+			} else {
+				/* Held */
+			}
 		}
-	} else {
-		/* Invalid input parameters */
+	}
+}
+
+/**
+ * @brief Take the oldest button event from the queue.
+ *
+ * @param ptr_str_event Receives the event.
+ * @return The state of the operation.
+ *         - BTN_E_OK: An event was taken.
+ *         - BTN_NO_EVENT: The queue is empty.
+ *         - BTN_NOT_OK: ptr_str_event is NULL.
+ */
+btn_enu_return_state_t BTN_get_event(btn_str_event_t *ptr_str_event)
+{
+	btn_enu_return_state_t enu_return_state = BTN_E_OK;
+
+	if(ptr_str_event == NULL) {
 		enu_return_state = BTN_NOT_OK;
+	} else if(RING_enuPop(&gs_str_events, ptr_str_event) != RING_OK) {
+		enu_return_state = BTN_NO_EVENT;
+	} else {
+		/* Event taken */
 	}
 
 	return enu_return_state;
 }
-
-
@@ -10,7 +10,19 @@
 #define CAR_CONTRO_INTERFACE_H_
 
 #include "../PWM/PWM_interface.h"
-#include "../motor/MOTOR_interface.h"
+#include "../MOTOR/MOTOR_interface.h"
+
+/**
+ * @brief Number of PWM configurations the car functions take (ptr_str_pwm_config points to an array).
+ *
+ * With the Timer 1 backend each motor has its own enable channel: entry 0 (OC1A) drives motor 1
+ * and entry 1 (OC1B) drives motor 2. The software backend drives one enable pin shared by both motors.
+ */
+#if PWM_BACKEND == PWM_BACKEND_TIMER1
+#define CAR_PWM_CHANNELS        2
+#else
+#define CAR_PWM_CHANNELS        1
+#endif
 
 
 
@@ -34,6 +46,22 @@ typedef enum car_enu_return_state_t
     CAR_NULL_PTR    /**< Car control operation failed due to a NULL pointer. */
 } car_enu_return_state_t;
 
+/**
+ * @brief Enumeration of the maneuvers the motor directions were last set for.
+ *
+ * CAR_CONTROL keeps the last commanded maneuver and skips the motor writes when it is commanded again.
+ */
+typedef enum
+{
+    CAR_MOTION_UNKNOWN = 0, /**< Directions not set yet, or the last write failed. */
+    CAR_MOTION_FORWARD,     /**< Both motors forward. */
+    CAR_MOTION_BACKWARD,    /**< Both motors backward. */
+    CAR_MOTION_RIGHT,       /**< Motor 1 forward, motor 2 backward. */
+    CAR_MOTION_LEFT,        /**< Motor 1 backward, motor 2 forward. */
+    CAR_MOTION_STOP,        /**< Both motors stopped. */
+    CAR_MOTION_MAX
+} car_enu_motion_t;
+
 
 
 /************************************************************************************************/
@@ -49,7 +77,7 @@ typedef enum car_enu_return_state_t
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The initialization state of the car.
 *         - CAR_OK: Car initialized successfully.
 *         - CAR_NOK: Car initialization failed due to motor initialization errors.
@@ -69,13 +97,15 @@ car_enu_return_state_t CAR_INIT(const motor_str_config_t *ptr_str_motor_1,const
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The movement state of the car.
 *         - CAR_OK: Car moved forward successfully.
 *         - CAR_NOK: Car movement failed due to motor movement errors.
 *         - CAR_NULL_PTR: Car movement failed due to NULL pointers.
 *
 * @note The function moves both motors forward and starts the PWM.
+*       The motor pins are only written when the maneuver differs from the last one, and a
+*       new duty cycle takes effect at the next PWM period.
 ************************************************************************/
 car_enu_return_state_t CAR_FORWARD(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, pwm_str_configuration_t *ptr_str_pwm_config);
 
@@ -90,13 +120,15 @@ car_enu_return_state_t CAR_FORWARD(const motor_str_config_t *ptr_str_motor_1,con
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The movement state of the car.
 *         - CAR_OK: Car moved backward successfully.
 *         - CAR_NOK: Car movement failed due to motor movement errors.
 *         - CAR_NULL_PTR: Car movement failed due to NULL pointers.
 *
 * @note The function moves both motors backward and starts the PWM.
+*       The motor pins are only written when the maneuver differs from the last one, and a
+*       new duty cycle takes effect at the next PWM period.
 ************************************************************************/
 car_enu_return_state_t CAR_BACKWARD(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, pwm_str_configuration_t *ptr_str_pwm_config);
 
@@ -111,13 +143,15 @@ car_enu_return_state_t CAR_BACKWARD(const motor_str_config_t *ptr_str_motor_1,co
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The movement state of the car.
 *         - CAR_OK: Car reversed to the right successfully.
 *         - CAR_NOK: Car movement failed due to motor movement errors.
 *         - CAR_NULL_PTR: Car movement failed due to NULL pointers.
 *
 * @note The function reverses motor 1 forward and motor 2 backward, then starts the PWM.
+*       The motor pins are only written when the maneuver differs from the last one, and a
+*       new duty cycle takes effect at the next PWM period.
 ************************************************************************/
 car_enu_return_state_t CAR_REVERSE_RIGHT(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, pwm_str_configuration_t *ptr_str_pwm_config);
 
@@ -133,13 +167,15 @@ car_enu_return_state_t CAR_REVERSE_RIGHT(const motor_str_config_t *ptr_str_motor
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The movement state of the car.
 *         - CAR_OK: Car reversed to the left successfully.
 *         - CAR_NOK: Car movement failed due to motor movement errors.
 *         - CAR_NULL_PTR: Car movement failed due to NULL pointers.
 *
 * @note The function reverses motor 1 backward and motor 2 forward, then starts the PWM.
+*       The motor pins are only written when the maneuver differs from the last one, and a
+*       new duty cycle takes effect at the next PWM period.
 ************************************************************************/
 car_enu_return_state_t CAR_REVERSE_LEFT(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, pwm_str_configuration_t *ptr_str_pwm_config);
 
@@ -156,13 +192,14 @@ car_enu_return_state_t CAR_REVERSE_LEFT(const motor_str_config_t *ptr_str_motor_
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The stop state of the car.
 *         - CAR_OK: Car stopped successfully.
 *         - CAR_NOK: Car stop failed due to motor stop errors.
 *         - CAR_NULL_PTR: Car stop failed due to NULL pointers.
 *
 * @note The function stops both motors and the PWM.
+*       The motor pins are only written when the maneuver differs from the last one.
 ************************************************************************/
 car_enu_return_state_t CAR_STOP(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, pwm_str_configuration_t *ptr_str_pwm_config);
 
@@ -7,6 +7,36 @@
 #include "CAR_CONTROL_interface.h"
 
 
+/* Maneuver the motor directions were last set for */
+static car_enu_motion_t gs_enu_car_motion = CAR_MOTION_UNKNOWN;
+
+/* Directions of motor 1 and motor 2 per maneuver */
+static const motor_enu_direction_t gs_arr_arr_enu_car_directions[CAR_MOTION_MAX][2] = {
+	[CAR_MOTION_UNKNOWN]  = {MOTOR_DIR_STOP,     MOTOR_DIR_STOP},
+	[CAR_MOTION_FORWARD]  = {MOTOR_DIR_FORWARD,  MOTOR_DIR_FORWARD},
+	[CAR_MOTION_BACKWARD] = {MOTOR_DIR_BACKWARD, MOTOR_DIR_BACKWARD},
+	[CAR_MOTION_RIGHT]    = {MOTOR_DIR_FORWARD,  MOTOR_DIR_BACKWARD},
+	[CAR_MOTION_LEFT]     = {MOTOR_DIR_BACKWARD, MOTOR_DIR_FORWARD},
+	[CAR_MOTION_STOP]     = {MOTOR_DIR_STOP,     MOTOR_DIR_STOP},
+};
+
+
+/* Static Function Prototype */
+
+/************************************************************************
+* @brief Sets the directions of both motors for a maneuver.
+*
+* The levels of IN1..IN4 come from the direction table. When both motors sit on the same
+* port all four pins change in one masked port write, otherwise each motor gets its own.
+* Nothing is written if the maneuver is already applied.
+*
+* @param ptr_str_motor_1 Pointer to the configuration of motor 1.
+* @param ptr_str_motor_2 Pointer to the configuration of motor 2.
+* @param enu_motion The maneuver.
+* @return CAR_OK, or CAR_NOK if a motor configuration is invalid or a write failed.
+************************************************************************/
+static car_enu_return_state_t CAR_enuSetMotion(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, car_enu_motion_t enu_motion);
+
 
 /* APIs Implementation */
 
@@ -19,7 +49,7 @@
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The initialization state of the car.
 *         - CAR_OK: Car initialized successfully.
 *         - CAR_NOK: Car initialization failed due to motor initialization errors.
@@ -37,7 +67,10 @@ car_enu_return_state_t CAR_INIT(const motor_str_config_t *ptr_str_motor_1,const
 	{
 		enu_motor_error_1 = MOTOR_INIT(ptr_str_motor_1);
 		enu_motor_error_2 = MOTOR_INIT(ptr_str_motor_2);
-		pwm_init(ptr_str_pwm_config);
+		gs_enu_car_motion = CAR_MOTION_UNKNOWN;
+		for(uint8_t u8_channel = U8_ZERO_VALUE; u8_channel < CAR_PWM_CHANNELS; u8_channel++){
+			pwm_init(&ptr_str_pwm_config[u8_channel]);
+		}
 		pwm_start_tick();
 		if((enu_motor_error_1 != MOTOR_OK) || (enu_motor_error_2 != MOTOR_OK)){
 			enu_return_state=CAR_NOK;
@@ -61,30 +94,26 @@ car_enu_return_state_t CAR_INIT(const motor_str_config_t *ptr_str_motor_1,const
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The movement state of the car.
 *         - CAR_OK: Car moved forward successfully.
 *         - CAR_NOK: Car movement failed due to motor movement errors.
 *         - CAR_NULL_PTR: Car movement failed due to NULL pointers.
 *
 * @note The function moves both motors forward and starts the PWM.
+*       All motor pins are written at once, and only when the maneuver differs from the last one, and a
+*       new duty cycle takes effect at the next PWM period.
 ************************************************************************/
 car_enu_return_state_t CAR_FORWARD(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, pwm_str_configuration_t *ptr_str_pwm_config)
 {
 	car_enu_return_state_t enu_return_state=CAR_OK;
-	motor_enu_return_state_t enu_motor_error_1;
-	motor_enu_return_state_t enu_motor_error_2;
 	
 	if((ptr_str_motor_1 !=NULL) && (ptr_str_motor_2 != NULL))
 	{
-		enu_motor_error_1 = MOTOR_FORWARD(ptr_str_motor_1);
-		enu_motor_error_2 = MOTOR_FORWARD(ptr_str_motor_2);
-		pwm_change_frequency_or_duty_cycle(ptr_str_pwm_config);
-		pwm_start(ptr_str_pwm_config);
-		if((enu_motor_error_1 != MOTOR_OK) || (enu_motor_error_2 != MOTOR_OK)){
-			enu_return_state=CAR_NOK;
-		}else{
-			
+		enu_return_state = CAR_enuSetMotion(ptr_str_motor_1, ptr_str_motor_2, CAR_MOTION_FORWARD);
+		for(uint8_t u8_channel = U8_ZERO_VALUE; u8_channel < CAR_PWM_CHANNELS; u8_channel++){
+			pwm_change_frequency_or_duty_cycle(&ptr_str_pwm_config[u8_channel]);
+			pwm_start(&ptr_str_pwm_config[u8_channel]);
 		}
 	}
 	else
@@ -104,30 +133,26 @@ car_enu_return_state_t CAR_FORWARD(const motor_str_config_t *ptr_str_motor_1,con
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The movement state of the car.
 *         - CAR_OK: Car moved backward successfully.
 *         - CAR_NOK: Car movement failed due to motor movement errors.
 *         - CAR_NULL_PTR: Car movement failed due to NULL pointers.
 *
 * @note The function moves both motors backward and starts the PWM.
+*       All motor pins are written at once, and only when the maneuver differs from the last one, and a
+*       new duty cycle takes effect at the next PWM period.
 ************************************************************************/
 car_enu_return_state_t CAR_BACKWARD(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, pwm_str_configuration_t *ptr_str_pwm_config)
 {
 	car_enu_return_state_t enu_return_state=CAR_OK;
-	motor_enu_return_state_t enu_motor_error_1;
-	motor_enu_return_state_t enu_motor_error_2;
 	
 	if((ptr_str_motor_1 !=NULL) && (ptr_str_motor_2 != NULL))
 	{
-		enu_motor_error_1 = MOTOR_BACKWARD(ptr_str_motor_1);
-		enu_motor_error_2 = MOTOR_BACKWARD(ptr_str_motor_2);
-		pwm_change_frequency_or_duty_cycle(ptr_str_pwm_config);
-		pwm_start(ptr_str_pwm_config);
-		if((enu_motor_error_1 != MOTOR_OK) || (enu_motor_error_2 != MOTOR_OK)){
-			enu_return_state=CAR_NOK;
-			}else{
-			
+		enu_return_state = CAR_enuSetMotion(ptr_str_motor_1, ptr_str_motor_2, CAR_MOTION_BACKWARD);
+		for(uint8_t u8_channel = U8_ZERO_VALUE; u8_channel < CAR_PWM_CHANNELS; u8_channel++){
+			pwm_change_frequency_or_duty_cycle(&ptr_str_pwm_config[u8_channel]);
+			pwm_start(&ptr_str_pwm_config[u8_channel]);
 		}
 	}
 	else
@@ -146,29 +171,25 @@ car_enu_return_state_t CAR_BACKWARD(const motor_str_config_t *ptr_str_motor_1,co
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The movement state of the car.
 *         - CAR_OK: Car reversed to the right successfully.
 *         - CAR_NOK: Car movement failed due to motor movement errors.
 *         - CAR_NULL_PTR: Car movement failed due to NULL pointers.
 *
 * @note The function reverses motor 1 forward and motor 2 backward, then starts the PWM.
+*       All motor pins are written at once, and only when the maneuver differs from the last one, and a
+*       new duty cycle takes effect at the next PWM period.
 ************************************************************************/
 car_enu_return_state_t CAR_REVERSE_RIGHT(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, pwm_str_configuration_t *ptr_str_pwm_config)
 {
 	car_enu_return_state_t enu_return_state=CAR_OK;
-	motor_enu_return_state_t enu_motor_error_1;
-	motor_enu_return_state_t enu_motor_error_2;
 	if((ptr_str_motor_1 !=NULL) && (ptr_str_motor_2 != NULL))
 	{
-		enu_motor_error_1 = MOTOR_FORWARD(ptr_str_motor_1);
-		enu_motor_error_2 = MOTOR_BACKWARD(ptr_str_motor_2);
-		pwm_change_frequency_or_duty_cycle(ptr_str_pwm_config);
-		pwm_start(ptr_str_pwm_config);
-		if((enu_motor_error_1 != MOTOR_OK) || (enu_motor_error_2 != MOTOR_OK)){
-			enu_return_state=CAR_NOK;
-			}else{
-			
+		enu_return_state = CAR_enuSetMotion(ptr_str_motor_1, ptr_str_motor_2, CAR_MOTION_RIGHT);
+		for(uint8_t u8_channel = U8_ZERO_VALUE; u8_channel < CAR_PWM_CHANNELS; u8_channel++){
+			pwm_change_frequency_or_duty_cycle(&ptr_str_pwm_config[u8_channel]);
+			pwm_start(&ptr_str_pwm_config[u8_channel]);
 		}
 	}
 	else
@@ -187,29 +208,25 @@ car_enu_return_state_t CAR_REVERSE_RIGHT(const motor_str_config_t *ptr_str_motor
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The movement state of the car.
 *         - CAR_OK: Car reversed to the left successfully.
 *         - CAR_NOK: Car movement failed due to motor movement errors.
 *         - CAR_NULL_PTR: Car movement failed due to NULL pointers.
 *
 * @note The function reverses motor 1 backward and motor 2 forward, then starts the PWM.
+*       All motor pins are written at once, and only when the maneuver differs from the last one, and a
+*       new duty cycle takes effect at the next PWM period.
 ************************************************************************/
 car_enu_return_state_t CAR_REVERSE_LEFT(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, pwm_str_configuration_t *ptr_str_pwm_config)
 {
 	car_enu_return_state_t enu_return_state=CAR_OK;
-	motor_enu_return_state_t enu_motor_error_1;
-	motor_enu_return_state_t enu_motor_error_2;
 	if((ptr_str_motor_1 !=NULL) && (ptr_str_motor_2 != NULL))
 	{
-		enu_motor_error_1 = MOTOR_BACKWARD(ptr_str_motor_1);
-		enu_motor_error_2 = MOTOR_FORWARD(ptr_str_motor_2);
-		pwm_change_frequency_or_duty_cycle(ptr_str_pwm_config);
-		pwm_start(ptr_str_pwm_config);
-		if((enu_motor_error_1 != MOTOR_OK) || (enu_motor_error_2 != MOTOR_OK)){
-			enu_return_state=CAR_NOK;
-			}else{
-			
+		enu_return_state = CAR_enuSetMotion(ptr_str_motor_1, ptr_str_motor_2, CAR_MOTION_LEFT);
+		for(uint8_t u8_channel = U8_ZERO_VALUE; u8_channel < CAR_PWM_CHANNELS; u8_channel++){
+			pwm_change_frequency_or_duty_cycle(&ptr_str_pwm_config[u8_channel]);
+			pwm_start(&ptr_str_pwm_config[u8_channel]);
 		}
 	}
 	else
@@ -228,28 +245,23 @@ car_enu_return_state_t CAR_REVERSE_LEFT(const motor_str_config_t *ptr_str_motor_
 *
 * @param ptr_str_motor_1 Pointer to the configuration of motor 1.
 * @param ptr_str_motor_2 Pointer to the configuration of motor 2.
-* @param ptr_str_pwm_config Pointer to the PWM configuration.
+* @param ptr_str_pwm_config Pointer to the CAR_PWM_CHANNELS PWM configurations.
 * @return The stop state of the car.
 *         - CAR_OK: Car stopped successfully.
 *         - CAR_NOK: Car stop failed due to motor stop errors.
 *         - CAR_NULL_PTR: Car stop failed due to NULL pointers.
 *
 * @note The function stops both motors and the PWM.
+*       All motor pins are written at once, and only when the maneuver differs from the last one.
 ************************************************************************/
 car_enu_return_state_t CAR_STOP(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, pwm_str_configuration_t *ptr_str_pwm_config)
 {
 	car_enu_return_state_t enu_return_state=CAR_OK;
-	motor_enu_return_state_t enu_motor_error_1;
-	motor_enu_return_state_t enu_motor_error_2;
 	if((ptr_str_motor_1 !=NULL) && (ptr_str_motor_2 != NULL))
 	{
-		enu_motor_error_1 = MOTOR_STOP(ptr_str_motor_1);
-		enu_motor_error_2 = MOTOR_STOP(ptr_str_motor_2);
-		pwm_stop(ptr_str_pwm_config);
-		if((enu_motor_error_1 != MOTOR_OK) || (enu_motor_error_2 != MOTOR_OK)){
-			enu_return_state=CAR_NOK;
-			}else{
-			
+		enu_return_state = CAR_enuSetMotion(ptr_str_motor_1, ptr_str_motor_2, CAR_MOTION_STOP);
+		for(uint8_t u8_channel = U8_ZERO_VALUE; u8_channel < CAR_PWM_CHANNELS; u8_channel++){
+			pwm_stop(&ptr_str_pwm_config[u8_channel]);
 		}
 	}
 	else
@@ -257,4 +269,43 @@ car_enu_return_state_t CAR_STOP(const motor_str_config_t *ptr_str_motor_1,const
 		enu_return_state=CAR_NULL_PTR;
 	}
 	return enu_return_state;
-}
\ No newline at end of file
+}
+
+
+/* Static Function Implementation */
+
+static car_enu_return_state_t CAR_enuSetMotion(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2, car_enu_motion_t enu_motion)
+{
+	car_enu_return_state_t enu_return_state = CAR_OK;
+	uint8_t u8_mask_1;
+	uint8_t u8_mask_2;
+	uint8_t u8_levels_1;
+	uint8_t u8_levels_2;
+	dio_enu_return_state_t enu_dio_error;
+
+	if(gs_enu_car_motion != enu_motion)
+	{
+		if((MOTOR_GET_LEVELS(ptr_str_motor_1, gs_arr_arr_enu_car_directions[enu_motion][0], &u8_mask_1, &u8_levels_1) != MOTOR_OK) ||
+		   (MOTOR_GET_LEVELS(ptr_str_motor_2, gs_arr_arr_enu_car_directions[enu_motion][1], &u8_mask_2, &u8_levels_2) != MOTOR_OK))
+		{
+			enu_return_state = CAR_NOK;
+		}
+		else if(ptr_str_motor_1->port == ptr_str_motor_2->port)
+		{
+			enu_dio_error = DIO_write_port_masked(ptr_str_motor_1->port, u8_mask_1 | u8_mask_2, u8_levels_1 | u8_levels_2);
+			enu_return_state = (enu_dio_error == DIO_OK) ? CAR_OK : CAR_NOK;
+		}
+		else
+		{
+			enu_dio_error = DIO_write_port_masked(ptr_str_motor_1->port, u8_mask_1, u8_levels_1);
+			if(enu_dio_error == DIO_OK)
+			{
+				enu_dio_error = DIO_write_port_masked(ptr_str_motor_2->port, u8_mask_2, u8_levels_2);
+			}
+			enu_return_state = (enu_dio_error == DIO_OK) ? CAR_OK : CAR_NOK;
+		}
+		gs_enu_car_motion = (enu_return_state == CAR_OK) ? enu_motion : CAR_MOTION_UNKNOWN;
+	}
+
+	return enu_return_state;
+}
@@ -0,0 +1,22 @@
+/**
+ * @file DIST_FILTER_config.h
+ * @brief Distance filter configuration: median window, EMA weight and rate-of-change gate.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef DIST_FILTER_CONFIG_H_
+#define DIST_FILTER_CONFIG_H_
+
+
+
+#define DFILTER_MEDIAN_SIZE          3        /**< Samples of the running median, 3 or 5. */
+#define DFILTER_EMA_SHIFT            1        /**< The EMA moves by 1/2^shift of the gap to the new median. */
+#define DFILTER_MAX_RATE_CM_PER_S    100      /**< Fastest plausible change of the distance. */
+#define DFILTER_RELOCK_SAMPLES       2        /**< Medians in a row outside the gate after which the filter follows them. */
+
+
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * @file DIST_FILTER_interface.h
+ * @brief Streaming filter between the ultrasonic measurements and the application.
+ *
+ * Each measurement goes through a running median of DFILTER_MEDIAN_SIZE samples, which removes
+ * a single multipath echo or missed edge, then through a rate-of-change gate and an exponential
+ * moving average. The gate holds back medians that moved faster than DFILTER_MAX_RATE_CM_PER_S
+ * allows since the previous one, until DFILTER_RELOCK_SAMPLES of them agree that the scene
+ * really changed. Only comparisons, additions and shifts are used per sample.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef DIST_FILTER_INTERFACE_H_
+#define DIST_FILTER_INTERFACE_H_
+#include "DIST_FILTER_config.h"
+#include "../ULTRASONIC/ULTRASONIC_interface.h"
+
+#if DFILTER_MEDIAN_SIZE != 3 && DFILTER_MEDIAN_SIZE != 5
+#error "DFILTER_MEDIAN_SIZE must be 3 or 5"
+#endif
+
+#if DFILTER_RELOCK_SAMPLES < 1
+#error "DFILTER_RELOCK_SAMPLES must be at least 1"
+#endif
+
+
+/************************************************************************************************/
+/*									Enumerated Datatypes										*/
+/************************************************************************************************/
+
+/**
+ * @brief Enumeration for distance filter return states.
+ */
+typedef enum {
+	DFILTER_OK,         /**< Function executed successfully. */
+	DFILTER_NOK         /**< Invalid argument. */
+} dfilter_enu_return_state_t;
+
+/**
+ * @brief Enumeration for the confidence of a filtered distance.
+ */
+typedef enum {
+	DFILTER_CONFIDENCE_LOW,     /**< The median window is still filling, or the last median was held back by the gate. */
+	DFILTER_CONFIDENCE_HIGH     /**< The filtered distance follows a full window of plausible samples. */
+} dfilter_enu_confidence_t;
+
+
+/************************************************************************************************/
+/*									Structure Datatypes											*/
+/************************************************************************************************/
+
+/**
+ * @brief Filter state, one per sensor. The caller owns the memory, the fields belong to the filter.
+ */
+typedef struct {
+	hultrasonic_distance_t arr_window[DFILTER_MEDIAN_SIZE];   /**< Last raw samples, oldest at u8_index once full. */
+	hultrasonic_distance_t ema;                               /**< Filtered distance. */
+	uint32_t u32_timestamp;                                   /**< Timestamp of the previous sample. */
+	uint8_t u8_index;                                         /**< Window slot of the next sample. */
+	uint8_t u8_count;                                         /**< Samples in the window, up to DFILTER_MEDIAN_SIZE. */
+	uint8_t u8_rejects;                                       /**< Medians held back by the gate in a row. */
+	uint16_t u16_samples;                                     /**< Samples taken since DFILTER_enuInit, wraps. */
+	uint16_t u16_rejected;                                    /**< Medians held back since DFILTER_enuInit, wraps. */
+} dfilter_str_t;
+
+/**
+ * @brief Result of one filter step.
+ */
+typedef struct {
+	hultrasonic_distance_t distance;            /**< Filtered distance. */
+	dfilter_enu_confidence_t enu_confidence;    /**< Whether the distance can be acted on. */
+} dfilter_str_output_t;
+
+
+/************************************************************************************************/
+/*									Function Prototypes     									*/
+/************************************************************************************************/
+
+/**
+ * @brief Empty a filter.
+ *
+ * The next samples fill the median window again, the EMA restarts from the first full window.
+ *
+ * @param ptr_str_filter Pointer to the filter state.
+ * @return DFILTER_OK, or DFILTER_NOK if ptr_str_filter is NULL.
+ */
+dfilter_enu_return_state_t DFILTER_enuInit(dfilter_str_t *ptr_str_filter);
+
+/**
+ * @brief Feed one measurement through the filter.
+ *
+ * @param ptr_str_filter Pointer to the filter state.
+ * @param distance The measured distance.
+ * @param u32_timestamp Timing tick of the measurement, the gap to the previous one scales the rate-of-change gate.
+ * @param ptr_str_output Receives the filtered distance and its confidence.
+ * @return DFILTER_OK, or DFILTER_NOK if a pointer is NULL.
+ *
+ * @note While the window fills the output is the median of the samples so far, with low confidence.
+ */
+dfilter_enu_return_state_t DFILTER_enuUpdate(dfilter_str_t *ptr_str_filter, hultrasonic_distance_t distance, uint32_t u32_timestamp,
+                                             dfilter_str_output_t *ptr_str_output);
+
+
+
+#endif /* DIST_FILTER_INTERFACE_H_ */
@@ -0,0 +1,152 @@
+/**
+ * @file DIST_FILTER_prog.c
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#include "DIST_FILTER_interface.h"
+#include "DIST_FILTER_config.h"
+#include "../../STD_LIB/bit_math.h"
+
+/* Longest gap between two samples the gate scales to, in timing ticks */
+#define DFILTER_MAX_GAP_TICKS        0xFFFFUL
+
+#if ULTRASONIC_FIXED_POINT_DISTANCE
+
+/* Gate width in Q8.8: rate * ticks / 1000, the ticks of about 1 ms divided by 1024 rather than 1000 */
+typedef uint32_t dfilter_step_t;
+#define DFILTER_MAX_STEP(TICKS)      ((((dfilter_step_t)DFILTER_MAX_RATE_CM_PER_S << HULTRASONIC_Q8_8_SHIFT) * (TICKS)) >> 10)
+
+/* Fraction 1/2^DFILTER_EMA_SHIFT of a difference */
+#define DFILTER_EMA_STEP(DIFF)       ((hultrasonic_distance_t)((DIFF) >> DFILTER_EMA_SHIFT))
+
+#else
+
+typedef float64_t dfilter_step_t;
+#define DFILTER_MAX_STEP(TICKS)      (((dfilter_step_t)DFILTER_MAX_RATE_CM_PER_S * (dfilter_step_t)(TICKS)) / 1000.0)
+#define DFILTER_EMA_STEP(DIFF)       ((DIFF) / (hultrasonic_distance_t)(1u << DFILTER_EMA_SHIFT))
+
+#endif
+
+/**
+ * @brief Returns the median of the samples in the window.
+ *
+ * Sorts a copy by insertion, at most 10 compares for 5 samples.
+ */
+static hultrasonic_distance_t DFILTER_median(const dfilter_str_t *ptr_str_filter)
+{
+	hultrasonic_distance_t arr_sorted[DFILTER_MEDIAN_SIZE];
+	hultrasonic_distance_t value;
+	uint8_t u8_index;
+	uint8_t u8_slot;
+
+	for(u8_index = 0; u8_index < ptr_str_filter->u8_count; u8_index++) {
+		value = ptr_str_filter->arr_window[u8_index];
+		for(u8_slot = u8_index; (u8_slot > 0) && (arr_sorted[u8_slot - 1u] > value); u8_slot--) {
+			arr_sorted[u8_slot] = arr_sorted[u8_slot - 1u];
+		}
+		arr_sorted[u8_slot] = value;
+	}
+
+	return arr_sorted[(ptr_str_filter->u8_count - 1u) >> 1];
+}
+
+/**
+ * @brief Empty a filter.
+ *
+ * @param ptr_str_filter Pointer to the filter state.
+ * @return DFILTER_OK, or DFILTER_NOK if ptr_str_filter is NULL.
+ */
+dfilter_enu_return_state_t DFILTER_enuInit(dfilter_str_t *ptr_str_filter)
+{
+	dfilter_enu_return_state_t enu_return_state = DFILTER_OK;
+
+	if(ptr_str_filter != NULL) {
+		ptr_str_filter->ema = 0;
+		ptr_str_filter->u32_timestamp = 0;
+		ptr_str_filter->u8_index = 0;
+		ptr_str_filter->u8_count = 0;
+		ptr_str_filter->u8_rejects = 0;
+		ptr_str_filter->u16_samples = 0;
+		ptr_str_filter->u16_rejected = 0;
+	} else {
+		enu_return_state = DFILTER_NOK;
+	}
+
+	return enu_return_state;
+}
+
+/**
+ * @brief Feed one measurement through the filter.
+ *
+ * The raw sample replaces the oldest one of the window. Once the window is full its median is
+ * compared with the filtered distance: within the gate the EMA moves towards it, outside it the
+ * filtered distance is kept and the confidence drops, until DFILTER_RELOCK_SAMPLES medians in a
+ * row were outside, which restarts the EMA at the new level.
+ *
+ * @param ptr_str_filter Pointer to the filter state.
+ * @param distance The measured distance.
+ * @param u32_timestamp Timing tick of the measurement, the gap to the previous one scales the rate-of-change gate.
+ * @param ptr_str_output Receives the filtered distance and its confidence.
+ * @return DFILTER_OK, or DFILTER_NOK if a pointer is NULL.
+ */
+dfilter_enu_return_state_t DFILTER_enuUpdate(dfilter_str_t *ptr_str_filter, hultrasonic_distance_t distance, uint32_t u32_timestamp,
+                                             dfilter_str_output_t *ptr_str_output)
+{
+	dfilter_enu_return_state_t enu_return_state = DFILTER_OK;
+	hultrasonic_distance_t median;
+	hultrasonic_distance_t diff;
+	uint32_t u32_gap;
+
+	if((ptr_str_filter != NULL) && (ptr_str_output != NULL)) {
+		ptr_str_filter->u16_samples++;
+		ptr_str_filter->arr_window[ptr_str_filter->u8_index] = distance;
+		ptr_str_filter->u8_index = (ptr_str_filter->u8_index + 1u < DFILTER_MEDIAN_SIZE) ? (ptr_str_filter->u8_index + 1u) : U8_ZERO_VALUE;
+		u32_gap = u32_timestamp - ptr_str_filter->u32_timestamp;
+		ptr_str_filter->u32_timestamp = u32_timestamp;
+		ptr_str_output->enu_confidence = DFILTER_CONFIDENCE_LOW;
+
+		if(ptr_str_filter->u8_count < DFILTER_MEDIAN_SIZE) {
+			/* Filling: the EMA starts from the median of the first full window */
+			ptr_str_filter->u8_count++;
+			ptr_str_filter->ema = DFILTER_median(ptr_str_filter);
+			if(ptr_str_filter->u8_count == DFILTER_MEDIAN_SIZE) {
+				ptr_str_output->enu_confidence = DFILTER_CONFIDENCE_HIGH;
+			}
+		} else {
+			median = DFILTER_median(ptr_str_filter);
+			diff = (median > ptr_str_filter->ema) ? (median - ptr_str_filter->ema) : (ptr_str_filter->ema - median);
+			if(u32_gap > DFILTER_MAX_GAP_TICKS) {
+				u32_gap = DFILTER_MAX_GAP_TICKS;
+			}
+
+			if((dfilter_step_t)diff <= DFILTER_MAX_STEP(u32_gap)) {
+				/* Plausible: smooth */
+				ptr_str_filter->u8_rejects = 0;
+				if(median > ptr_str_filter->ema) {
+					ptr_str_filter->ema += DFILTER_EMA_STEP(diff);
+				} else {
+					ptr_str_filter->ema = median;   // Closing in is never delayed
+				}
+				ptr_str_output->enu_confidence = DFILTER_CONFIDENCE_HIGH;
+			} else if(ptr_str_filter->u8_rejects + 1u >= DFILTER_RELOCK_SAMPLES) {
+				/* The jump persists, the scene changed (new obstacle, car turned) */
+				ptr_str_filter->u8_rejects = 0;
+				ptr_str_filter->ema = median;
+				ptr_str_output->enu_confidence = DFILTER_CONFIDENCE_HIGH;
+			} else {
+				/* Implausible: keep the filtered distance until the jump is confirmed */
+				ptr_str_filter->u8_rejects++;
+				ptr_str_filter->u16_rejected++;
+			}
+		}
+
+		ptr_str_output->distance = ptr_str_filter->ema;
+	} else {
+		enu_return_state = DFILTER_NOK;
+	}
+
+	return enu_return_state;
+}
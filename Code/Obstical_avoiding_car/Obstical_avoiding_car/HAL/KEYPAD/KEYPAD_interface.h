@@ -11,6 +11,7 @@
 
 
 #include "../../MCAL/DIO/DIO_interface.h"
+#include "../../STD_LIB/ring_buffer.h"
 
 /**
  * @def KEYPAD_ROWS_MAX
@@ -28,6 +29,32 @@
  */
 #define KEYPAD_COLS_MAX             3
 
+/**
+ * @def KEYPAD_DEBOUNCE_SCANS
+ * @brief Full scans a key must agree in before its debounced state changes.
+ *
+ * A full scan takes KEYPAD_COLS_MAX calls of KEYPAD_vidTick.
+ */
+#define KEYPAD_DEBOUNCE_SCANS       2
+
+/**
+ * @def KEYPAD_EVENT_QUEUE_SIZE
+ * @brief Capacity of the key event queue, a power of two.
+ */
+#define KEYPAD_EVENT_QUEUE_SIZE     8
+
+#if (KEYPAD_ROWS_MAX * KEYPAD_COLS_MAX) > 16
+#error "The key bitmap holds at most 16 keys"
+#endif
+
+#if !RING_CAPACITY_VALID(KEYPAD_EVENT_QUEUE_SIZE)
+#error "KEYPAD_EVENT_QUEUE_SIZE must be a power of two up to 128"
+#endif
+
+#if KEYPAD_DEBOUNCE_SCANS < 1
+#error "KEYPAD_DEBOUNCE_SCANS must be at least 1"
+#endif
+
 
 
 /************************************************************************************************/
@@ -76,6 +103,27 @@ typedef enum{
     KEYPAD_NO_DATA
 }keypad_enu_return_state_t;
 
+/**
+ * @enum keypad_enu_event_t
+ * @brief Key events posted by KEYPAD_vidTick.
+ */
+typedef enum{
+    KEYPAD_EVENT_KEY_DOWN,  /**< The debounced key became pressed. */
+    KEYPAD_EVENT_KEY_UP     /**< The debounced key became released. */
+}keypad_enu_event_t;
+
+/**
+ * @struct keypad_str_event_t
+ * @brief Key event taken from the queue with KEYPAD_get_event.
+ */
+typedef struct
+{
+    uint8_t u8_key;                 /**< Character of the key in the keypad layout. */
+    uint8_t u8_row;                 /**< Row of the key. */
+    uint8_t u8_col;                 /**< Column of the key. */
+    keypad_enu_event_t enu_event;   /**< What happened. */
+} keypad_str_event_t;
+
 
 
 
@@ -87,7 +135,8 @@ typedef enum{
  * @brief Initialize a keypad based on the provided configuration.
  *
  * This function initializes a keypad based on the provided keypad configuration. It configures
- * the specified row and column pins of the keypad and sets them to appropriate initial states.
+ * the specified row and column pins of the keypad and sets them to appropriate initial states,
+ * and makes it the keypad KEYPAD_vidTick scans.
  *
  * @param ptr_str_keypad_config Pointer to the keypad configuration structure.
  * @return The initialization state of the keypad.
@@ -95,6 +144,7 @@ typedef enum{
  *         - KEYPAD_E_NOT_OK: Keypad initialization failed due to a NULL configuration pointer.
  *
  * @note The keypad configuration structure contains arrays of port and pin information for rows and columns.
+ * It must stay valid after the call, the scanner keeps using it.
  */
 keypad_enu_return_state_t KEYPAD_init(keypad_str_config_t *ptr_str_keypad_config);
 
@@ -105,7 +155,9 @@ keypad_enu_return_state_t KEYPAD_init(keypad_str_config_t *ptr_str_keypad_config
  *
  * This function reads data from the keypad based on the provided keypad configuration.
  * It scans through the columns and rows of the keypad to detect button presses and
- * returns the corresponding character. If no button is pressed, it returns 'N'.
+ * returns the corresponding character of the first key held down. If no button is pressed,
+ * it returns 'N'. It does not wait for the key to be released, so a held key is returned by
+ * every call; KEYPAD_get_event reports each press once.
  *
  * @param ptr_str_keypad_config Pointer to the keypad configuration structure.
  * @param ptr_u8_data Pointer to the variable where the read data will be stored.
@@ -116,6 +168,45 @@ keypad_enu_return_state_t KEYPAD_init(keypad_str_config_t *ptr_str_keypad_config
  */
 keypad_enu_return_state_t KEYPAD_read(keypad_str_config_t *ptr_str_keypad_config, uint8_t *ptr_u8_data);
 
+/**
+ * @brief Advance the keypad scan by one column.
+ *
+ * Each call reads the rows of the column driven low by the previous call, which had a whole
+ * tick to settle, and drives the next column low. After the last column the scan is debounced
+ * and a key-down or key-up event is posted for every key that changed, any number of keys may
+ * be held at once. To be called periodically, from a scheduler task or the timer tick; it never
+ * waits.
+ *
+ * @note Without diodes in the matrix, three keys on the corners of a rectangle make the fourth
+ * corner read as pressed. Such scans are ambiguous and are dropped, the bitmap keeps its state.
+ * @note Events are dropped while the queue is full.
+ */
+void KEYPAD_vidTick(void);
+
+/**
+ * @brief Take the oldest key event from the queue.
+ *
+ * @param ptr_str_event Receives the event.
+ * @return The state of the operation.
+ *         - KEYPAD_E_OK: An event was taken.
+ *         - KEYPAD_NO_DATA: The queue is empty.
+ *         - KEYPAD_NULL_PTR: ptr_str_event is NULL.
+ *
+ * @note Non-blocking. KEYPAD_vidTick may run in an interrupt while the application takes events.
+ */
+keypad_enu_return_state_t KEYPAD_get_event(keypad_str_event_t *ptr_str_event);
+
+/**
+ * @brief Get the debounced state of every key.
+ *
+ * @param ptr_u16_keys Receives the key bitmap, bit (col * KEYPAD_ROWS_MAX + row) is set while
+ *        that key is held.
+ * @return The state of the operation.
+ *         - KEYPAD_E_OK: Bitmap read successfully.
+ *         - KEYPAD_NULL_PTR: ptr_u16_keys is NULL.
+ */
+keypad_enu_return_state_t KEYPAD_get_keys(uint16_t *ptr_u16_keys);
+
 
 
 #endif /* KEYPAD_H	*/
\ No newline at end of file
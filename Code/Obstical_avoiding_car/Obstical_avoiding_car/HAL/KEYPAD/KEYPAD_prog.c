@@ -23,12 +23,115 @@ static uint8_t keypad[KEYPAD_ROWS_MAX][KEYPAD_COLS_MAX] = {
     {'7', '8', '9'},
     {'*', '0', '#'}
 };
+
+/* Rows of one column in the key bitmap, columns are stored one after the other */
+#define KEYPAD_ROW_MASK             ((uint16_t)((1u << KEYPAD_ROWS_MAX) - 1u))
+#define KEYPAD_KEY_BIT(ROW, COL)    ((uint16_t)(1u << (((COL) * KEYPAD_ROWS_MAX) + (ROW))))
+
+/* Keypad scanned by KEYPAD_vidTick, set by KEYPAD_init */
+static keypad_str_config_t *gs_ptr_str_keypad = NULL;
+
+/* Scan in progress: column driven low and the keys found so far */
+static uint8_t gs_u8_scan_col = U8_ZERO_VALUE;
+static uint16_t gs_u16_scan_keys = 0;
+
+/* Last complete scans, the debounced bitmap follows a key once they all agree on it */
+static uint16_t gs_arr_u16_scans[KEYPAD_DEBOUNCE_SCANS];
+static uint8_t gs_u8_scan_index = U8_ZERO_VALUE;
+static volatile uint16_t gs_v_u16_keys = 0;
+
+/* Event queue: KEYPAD_vidTick is the producer, KEYPAD_get_event the consumer */
+static keypad_str_event_t gs_arr_str_events[KEYPAD_EVENT_QUEUE_SIZE];
+static ring_str_t gs_str_events = RING_INITIALIZER(gs_arr_str_events);
+
+/**
+ * @brief Drive one column of a keypad to the given level.
+ */
+static void KEYPAD_vidDriveCol(keypad_str_config_t *ptr_str_keypad_config, uint8_t u8_col, dio_enu_level_t enu_level)
+{
+	DIO_write_pin(ptr_str_keypad_config->str_col_pins[u8_col].enu_port, ptr_str_keypad_config->str_col_pins[u8_col].enu_pin, enu_level);
+}
+
+/**
+ * @brief Check a scan for ghost keys.
+ *
+ * @return U8_ONE_VALUE if two columns share two or more pressed rows, the pattern three held keys
+ *         on the corners of a rectangle produce, U8_ZERO_VALUE otherwise.
+ */
+static uint8_t KEYPAD_u8IsAmbiguous(uint16_t u16_keys)
+{
+	uint8_t u8_ambiguous = U8_ZERO_VALUE;
+	uint16_t u16_rows;
+
+	for(uint8_t u8_col = U8_ZERO_VALUE; (u8_col < (KEYPAD_COLS_MAX - 1u)) && (u8_ambiguous == U8_ZERO_VALUE); u8_col++){
+		for(uint8_t u8_other = u8_col + 1u; u8_other < KEYPAD_COLS_MAX; u8_other++){
+			u16_rows = (uint16_t)((u16_keys >> (u8_col * KEYPAD_ROWS_MAX)) & (u16_keys >> (u8_other * KEYPAD_ROWS_MAX)) & KEYPAD_ROW_MASK);
+			if((u16_rows & (uint16_t)(u16_rows - 1u)) != 0){
+				u8_ambiguous = U8_ONE_VALUE;
+				break;
+			}
+		}
+	}
+
+	return u8_ambiguous;
+}
+
+/**
+ * @brief Append an event to the queue, the event is dropped when the queue is full.
+ */
+static void KEYPAD_vidPost(uint8_t u8_row, uint8_t u8_col, keypad_enu_event_t enu_event)
+{
+	keypad_str_event_t str_event;
+
+	str_event.u8_key = keypad[u8_row][u8_col];
+	str_event.u8_row = u8_row;
+	str_event.u8_col = u8_col;
+	str_event.enu_event = enu_event;
+	(void) RING_enuPush(&gs_str_events, &str_event);   // RING_FULL: the event is lost
+}
+
+/**
+ * @brief Debounce a complete scan and post an event for every key that changed.
+ */
+static void KEYPAD_vidScanDone(uint16_t u16_scan)
+{
+	uint16_t u16_all = 0xFFFFu;
+	uint16_t u16_any = 0;
+	uint16_t u16_keys;
+	uint16_t u16_changed;
+
+	if(KEYPAD_u8IsAmbiguous(u16_scan) == U8_ZERO_VALUE){
+		gs_arr_u16_scans[gs_u8_scan_index] = u16_scan;
+		gs_u8_scan_index = (gs_u8_scan_index + 1u < KEYPAD_DEBOUNCE_SCANS) ? (gs_u8_scan_index + 1u) : U8_ZERO_VALUE;
+
+		for(uint8_t u8_index = U8_ZERO_VALUE; u8_index < KEYPAD_DEBOUNCE_SCANS; u8_index++){
+			u16_all &= gs_arr_u16_scans[u8_index];
+			u16_any |= gs_arr_u16_scans[u8_index];
+		}
+
+		// Pressed in every scan sets a key, released in every scan clears it, otherwise it keeps its state
+		u16_keys = (uint16_t)((gs_v_u16_keys | u16_all) & u16_any);
+		u16_changed = u16_keys ^ gs_v_u16_keys;
+		gs_v_u16_keys = u16_keys;
+
+		for(uint8_t u8_col = U8_ZERO_VALUE; (u8_col < KEYPAD_COLS_MAX) && (u16_changed != 0); u8_col++){
+			for(uint8_t u8_row = U8_ZERO_VALUE; u8_row < KEYPAD_ROWS_MAX; u8_row++){
+				if((u16_changed & KEYPAD_KEY_BIT(u8_row, u8_col)) != 0){
+					KEYPAD_vidPost(u8_row, u8_col, ((u16_keys & KEYPAD_KEY_BIT(u8_row, u8_col)) != 0) ? KEYPAD_EVENT_KEY_DOWN : KEYPAD_EVENT_KEY_UP);
+				}
+			}
+		}
+	}else{
+		/* Ghost pattern, the scan does not tell which keys are held */
+	}
+}
 	
 /**
  * @brief Initialize a keypad based on the provided configuration.
  *
  * This function initializes a keypad based on the provided keypad configuration. It configures
- * the specified row and column pins of the keypad and sets them to appropriate initial states.
+ * the specified row and column pins of the keypad and sets them to appropriate initial states,
+ * and makes it the keypad KEYPAD_vidTick scans.
  *
  * @param ptr_str_keypad_config Pointer to the keypad configuration structure.
  * @return The initialization state of the keypad.
@@ -56,6 +159,17 @@ keypad_enu_return_state_t KEYPAD_init(keypad_str_config_t *ptr_str_keypad_config
 			DIO_init(ptr_str_keypad_config->str_col_pins[u8_counter].enu_port, ptr_str_keypad_config->str_col_pins[u8_counter].enu_pin, DIO_PIN_OUTPUT);
 			DIO_write_pin(ptr_str_keypad_config->str_col_pins[u8_counter].enu_port, ptr_str_keypad_config->str_col_pins[u8_counter].enu_pin, DIO_PIN_HIGH_LEVEL);
 		}
+
+		/* Start the scan with no key held, the first column settles until the next tick */
+		gs_u8_scan_col = U8_ZERO_VALUE;
+		gs_u16_scan_keys = 0;
+		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < KEYPAD_DEBOUNCE_SCANS; u8_counter++){
+			gs_arr_u16_scans[u8_counter] = 0;
+		}
+		gs_u8_scan_index = U8_ZERO_VALUE;
+		gs_v_u16_keys = 0;
+		KEYPAD_vidDriveCol(ptr_str_keypad_config, gs_u8_scan_col, DIO_PIN_LOW_LEVEL);
+		gs_ptr_str_keypad = ptr_str_keypad_config;
 	}
 	return enu_return_state;
 }
@@ -67,7 +181,8 @@ keypad_enu_return_state_t KEYPAD_init(keypad_str_config_t *ptr_str_keypad_config
  *
  * This function reads data from the keypad based on the provided keypad configuration.
  * It scans through the columns and rows of the keypad to detect button presses and
- * returns the corresponding character. If no button is pressed, it returns 'N'.
+ * returns the corresponding character of the first key held down. If no button is pressed,
+ * it returns 'N'. It does not wait for the key to be released.
  *
  * @param ptr_str_keypad_config Pointer to the keypad configuration structure.
  * @param ptr_u8_data Pointer to the variable where the read data will be stored.
@@ -102,10 +217,6 @@ keypad_enu_return_state_t KEYPAD_read (keypad_str_config_t *ptr_str_keypad_confi
 				DIO_read_pin(ptr_str_keypad_config->str_row_pins[u8_row_counter].enu_port, ptr_str_keypad_config->str_row_pins[u8_row_counter].enu_pin, &enu_pin_level);
 				if(enu_pin_level == DIO_PIN_LOW_LEVEL)
 				{
-					while(enu_pin_level == DIO_PIN_LOW_LEVEL)
-					{
-						DIO_read_pin(ptr_str_keypad_config->str_row_pins[u8_row_counter].enu_port, ptr_str_keypad_config->str_row_pins[u8_row_counter].enu_pin, &enu_pin_level);
-					}
 					*ptr_u8_data = keypad[u8_row_counter][u8_col_counter];
 					u8_catched_data_flag = U8_ONE_VALUE;
 					break;
@@ -115,6 +226,11 @@ keypad_enu_return_state_t KEYPAD_read (keypad_str_config_t *ptr_str_keypad_confi
 			DIO_write_pin(ptr_str_keypad_config->str_col_pins[u8_col_counter].enu_port, ptr_str_keypad_config->str_col_pins[u8_col_counter].enu_pin, DIO_PIN_HIGH_LEVEL);
 		}
 		
+		if(ptr_str_keypad_config == gs_ptr_str_keypad)
+		{
+			/* Give the column of the scan in progress back to KEYPAD_vidTick */
+			KEYPAD_vidDriveCol(ptr_str_keypad_config, gs_u8_scan_col, DIO_PIN_LOW_LEVEL);
+		}
 	}
 	
 	if(u8_catched_data_flag != U8_ONE_VALUE)
@@ -127,4 +243,87 @@ keypad_enu_return_state_t KEYPAD_read (keypad_str_config_t *ptr_str_keypad_confi
 		
 	}
 	return enu_return_state;
-}
\ No newline at end of file
+}
+
+
+
+/**
+ * @brief Advance the keypad scan by one column.
+ *
+ * Reads the rows of the column driven low by the previous call, releases it and drives the next
+ * one, so each call costs KEYPAD_ROWS_MAX pin reads and two pin writes. The last column of a
+ * scan also debounces it and posts the key events.
+ */
+void KEYPAD_vidTick(void)
+{
+	keypad_str_config_t *ptr_str_keypad_config = gs_ptr_str_keypad;
+	dio_enu_level_t enu_pin_level;
+
+	if(ptr_str_keypad_config != NULL){
+		for(uint8_t u8_row = U8_ZERO_VALUE; u8_row < KEYPAD_ROWS_MAX; u8_row++){
+			DIO_read_pin(ptr_str_keypad_config->str_row_pins[u8_row].enu_port, ptr_str_keypad_config->str_row_pins[u8_row].enu_pin, &enu_pin_level);
+			if(enu_pin_level == DIO_PIN_LOW_LEVEL){
+				gs_u16_scan_keys |= KEYPAD_KEY_BIT(u8_row, gs_u8_scan_col);
+			}
+		}
+		KEYPAD_vidDriveCol(ptr_str_keypad_config, gs_u8_scan_col, DIO_PIN_HIGH_LEVEL);
+
+		gs_u8_scan_col++;
+		if(gs_u8_scan_col == KEYPAD_COLS_MAX){
+			KEYPAD_vidScanDone(gs_u16_scan_keys);
+			gs_u16_scan_keys = 0;
+			gs_u8_scan_col = U8_ZERO_VALUE;
+		}
+		KEYPAD_vidDriveCol(ptr_str_keypad_config, gs_u8_scan_col, DIO_PIN_LOW_LEVEL);
+	}
+}
+
+
+
+/**
+ * @brief Take the oldest key event from the queue.
+ *
+ * @param ptr_str_event Receives the event.
+ * @return The state of the operation.
+ *         - KEYPAD_E_OK: An event was taken.
+ *         - KEYPAD_NO_DATA: The queue is empty.
+ *         - KEYPAD_NULL_PTR: ptr_str_event is NULL.
+ */
+keypad_enu_return_state_t KEYPAD_get_event(keypad_str_event_t *ptr_str_event)
+{
+	keypad_enu_return_state_t enu_return_state = KEYPAD_E_OK;
+
+	if(ptr_str_event == NULL){
+		enu_return_state = KEYPAD_NULL_PTR;
+	}else if(RING_enuPop(&gs_str_events, ptr_str_event) != RING_OK){
+		enu_return_state = KEYPAD_NO_DATA;
+	}else{
+		/* Event taken */
+	}
+
+	return enu_return_state;
+}
+
+
+
+/**
+ * @brief Get the debounced state of every key.
+ *
+ * @param ptr_u16_keys Receives the key bitmap, bit (col * KEYPAD_ROWS_MAX + row) is set while
+ *        that key is held.
+ * @return The state of the operation.
+ *         - KEYPAD_E_OK: Bitmap read successfully.
+ *         - KEYPAD_NULL_PTR: ptr_u16_keys is NULL.
+ */
+keypad_enu_return_state_t KEYPAD_get_keys(uint16_t *ptr_u16_keys)
+{
+	keypad_enu_return_state_t enu_return_state = KEYPAD_E_OK;
+
+	if(ptr_u16_keys == NULL){
+		enu_return_state = KEYPAD_NULL_PTR;
+	}else{
+		*ptr_u16_keys = gs_v_u16_keys;
+	}
+
+	return enu_return_state;
+}
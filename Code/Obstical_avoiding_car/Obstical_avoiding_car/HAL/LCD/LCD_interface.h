@@ -11,6 +11,8 @@
 #include "LCD_cmd.h"
 #include "../../MCAL/DIO/DIO_interface.h"
 #include "../../STD_LIB/bit_math.h"
+#include "../TIMING/TIMING_interface.h"
+#include "../../MCAL/AVR_ARCH/PGM_interface.h"
 
 /**
  * @brief Index of the most significant bit (MSB) in a byte (7 for an 8-bit byte).
@@ -32,6 +34,72 @@
  */
 #define LCD_MAX_DATA_PINS_MOD_8         8
 
+/**
+ * @brief Number of rows of the display (and of the frame buffer).
+ */
+#define LCD_ROWS                        2
+
+/**
+ * @brief Number of columns of the display (and of the frame buffer).
+ */
+#define LCD_COLS                        16
+
+/**
+ * @brief Who calls LCD_vidFlushTick.
+ *
+ * 1: LCD_init subscribes it to the timing_init tick, it then runs in the timer interrupt.
+ * 0: the application calls it about once per millisecond, from a scheduler task for instance.
+ */
+#define LCD_FLUSH_ON_TICK               0
+
+/**
+ * @brief How the driver waits for the LCD controller between two bytes.
+ *
+ * 1: the busy flag is read back over D7 (RW must be wired). Blocking calls send each byte as
+ *    soon as the controller is ready, about 40 us after the previous one, the flusher sends one
+ *    whole byte per call if the controller is ready.
+ * 0: fixed waits, about 3 ms per transfer in blocking calls and one transfer per flusher call.
+ *
+ * The initialization sequence always uses the fixed waits, the busy flag is only valid once the
+ * interface length is set.
+ */
+#define LCD_BUSY_FLAG_POLLING           1
+
+/**
+ * @brief Busy flag reads before the driver gives up waiting and writes anyway.
+ *
+ * One read takes a few microseconds at 16 MHz, the bound covers the 1.52 ms of the clear and
+ * home commands with margin, so it only expires when the controller does not answer.
+ */
+#define LCD_BUSY_TIMEOUT_POLLS          400u
+
+/**
+ * @brief Character a cleared cell holds.
+ */
+#define LCD_BLANK_CHAR                  ' '
+
+/**
+ * @brief Bytes of one CGRAM character pattern, one per dot row of a 5x8 character.
+ */
+#define LCD_CGRAM_CHAR_BYTES            8
+
+/**
+ * @brief Number of user-defined characters the CGRAM holds.
+ */
+#define LCD_CGRAM_CHARS                 8
+
+/**
+ * @brief Character a field shows in every cell when its value has more digits than the field is wide.
+ */
+#define LCD_FIELD_OVERFLOW_CHAR         '*'
+
+/**
+ * @brief Value of the tracked address counter when the flusher does not know where the LCD points.
+ *
+ * Any valid "set DDRAM address" command has bit 7 set, so 0 never matches one.
+ */
+#define LCD_ADDRESS_UNKNOWN             0x00
+
 
 /**
  * @brief Pre-defined value representing the bell character in the user-defined special characters.
@@ -114,6 +182,28 @@ typedef enum{
 	LCD_NULL_PTR    /**< Null pointer provided as argument */
 }lcd_enu_return_state_t;
 
+/**
+ * @brief Steps of the background flusher, one bus transfer per tick.
+ */
+typedef enum{
+	LCD_FLUSH_IDLE = 0,     /**< Between two bytes, the next tick looks for a changed cell */
+	LCD_FLUSH_LOW_NIBBLE    /**< The high nibble was sent, the next tick (or a pause of the flusher) sends the low nibble */
+}lcd_enu_flush_step_t;
+
+/**
+ * @brief A fixed place on the display that shows a number, see LCD_writeField.
+ *
+ * Define it once, usually as a const, and paint its labels around it once. Updating the value
+ * rewrites the field's cells only.
+ */
+typedef struct
+{
+	lcd_enu_row_select_t enu_row;   /**< Row of the field */
+	lcd_enu_col_select_t enu_col;   /**< Leftmost column of the field */
+	uint8_t u8_width;               /**< Number of cells, the value is right-aligned in them */
+	uint8_t u8_pad_char;            /**< Fills the cells left of the value, LCD_BLANK_CHAR or '0' for instance */
+}lcd_str_field_t;
+
 /**
  * @brief Type definition for user-defined special character types for the LCD.
  */
@@ -130,21 +220,23 @@ typedef uint8_t u8_en_lcdSpCharType;
  *
  * This function initializes the LCD module based on the provided LCD configuration. It sets up the required
  * control and data pins and sends the necessary initialization commands to configure the LCD display.
+ * It then blanks the frame buffer and, with LCD_FLUSH_ON_TICK, subscribes LCD_vidFlushTick to the timing_init tick.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
  * @return The initialization state of the LCD.
  *         - LCD_E_OK: LCD initialized successfully.
- *         - LCD_E_NOT_OK: LCD initialization failed due to an unsupported mode.
+ *         - LCD_E_NOT_OK: LCD initialization failed due to an unsupported mode or no free tick callback.
  *
  * @note The LCD configuration structure contains pin information for control pins (RS, RW, E) and data pins,
- * as well as the LCD mode (4-bit or 8-bit).
+ * as well as the LCD mode (4-bit or 8-bit). The configuration must stay valid after the call,
+ * the flusher keeps using it.
  */
 lcd_enu_return_state_t LCD_init (lcd_str_config_t *ptr_str_config);
 
 /**
  * @brief Send a command to the LCD display.
  *
- * This function sends a command to the LCD display. It takes a command value as input and
+ * This function sends a command to the LCD display right away. It takes a command value as input and
  * transmits the command using appropriate control signals and data pins according to the
  * LCD's mode (4-bit or 8-bit).
  *
@@ -152,26 +244,25 @@ lcd_enu_return_state_t LCD_init (lcd_str_config_t *ptr_str_config);
  * @param cmd The command to be sent to the LCD.
  * @return The state of the command transmission operation.
  *         - LCD_E_OK: Command transmitted successfully.
+ *         - LCD_E_NOT_OK: Unsupported LCD mode.
  *
- * @note This function handles the transmission of the command to the LCD display.
- * It uses control signals like 'E', 'RS', and 'RW' to manage the data transmission.
- * Depending on the LCD's mode, it uses the appropriate number of data pins to transmit the command.
+ * @note This call is blocking. It waits for the flusher to finish the byte it is sending, then holds it
+ * while the command is transmitted. It must not be called with interrupts disabled while the flusher runs.
+ * With LCD_BUSY_FLAG_POLLING it returns once the command is latched, the next transfer waits for the busy flag.
  */
 lcd_enu_return_state_t LCD_cmd(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_cmd);
 
 /**
  * @brief Display a character on the LCD.
  *
- * This function displays a character on the LCD screen. It takes a character value as input and
- * transmits the character's ASCII code to the LCD using appropriate control signals and data pins
- * based on the LCD's mode (4-bit or 8-bit).
+ * This function writes a character into the frame buffer at the cursor position and moves the
+ * cursor one column to the right. The character reaches the display on the following ticks.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
- * @param cmd The character to be displayed on the LCD.
+ * @param copy_u8_data The character to be displayed on the LCD.
  *
- * @note This function sends the character data to the LCD display to show it on the screen.
- * It uses control signals 'E', 'RS', and 'RW' to manage the data transmission. Depending on
- * the LCD's mode, it uses the appropriate number of data pins to transmit the character's ASCII code.
+ * @note Characters written past the last column are dropped, they would land in the hidden
+ * part of the LCD's line memory anyway.
  */
 void LCD_char(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data);
 
@@ -179,35 +270,27 @@ void LCD_char(lcd_str_config_t *ptr_str_config, uint8_t copy_u8_data);
 /**
  * @brief Clear the LCD display.
  *
- * This function sends the command to clear the LCD display, which removes any content displayed
- * on the screen and resets the cursor position to the beginning of the first line.
+ * This function fills the frame buffer with blanks and moves the cursor to the beginning of the first line.
+ * Only the cells that were not blank already are rewritten on the display.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
  * @return The state of the LCD clear operation.
  *         - LCD_E_OK: LCD cleared successfully.
- *         - LCD_E_NOT_OK: LCD clear operation failed.
- *
- * @note This function sends the clear command and then introduces a delay of approximately 3 milliseconds
- * to ensure the clear operation completes before returning.
  */
 lcd_enu_return_state_t LCD_clear (lcd_str_config_t* ptr_str_config);
 
 /**
  * @brief Set the cursor position on the LCD display.
  *
- * This function sets the position of the cursor on the LCD display based on the specified row
- * and column indices. It calculates the appropriate DDRAM address based on the selected row
- * and column, and sends the command to position the cursor at that address.
+ * This function sets the position at which the next characters are written into the frame buffer.
+ * No command is sent, the flusher addresses the LCD itself when it writes a changed cell.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
  * @param copy_enu_row The row on the LCD where the cursor should be positioned.
  * @param copy_enu_col The column on the LCD where the cursor should be positioned.
  * @return The state of the cursor position setting operation.
  *         - LCD_E_OK: Cursor position set successfully.
- *         - LCD_E_NOT_OK: Cursor position setting operation failed due to an invalid row selection.
- *
- * @note The function calculates the appropriate DDRAM address for the specified row and column indices,
- * and sends the command to set the cursor position to that address on the LCD.
+ *         - LCD_E_NOT_OK: Cursor position setting operation failed due to an invalid row or column selection.
  */
 lcd_enu_return_state_t LCD_setCursor (lcd_str_config_t *ptr_str_config, lcd_enu_row_select_t copy_enu_row, lcd_enu_col_select_t copy_enu_col);
 
@@ -215,22 +298,66 @@ lcd_enu_return_state_t LCD_setCursor (lcd_str_config_t *ptr_str_config, lcd_enu_
 /**
  * @brief Write a null-terminated string to the LCD display.
  *
- * This function writes a null-terminated string of characters to the LCD display.
- * It iterates through each character in the input string and sends individual characters
- * to the LCD using the LCD_char function. The function continues writing characters
- * until the null-terminator is encountered.
+ * This function writes a null-terminated string of characters into the frame buffer, starting at the cursor
+ * position, using the LCD_char function. It returns immediately: the background flusher sends the cells
+ * that differ from what the display already shows, so rewriting the same text costs no bus transfer.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
  * @param ptr_u8_data Pointer to the null-terminated string to be written.
  * @return The state of the string writing operation.
  *         - LCD_E_OK: String written successfully.
  *         - LCD_NULL_PTR: The input string pointer is NULL.
- *
- * @note The function iterates through the input string and sends each character to the LCD using
- * the LCD_char function until the null-terminator ('\0') is encountered.
  */
 lcd_enu_return_state_t LCD_writeString (lcd_str_config_t *ptr_str_config, uint8_t *ptr_u8_data);
 
+/**
+ * @brief Write a null-terminated string kept in program memory to the LCD display.
+ *
+ * Same as LCD_writeString for a string defined with PROGMEM: the characters are read from flash
+ * one by one into the frame buffer, the string never occupies SRAM.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param ptr_u8_data Program memory address of the null-terminated string to be written.
+ * @return The state of the string writing operation.
+ *         - LCD_E_OK: String written successfully.
+ *         - LCD_NULL_PTR: The input string pointer is NULL.
+ */
+lcd_enu_return_state_t LCD_writeString_P (lcd_str_config_t *ptr_str_config, const uint8_t *ptr_u8_data);
+
+/**
+ * @brief Load a user-defined character pattern kept in program memory into the CGRAM.
+ *
+ * The LCD_CGRAM_CHAR_BYTES rows of the pattern are streamed from flash to the LCD right away
+ * (blocking, see LCD_cmd). Writing the character code copy_u8_index then shows the pattern.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param copy_u8_index Character code of the pattern, 0 .. LCD_CGRAM_CHARS - 1.
+ * @param ptr_u8_pattern Program memory address of the LCD_CGRAM_CHAR_BYTES pattern rows.
+ * @return The state of the operation.
+ *         - LCD_E_OK: Pattern written successfully.
+ *         - LCD_E_NOT_OK: Invalid character code or unsupported LCD mode.
+ *         - LCD_NULL_PTR: The pattern pointer is NULL.
+ */
+lcd_enu_return_state_t LCD_writeCustomChar_P (lcd_str_config_t *ptr_str_config, uint8_t copy_u8_index, const uint8_t *ptr_u8_pattern);
+
+/**
+ * @brief Show a number in a field.
+ *
+ * The value is converted to decimal without any division and written right-aligned into the
+ * field's cells of the frame buffer, the cells on its left get the field's padding character.
+ * The cursor does not move, and only the cells whose character changes reach the display.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param ptr_str_field Pointer to the field.
+ * @param copy_u16_value The value to show.
+ * @return The state of the field update.
+ *         - LCD_E_OK: Value written.
+ *         - LCD_E_NOT_OK: The field does not fit on the display, or the value has more digits than
+ *           the field is wide (the field is then filled with LCD_FIELD_OVERFLOW_CHAR).
+ *         - LCD_NULL_PTR: The field pointer is NULL.
+ */
+lcd_enu_return_state_t LCD_writeField (lcd_str_config_t *ptr_str_config, const lcd_str_field_t *ptr_str_field, uint16_t copy_u16_value);
+
 /**
 * @brief Write a custom special character to the LCD display.
 *
@@ -250,5 +377,20 @@ lcd_enu_return_state_t LCD_writeString (lcd_str_config_t *ptr_str_config, uint8_
 */
 lcd_enu_return_state_t LCD_writeSpChar (lcd_str_config_t *ptr_str_config, u8_en_lcdSpCharType copy_u8_SpChar);
 
+/**
+ * @brief Background flusher of the frame buffer, one bus transfer per call.
+ *
+ * LCD_init subscribes this function to the timing_init tick, or the application calls it about
+ * once per millisecond when LCD_FLUSH_ON_TICK is 0. On each call it sends one nibble
+ * (one byte in 8-bit mode) of the next cell whose frame buffer content differs from what the
+ * display shows, preceded by a "set DDRAM address" command when the LCD's address counter
+ * does not already point at that cell. Consecutive changed cells are streamed without
+ * re-addressing. Nothing is sent when the display is up to date.
+ *
+ * With LCD_BUSY_FLAG_POLLING a call sends one whole byte instead. It reads the busy flag once
+ * first and sends nothing while the controller is busy, the next call tries again.
+ */
+void LCD_vidFlushTick(void);
+
 
 #endif /* LCD_INTERFACE_H	*/
\ No newline at end of file
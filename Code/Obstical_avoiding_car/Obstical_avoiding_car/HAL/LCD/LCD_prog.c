@@ -8,20 +8,60 @@
 
 
 #include "LCD_interface.h"
+#include "../../MCAL/AVR_ARCH/CPU_interface.h"
+
+
+/* Double dabble conversion of a 16-bit value into five BCD digits */
+#define LCD_BCD_INPUT_BITS          16u
+#define LCD_BCD_DIGITS              5u
+#define LCD_BCD_DIGIT_BITS          4u
+#define LCD_BCD_DIGIT_MASK          0x0Fu
+#define LCD_BCD_ADJUST_LIMIT        5u
+#define LCD_BCD_ADJUST              3u
+
+/* Pattern of LCD_BELL, in flash */
+static const uint8_t gs_arr_u8_bell_pattern[LCD_CGRAM_CHAR_BYTES] PROGMEM = {0x04, 0x0E, 0x0E, 0x0E, 0x1F, 0x00, 0x04, 0x00};
+
+/* Configuration used by the flusher, recorded by LCD_init */
+static lcd_str_config_t *gs_ptr_str_config = NULL;
+
+/* Frame buffer: what the application wants on the display */
+static volatile uint8_t gs_arr_u8_frame[LCD_ROWS][LCD_COLS];
+
+/* What the display currently shows */
+static volatile uint8_t gs_arr_u8_shown[LCD_ROWS][LCD_COLS];
+
+/* Cursor of the frame buffer */
+static uint8_t gs_u8_cursor_row = U8_ZERO_VALUE;
+static uint8_t gs_u8_cursor_col = U8_ZERO_VALUE;
+
+/* "Set DDRAM address" command matching the LCD's address counter, or LCD_ADDRESS_UNKNOWN */
+static volatile uint8_t gs_u8_lcd_address = LCD_ADDRESS_UNKNOWN;
+
+/* Flusher state */
+static volatile lcd_enu_flush_step_t gs_enu_flush_step = LCD_FLUSH_IDLE;
+static volatile uint8_t gs_u8_flush_pause = U8_ZERO_VALUE;
+static uint8_t gs_u8_flush_byte;
+static dio_enu_level_t gs_enu_flush_rs;
+static uint8_t gs_u8_flush_row = U8_ZERO_VALUE;
+static uint8_t gs_u8_flush_col = U8_ZERO_VALUE;
+
+#if LCD_BUSY_FLAG_POLLING
+/* Set once the initialization sequence is done, the busy flag is meaningless before */
+static uint8_t gs_u8_busy_flag_valid = U8_ZERO_VALUE;
+#endif
 
 
 /**
  * @brief Enable the LCD for data/command transmission.
  *
  * This function is responsible for generating the enabling pulse for the LCD's data/command transmission.
- * It sets the 'E' (Enable) signal to a high level for a brief moment, followed by setting it back to a low level.
+ * It sets the 'E' (Enable) signal to a high level, followed by setting it back to a low level.
  * This pulse triggers the LCD to read the data or command being sent to it.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
  *
- * @note This function is a part of the mechanism to enable the LCD for data or command transmission.
- * It generates the necessary pulse on the 'E' signal to initiate the read or write operation.
- * A short delay is included after setting 'E' high and before setting it low again to ensure proper timing.
+ * @note The LCD needs a pulse of at least 450 ns, which two pin writes already exceed.
  */
 static void ENABLE(lcd_str_config_t* ptr_str_config);
 
@@ -37,77 +77,183 @@ static void ENABLE(lcd_str_config_t* ptr_str_config);
  */
 static void delay_3_ms(void);
 
+/**
+ * @brief Put one transfer on the LCD bus and latch it.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param copy_enu_rs Level of RS: low for a command, high for data.
+ * @param copy_u8_byte The byte to transfer.
+ * @param copy_u8_msb_index Index of the first bit to put on the data pins: 7 for the high nibble or
+ *                          the whole byte, 3 for the low nibble.
+ */
+static void lcd_vidBusWrite(lcd_str_config_t *ptr_str_config, dio_enu_level_t copy_enu_rs, uint8_t copy_u8_byte, uint8_t copy_u8_msb_index);
+
+/**
+ * @brief Transfer a whole byte, waiting after each part.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param copy_enu_rs Level of RS: low for a command, high for data.
+ * @param copy_u8_byte The byte to transfer.
+ * @return LCD_E_OK, or LCD_E_NOT_OK for an unsupported mode.
+ */
+static lcd_enu_return_state_t lcd_enuSendBlocking(lcd_str_config_t *ptr_str_config, dio_enu_level_t copy_enu_rs, uint8_t copy_u8_byte);
+
+#if LCD_BUSY_FLAG_POLLING
+/**
+ * @brief Wait until the LCD controller is ready for the next byte.
+ *
+ * Turns the data pins around once, reads the busy flag on D7 with RW high until it clears or
+ * copy_u16_polls reads were made, then drives the bus again. In 4-bit mode every read takes two
+ * E pulses, the second one carries the low half of the address counter and is discarded.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param copy_u16_polls Busy flag reads before giving up, 1 to only check it.
+ * @return LCD_E_OK once the controller is ready, LCD_E_NOT_OK if it was still busy after the last read.
+ *
+ * @note D7 is valid at most 360 ns after E rises, the pin read that follows the E write comes later.
+ */
+static lcd_enu_return_state_t lcd_enuWaitReady(lcd_str_config_t *ptr_str_config, uint16_t copy_u16_polls);
+#endif
+
+/**
+ * @brief Select the next transfer of the flusher.
+ *
+ * Looks for a changed cell, starting where the last byte went, and records the "set DDRAM
+ * address" command or the character to send for it.
+ *
+ * @return U8_ONE_VALUE if there is something to send, U8_ZERO_VALUE if the display is up to date.
+ */
+static uint8_t lcd_u8FlushPick(void);
+
+/**
+ * @brief Account for a byte the flusher has completely sent.
+ */
+static void lcd_vidFlushDone(void);
+
+/**
+ * @brief Convert a binary value to packed BCD with the double dabble (shift and add 3) algorithm.
+ *
+ * @param copy_u16_value The value to convert.
+ * @return Five BCD digits, the units in bits 0..3.
+ */
+static uint32_t lcd_u32ToBcd(uint16_t copy_u16_value);
+
+/**
+ * @brief Hold the flusher at a byte boundary so the bus can be used directly.
+ *
+ * The flusher does nothing while paused, a byte it left between its two nibbles is finished here.
+ */
+static void lcd_vidFlushPause(void);
+
+/**
+ * @brief Let the flusher run again.
+ */
+static void lcd_vidFlushResume(void);
+
 
 /**
  * @brief Initialize the LCD module based on the provided configuration.
  *
  * This function initializes the LCD module based on the provided LCD configuration. It sets up the required
  * control and data pins and sends the necessary initialization commands to configure the LCD display.
+ * It then blanks the frame buffer and, with LCD_FLUSH_ON_TICK, subscribes LCD_vidFlushTick to the timing_init tick.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
  * @return The initialization state of the LCD.
  *         - LCD_E_OK: LCD initialized successfully.
- *         - LCD_E_NOT_OK: LCD initialization failed due to an unsupported mode.
+ *         - LCD_E_NOT_OK: LCD initialization failed due to an unsupported mode or no free tick callback.
  *
  * @note The LCD configuration structure contains pin information for control pins (RS, RW, E) and data pins,
- * as well as the LCD mode (4-bit or 8-bit).
+ * as well as the LCD mode (4-bit or 8-bit). The configuration must stay valid after the call,
+ * the flusher keeps using it.
  */
 lcd_enu_return_state_t LCD_init(lcd_str_config_t* ptr_str_config)
 {
 	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
-	
+
+	lcd_vidFlushPause();
+	gs_ptr_str_config = ptr_str_config;
+#if LCD_BUSY_FLAG_POLLING
+	gs_u8_busy_flag_valid = U8_ZERO_VALUE;
+#endif
+
 	enu_return_state |=DIO_init(ptr_str_config->str_RSpin.enu_port, ptr_str_config->str_RSpin.enu_pin, DIO_PIN_OUTPUT);
 	enu_return_state |=DIO_init(ptr_str_config->str_RWpin.enu_port, ptr_str_config->str_RWpin.enu_pin, DIO_PIN_OUTPUT);
 	enu_return_state |=DIO_init(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_OUTPUT);
-	
+
 	if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
 	{
-		
-		
+
+
 		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < LCD_MAX_DATA_PINS_MOD_4; u8_counter++){
 			enu_return_state |=DIO_init(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin, DIO_PIN_OUTPUT);
 		}
-		LCD_cmd(ptr_str_config, LCD_CMD_CURSOR_HOME);
-		LCD_cmd(ptr_str_config, LCD_4BITS_2LINES_58DM);
-		LCD_cmd(ptr_str_config, LCD_DISPLAY_ON_CUR_OFF_BLOCK_OFF);
-		LCD_cmd(ptr_str_config, LCD_CMD_ENTRY_MODE_INCREMENT_ON_SHIFT_OFF);
-		LCD_cmd(ptr_str_config, LCD_CMD_CLEAR);						
-								
+		lcd_enuSendBlocking(ptr_str_config, DIO_PIN_LOW_LEVEL, LCD_CMD_CURSOR_HOME);
+		lcd_enuSendBlocking(ptr_str_config, DIO_PIN_LOW_LEVEL, LCD_4BITS_2LINES_58DM);
+		lcd_enuSendBlocking(ptr_str_config, DIO_PIN_LOW_LEVEL, LCD_DISPLAY_ON_CUR_OFF_BLOCK_OFF);
+		lcd_enuSendBlocking(ptr_str_config, DIO_PIN_LOW_LEVEL, LCD_CMD_ENTRY_MODE_INCREMENT_ON_SHIFT_OFF);
+		lcd_enuSendBlocking(ptr_str_config, DIO_PIN_LOW_LEVEL, LCD_CMD_CLEAR);
+
 	}else if(ptr_str_config->enu_mode == LCD_8_BIT_MODE){
 		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < LCD_MAX_DATA_PINS_MOD_8; u8_counter++){
 			enu_return_state |=DIO_init(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin, DIO_PIN_OUTPUT);
 		}
-		LCD_cmd(ptr_str_config, LCD_8BITS_2LINES_58DM);
-		LCD_cmd(ptr_str_config, LCD_DISPLAY_ON_CUR_OFF_BLOCK_OFF);
-		LCD_cmd(ptr_str_config, LCD_CMD_ENTRY_MODE_INCREMENT_ON_SHIFT_OFF);
-		LCD_cmd(ptr_str_config, LCD_CMD_CLEAR);
-							
+		lcd_enuSendBlocking(ptr_str_config, DIO_PIN_LOW_LEVEL, LCD_8BITS_2LINES_58DM);
+		lcd_enuSendBlocking(ptr_str_config, DIO_PIN_LOW_LEVEL, LCD_DISPLAY_ON_CUR_OFF_BLOCK_OFF);
+		lcd_enuSendBlocking(ptr_str_config, DIO_PIN_LOW_LEVEL, LCD_CMD_ENTRY_MODE_INCREMENT_ON_SHIFT_OFF);
+		lcd_enuSendBlocking(ptr_str_config, DIO_PIN_LOW_LEVEL, LCD_CMD_CLEAR);
+
 	}else{
-		enu_return_state=LCD_E_NOT_OK;						
+		enu_return_state=LCD_E_NOT_OK;
+	}
+
+	/* The clear command blanked the display and moved its address counter home */
+	for(uint8_t u8_row = U8_ZERO_VALUE; u8_row < LCD_ROWS; u8_row++){
+		for(uint8_t u8_col = U8_ZERO_VALUE; u8_col < LCD_COLS; u8_col++){
+			gs_arr_u8_frame[u8_row][u8_col] = LCD_BLANK_CHAR;
+			gs_arr_u8_shown[u8_row][u8_col] = LCD_BLANK_CHAR;
+		}
 	}
+	gs_u8_lcd_address = LCD_DDRAM_START_ADD_LINE_1;
+	gs_u8_cursor_row = U8_ZERO_VALUE;
+	gs_u8_cursor_col = U8_ZERO_VALUE;
+#if LCD_BUSY_FLAG_POLLING
+	if(enu_return_state == LCD_E_OK){
+		gs_u8_busy_flag_valid = U8_ONE_VALUE;
+	}
+#endif
+	lcd_vidFlushResume();
+
+#if LCD_FLUSH_ON_TICK
+	if(timing_add_tick_callback(LCD_vidFlushTick) != TIMING_OK){
+		enu_return_state = LCD_E_NOT_OK;
+	}
+#endif
 	return enu_return_state;
 }
 
 /**
  * @brief Clear the LCD display.
  *
- * This function sends the command to clear the LCD display, which removes any content displayed
- * on the screen and resets the cursor position to the beginning of the first line.
+ * This function fills the frame buffer with blanks and moves the cursor to the beginning of the first line.
+ * Only the cells that were not blank already are rewritten on the display.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
  * @return The state of the LCD clear operation.
  *         - LCD_E_OK: LCD cleared successfully.
- *         - LCD_E_NOT_OK: LCD clear operation failed.
- *
- * @note This function sends the clear command and then introduces a delay of approximately 3 milliseconds
- * to ensure the clear operation completes before returning.
  */
 lcd_enu_return_state_t LCD_clear (lcd_str_config_t* ptr_str_config)
 {
 
 	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
-	enu_return_state |= LCD_cmd(ptr_str_config,LCD_CMD_CLEAR);
-	delay_3_ms();
+	(void)ptr_str_config;
+	for(uint8_t u8_row = U8_ZERO_VALUE; u8_row < LCD_ROWS; u8_row++){
+		for(uint8_t u8_col = U8_ZERO_VALUE; u8_col < LCD_COLS; u8_col++){
+			gs_arr_u8_frame[u8_row][u8_col] = LCD_BLANK_CHAR;
+		}
+	}
+	gs_u8_cursor_row = U8_ZERO_VALUE;
+	gs_u8_cursor_col = U8_ZERO_VALUE;
 	return enu_return_state;
 
 }
@@ -116,32 +262,27 @@ lcd_enu_return_state_t LCD_clear (lcd_str_config_t* ptr_str_config)
 /**
  * @brief Set the cursor position on the LCD display.
  *
- * This function sets the position of the cursor on the LCD display based on the specified row
- * and column indices. It calculates the appropriate DDRAM address based on the selected row
- * and column, and sends the command to position the cursor at that address.
+ * This function sets the position at which the next characters are written into the frame buffer.
+ * No command is sent, the flusher addresses the LCD itself when it writes a changed cell.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
  * @param copy_enu_row The row on the LCD where the cursor should be positioned.
  * @param copy_enu_col The column on the LCD where the cursor should be positioned.
  * @return The state of the cursor position setting operation.
  *         - LCD_E_OK: Cursor position set successfully.
- *         - LCD_E_NOT_OK: Cursor position setting operation failed due to an invalid row selection.
- *
- * @note The function calculates the appropriate DDRAM address for the specified row and column indices,
- * and sends the command to set the cursor position to that address on the LCD.
+ *         - LCD_E_NOT_OK: Cursor position setting operation failed due to an invalid row or column selection.
  */
 lcd_enu_return_state_t LCD_setCursor (lcd_str_config_t* ptr_str_config, lcd_enu_row_select_t copy_enu_row, lcd_enu_col_select_t copy_enu_col)
 {
 	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
-	if(copy_enu_row == LCD_ROW_1)
+	(void)ptr_str_config;
+	if((copy_enu_row <= LCD_ROW_2) && (copy_enu_col <= LCD_COL_16))
 	{
-		LCD_cmd(ptr_str_config, LCD_DDRAM_START_ADD_LINE_1 + copy_enu_col);
-		
-	}else if(copy_enu_row == LCD_ROW_2){
-		LCD_cmd(ptr_str_config, LCD_DDRAM_START_ADD_LINE_2 + copy_enu_col);	
+		gs_u8_cursor_row = copy_enu_row;
+		gs_u8_cursor_col = copy_enu_col;
 
 	}else{
-		
+
 		enu_return_state=LCD_E_NOT_OK;
 	}
 
@@ -152,19 +293,15 @@ lcd_enu_return_state_t LCD_setCursor (lcd_str_config_t* ptr_str_config, lcd_enu_
 /**
  * @brief Write a null-terminated string to the LCD display.
  *
- * This function writes a null-terminated string of characters to the LCD display.
- * It iterates through each character in the input string and sends individual characters
- * to the LCD using the LCD_char function. The function continues writing characters
- * until the null-terminator is encountered.
+ * This function writes a null-terminated string of characters into the frame buffer, starting at the cursor
+ * position, using the LCD_char function. It returns immediately: the background flusher sends the cells
+ * that differ from what the display already shows, so rewriting the same text costs no bus transfer.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
  * @param ptr_u8_data Pointer to the null-terminated string to be written.
  * @return The state of the string writing operation.
  *         - LCD_E_OK: String written successfully.
  *         - LCD_NULL_PTR: The input string pointer is NULL.
- *
- * @note The function iterates through the input string and sends each character to the LCD using
- * the LCD_char function until the null-terminator ('\0') is encountered.
  */
 lcd_enu_return_state_t LCD_writeString (lcd_str_config_t *ptr_str_config, uint8_t *ptr_u8_data)
 {
@@ -181,15 +318,108 @@ lcd_enu_return_state_t LCD_writeString (lcd_str_config_t *ptr_str_config, uint8_
 		{
 			LCD_char(ptr_str_config,ptr_u8_data[u8_char_counter]);
 			u8_char_counter++;
-			
+
 		}
 	}
 	return enu_return_state;
-	
+
 
 }
 
 
+/**
+ * @brief Write a null-terminated string kept in program memory to the LCD display.
+ *
+ * Same as LCD_writeString for a string defined with PROGMEM: the characters are read from flash
+ * one by one into the frame buffer, the string never occupies SRAM.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param ptr_u8_data Program memory address of the null-terminated string to be written.
+ * @return The state of the string writing operation.
+ *         - LCD_E_OK: String written successfully.
+ *         - LCD_NULL_PTR: The input string pointer is NULL.
+ */
+lcd_enu_return_state_t LCD_writeString_P (lcd_str_config_t *ptr_str_config, const uint8_t *ptr_u8_data)
+{
+	lcd_enu_return_state_t enu_return_state=LCD_E_OK;
+	uint8_t u8_char;
+	if(ptr_u8_data == NULL)
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else
+	{
+		u8_char = pgm_read_byte(ptr_u8_data);
+		while(u8_char != '\0')
+		{
+			LCD_char(ptr_str_config, u8_char);
+			ptr_u8_data++;
+			u8_char = pgm_read_byte(ptr_u8_data);
+		}
+	}
+	return enu_return_state;
+}
+
+
+/**
+ * @brief Show a number in a field.
+ *
+ * The value is converted to decimal without any division and written right-aligned into the
+ * field's cells of the frame buffer, the cells on its left get the field's padding character.
+ * The cursor does not move, and only the cells whose character changes reach the display.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param ptr_str_field Pointer to the field.
+ * @param copy_u16_value The value to show.
+ * @return The state of the field update.
+ *         - LCD_E_OK: Value written.
+ *         - LCD_E_NOT_OK: The field does not fit on the display, or the value has more digits than
+ *           the field is wide (the field is then filled with LCD_FIELD_OVERFLOW_CHAR).
+ *         - LCD_NULL_PTR: The field pointer is NULL.
+ */
+lcd_enu_return_state_t LCD_writeField (lcd_str_config_t *ptr_str_config, const lcd_str_field_t *ptr_str_field, uint16_t copy_u16_value)
+{
+	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	uint32_t u32_bcd;
+	uint8_t u8_col;
+	(void)ptr_str_config;
+
+	if(ptr_str_field == NULL)
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if((ptr_str_field->enu_row > LCD_ROW_2) || (ptr_str_field->u8_width == U8_ZERO_VALUE) ||
+	        (((uint8_t)ptr_str_field->enu_col + ptr_str_field->u8_width) > LCD_COLS))
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else
+	{
+		u32_bcd = lcd_u32ToBcd(copy_u16_value);
+		/* Right to left: the units always, then digits while some are left, then padding */
+		u8_col = (uint8_t)ptr_str_field->enu_col + ptr_str_field->u8_width;
+		do{
+			u8_col--;
+			if((u8_col == ((uint8_t)ptr_str_field->enu_col + ptr_str_field->u8_width - U8_ONE_VALUE)) || (u32_bcd != U8_ZERO_VALUE)){
+				gs_arr_u8_frame[ptr_str_field->enu_row][u8_col] = (uint8_t)('0' + (u32_bcd & LCD_BCD_DIGIT_MASK));
+				u32_bcd >>= LCD_BCD_DIGIT_BITS;
+			}else{
+				gs_arr_u8_frame[ptr_str_field->enu_row][u8_col] = ptr_str_field->u8_pad_char;
+			}
+		}while(u8_col != (uint8_t)ptr_str_field->enu_col);
+
+		if(u32_bcd != U8_ZERO_VALUE)
+		{
+			for(u8_col = (uint8_t)ptr_str_field->enu_col; u8_col < ((uint8_t)ptr_str_field->enu_col + ptr_str_field->u8_width); u8_col++){
+				gs_arr_u8_frame[ptr_str_field->enu_row][u8_col] = LCD_FIELD_OVERFLOW_CHAR;
+			}
+			enu_return_state = LCD_E_NOT_OK;
+		}
+	}
+	return enu_return_state;
+}
+
+
 /**
 * @brief Write a custom special character to the LCD display.
 *
@@ -203,29 +433,63 @@ lcd_enu_return_state_t LCD_writeString (lcd_str_config_t *ptr_str_config, uint8_
 * @return The state of the special character writing operation.
 *         - LCD_E_OK: Special character written successfully.
 *
-* @note This function generates the custom special character pattern using predefined data values
-* and writes it to the LCD CGRAM (Character Generator RAM) at the specified position for special characters.
-* The function then positions the cursor at the start of the next line and writes the special character to the display.
+* @note The pattern is streamed from flash to the CGRAM right away (blocking, see LCD_cmd). The character itself is
+* placed in the frame buffer at the start of the second line and shown by the flusher.
 */
 lcd_enu_return_state_t LCD_writeSpChar (lcd_str_config_t *ptr_str_config, u8_en_lcdSpCharType u8_SpChar)
 {   lcd_enu_return_state_t enu_return_state=LCD_E_OK;
-	uint8_t sp_char[]= {0x04, 0x0E, 0x0E, 0x0E, 0x1F, 0x00, 0x04, 0x00};
-	uint8_t i;
-	LCD_cmd(ptr_str_config,0x40+( u8_SpChar* 8));
-	for(i=0;i<8;i++)
-	{
-		LCD_char(ptr_str_config,sp_char[i]);
-	}	
-	
-	LCD_cmd(ptr_str_config,0xc0);
+	enu_return_state = LCD_writeCustomChar_P(ptr_str_config, u8_SpChar, gs_arr_u8_bell_pattern);
+
+	LCD_setCursor(ptr_str_config, LCD_ROW_2, LCD_COL_1);
 	LCD_char(ptr_str_config,LCD_BELL);
 	return enu_return_state;
 }
 
+
+/**
+ * @brief Load a user-defined character pattern kept in program memory into the CGRAM.
+ *
+ * The LCD_CGRAM_CHAR_BYTES rows of the pattern are streamed from flash to the LCD right away
+ * (blocking, see LCD_cmd). Writing the character code copy_u8_index then shows the pattern.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param copy_u8_index Character code of the pattern, 0 .. LCD_CGRAM_CHARS - 1.
+ * @param ptr_u8_pattern Program memory address of the LCD_CGRAM_CHAR_BYTES pattern rows.
+ * @return The state of the operation.
+ *         - LCD_E_OK: Pattern written successfully.
+ *         - LCD_E_NOT_OK: Invalid character code or unsupported LCD mode.
+ *         - LCD_NULL_PTR: The pattern pointer is NULL.
+ */
+lcd_enu_return_state_t LCD_writeCustomChar_P (lcd_str_config_t *ptr_str_config, uint8_t copy_u8_index, const uint8_t *ptr_u8_pattern)
+{
+	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	if(ptr_u8_pattern == NULL)
+	{
+		enu_return_state = LCD_NULL_PTR;
+	}
+	else if(copy_u8_index >= LCD_CGRAM_CHARS)
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+	else
+	{
+		lcd_vidFlushPause();
+		enu_return_state = lcd_enuSendBlocking(ptr_str_config, DIO_PIN_LOW_LEVEL, LCD_CGRAM_START_ADD + (copy_u8_index * LCD_CGRAM_CHAR_BYTES));
+		for(uint8_t u8_row = U8_ZERO_VALUE; (u8_row < LCD_CGRAM_CHAR_BYTES) && (enu_return_state == LCD_E_OK); u8_row++)
+		{
+			enu_return_state = lcd_enuSendBlocking(ptr_str_config, DIO_PIN_HIGH_LEVEL, pgm_read_byte(&ptr_u8_pattern[u8_row]));
+		}
+		/* The address counter now points into the CGRAM */
+		gs_u8_lcd_address = LCD_ADDRESS_UNKNOWN;
+		lcd_vidFlushResume();
+	}
+	return enu_return_state;
+}
+
 /**
  * @brief Send a command to the LCD display.
  *
- * This function sends a command to the LCD display. It takes a command value as input and
+ * This function sends a command to the LCD display right away. It takes a command value as input and
  * transmits the command using appropriate control signals and data pins according to the
  * LCD's mode (4-bit or 8-bit).
  *
@@ -233,148 +497,375 @@ lcd_enu_return_state_t LCD_writeSpChar (lcd_str_config_t *ptr_str_config, u8_en_
  * @param cmd The command to be sent to the LCD.
  * @return The state of the command transmission operation.
  *         - LCD_E_OK: Command transmitted successfully.
+ *         - LCD_E_NOT_OK: Unsupported LCD mode.
  *
- * @note This function handles the transmission of the command to the LCD display.
- * It uses control signals like 'E', 'RS', and 'RW' to manage the data transmission.
- * Depending on the LCD's mode, it uses the appropriate number of data pins to transmit the command.
+ * @note This call is blocking. It waits for the flusher to finish the byte it is sending, then holds it
+ * while the command is transmitted. It must not be called with interrupts disabled while the flusher runs.
+ * With LCD_BUSY_FLAG_POLLING it returns once the command is latched, the next transfer waits for the busy flag.
  */
 lcd_enu_return_state_t LCD_cmd(lcd_str_config_t *ptr_str_config,uint8_t cmd)
 {   lcd_enu_return_state_t enu_return_state=LCD_E_OK;
-	lcd_enu_return_state_t u8_bit_counter = LCD_MSB_INDEX;
+	lcd_vidFlushPause();
+	enu_return_state = lcd_enuSendBlocking(ptr_str_config, DIO_PIN_LOW_LEVEL, cmd);
+	gs_u8_lcd_address = LCD_ADDRESS_UNKNOWN;
+	if(cmd == LCD_CMD_CLEAR){
+		/* The display is blank now, the flusher restores the frame buffer */
+		for(uint8_t u8_row = U8_ZERO_VALUE; u8_row < LCD_ROWS; u8_row++){
+			for(uint8_t u8_col = U8_ZERO_VALUE; u8_col < LCD_COLS; u8_col++){
+				gs_arr_u8_shown[u8_row][u8_col] = LCD_BLANK_CHAR;
+			}
+		}
+	}
+	lcd_vidFlushResume();
+	return enu_return_state;
+}
+
+
+/**
+ * @brief Display a character on the LCD.
+ *
+ * This function writes a character into the frame buffer at the cursor position and moves the
+ * cursor one column to the right. The character reaches the display on the following ticks.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param cmd The character to be displayed on the LCD.
+ *
+ * @note Characters written past the last column are dropped, they would land in the hidden
+ * part of the LCD's line memory anyway.
+ */
+
+  void LCD_char(lcd_str_config_t *ptr_str_config, uint8_t cmd)
+{
+	(void)ptr_str_config;
+	if(gs_u8_cursor_col < LCD_COLS)
+	{
+		gs_arr_u8_frame[gs_u8_cursor_row][gs_u8_cursor_col] = cmd;
+		gs_u8_cursor_col++;
+	}
+	else
+	{
+		//do nothing
+	}
+}
+
+
+/**
+ * @brief Background flusher of the frame buffer, one bus transfer per call.
+ *
+ * LCD_init subscribes this function to the timing_init tick, or the application calls it about
+ * once per millisecond when LCD_FLUSH_ON_TICK is 0. On each call it sends one nibble
+ * (one byte in 8-bit mode) of the next cell whose frame buffer content differs from what the
+ * display shows, preceded by a "set DDRAM address" command when the LCD's address counter
+ * does not already point at that cell. Consecutive changed cells are streamed without
+ * re-addressing. Nothing is sent when the display is up to date.
+ *
+ * With LCD_BUSY_FLAG_POLLING a call sends one whole byte instead. It reads the busy flag once
+ * first and sends nothing while the controller is busy, the next call tries again.
+ */
+void LCD_vidFlushTick(void)
+{
+	if((gs_ptr_str_config == NULL) || (gs_u8_flush_pause == U8_ONE_VALUE))
+	{
+		return;
+	}
+
+#if LCD_BUSY_FLAG_POLLING
+	/* A controller still busy is asked again by the next tick, the flusher never waits for it */
+	if((lcd_u8FlushPick() == U8_ZERO_VALUE) || (lcd_enuWaitReady(gs_ptr_str_config, U8_ONE_VALUE) != LCD_E_OK))
+	{
+		return;
+	}
+	lcd_vidBusWrite(gs_ptr_str_config, gs_enu_flush_rs, gs_u8_flush_byte, LCD_MSB_INDEX);
+	if(gs_ptr_str_config->enu_mode == LCD_4_BIT_MODE){
+		lcd_vidBusWrite(gs_ptr_str_config, gs_enu_flush_rs, gs_u8_flush_byte, LCD_MSB_INDEX - LCD_MAX_DATA_PINS_MOD_4);
+	}
+	lcd_vidFlushDone();
+#else
+	if(gs_enu_flush_step == LCD_FLUSH_IDLE)
+	{
+		if(lcd_u8FlushPick() == U8_ZERO_VALUE)
+		{
+			return;
+		}
+		lcd_vidBusWrite(gs_ptr_str_config, gs_enu_flush_rs, gs_u8_flush_byte, LCD_MSB_INDEX);
+		if(gs_ptr_str_config->enu_mode == LCD_4_BIT_MODE){
+			gs_enu_flush_step = LCD_FLUSH_LOW_NIBBLE;
+			return;
+		}
+	}
+	else
+	{
+		lcd_vidBusWrite(gs_ptr_str_config, gs_enu_flush_rs, gs_u8_flush_byte, LCD_MSB_INDEX - LCD_MAX_DATA_PINS_MOD_4);
+		gs_enu_flush_step = LCD_FLUSH_IDLE;
+	}
+	lcd_vidFlushDone();
+#endif
+}
+
+
+/**
+ * @brief Select the next transfer of the flusher.
+ *
+ * Looks for a changed cell, starting where the last byte went, and records the "set DDRAM
+ * address" command or the character to send for it.
+ *
+ * @return U8_ONE_VALUE if there is something to send, U8_ZERO_VALUE if the display is up to date.
+ */
+static uint8_t lcd_u8FlushPick(void)
+{
+	uint8_t u8_row = gs_u8_flush_row;
+	uint8_t u8_col = gs_u8_flush_col;
+	uint8_t u8_address;
+	uint8_t u8_found = U8_ZERO_VALUE;
+
+	for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < (LCD_ROWS * LCD_COLS); u8_counter++){
+		if(gs_arr_u8_frame[u8_row][u8_col] != gs_arr_u8_shown[u8_row][u8_col]){
+			u8_found = U8_ONE_VALUE;
+			break;
+		}
+		u8_col++;
+		if(u8_col == LCD_COLS){
+			u8_col = U8_ZERO_VALUE;
+			u8_row = (u8_row + U8_ONE_VALUE) % LCD_ROWS;
+		}
+	}
+	if(u8_found == U8_ONE_VALUE)
+	{
+		gs_u8_flush_row = u8_row;
+		gs_u8_flush_col = u8_col;
+		u8_address = ((u8_row == LCD_ROW_1) ? LCD_DDRAM_START_ADD_LINE_1 : LCD_DDRAM_START_ADD_LINE_2) + u8_col;
+		if(u8_address != gs_u8_lcd_address){
+			gs_enu_flush_rs = DIO_PIN_LOW_LEVEL;
+			gs_u8_flush_byte = u8_address;
+		}else{
+			gs_enu_flush_rs = DIO_PIN_HIGH_LEVEL;
+			gs_u8_flush_byte = gs_arr_u8_frame[u8_row][u8_col];
+		}
+	}
+	return u8_found;
+}
+
+
+/**
+ * @brief Account for a byte the flusher has completely sent.
+ */
+static void lcd_vidFlushDone(void)
+{
+	if(gs_enu_flush_rs == DIO_PIN_LOW_LEVEL){
+		gs_u8_lcd_address = gs_u8_flush_byte;
+	}else{
+		gs_arr_u8_shown[gs_u8_flush_row][gs_u8_flush_col] = gs_u8_flush_byte;
+		gs_u8_lcd_address++;
+		gs_u8_flush_col++;
+		if(gs_u8_flush_col == LCD_COLS){
+			gs_u8_flush_col = U8_ZERO_VALUE;
+			gs_u8_flush_row = (gs_u8_flush_row + U8_ONE_VALUE) % LCD_ROWS;
+		}
+	}
+}
+
+
+/**
+ * @brief Put one transfer on the LCD bus and latch it.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param copy_enu_rs Level of RS: low for a command, high for data.
+ * @param copy_u8_byte The byte to transfer.
+ * @param copy_u8_msb_index Index of the first bit to put on the data pins: 7 for the high nibble or
+ *                          the whole byte, 3 for the low nibble.
+ */
+static void lcd_vidBusWrite(lcd_str_config_t *ptr_str_config, dio_enu_level_t copy_enu_rs, uint8_t copy_u8_byte, uint8_t copy_u8_msb_index)
+{
+	sint8_t s8_bit_counter = copy_u8_msb_index;
 	DIO_write_pin(ptr_str_config->str_Epin.enu_port,ptr_str_config->str_Epin.enu_pin,DIO_PIN_LOW_LEVEL);
-	DIO_write_pin(ptr_str_config->str_RSpin.enu_port,ptr_str_config->str_RSpin.enu_pin,DIO_PIN_LOW_LEVEL);
+	DIO_write_pin(ptr_str_config->str_RSpin.enu_port,ptr_str_config->str_RSpin.enu_pin,copy_enu_rs);
 	DIO_write_pin(ptr_str_config->str_RWpin.enu_port,ptr_str_config->str_RWpin.enu_pin,DIO_PIN_LOW_LEVEL);
 	if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
 	{
 		for(sint8_t u8_counter = LCD_MAX_DATA_PINS_MOD_4 - U8_ONE_VALUE; u8_counter >= U8_ZERO_VALUE; u8_counter--){
-			if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
+			if(READ_BIT(copy_u8_byte,s8_bit_counter) == U8_ONE_VALUE){
 				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
 			}else{
 				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
 			}
-			u8_bit_counter--;
+			s8_bit_counter--;
 		}
-		ENABLE(ptr_str_config);
-		delay_3_ms();
-	   for(sint8_t u8_counter = LCD_MAX_DATA_PINS_MOD_4-U8_ONE_VALUE; u8_counter >= U8_ZERO_VALUE; u8_counter--){
-		   if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
-			   DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
-			}else{
-			   DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
-		   }
-		   u8_bit_counter--;
-	   }
-		ENABLE(ptr_str_config);
-		delay_3_ms();
 	}
-	else if(ptr_str_config->enu_mode == LCD_8_BIT_MODE)
+	else
 	{
 		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < LCD_MAX_DATA_PINS_MOD_8; u8_counter++){
-			if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
+			if(READ_BIT(copy_u8_byte,s8_bit_counter) == U8_ONE_VALUE){
 				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
-				}else{
+			}else{
 				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
 			}
-			u8_bit_counter--;
+			s8_bit_counter--;
 		}
-		ENABLE(ptr_str_config);
-		delay_3_ms();	
+	}
+	ENABLE(ptr_str_config);
+}
+
+
+/**
+ * @brief Transfer a whole byte, waiting after each part.
+ *
+ * @param ptr_str_config Pointer to the LCD configuration structure.
+ * @param copy_enu_rs Level of RS: low for a command, high for data.
+ * @param copy_u8_byte The byte to transfer.
+ * @return LCD_E_OK, or LCD_E_NOT_OK for an unsupported mode.
+ */
+static lcd_enu_return_state_t lcd_enuSendBlocking(lcd_str_config_t *ptr_str_config, dio_enu_level_t copy_enu_rs, uint8_t copy_u8_byte)
+{
+	lcd_enu_return_state_t enu_return_state = LCD_E_OK;
+	if((ptr_str_config->enu_mode != LCD_4_BIT_MODE) && (ptr_str_config->enu_mode != LCD_8_BIT_MODE))
+	{
+		enu_return_state = LCD_E_NOT_OK;
+	}
+#if LCD_BUSY_FLAG_POLLING
+	else if(gs_u8_busy_flag_valid == U8_ONE_VALUE)
+	{
+		/* After a timeout the controller has had longer than any instruction takes, write anyway */
+		(void) lcd_enuWaitReady(ptr_str_config, LCD_BUSY_TIMEOUT_POLLS);
+		lcd_vidBusWrite(ptr_str_config, copy_enu_rs, copy_u8_byte, LCD_MSB_INDEX);
+		if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
+		{
+			lcd_vidBusWrite(ptr_str_config, copy_enu_rs, copy_u8_byte, LCD_MSB_INDEX - LCD_MAX_DATA_PINS_MOD_4);
+		}
+	}
+#endif
+	else if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
+	{
+		lcd_vidBusWrite(ptr_str_config, copy_enu_rs, copy_u8_byte, LCD_MSB_INDEX);
+		delay_3_ms();
+		lcd_vidBusWrite(ptr_str_config, copy_enu_rs, copy_u8_byte, LCD_MSB_INDEX - LCD_MAX_DATA_PINS_MOD_4);
+		delay_3_ms();
 	}
 	else
 	{
-		//do nothing
-		enu_return_state=LCD_E_NOT_OK;
+		lcd_vidBusWrite(ptr_str_config, copy_enu_rs, copy_u8_byte, LCD_MSB_INDEX);
+		delay_3_ms();
 	}
-	delay_3_ms();
 	return enu_return_state;
 }
 
 
+#if LCD_BUSY_FLAG_POLLING
 /**
- * @brief Display a character on the LCD.
+ * @brief Wait until the LCD controller is ready for the next byte.
  *
- * This function displays a character on the LCD screen. It takes a character value as input and
- * transmits the character's ASCII code to the LCD using appropriate control signals and data pins
- * based on the LCD's mode (4-bit or 8-bit).
+ * Turns the data pins around once, reads the busy flag on D7 with RW high until it clears or
+ * copy_u16_polls reads were made, then drives the bus again. In 4-bit mode every read takes two
+ * E pulses, the second one carries the low half of the address counter and is discarded.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
- * @param cmd The character to be displayed on the LCD.
+ * @param copy_u16_polls Busy flag reads before giving up, 1 to only check it.
+ * @return LCD_E_OK once the controller is ready, LCD_E_NOT_OK if it was still busy after the last read.
  *
- * @note This function sends the character data to the LCD display to show it on the screen.
- * It uses control signals 'E', 'RS', and 'RW' to manage the data transmission. Depending on
- * the LCD's mode, it uses the appropriate number of data pins to transmit the character's ASCII code.
+ * @note D7 is valid at most 360 ns after E rises, the pin read that follows the E write comes later.
  */
-
-  void LCD_char(lcd_str_config_t *ptr_str_config, uint8_t cmd)
+static lcd_enu_return_state_t lcd_enuWaitReady(lcd_str_config_t *ptr_str_config, uint16_t copy_u16_polls)
 {
-	lcd_enu_return_state_t u8_bit_counter = LCD_MSB_INDEX;
-	DIO_write_pin(ptr_str_config->str_Epin.enu_port,ptr_str_config->str_Epin.enu_pin,DIO_PIN_LOW_LEVEL);
-	DIO_write_pin(ptr_str_config->str_RSpin.enu_port,ptr_str_config->str_RSpin.enu_pin,DIO_PIN_HIGH_LEVEL);
-	DIO_write_pin(ptr_str_config->str_RWpin.enu_port,ptr_str_config->str_RWpin.enu_pin,DIO_PIN_LOW_LEVEL);
-	
-	
-	if(ptr_str_config->enu_mode == LCD_4_BIT_MODE)
-	{
-		
-		for(sint8_t u8_counter = LCD_MAX_DATA_PINS_MOD_4-U8_ONE_VALUE; u8_counter >= U8_ZERO_VALUE; u8_counter--){
-			if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
-				}else{
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
-			}
-			u8_bit_counter--;
+	lcd_enu_return_state_t enu_return_state = LCD_E_NOT_OK;
+	/* D7 is the last of the four data pins in 4-bit mode and the first of the eight in 8-bit mode */
+	uint8_t u8_pins = (ptr_str_config->enu_mode == LCD_4_BIT_MODE) ? LCD_MAX_DATA_PINS_MOD_4 : LCD_MAX_DATA_PINS_MOD_8;
+	lcd_str_unit_t *ptr_str_d7 = &ptr_str_config->str_data_pins[(ptr_str_config->enu_mode == LCD_4_BIT_MODE) ? (LCD_MAX_DATA_PINS_MOD_4 - U8_ONE_VALUE) : U8_ZERO_VALUE];
+	dio_enu_level_t enu_busy = DIO_PIN_HIGH_LEVEL;
+
+	/* Release the data pins before the LCD starts driving them */
+	for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < u8_pins; u8_counter++){
+		DIO_init(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin, DIO_PIN_INPUT);
+	}
+	DIO_write_pin(ptr_str_config->str_RSpin.enu_port, ptr_str_config->str_RSpin.enu_pin, DIO_PIN_LOW_LEVEL);
+	DIO_write_pin(ptr_str_config->str_RWpin.enu_port, ptr_str_config->str_RWpin.enu_pin, DIO_PIN_HIGH_LEVEL);
+
+	for(uint16_t u16_polls = U8_ZERO_VALUE; (u16_polls < copy_u16_polls) && (enu_return_state != LCD_E_OK); u16_polls++){
+		DIO_write_pin(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_HIGH_LEVEL);
+		DIO_read_pin(ptr_str_d7->enu_port, ptr_str_d7->enu_pin, &enu_busy);
+		DIO_write_pin(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_LOW_LEVEL);
+		if(ptr_str_config->enu_mode == LCD_4_BIT_MODE){
+			ENABLE(ptr_str_config);
 		}
-		ENABLE(ptr_str_config);
-		delay_3_ms();
-		for(sint8_t u8_counter = LCD_MAX_DATA_PINS_MOD_4-U8_ONE_VALUE; u8_counter >= U8_ZERO_VALUE; u8_counter--){
-			if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
-				}else{
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
-			}
-			u8_bit_counter--;
+		if(enu_busy == DIO_PIN_LOW_LEVEL){
+			enu_return_state = LCD_E_OK;
 		}
-		ENABLE(ptr_str_config);
-		delay_3_ms();
 	}
-	else if(ptr_str_config->enu_mode == LCD_8_BIT_MODE)
-	{
-		for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < LCD_MAX_DATA_PINS_MOD_8; u8_counter++){
-			if(READ_BIT(cmd,u8_bit_counter) == U8_ONE_VALUE){
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_HIGH_LEVEL);
-				}else{
-				DIO_write_pin(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin,DIO_PIN_LOW_LEVEL);
+
+	/* Stop the LCD driving the bus before the pins become outputs again */
+	DIO_write_pin(ptr_str_config->str_RWpin.enu_port, ptr_str_config->str_RWpin.enu_pin, DIO_PIN_LOW_LEVEL);
+	for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < u8_pins; u8_counter++){
+		DIO_init(ptr_str_config->str_data_pins[u8_counter].enu_port, ptr_str_config->str_data_pins[u8_counter].enu_pin, DIO_PIN_OUTPUT);
+	}
+	return enu_return_state;
+}
+#endif
+
+
+/**
+ * @brief Convert a binary value to packed BCD with the double dabble (shift and add 3) algorithm.
+ *
+ * @param copy_u16_value The value to convert.
+ * @return Five BCD digits, the units in bits 0..3.
+ */
+static uint32_t lcd_u32ToBcd(uint16_t copy_u16_value)
+{
+	uint32_t u32_bcd = U8_ZERO_VALUE;
+	uint8_t u8_shift;
+
+	for(uint8_t u8_bit = U8_ZERO_VALUE; u8_bit < LCD_BCD_INPUT_BITS; u8_bit++){
+		/* A digit of 5 or more would become 10 or more when doubled, carry it into the next digit */
+		for(u8_shift = U8_ZERO_VALUE; u8_shift < (LCD_BCD_DIGITS * LCD_BCD_DIGIT_BITS); u8_shift += LCD_BCD_DIGIT_BITS){
+			if(((u32_bcd >> u8_shift) & LCD_BCD_DIGIT_MASK) >= LCD_BCD_ADJUST_LIMIT){
+				u32_bcd += ((uint32_t)LCD_BCD_ADJUST << u8_shift);
 			}
-			u8_bit_counter--;
 		}
-		ENABLE(ptr_str_config);
-		delay_3_ms();
+		u32_bcd = (u32_bcd << U8_ONE_VALUE) | ((copy_u16_value >> (LCD_BCD_INPUT_BITS - U8_ONE_VALUE)) & U8_ONE_VALUE);
+		copy_u16_value <<= U8_ONE_VALUE;
 	}
-	else
+	return u32_bcd;
+}
+
+
+/**
+ * @brief Hold the flusher at a byte boundary so the bus can be used directly.
+ */
+static void lcd_vidFlushPause(void)
+{
+	gs_u8_flush_pause = U8_ONE_VALUE;
+	/* From here on the tick leaves the bus alone, even from the timer interrupt */
+	if(gs_enu_flush_step == LCD_FLUSH_LOW_NIBBLE)
 	{
-		//do nothing
+		lcd_vidBusWrite(gs_ptr_str_config, gs_enu_flush_rs, gs_u8_flush_byte, LCD_MSB_INDEX - LCD_MAX_DATA_PINS_MOD_4);
+		delay_3_ms();
+		gs_enu_flush_step = LCD_FLUSH_IDLE;
+		lcd_vidFlushDone();
 	}
 }
 
 
+/**
+ * @brief Let the flusher run again.
+ */
+static void lcd_vidFlushResume(void)
+{
+	gs_u8_flush_pause = U8_ZERO_VALUE;
+}
+
+
 /**
  * @brief Enable the LCD for data/command transmission.
  *
  * This function is responsible for generating the enabling pulse for the LCD's data/command transmission.
- * It sets the 'E' (Enable) signal to a high level for a brief moment, followed by setting it back to a low level.
+ * It sets the 'E' (Enable) signal to a high level, followed by setting it back to a low level.
  * This pulse triggers the LCD to read the data or command being sent to it.
  *
  * @param ptr_str_config Pointer to the LCD configuration structure.
  *
- * @note This function is a part of the mechanism to enable the LCD for data or command transmission.
- * It generates the necessary pulse on the 'E' signal to initiate the read or write operation.
- * A short delay is included after setting 'E' high and before setting it low again to ensure proper timing.
+ * @note The LCD needs a pulse of at least 450 ns, which two pin writes already exceed.
  */
 void ENABLE(lcd_str_config_t* ptr_str_config)
 {
-	
+
 	DIO_write_pin(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_HIGH_LEVEL);
-	delay_3_ms();
 	DIO_write_pin(ptr_str_config->str_Epin.enu_port, ptr_str_config->str_Epin.enu_pin, DIO_PIN_LOW_LEVEL);
 
 
@@ -394,5 +885,6 @@ void ENABLE(lcd_str_config_t* ptr_str_config)
 void delay_3_ms(void){
 	static uint32_t u32_desired_ticks = 5000;
 	for(volatile uint32_t u32_counter = 0; u32_counter < u32_desired_ticks; u32_counter++);
-	
-}
\ No newline at end of file
+	cpu_spin_us(3000);
+
+}
@@ -39,6 +39,18 @@ typedef enum motor_enu_return_state_t {
     MOTOR_NOK        /**< Motor control operation failed. */
 } motor_enu_return_state_t;
 
+/**
+ * @brief Enumeration for motor directions.
+ *
+ * This enumeration indexes the table of H-bridge input levels of a motor.
+ */
+typedef enum motor_enu_direction_t {
+    MOTOR_DIR_STOP = 0,  /**< Both inputs low. */
+    MOTOR_DIR_FORWARD,   /**< Input 1 high, input 2 low. */
+    MOTOR_DIR_BACKWARD,  /**< Input 1 low, input 2 high. */
+    MOTOR_DIR_MAX
+} motor_enu_direction_t;
+
 	
 
 /************************************************************************************************/
@@ -65,6 +77,7 @@ motor_enu_return_state_t MOTOR_INIT(const motor_str_config_t *ptr_str_motor_conf
  * @brief Turn the motor forward based on the provided configuration.
  *
  * This function controls the motor to rotate in the forward direction by setting the corresponding pins of the specified port.
+ * Both pins change in a single port write, so the H-bridge never sees an intermediate state.
  *
  * @param ptr_str_motor_config Pointer to the motor configuration structure.
  * @return The state of the motor operation.
@@ -80,6 +93,7 @@ motor_enu_return_state_t MOTOR_FORWARD(const motor_str_config_t* ptr_str_motor_c
  * @brief Turn the motor backward based on the provided configuration.
  *
  * This function controls the motor to rotate in the backward direction by setting the corresponding pins of the specified port.
+ * Both pins change in a single port write, so the H-bridge never sees an intermediate state.
  *
  * @param ptr_str_motor_config Pointer to the motor configuration structure.
  * @return The state of the motor operation.
@@ -94,7 +108,7 @@ motor_enu_return_state_t MOTOR_BACKWARD(const motor_str_config_t* ptr_str_motor_
 /**
  * @brief Stop the motor based on the provided configuration.
  *
- * This function stops the motor by setting both pins of the specified port to a low level.
+ * This function stops the motor by setting both pins of the specified port to a low level in a single port write.
  *
  * @param ptr_str_motor_config Pointer to the motor configuration structure.
  * @return The state of the motor operation.
@@ -106,6 +120,22 @@ motor_enu_return_state_t MOTOR_BACKWARD(const motor_str_config_t* ptr_str_motor_
 motor_enu_return_state_t MOTOR_STOP(const motor_str_config_t* ptr_str_motor_config);
 
 
+/**
+ * @brief Get the port bits of a motor's inputs and their levels for a direction.
+ *
+ * Lets a caller drive several motors on one port with a single DIO_write_port_masked.
+ *
+ * @param ptr_str_motor_config Pointer to the motor configuration structure.
+ * @param enu_direction The direction.
+ * @param ptr_u8_mask Receives the bits of both motor pins.
+ * @param ptr_u8_levels Receives the levels of both motor pins for the direction.
+ * @return The state of the motor operation.
+ *         - MOTOR_OK: The mask and levels are valid.
+ *         - MOTOR_NOK: A pointer is NULL, or the direction or a pin number is invalid.
+ */
+motor_enu_return_state_t MOTOR_GET_LEVELS(const motor_str_config_t* ptr_str_motor_config, motor_enu_direction_t enu_direction, uint8_t *ptr_u8_mask, uint8_t *ptr_u8_levels);
+
+
 
 
 
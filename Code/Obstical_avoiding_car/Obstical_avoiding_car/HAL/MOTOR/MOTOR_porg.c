@@ -9,6 +9,26 @@
 #include "MOTOR_interface.h"
 
 
+/* Levels of the motor inputs per direction: bit 0 for pin_num1, bit 1 for pin_num2 */
+#define MOTOR_LEVEL_PIN_1       0x01u
+#define MOTOR_LEVEL_PIN_2       0x02u
+
+static const uint8_t gs_arr_u8_motor_levels[MOTOR_DIR_MAX] = {
+	[MOTOR_DIR_STOP]     = 0u,
+	[MOTOR_DIR_FORWARD]  = MOTOR_LEVEL_PIN_1,
+	[MOTOR_DIR_BACKWARD] = MOTOR_LEVEL_PIN_2,
+};
+
+/**
+ * @brief Drive both inputs of a motor for a direction with one port write.
+ *
+ * @param ptr_str_motor_config Pointer to the motor configuration structure.
+ * @param enu_direction The direction.
+ * @return MOTOR_OK, or MOTOR_NOK if the configuration is invalid.
+ */
+static motor_enu_return_state_t MOTOR_enuWrite(const motor_str_config_t *ptr_str_motor_config, motor_enu_direction_t enu_direction);
+
+
 
 /**
  * @brief Initialize a motor based on the provided configuration.
@@ -44,6 +64,7 @@ motor_enu_return_state_t MOTOR_INIT(const motor_str_config_t *ptr_str_motor_conf
  * @brief Turn the motor forward based on the provided configuration.
  *
  * This function controls the motor to rotate in the forward direction by setting the corresponding pins of the specified port.
+ * Both pins change in a single port write, so the H-bridge never sees an intermediate state.
  *
  * @param ptr_str_motor_config Pointer to the motor configuration structure.
  * @return The state of the motor operation.
@@ -54,25 +75,14 @@ motor_enu_return_state_t MOTOR_INIT(const motor_str_config_t *ptr_str_motor_conf
  */
 motor_enu_return_state_t MOTOR_FORWARD(const motor_str_config_t *ptr_str_motor_config)
 {
-	motor_enu_return_state_t enu_return_state = MOTOR_OK; 
-	dio_enu_return_state_t enu_return_state_pin_1 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num1,DIO_PIN_HIGH_LEVEL);
-	dio_enu_return_state_t enu_return_state_pin_2 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num2,DIO_PIN_LOW_LEVEL);
-	if( (enu_return_state_pin_1 == DIO_OK) && (enu_return_state_pin_2 == DIO_OK))
-	{
-		enu_return_state = MOTOR_OK;
-	}
-	else
-	{
-		enu_return_state = MOTOR_NOK;
-	}
-	
-	return enu_return_state;
+	return MOTOR_enuWrite(ptr_str_motor_config, MOTOR_DIR_FORWARD);
 }
 
 /**
  * @brief Turn the motor backward based on the provided configuration.
  *
  * This function controls the motor to rotate in the backward direction by setting the corresponding pins of the specified port.
+ * Both pins change in a single port write, so the H-bridge never sees an intermediate state.
  *
  * @param ptr_str_motor_config Pointer to the motor configuration structure.
  * @return The state of the motor operation.
@@ -83,27 +93,14 @@ motor_enu_return_state_t MOTOR_FORWARD(const motor_str_config_t *ptr_str_motor_c
  */
 motor_enu_return_state_t MOTOR_BACKWARD(const motor_str_config_t *ptr_str_motor_config)
 {
-	motor_enu_return_state_t enu_return_state = MOTOR_OK; 
-	dio_enu_return_state_t enu_return_state_pin_1 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num1,DIO_PIN_LOW_LEVEL);
-	dio_enu_return_state_t enu_return_state_pin_2 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num2,DIO_PIN_HIGH_LEVEL);
-	
-	if( (enu_return_state_pin_1 == DIO_OK) && (enu_return_state_pin_2 == DIO_OK))
-	{
-		enu_return_state = MOTOR_OK;
-	}
-	else
-	{
-		enu_return_state = MOTOR_NOK;
-	}
-	
-	return enu_return_state;
+	return MOTOR_enuWrite(ptr_str_motor_config, MOTOR_DIR_BACKWARD);
 }
 
 
 /**
  * @brief Stop the motor based on the provided configuration.
  *
- * This function stops the motor by setting both pins of the specified port to a low level.
+ * This function stops the motor by setting both pins of the specified port to a low level in a single port write.
  *
  * @param ptr_str_motor_config Pointer to the motor configuration structure.
  * @return The state of the motor operation.
@@ -114,18 +111,58 @@ motor_enu_return_state_t MOTOR_BACKWARD(const motor_str_config_t *ptr_str_motor_
  */
 motor_enu_return_state_t MOTOR_STOP(const motor_str_config_t *ptr_str_motor_config)
 {
-	motor_enu_return_state_t enu_return_state = MOTOR_OK; 
-	dio_enu_return_state_t enu_return_state_pin_1 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num1,DIO_PIN_LOW_LEVEL);
-	dio_enu_return_state_t enu_return_state_pin_2 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num2,DIO_PIN_LOW_LEVEL);
-	
-	if( (enu_return_state_pin_1 == DIO_OK) && (enu_return_state_pin_2 == DIO_OK))
-	{   
-		enu_return_state = MOTOR_OK; 
+	return MOTOR_enuWrite(ptr_str_motor_config, MOTOR_DIR_STOP);
+}
+
+/**
+ * @brief Get the port bits of a motor's inputs and their levels for a direction.
+ *
+ * Lets a caller drive several motors on one port with a single DIO_write_port_masked.
+ *
+ * @param ptr_str_motor_config Pointer to the motor configuration structure.
+ * @param enu_direction The direction.
+ * @param ptr_u8_mask Receives the bits of both motor pins.
+ * @param ptr_u8_levels Receives the levels of both motor pins for the direction.
+ * @return The state of the motor operation.
+ *         - MOTOR_OK: The mask and levels are valid.
+ *         - MOTOR_NOK: A pointer is NULL, or the direction or a pin number is invalid.
+ */
+motor_enu_return_state_t MOTOR_GET_LEVELS(const motor_str_config_t *ptr_str_motor_config, motor_enu_direction_t enu_direction, uint8_t *ptr_u8_mask, uint8_t *ptr_u8_levels)
+{
+	motor_enu_return_state_t enu_return_state = MOTOR_OK;
+	uint8_t u8_pin_1;
+	uint8_t u8_pin_2;
+
+	if((ptr_str_motor_config == NULL) || (ptr_u8_mask == NULL) || (ptr_u8_levels == NULL) ||
+	   (enu_direction >= MOTOR_DIR_MAX) || (ptr_str_motor_config->pin_num1 > PIN7) || (ptr_str_motor_config->pin_num2 > PIN7))
+	{
+		enu_return_state = MOTOR_NOK;
 	}
 	else
+	{
+		u8_pin_1 = (uint8_t)(U8_ONE_VALUE << ptr_str_motor_config->pin_num1);
+		u8_pin_2 = (uint8_t)(U8_ONE_VALUE << ptr_str_motor_config->pin_num2);
+		*ptr_u8_mask = u8_pin_1 | u8_pin_2;
+		*ptr_u8_levels = ((gs_arr_u8_motor_levels[enu_direction] & MOTOR_LEVEL_PIN_1) ? u8_pin_1 : 0u) |
+		                 ((gs_arr_u8_motor_levels[enu_direction] & MOTOR_LEVEL_PIN_2) ? u8_pin_2 : 0u);
+	}
+
+	return enu_return_state;
+}
+
+
+static motor_enu_return_state_t MOTOR_enuWrite(const motor_str_config_t *ptr_str_motor_config, motor_enu_direction_t enu_direction)
+{
+	motor_enu_return_state_t enu_return_state;
+	uint8_t u8_mask;
+	uint8_t u8_levels;
+
+	enu_return_state = MOTOR_GET_LEVELS(ptr_str_motor_config, enu_direction, &u8_mask, &u8_levels);
+	if((enu_return_state == MOTOR_OK) &&
+	   (DIO_write_port_masked(ptr_str_motor_config->port, u8_mask, u8_levels) != DIO_OK))
 	{
 		enu_return_state = MOTOR_NOK;
 	}
-	
+
 	return enu_return_state;
-}
\ No newline at end of file
+}
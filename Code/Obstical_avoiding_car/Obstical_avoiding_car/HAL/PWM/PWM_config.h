@@ -18,4 +18,31 @@
 
 #define PWM_CHANNEL_MAX     5 /**< Maximum number of PWM channels available. */
 
+/**
+ * @brief PWM backends.
+ *
+ * - PWM_BACKEND_SOFTWARE toggles any DIO pins from the 1 ms timing tick (1 ms resolution). All channels
+ *   share one period; the pins of a port rise together in one write and fall in one write per tick.
+ * - PWM_BACKEND_TIMER1 uses the Timer 1 10-bit fast PWM compare outputs OC1A (PD5) and OC1B (PD4):
+ *   1024 duty steps, no CPU cost per period, one independent duty per output. Both outputs share
+ *   the frequency, which is F_CPU / (N * 1024) for a prescaler N of 1, 8, 64, 256 or 1024
+ *   (15625, 1953, 244, 61 or 15 Hz at 16 MHz). The highest one not above the requested frequency is used.
+ */
+#define PWM_BACKEND_SOFTWARE    0
+#define PWM_BACKEND_TIMER1      1
+
+/**
+ * @brief Selected PWM backend.
+ *
+ * PWM_BACKEND_TIMER1 and ULTRASONIC_ENGINE_ICP (ULTRASONIC_config.h) are mutually exclusive, both need Timer 1:
+ * selecting both is a build error.
+ */
+#define PWM_BACKEND             PWM_BACKEND_SOFTWARE
+
+/** @brief Pins of the Timer 1 compare outputs (fixed by the hardware). */
+#define PWM_OC1A_PORT           PORTD
+#define PWM_OC1A_PIN            PIN5
+#define PWM_OC1B_PORT           PORTD
+#define PWM_OC1B_PIN            PIN4
+
 #endif /* PWM_CONFIG_H_ */
\ No newline at end of file
@@ -8,12 +8,16 @@
 
 #ifndef PWM_INTERFACE_H_
 #define PWM_INTERFACE_H_
+#include "PWM_config.h"
 #include "../TIMING/TIMING_interface.h"
 #include "../../MCAL/DIO/DIO_interface.h"
 
 #define PWM_1000_US									1000
 #define PWMM_TO_CONVERT_TO_US						1000
 #define PWMM_TO_CONVERT_FROM_PRESENTAGE				100
+
+/* Number of DIO ports the software PWM engine batches its writes for */
+#define PWM_PORTS_COUNT								(PORTD + 1)
 /************************************************************************************************/
 /*									Enumerated Datatypes										*/
 /************************************************************************************************/
@@ -47,10 +51,12 @@ typedef struct {
     dio_enu_pin_t enu_pin_index;   /**< Pin index of the PWM pin. */
     uint8_t duty_cycle;            /**< Duty cycle of the PWM signal. */
     uint32_t frequency;            /**< Frequency of the PWM signal. */
-    uint16_t t_on;                 /**< Time ON of the PWM signal. */
-    uint16_t cycle_duration;       /**< Duration of a single PWM cycle. */
+    uint16_t t_on;                 /**< Time ON of the PWM signal (ticks, timer counts with the Timer 1 backend). */
+    uint16_t cycle_duration;       /**< Duration of a single PWM cycle (ticks, timer counts with the Timer 1 backend). */
     pwm_state_t pwm_state;         /**< Current state of the PWM channel. */
     uint32_t pwm_tick_ss;          /**< Stored PWM tick snapshot. */
+    uint8_t applied_duty_cycle;    /**< Duty cycle t_on was last computed for. */
+    uint32_t applied_frequency;    /**< Frequency cycle_duration was last computed for. */
 } pwm_str_configuration_t;
 
 
@@ -67,12 +73,17 @@ typedef struct {
  * The cycle duration and time-on (duty cycle) are calculated based on the provided frequency
  * and duty cycle values.
  *
+ * Every initialized channel is served by the same engine: at the start of each period the pins of
+ * the running channels go high (one write per port) and their falling edges are sorted, so the
+ * tick interrupt only does work at the ticks where pins fall. Initializing a channel again only
+ * updates it.
+ *
  * @param ptr_str_pwm_configuration Pointer to the PWM configuration structure.
  * @return The initialization state of the PWM channel.
  *         - PWM_OK: PWM channel initialized successfully.
- *         - PWM_NOK: PWM channel initialization failed due to a NULL configuration pointer.
+ *         - PWM_NOK: NULL configuration pointer, zero frequency, or PWM_CHANNEL_MAX channels are already initialized.
  *
- * @note The PWM configuration structure contains the port, pin, frequency, and duty cycle information.
+ * @note All channels share one period, initializing a channel at another frequency changes it for all.
  */
 pwm_enu_return_state_t pwm_init(pwm_str_configuration_t *ptr_str_pwm_configuration);
 
@@ -92,9 +103,9 @@ void pwm_start_tick(void);
 /**
  * @brief Start the PWM signal generation.
  *
- * This function starts the PWM signal generation for the specified PWM configuration.
- * It sets the PWM state to "PWM_ON", writes a high-level signal to the specified port and pin,
- * and records the current value of the "pwm_tick" variable as the start of the PWM tick count.
+ * This function sets the PWM state to "PWM_ON" and records the current value of the "pwm_tick"
+ * variable. The engine raises the pin at the start of its next period, so the running period
+ * of the other channels is not disturbed.
  *
  * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
  * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
@@ -104,10 +115,7 @@ pwm_enu_return_state_t pwm_start(pwm_str_configuration_t *ptr_str_pwm_configurat
 /**
  * @brief Check the PWM signal generation status.
  *
- * This function checks the status of the PWM signal generation for the specified PWM configuration.
- * It calculates the actual time since the PWM signal started and compares it with the "t_on" and
- * "cycle_duration" values in the configuration. Depending on the comparison, it updates the PWM state
- * and writes appropriate signal levels to the specified port and pin.
+ * The engine serves all channels from the tick interrupt, this function only validates its argument.
  *
  * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
  * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
@@ -118,10 +126,13 @@ pwm_enu_return_state_t pwm_checking(pwm_str_configuration_t *ptr_str_pwm_configu
  * @brief Update PWM frequency or duty cycle and recalculate timing parameters.
  *
  * This function updates the PWM frequency or duty cycle in the specified PWM configuration.
- * It recalculates the "cycle_duration" and "t_on" values based on the new frequency or duty cycle.
+ * It recalculates the "cycle_duration" and "t_on" values based on the new frequency or duty cycle,
+ * or does nothing if neither changed since they were last computed. The engine latches the new
+ * values at the start of its next period, so no period is cut short or stretched; the frequency
+ * applies to all channels.
  *
  * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
- * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
+ * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK" (NULL pointer or zero frequency).
  */
 pwm_enu_return_state_t pwm_change_frequency_or_duty_cycle(pwm_str_configuration_t *ptr_str_pwm_configuration);
 
@@ -130,6 +141,7 @@ pwm_enu_return_state_t pwm_change_frequency_or_duty_cycle(pwm_str_configuration_
  *
  * This function stops the PWM signal by setting the PWM state to OFF, turning off the PWM output,
  * and resetting the PWM tick snapshot. It updates the specified PWM configuration accordingly.
+ * The pin goes low at once; the state is cleared first so the engine cannot raise it again.
  *
  * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
  * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
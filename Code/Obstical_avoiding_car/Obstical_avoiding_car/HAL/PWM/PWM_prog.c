@@ -6,22 +6,147 @@
  */
 
 #include "PWM_interface.h"
-#include "PWM_config.h"
+#include "../ULTRASONIC/ULTRASONIC_config.h"
+
+#if (PWM_BACKEND == PWM_BACKEND_TIMER1) && (ULTRASONIC_ENGINE == ULTRASONIC_ENGINE_ICP)
+#error "The Timer 1 backend and the ICP ranging engine both need Timer 1, select ULTRASONIC_ENGINE_EXTI in ULTRASONIC_config.h"
+#endif
+
+static volatile uint32_t pwm_tick = 0;
+
+#if PWM_BACKEND == PWM_BACKEND_SOFTWARE
+
+/**
+ * @brief Falling edge of the period: the pins of one port that go low at the same tick.
+ */
+typedef struct{
+	uint16_t u16_time;          /**< Tick of the period at which the pins go low. */
+	dio_enu_port_t enu_port;    /**< Port of the pins. */
+	uint8_t u8_mask;            /**< Pins going low, one bit per pin. */
+}pwm_str_edge_t;
+
+/* Registered channels */
 static uint8_t gs_u8_pwm_channel_counter = U8_ZERO_VALUE;
 static pwm_str_configuration_t *gs_arr_str_pwm_configuration[PWM_CHANNEL_MAX] = {NULL};
-static volatile uint32_t pwm_tick = 0;
+
+/* Period of all channels in ticks, as requested by the last pwm_init / pwm_change_frequency_or_duty_cycle */
+static volatile uint16_t gs_u16_pwm_period = U8_ZERO_VALUE;
+
+/* Set once new times are complete, cleared while they are written: the interrupt latches them only when set */
+static volatile uint8_t gs_v_u8_pwm_update_ready = U8_ZERO_VALUE;
+
+/* Period and time ON of each channel latched at the start of the period in progress */
+static uint16_t gs_u16_pwm_latched_period = U8_ZERO_VALUE;
+static uint16_t gs_arr_u16_pwm_latched_t_on[PWM_CHANNEL_MAX];
+
+/* Period in progress: its length, the current tick in it, and its falling edges sorted by time */
+static uint16_t gs_u16_pwm_frame_period = U8_ZERO_VALUE;
+static uint16_t gs_u16_pwm_phase = U8_ZERO_VALUE;
+static pwm_str_edge_t gs_arr_str_pwm_edges[PWM_CHANNEL_MAX];
+static uint8_t gs_u8_pwm_edges_count = U8_ZERO_VALUE;
+static uint8_t gs_u8_pwm_next_edge = U8_ZERO_VALUE;
+
+/**
+ * @brief Start a period: raise the pins of the running channels and sort their falling edges.
+ *
+ * Called from the tick interrupt at tick 0 of every period.
+ */
+static void pwm_vidFrameStart(void);
+
+/**
+ * @brief Compute cycle_duration and t_on in ticks and hand them to the engine.
+ *
+ * Integer arithmetic only. The engine latches the new times at the start of its next period,
+ * so a period in progress always finishes with the times it started with.
+ *
+ * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
+ */
+static void pwm_vidSoftwareSetup(pwm_str_configuration_t *ptr_str_pwm_configuration){
+	uint16_t u16_cycle_duration = (uint16_t)(PWMM_TO_CONVERT_TO_US / ptr_str_pwm_configuration->frequency);
+	uint16_t u16_t_on = (uint16_t)(((uint32_t)ptr_str_pwm_configuration->duty_cycle * u16_cycle_duration) / PWMM_TO_CONVERT_FROM_PRESENTAGE);
+
+	if(u16_t_on > u16_cycle_duration){
+		u16_t_on = u16_cycle_duration;
+	}
+	/* The interrupt does not latch while the times are incomplete */
+	gs_v_u8_pwm_update_ready = U8_ZERO_VALUE;
+	ptr_str_pwm_configuration->cycle_duration = u16_cycle_duration;
+	ptr_str_pwm_configuration->t_on = u16_t_on;
+	gs_u16_pwm_period = u16_cycle_duration;
+	gs_v_u8_pwm_update_ready = U8_ONE_VALUE;
+	ptr_str_pwm_configuration->applied_duty_cycle = ptr_str_pwm_configuration->duty_cycle;
+	ptr_str_pwm_configuration->applied_frequency = ptr_str_pwm_configuration->frequency;
+}
+
+/**
+ * @brief Insert a falling edge in the sorted edge list, merged with an edge of the same tick and port.
+ *
+ * @param[in] u16_time Tick of the period at which the pin goes low.
+ * @param[in] enu_port Port of the pin.
+ * @param[in] u8_mask Pin bit.
+ */
+static void pwm_vidAddEdge(uint16_t u16_time, dio_enu_port_t enu_port, uint8_t u8_mask);
+
+#elif PWM_BACKEND == PWM_BACKEND_TIMER1
+
+/* Timer 1 prescaler divisions, indexed from TIMER_PRESCALLER_0 */
+static const uint16_t gs_arr_u16_timer1_prescallers[] = {1, 8, 64, 256, 1024};
+
+/* Clock setting Timer 1 currently runs with */
+static timer_prescaller_t gs_enu_timer1_prescaller = TIMER_STOP;
+
+/* Configuration driving each compare output */
+static pwm_str_configuration_t *gs_arr_str_timer1_channels[TIMER1_CHANNEL_B + 1] = {NULL};
+
+/**
+ * @brief Find the compare output of a configuration.
+ *
+ * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
+ * @param[out] ptr_enu_channel The compare output driving the configured pin.
+ * @return PWM_OK, or PWM_NOK if the pin is neither OC1A nor OC1B.
+ */
+static pwm_enu_return_state_t pwm_enuTimer1Channel(const pwm_str_configuration_t *ptr_str_pwm_configuration, timer1_enu_channel_t *ptr_enu_channel);
+
+/**
+ * @brief Compute cycle_duration and t_on in timer counts and run Timer 1 at the configured frequency.
+ *
+ * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
+ */
+static void pwm_vidTimer1Setup(pwm_str_configuration_t *ptr_str_pwm_configuration);
+
+/**
+ * @brief Drive a compare output from its configuration's t_on and state.
+ *
+ * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
+ * @param[in] enu_channel The compare output of the configuration.
+ */
+static void pwm_vidTimer1Apply(const pwm_str_configuration_t *ptr_str_pwm_configuration, timer1_enu_channel_t enu_channel);
+
+#else
+#error "PWM_BACKEND must be PWM_BACKEND_SOFTWARE or PWM_BACKEND_TIMER1"
+#endif
 
 void pwm_tick_counter(void){
 	pwm_tick++;
-	for(uint8_t u8_counter=U8_ZERO_VALUE; (u8_counter <= gs_u8_pwm_channel_counter) && (gs_u8_pwm_channel_counter < PWM_CHANNEL_MAX); u8_counter++){
-		
-		pwm_checking(gs_arr_str_pwm_configuration[u8_counter]);
+#if PWM_BACKEND == PWM_BACKEND_SOFTWARE
+	if(gs_u16_pwm_phase == U8_ZERO_VALUE){
+		pwm_vidFrameStart();
+	}else{
+		/* Only the edges due now are visited, one port write per port */
+		while((gs_u8_pwm_next_edge < gs_u8_pwm_edges_count) && (gs_arr_str_pwm_edges[gs_u8_pwm_next_edge].u16_time == gs_u16_pwm_phase)){
+			DIO_write_port_masked(gs_arr_str_pwm_edges[gs_u8_pwm_next_edge].enu_port, gs_arr_str_pwm_edges[gs_u8_pwm_next_edge].u8_mask, U8_ZERO_VALUE);
+			gs_u8_pwm_next_edge++;
+		}
 	}
-	
-	
+	gs_u16_pwm_phase++;
+	if(gs_u16_pwm_phase >= gs_u16_pwm_frame_period){
+		gs_u16_pwm_phase = U8_ZERO_VALUE;
+	}
+#endif
 };
 	
 	
+#if PWM_BACKEND == PWM_BACKEND_SOFTWARE
 
 /**
  * @brief Initialize the PWM channel based on the provided configuration.
@@ -31,33 +156,109 @@ void pwm_tick_counter(void){
  * The cycle duration and time-on (duty cycle) are calculated based on the provided frequency
  * and duty cycle values.
  *
+ * Every initialized channel is served by the same engine: at the start of each period the pins of
+ * the running channels go high (one write per port) and their falling edges are sorted, so the
+ * tick interrupt only does work at the ticks where pins fall. Initializing a channel again only
+ * updates it.
+ *
  * @param ptr_str_pwm_configuration Pointer to the PWM configuration structure.
  * @return The initialization state of the PWM channel.
  *         - PWM_OK: PWM channel initialized successfully.
- *         - PWM_NOK: PWM channel initialization failed due to a NULL configuration pointer.
+ *         - PWM_NOK: NULL configuration pointer, zero frequency, or PWM_CHANNEL_MAX channels are already initialized.
  *
- * @note The PWM configuration structure contains the port, pin, frequency, and duty cycle information.
+ * @note All channels share one period, initializing a channel at another frequency changes it for all.
  */
 
 pwm_enu_return_state_t pwm_init(pwm_str_configuration_t *ptr_str_pwm_configuration){
 	
 	pwm_enu_return_state_t ret = PWM_OK;
+	uint8_t u8_counter;
 	if(ptr_str_pwm_configuration == NULL ){
 		ret =PWM_NOK;
 	}
 	else{
-				
-		DIO_init (ptr_str_pwm_configuration->enu_port_index, ptr_str_pwm_configuration->enu_pin_index, DIO_PIN_OUTPUT);
-		ptr_str_pwm_configuration->cycle_duration = 1/(double)ptr_str_pwm_configuration->frequency*PWMM_TO_CONVERT_TO_US; 
-		ptr_str_pwm_configuration->t_on = (((double)ptr_str_pwm_configuration->duty_cycle)/PWMM_TO_CONVERT_FROM_PRESENTAGE)*(ptr_str_pwm_configuration->cycle_duration);
-		ptr_str_pwm_configuration->pwm_state = PWM_OFF;
-		gs_arr_str_pwm_configuration[gs_u8_pwm_channel_counter] = ptr_str_pwm_configuration;
-		
+		for(u8_counter = U8_ZERO_VALUE; u8_counter < gs_u8_pwm_channel_counter; u8_counter++){
+			if(gs_arr_str_pwm_configuration[u8_counter] == ptr_str_pwm_configuration){
+				break; // Already registered
+			}
+		}
+		if(((u8_counter == gs_u8_pwm_channel_counter) && (gs_u8_pwm_channel_counter >= PWM_CHANNEL_MAX)) ||
+		   (ptr_str_pwm_configuration->frequency == U8_ZERO_VALUE)){
+			ret = PWM_NOK;
+		}else{
+			DIO_init (ptr_str_pwm_configuration->enu_port_index, ptr_str_pwm_configuration->enu_pin_index, DIO_PIN_OUTPUT);
+			ptr_str_pwm_configuration->pwm_state = PWM_OFF;
+			pwm_vidSoftwareSetup(ptr_str_pwm_configuration);
+			if(u8_counter == gs_u8_pwm_channel_counter){
+				/* The slot is filled before the count is published, the interrupt never sees an empty slot */
+				gs_arr_str_pwm_configuration[gs_u8_pwm_channel_counter] = ptr_str_pwm_configuration;
+				gs_u8_pwm_channel_counter++;
+			}
+		}
 	}
 	return ret;
 }
 
 
+static void pwm_vidFrameStart(void){
+	uint8_t arr_u8_port_mask[PWM_PORTS_COUNT] = {U8_ZERO_VALUE};
+	uint8_t arr_u8_port_level[PWM_PORTS_COUNT] = {U8_ZERO_VALUE};
+	const pwm_str_configuration_t *ptr_str_channel;
+	uint8_t u8_counter;
+	uint8_t u8_pin_mask;
+
+	if(gs_v_u8_pwm_update_ready == U8_ONE_VALUE){
+		gs_v_u8_pwm_update_ready = U8_ZERO_VALUE;
+		gs_u16_pwm_latched_period = gs_u16_pwm_period;
+		for(u8_counter = U8_ZERO_VALUE; u8_counter < gs_u8_pwm_channel_counter; u8_counter++){
+			gs_arr_u16_pwm_latched_t_on[u8_counter] = gs_arr_str_pwm_configuration[u8_counter]->t_on;
+		}
+	}
+	gs_u16_pwm_frame_period = gs_u16_pwm_latched_period;
+	gs_u8_pwm_edges_count = U8_ZERO_VALUE;
+	gs_u8_pwm_next_edge = U8_ZERO_VALUE;
+	for(u8_counter = U8_ZERO_VALUE; u8_counter < gs_u8_pwm_channel_counter; u8_counter++){
+		ptr_str_channel = gs_arr_str_pwm_configuration[u8_counter];
+		u8_pin_mask = (uint8_t)(U8_ONE_VALUE << ptr_str_channel->enu_pin_index);
+		arr_u8_port_mask[ptr_str_channel->enu_port_index] |= u8_pin_mask;
+		if((ptr_str_channel->pwm_state == PWM_ON) && (gs_arr_u16_pwm_latched_t_on[u8_counter] != U8_ZERO_VALUE)){
+			arr_u8_port_level[ptr_str_channel->enu_port_index] |= u8_pin_mask;
+			if(gs_arr_u16_pwm_latched_t_on[u8_counter] < gs_u16_pwm_frame_period){
+				pwm_vidAddEdge(gs_arr_u16_pwm_latched_t_on[u8_counter], ptr_str_channel->enu_port_index, u8_pin_mask);
+			}
+		}
+	}
+	/* Stopped channels and channels at 0 % are driven low here as well */
+	for(u8_counter = U8_ZERO_VALUE; u8_counter < PWM_PORTS_COUNT; u8_counter++){
+		if(arr_u8_port_mask[u8_counter] != U8_ZERO_VALUE){
+			DIO_write_port_masked((dio_enu_port_t)u8_counter, arr_u8_port_mask[u8_counter], arr_u8_port_level[u8_counter]);
+		}
+	}
+}
+
+
+static void pwm_vidAddEdge(uint16_t u16_time, dio_enu_port_t enu_port, uint8_t u8_mask){
+	uint8_t u8_counter;
+
+	for(u8_counter = U8_ZERO_VALUE; u8_counter < gs_u8_pwm_edges_count; u8_counter++){
+		if((gs_arr_str_pwm_edges[u8_counter].u16_time == u16_time) && (gs_arr_str_pwm_edges[u8_counter].enu_port == enu_port)){
+			gs_arr_str_pwm_edges[u8_counter].u8_mask |= u8_mask;
+			return;
+		}
+	}
+	/* Insertion sort, the list holds at most PWM_CHANNEL_MAX edges */
+	for(u8_counter = gs_u8_pwm_edges_count; (u8_counter > U8_ZERO_VALUE) && (gs_arr_str_pwm_edges[u8_counter - U8_ONE_VALUE].u16_time > u16_time); u8_counter--){
+		gs_arr_str_pwm_edges[u8_counter] = gs_arr_str_pwm_edges[u8_counter - U8_ONE_VALUE];
+	}
+	gs_arr_str_pwm_edges[u8_counter].u16_time = u16_time;
+	gs_arr_str_pwm_edges[u8_counter].enu_port = enu_port;
+	gs_arr_str_pwm_edges[u8_counter].u8_mask = u8_mask;
+	gs_u8_pwm_edges_count++;
+}
+
+
+
+#endif
 
 /**
  * @brief Start the PWM tick generation using the timing module.
@@ -74,12 +275,14 @@ void pwm_start_tick(void){
 	timing_start();
 }
 
+#if PWM_BACKEND == PWM_BACKEND_SOFTWARE
+
 /**
  * @brief Start the PWM signal generation.
  *
- * This function starts the PWM signal generation for the specified PWM configuration.
- * It sets the PWM state to "PWM_ON", writes a high-level signal to the specified port and pin,
- * and records the current value of the "pwm_tick" variable as the start of the PWM tick count.
+ * This function sets the PWM state to "PWM_ON" and records the current value of the "pwm_tick"
+ * variable. The engine raises the pin at the start of its next period, so the running period
+ * of the other channels is not disturbed.
  *
  * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
  * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
@@ -91,8 +294,9 @@ pwm_enu_return_state_t pwm_start(pwm_str_configuration_t *ptr_str_pwm_configurat
 	}
 	else{
 		ptr_str_pwm_configuration->pwm_state = PWM_ON;
-		DIO_write_pin(ptr_str_pwm_configuration->enu_port_index, ptr_str_pwm_configuration->enu_pin_index, DIO_PIN_HIGH_LEVEL);
-		ptr_str_pwm_configuration->pwm_tick_ss = pwm_tick;
+		do{
+			ptr_str_pwm_configuration->pwm_tick_ss = pwm_tick;
+		}while(ptr_str_pwm_configuration->pwm_tick_ss != pwm_tick);  // The tick interrupt may change it between its bytes
 	}
 	return ret;
 }
@@ -101,10 +305,7 @@ pwm_enu_return_state_t pwm_start(pwm_str_configuration_t *ptr_str_pwm_configurat
 /**
  * @brief Check the PWM signal generation status.
  *
- * This function checks the status of the PWM signal generation for the specified PWM configuration.
- * It calculates the actual time since the PWM signal started and compares it with the "t_on" and
- * "cycle_duration" values in the configuration. Depending on the comparison, it updates the PWM state
- * and writes appropriate signal levels to the specified port and pin.
+ * The engine serves all channels from the tick interrupt, this function only validates its argument.
  *
  * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
  * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
@@ -114,51 +315,32 @@ pwm_enu_return_state_t pwm_checking(pwm_str_configuration_t *ptr_str_pwm_configu
 	if(ptr_str_pwm_configuration == NULL ){
 		ret =PWM_NOK;
 	}
-	else{
-		uint32_t pwm_tick_temp = pwm_tick, actual_time =0;
-		if(ptr_str_pwm_configuration->pwm_tick_ss > pwm_tick_temp){
-			actual_time = MAX_VALUE_UINT32-ptr_str_pwm_configuration->pwm_tick_ss+pwm_tick_temp;
-		}else{
-			actual_time = pwm_tick_temp - ptr_str_pwm_configuration->pwm_tick_ss;
-		}
-		
-		if(ptr_str_pwm_configuration->t_on > actual_time){
-			if(ptr_str_pwm_configuration->pwm_state != PWM_ON){
-				ptr_str_pwm_configuration->pwm_state = PWM_ON;
-				DIO_write_pin(ptr_str_pwm_configuration->enu_port_index, ptr_str_pwm_configuration->enu_pin_index, DIO_PIN_HIGH_LEVEL);
-			}	
-		}else if(ptr_str_pwm_configuration->cycle_duration > actual_time){
-			if(ptr_str_pwm_configuration->pwm_state != PWM_OFF){
-				ptr_str_pwm_configuration->pwm_state = PWM_OFF;
-				DIO_write_pin(ptr_str_pwm_configuration->enu_port_index, ptr_str_pwm_configuration->enu_pin_index, DIO_PIN_LOW_LEVEL);
-			}
-		}else{
-			ptr_str_pwm_configuration->pwm_tick_ss =  pwm_tick_temp;
-		}
-		
-	}
 	return ret;
-	
 }
 
 /**
  * @brief Update PWM frequency or duty cycle and recalculate timing parameters.
  *
  * This function updates the PWM frequency or duty cycle in the specified PWM configuration.
- * It recalculates the "cycle_duration" and "t_on" values based on the new frequency or duty cycle.
+ * It recalculates the "cycle_duration" and "t_on" values based on the new frequency or duty cycle,
+ * or does nothing if neither changed since they were last computed. The engine latches the new
+ * values at the start of its next period, so no period is cut short or stretched; the frequency
+ * applies to all channels.
  *
  * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
- * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
+ * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK" (NULL pointer or zero frequency).
  */
 pwm_enu_return_state_t pwm_change_frequency_or_duty_cycle(pwm_str_configuration_t *ptr_str_pwm_configuration){
 	pwm_enu_return_state_t ret = PWM_OK;
-	if(ptr_str_pwm_configuration == NULL ){
+	if((ptr_str_pwm_configuration == NULL) || (ptr_str_pwm_configuration->frequency == U8_ZERO_VALUE)){
 		ret =PWM_NOK;
 	}
+	else if((ptr_str_pwm_configuration->duty_cycle != ptr_str_pwm_configuration->applied_duty_cycle) ||
+	        (ptr_str_pwm_configuration->frequency != ptr_str_pwm_configuration->applied_frequency)){
+		pwm_vidSoftwareSetup(ptr_str_pwm_configuration);
+	}
 	else{
-		ptr_str_pwm_configuration->cycle_duration = U8_ONE_VALUE/(double)ptr_str_pwm_configuration->frequency*PWMM_TO_CONVERT_TO_US;
-		ptr_str_pwm_configuration->t_on = (((double)ptr_str_pwm_configuration->duty_cycle)/100)*(ptr_str_pwm_configuration->cycle_duration);
-		
+		/* Nothing changed */
 	}
 	return ret;
 }
@@ -168,6 +350,7 @@ pwm_enu_return_state_t pwm_change_frequency_or_duty_cycle(pwm_str_configuration_
  *
  * This function stops the PWM signal by setting the PWM state to OFF, turning off the PWM output,
  * and resetting the PWM tick snapshot. It updates the specified PWM configuration accordingly.
+ * The pin goes low at once; the state is cleared first so the engine cannot raise it again.
  *
  * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
  * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
@@ -178,12 +361,193 @@ pwm_enu_return_state_t pwm_stop(pwm_str_configuration_t *ptr_str_pwm_configurati
 		ret =PWM_NOK;
 	}else{
 		ptr_str_pwm_configuration->pwm_state = PWM_OFF;
+		DIO_write_port_masked(ptr_str_pwm_configuration->enu_port_index, (uint8_t)(U8_ONE_VALUE << ptr_str_pwm_configuration->enu_pin_index), U8_ZERO_VALUE);
+		ptr_str_pwm_configuration->pwm_tick_ss = U8_ZERO_VALUE;
+	}
+	return ret;
+}
+
+#elif PWM_BACKEND == PWM_BACKEND_TIMER1
+
+/**
+ * @brief Initialize the PWM channel based on the provided configuration.
+ *
+ * This function initializes a Timer 1 PWM output based on the provided PWM configuration.
+ * It sets the pin as an output at low level and starts Timer 1 in fast PWM mode at the frequency
+ * closest to (not above) the configured one. The cycle duration and time-on are expressed in
+ * timer counts. The output stays disconnected until pwm_start.
+ *
+ * @param ptr_str_pwm_configuration Pointer to the PWM configuration structure.
+ * @return The initialization state of the PWM channel.
+ *         - PWM_OK: PWM channel initialized successfully.
+ *         - PWM_NOK: NULL configuration pointer, or the pin is neither OC1A (PD5) nor OC1B (PD4).
+ *
+ * @note Both outputs share the timer, initializing one at another frequency changes both.
+ */
+pwm_enu_return_state_t pwm_init(pwm_str_configuration_t *ptr_str_pwm_configuration){
+	pwm_enu_return_state_t ret = PWM_OK;
+	timer1_enu_channel_t enu_channel;
+	if((ptr_str_pwm_configuration == NULL) || (pwm_enuTimer1Channel(ptr_str_pwm_configuration, &enu_channel) != PWM_OK)){
+		ret =PWM_NOK;
+	}
+	else{
+		DIO_init (ptr_str_pwm_configuration->enu_port_index, ptr_str_pwm_configuration->enu_pin_index, DIO_PIN_OUTPUT);
 		DIO_write_pin(ptr_str_pwm_configuration->enu_port_index, ptr_str_pwm_configuration->enu_pin_index, DIO_PIN_LOW_LEVEL);
+		ptr_str_pwm_configuration->pwm_state = PWM_OFF;
+		gs_arr_str_timer1_channels[enu_channel] = ptr_str_pwm_configuration;
+		pwm_vidTimer1Setup(ptr_str_pwm_configuration);
+		pwm_vidTimer1Apply(ptr_str_pwm_configuration, enu_channel);
+	}
+	return ret;
+}
+
+/**
+ * @brief Start the PWM signal generation.
+ *
+ * This function connects the compare output to its pin with the configured duty cycle.
+ * The hardware then produces the waveform without any CPU involvement.
+ *
+ * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
+ * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
+ */
+pwm_enu_return_state_t pwm_start(pwm_str_configuration_t *ptr_str_pwm_configuration){
+	pwm_enu_return_state_t ret = PWM_OK;
+	timer1_enu_channel_t enu_channel;
+	if((ptr_str_pwm_configuration == NULL) || (pwm_enuTimer1Channel(ptr_str_pwm_configuration, &enu_channel) != PWM_OK)){
+		ret =PWM_NOK;
+	}
+	else{
+		ptr_str_pwm_configuration->pwm_state = PWM_ON;
+		pwm_vidTimer1Apply(ptr_str_pwm_configuration, enu_channel);
+	}
+	return ret;
+}
+
+/**
+ * @brief Check the PWM signal generation status.
+ *
+ * The Timer 1 outputs need no servicing, this function only validates its argument.
+ *
+ * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
+ * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
+ */
+pwm_enu_return_state_t pwm_checking(pwm_str_configuration_t *ptr_str_pwm_configuration){
+	pwm_enu_return_state_t ret = PWM_OK;
+	if(ptr_str_pwm_configuration == NULL ){
+		ret =PWM_NOK;
+	}
+	return ret;
+}
+
+/**
+ * @brief Update PWM frequency or duty cycle and recalculate timing parameters.
+ *
+ * This function recalculates the "cycle_duration" and "t_on" values in timer counts, or does nothing
+ * if neither the frequency nor the duty cycle changed since they were last computed. A running output
+ * picks the new duty cycle up at the end of its current period (the compare register is double buffered).
+ *
+ * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
+ * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
+ */
+pwm_enu_return_state_t pwm_change_frequency_or_duty_cycle(pwm_str_configuration_t *ptr_str_pwm_configuration){
+	pwm_enu_return_state_t ret = PWM_OK;
+	timer1_enu_channel_t enu_channel;
+	if((ptr_str_pwm_configuration == NULL) || (pwm_enuTimer1Channel(ptr_str_pwm_configuration, &enu_channel) != PWM_OK)){
+		ret =PWM_NOK;
+	}
+	else if((ptr_str_pwm_configuration->duty_cycle == ptr_str_pwm_configuration->applied_duty_cycle) &&
+	        (ptr_str_pwm_configuration->frequency == ptr_str_pwm_configuration->applied_frequency)){
+		/* Nothing changed */
+	}
+	else{
+		pwm_vidTimer1Setup(ptr_str_pwm_configuration);
+		pwm_vidTimer1Apply(ptr_str_pwm_configuration, enu_channel);
+	}
+	return ret;
+}
+
+/**
+ * @brief Stop the PWM signal by turning off the PWM output and resetting related variables.
+ *
+ * This function disconnects the compare output, so the pin falls back to its low PORT level.
+ *
+ * @param[in] ptr_str_pwm_configuration A pointer to the PWM configuration structure.
+ * @return The return state of the PWM operation, which is either "PWM_OK" or "PWM_NOK".
+ */
+pwm_enu_return_state_t pwm_stop(pwm_str_configuration_t *ptr_str_pwm_configuration){
+	pwm_enu_return_state_t ret = PWM_OK;
+	timer1_enu_channel_t enu_channel;
+	if((ptr_str_pwm_configuration == NULL) || (pwm_enuTimer1Channel(ptr_str_pwm_configuration, &enu_channel) != PWM_OK)){
+		ret =PWM_NOK;
+	}
+	else{
+		ptr_str_pwm_configuration->pwm_state = PWM_OFF;
+		pwm_vidTimer1Apply(ptr_str_pwm_configuration, enu_channel);
 		ptr_str_pwm_configuration->pwm_tick_ss = U8_ZERO_VALUE;
 	}
 	return ret;
 }
 
+
+static pwm_enu_return_state_t pwm_enuTimer1Channel(const pwm_str_configuration_t *ptr_str_pwm_configuration, timer1_enu_channel_t *ptr_enu_channel){
+	pwm_enu_return_state_t ret = PWM_OK;
+	if((ptr_str_pwm_configuration->enu_port_index == PWM_OC1A_PORT) && (ptr_str_pwm_configuration->enu_pin_index == PWM_OC1A_PIN)){
+		*ptr_enu_channel = TIMER1_CHANNEL_A;
+	}else if((ptr_str_pwm_configuration->enu_port_index == PWM_OC1B_PORT) && (ptr_str_pwm_configuration->enu_pin_index == PWM_OC1B_PIN)){
+		*ptr_enu_channel = TIMER1_CHANNEL_B;
+	}else{
+		ret = PWM_NOK;
+	}
+	return ret;
+}
+
+
+static void pwm_vidTimer1Setup(pwm_str_configuration_t *ptr_str_pwm_configuration){
+	timer_prescaller_t enu_prescaller = TIMER_PRESCALLER_1024;
+	uint8_t u8_counter;
+
+	/* Highest available frequency not above the requested one */
+	for(u8_counter = U8_ZERO_VALUE; u8_counter < (TIMER_PRESCALLER_1024 - TIMER_PRESCALLER_0); u8_counter++){
+		if((MCU_CLOCK / ((uint32_t)gs_arr_u16_timer1_prescallers[u8_counter] * (TIMER1_PWM_TOP + 1UL))) <= ptr_str_pwm_configuration->frequency){
+			enu_prescaller = (timer_prescaller_t)(TIMER_PRESCALLER_0 + u8_counter);
+			break;
+		}
+	}
+	ptr_str_pwm_configuration->cycle_duration = TIMER1_PWM_TOP + 1;
+	if(ptr_str_pwm_configuration->duty_cycle >= PWMM_TO_CONVERT_FROM_PRESENTAGE){
+		ptr_str_pwm_configuration->t_on = ptr_str_pwm_configuration->cycle_duration;
+	}else{
+		ptr_str_pwm_configuration->t_on = ((uint32_t)ptr_str_pwm_configuration->duty_cycle * ptr_str_pwm_configuration->cycle_duration) / PWMM_TO_CONVERT_FROM_PRESENTAGE;
+	}
+	ptr_str_pwm_configuration->applied_duty_cycle = ptr_str_pwm_configuration->duty_cycle;
+	ptr_str_pwm_configuration->applied_frequency = ptr_str_pwm_configuration->frequency;
+
+	if(enu_prescaller != gs_enu_timer1_prescaller){
+		/* Restarting the timer disconnects both outputs, restore the other one */
+		gs_enu_timer1_prescaller = enu_prescaller;
+		timer1_pwm_initialization(enu_prescaller);
+		for(u8_counter = TIMER1_CHANNEL_A; u8_counter <= TIMER1_CHANNEL_B; u8_counter++){
+			if((gs_arr_str_timer1_channels[u8_counter] != NULL) && (gs_arr_str_timer1_channels[u8_counter] != ptr_str_pwm_configuration)){
+				pwm_vidTimer1Apply(gs_arr_str_timer1_channels[u8_counter], (timer1_enu_channel_t)u8_counter);
+			}
+		}
+	}
+}
+
+
+static void pwm_vidTimer1Apply(const pwm_str_configuration_t *ptr_str_pwm_configuration, timer1_enu_channel_t enu_channel){
+	if((ptr_str_pwm_configuration->pwm_state == PWM_ON) && (ptr_str_pwm_configuration->t_on != U8_ZERO_VALUE)){
+		/* The pin is high for compare + 1 counts */
+		timer1_pwm_set_compare(enu_channel, ptr_str_pwm_configuration->t_on - U8_ONE_VALUE);
+		timer1_pwm_connect(enu_channel, U8_ONE_VALUE);
+	}else{
+		/* A zero compare would still give a one-count pulse, let the pin follow its low PORT bit */
+		timer1_pwm_connect(enu_channel, U8_ZERO_VALUE);
+	}
+}
+
+#endif
+
 /**
  * @brief End the PWM timing tick.
  *
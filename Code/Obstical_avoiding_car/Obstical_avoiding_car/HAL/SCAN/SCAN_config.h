@@ -0,0 +1,24 @@
+/**
+ * @file SCAN_config.h
+ * @brief Scan Configuration Header File
+ *
+ * This header file provides configuration macros for the servo sweep: the number of angles, the
+ * pings per angle and the age after which a distance is measured again.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef SCAN_CONFIG_H_
+#define SCAN_CONFIG_H_
+
+
+
+#define SCAN_ANGLES_COUNT            7        /**< Angles spread evenly over the servo travel, both ends included (3..8). */
+#define SCAN_PINGS_PER_ANGLE         2        /**< Pings per angle, the shortest echo is kept so a missed edge cannot open a way. */
+#define SCAN_MAX_AGE_MS              2000     /**< Age after which a distance is measured again by the next sweep. */
+
+
+
+#endif
@@ -0,0 +1,129 @@
+/**
+ * @file SCAN_interface.h
+ * @brief Polar distance profile swept by an ultrasonic sensor on a servo.
+ *
+ * A sweep turns the servo through SCAN_ANGLES_COUNT angles, pings the sensor SCAN_PINGS_PER_ANGLE
+ * times at each one once the servo settled, and stores the shortest echo with its timestamp. The
+ * profile is kept across sweeps: a sweep only measures the angles that hold no distance or one older
+ * than SCAN_MAX_AGE_MS, and SCAN_vidRotate shifts the profile when the car turns on the spot, so the
+ * angles still in view are reused. The sensor looks straight ahead again when a sweep ends.
+ *
+ * Headings are in degrees relative to the car axis, positive to the left (counterclockwise).
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef SCAN_INTERFACE_H_
+#define SCAN_INTERFACE_H_
+#include "SCAN_config.h"
+#include "../SERVO/SERVO_interface.h"
+#include "../ULTRASONIC/ULTRASONIC_interface.h"
+
+#if (SCAN_ANGLES_COUNT < 3) || (SCAN_ANGLES_COUNT > 8)
+#error "SCAN_ANGLES_COUNT must be within 3..8"
+#endif
+
+#if (SERVO_RANGE_DEG % (SCAN_ANGLES_COUNT - 1)) != 0
+#error "SERVO_RANGE_DEG must be a multiple of SCAN_ANGLES_COUNT - 1"
+#endif
+
+#if SCAN_PINGS_PER_ANGLE < 1
+#error "SCAN_PINGS_PER_ANGLE must be at least 1"
+#endif
+
+/** @brief Degrees between two angles of the sweep. */
+#define SCAN_STEP_DEG                (SERVO_RANGE_DEG / (SCAN_ANGLES_COUNT - 1))
+
+
+/************************************************************************************************/
+/*									Enumerated Datatypes										*/
+/************************************************************************************************/
+
+/**
+ * @brief Enumeration for scan return states.
+ */
+typedef enum {
+	SCAN_OK,            /**< Function executed successfully. */
+	SCAN_NOK,           /**< Not initialized, or no distance in the profile. */
+	SCAN_BUSY           /**< A sweep is running. */
+} scan_enu_return_state_t;
+
+
+/************************************************************************************************/
+/*									Structure Datatypes											*/
+/************************************************************************************************/
+
+/**
+ * @brief Polar profile, index 0 looks fully right and the last index fully left.
+ */
+typedef struct {
+	uint8_t arr_u8_cm[SCAN_ANGLES_COUNT];       /**< Shortest echo per angle, in whole centimetres. */
+	uint16_t arr_u16_tick[SCAN_ANGLES_COUNT];   /**< Low half of the timing tick each distance was measured at. */
+	uint8_t u8_valid;                           /**< One bit per angle holding a distance. */
+} scan_str_profile_t;
+
+
+/************************************************************************************************/
+/*									Function Prototypes     									*/
+/************************************************************************************************/
+
+/**
+ * @brief Initialize the servo, turn the sensor straight ahead and empty the profile.
+ *
+ * @param ptr_str_sensor Sensor on the servo, initialized with HULTRASONIC_enuInitSensor.
+ * @return SCAN_OK, or SCAN_NOK if ptr_str_sensor is NULL.
+ */
+scan_enu_return_state_t SCAN_enuInit(const hultrasonic_str_config_t *ptr_str_sensor);
+
+/**
+ * @brief Start a sweep over the angles without a recent distance.
+ *
+ * @return SCAN_OK, or SCAN_NOK if the module is not initialized.
+ */
+scan_enu_return_state_t SCAN_enuStart(void);
+
+/**
+ * @brief Run the sweep one step, at most one ping per call.
+ *
+ * To be called periodically while a sweep runs, at least ULTRASONIC_MIN_CYCLE_TICKS apart, with no
+ * other ping of the sensors in between.
+ *
+ * @return SCAN_BUSY while the sweep runs, SCAN_OK once the sensor looks straight ahead again.
+ */
+scan_enu_return_state_t SCAN_enuTick(void);
+
+/**
+ * @brief Stop a sweep and turn the sensor straight ahead, the distances measured so far are kept.
+ */
+void SCAN_vidAbort(void);
+
+/**
+ * @brief Heading with the most room.
+ *
+ * Of equal distances the one closest to straight ahead wins.
+ *
+ * @param ptr_s8_heading Receives the heading in degrees, positive to the left.
+ * @param ptr_u8_cm Receives the distance along it in centimetres.
+ * @return SCAN_OK, SCAN_BUSY while a sweep runs, or SCAN_NOK if a pointer is NULL or the profile is empty.
+ */
+scan_enu_return_state_t SCAN_enuGetBest(sint8_t *ptr_s8_heading, uint8_t *ptr_u8_cm);
+
+/**
+ * @brief Follow a rotation of the car on the spot.
+ *
+ * The profile shifts by the nearest number of steps, the angles that leave the servo travel are dropped.
+ *
+ * @param s16_degrees Rotation of the car in degrees, positive to the left.
+ */
+void SCAN_vidRotate(sint16_t s16_degrees);
+
+/**
+ * @brief Drop the whole profile, for when the car moves.
+ */
+void SCAN_vidInvalidate(void);
+
+
+
+#endif /* SCAN_INTERFACE_H_ */
@@ -0,0 +1,288 @@
+/**
+ * @file SCAN_prog.c
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#include "../TIMING/TIMING_interface.h"
+#include "../../STD_LIB/bit_math.h"
+#include "SCAN_interface.h"
+#include "SCAN_config.h"
+
+/* Angle index and servo angle of straight ahead */
+#define SCAN_CENTER_INDEX            ((SCAN_ANGLES_COUNT - 1) / 2)
+#define SCAN_CENTER_DEG              (SERVO_RANGE_DEG / 2)
+
+/* Heading of an angle index, positive to the left */
+#define SCAN_HEADING(INDEX)          ((sint16_t)((INDEX) * SCAN_STEP_DEG) - SCAN_CENTER_DEG)
+
+/* Bit of an angle index in u8_valid */
+#define SCAN_BIT(INDEX)              ((uint8_t)(U8_ONE_VALUE << (INDEX)))
+
+/* Longest time between two sweeps the 16 bit timestamps can tell apart, in timing ticks */
+#define SCAN_MAX_STAMP_AGE           0x7FFFUL
+
+/* Largest distance a profile entry holds, in centimetres */
+#define SCAN_MAX_CM                  255u
+
+/* Steps of a sweep */
+typedef enum {
+	SCAN_STATE_IDLE,        /* no sweep, the sensor looks straight ahead */
+	SCAN_STATE_MOVE,        /* servo turning to the angle being measured */
+	SCAN_STATE_PING,        /* pinging at the angle being measured */
+	SCAN_STATE_RETURN       /* servo turning back straight ahead */
+} scan_enu_state_t;
+
+static scan_str_profile_t gs_str_profile;
+static const hultrasonic_str_config_t *gs_ptr_str_sensor = NULL;
+static scan_enu_state_t gs_enu_state = SCAN_STATE_IDLE;
+
+/* Tick of the last sweep start, to drop a profile older than the timestamps can tell */
+static uint32_t gs_u32_start_tick = U8_ZERO_VALUE;
+
+/* Angle being measured, pings started and echoes received there, and their shortest distance */
+static uint8_t gs_u8_index = U8_ZERO_VALUE;
+static uint8_t gs_u8_pings = U8_ZERO_VALUE;
+static uint8_t gs_u8_echoes = U8_ZERO_VALUE;
+static uint8_t gs_u8_min_cm = SCAN_MAX_CM;
+
+/* Last echo, written by the echo interrupt */
+static volatile uint8_t gs_v_u8_echo_cm = U8_ZERO_VALUE;
+static volatile uint8_t gs_v_u8_echo_ready = U8_ZERO_VALUE;
+
+/**
+ * @brief Echo interrupt: keeps the distance for the next SCAN_enuTick.
+ */
+static void SCAN_vidEcho(const hultrasonic_str_measurement_t *ptr_str_measurement)
+{
+	if(ptr_str_measurement->distance >= HULTRASONIC_DISTANCE_CM(SCAN_MAX_CM)){
+		gs_v_u8_echo_cm = SCAN_MAX_CM;
+	}else{
+		gs_v_u8_echo_cm = HULTRASONIC_DISTANCE_TO_CM(ptr_str_measurement->distance);
+	}
+	gs_v_u8_echo_ready = U8_ONE_VALUE;
+}
+
+/**
+ * @brief Turn to the next angle from u8_from on without a distance, or back straight ahead.
+ */
+static void SCAN_vidNext(uint8_t u8_from)
+{
+	uint8_t u8_index = u8_from;
+
+	while((u8_index < SCAN_ANGLES_COUNT) && ((gs_str_profile.u8_valid & SCAN_BIT(u8_index)) != U8_ZERO_VALUE)){
+		u8_index++;
+	}
+
+	if(u8_index < SCAN_ANGLES_COUNT){
+		gs_u8_index = u8_index;
+		(void) SERVO_enuSetAngle((uint8_t)(u8_index * SCAN_STEP_DEG));
+		gs_enu_state = SCAN_STATE_MOVE;
+	}else{
+		(void) SERVO_enuSetAngle(SCAN_CENTER_DEG);
+		gs_enu_state = SCAN_STATE_RETURN;
+	}
+}
+
+/**
+ * @brief Initialize the servo, turn the sensor straight ahead and empty the profile.
+ *
+ * @param ptr_str_sensor Sensor on the servo, initialized with HULTRASONIC_enuInitSensor.
+ * @return SCAN_OK, or SCAN_NOK if ptr_str_sensor is NULL.
+ */
+scan_enu_return_state_t SCAN_enuInit(const hultrasonic_str_config_t *ptr_str_sensor)
+{
+	scan_enu_return_state_t enu_return_state = SCAN_OK;
+
+	if(ptr_str_sensor == NULL){
+		enu_return_state = SCAN_NOK;
+	}else{
+		gs_ptr_str_sensor = ptr_str_sensor;
+		gs_str_profile.u8_valid = U8_ZERO_VALUE;
+		gs_enu_state = SCAN_STATE_IDLE;
+		(void) SERVO_enuInit(SCAN_CENTER_DEG);
+	}
+
+	return enu_return_state;
+}
+
+/**
+ * @brief Start a sweep over the angles without a recent distance.
+ *
+ * @return SCAN_OK, or SCAN_NOK if the module is not initialized.
+ */
+scan_enu_return_state_t SCAN_enuStart(void)
+{
+	scan_enu_return_state_t enu_return_state = SCAN_OK;
+	uint32_t u32_now = timing_get_tick_count();
+	uint8_t u8_index;
+
+	if(gs_ptr_str_sensor == NULL){
+		enu_return_state = SCAN_NOK;
+	}else{
+		if((u32_now - gs_u32_start_tick) > SCAN_MAX_STAMP_AGE){
+			gs_str_profile.u8_valid = U8_ZERO_VALUE;
+		}
+		gs_u32_start_tick = u32_now;
+
+		for(u8_index = 0; u8_index < SCAN_ANGLES_COUNT; u8_index++){
+			if((uint16_t)((uint16_t)u32_now - gs_str_profile.arr_u16_tick[u8_index]) > SCAN_MAX_AGE_MS){
+				gs_str_profile.u8_valid &= (uint8_t)~SCAN_BIT(u8_index);
+			}
+		}
+		SCAN_vidNext(U8_ZERO_VALUE);
+	}
+
+	return enu_return_state;
+}
+
+/**
+ * @brief Run the sweep one step, at most one ping per call.
+ *
+ * @return SCAN_BUSY while the sweep runs, SCAN_OK once the sensor looks straight ahead again.
+ */
+scan_enu_return_state_t SCAN_enuTick(void)
+{
+	scan_enu_return_state_t enu_return_state = SCAN_BUSY;
+
+	if((gs_enu_state == SCAN_STATE_MOVE) && (SERVO_u8IsSettled() == U8_ONE_VALUE)){
+		/* An echo of the previous angle has died out while the servo turned */
+		gs_v_u8_echo_ready = U8_ZERO_VALUE;
+		gs_u8_pings = U8_ZERO_VALUE;
+		gs_u8_echoes = U8_ZERO_VALUE;
+		gs_u8_min_cm = SCAN_MAX_CM;
+		gs_enu_state = SCAN_STATE_PING;
+	}
+
+	if(gs_enu_state == SCAN_STATE_PING){
+		if(gs_v_u8_echo_ready == U8_ONE_VALUE){
+			gs_v_u8_echo_ready = U8_ZERO_VALUE;
+			gs_u8_echoes++;
+			if(gs_v_u8_echo_cm < gs_u8_min_cm){
+				gs_u8_min_cm = gs_v_u8_echo_cm;
+			}
+		}
+
+		if(gs_u8_pings < SCAN_PINGS_PER_ANGLE){
+			if(HULTRASONIC_enuStartMeasurement(gs_ptr_str_sensor, SCAN_vidEcho) == HULTRASONIC_OK){
+				gs_u8_pings++;
+			}
+		}else{
+			/* The last echo had a whole call period to come back */
+			if(gs_u8_echoes != U8_ZERO_VALUE){
+				gs_str_profile.arr_u8_cm[gs_u8_index] = gs_u8_min_cm;
+				gs_str_profile.arr_u16_tick[gs_u8_index] = (uint16_t)timing_get_tick_count();
+				gs_str_profile.u8_valid |= SCAN_BIT(gs_u8_index);
+			}
+			SCAN_vidNext((uint8_t)(gs_u8_index + 1u));
+		}
+	}
+
+	if((gs_enu_state == SCAN_STATE_RETURN) && (SERVO_u8IsSettled() == U8_ONE_VALUE)){
+		gs_enu_state = SCAN_STATE_IDLE;
+	}
+
+	if(gs_enu_state == SCAN_STATE_IDLE){
+		enu_return_state = SCAN_OK;
+	}
+
+	return enu_return_state;
+}
+
+/**
+ * @brief Stop a sweep and turn the sensor straight ahead, the distances measured so far are kept.
+ */
+void SCAN_vidAbort(void)
+{
+	(void) SERVO_enuSetAngle(SCAN_CENTER_DEG);
+	gs_enu_state = SCAN_STATE_IDLE;
+}
+
+/**
+ * @brief Heading with the most room.
+ *
+ * @param ptr_s8_heading Receives the heading in degrees, positive to the left.
+ * @param ptr_u8_cm Receives the distance along it in centimetres.
+ * @return SCAN_OK, SCAN_BUSY while a sweep runs, or SCAN_NOK if a pointer is NULL or the profile is empty.
+ */
+scan_enu_return_state_t SCAN_enuGetBest(sint8_t *ptr_s8_heading, uint8_t *ptr_u8_cm)
+{
+	scan_enu_return_state_t enu_return_state = SCAN_NOK;
+	uint8_t u8_index;
+	uint8_t u8_offset;
+	uint8_t u8_best_offset = SCAN_ANGLES_COUNT;
+	uint8_t u8_best_index = U8_ZERO_VALUE;
+	uint8_t u8_best_cm = U8_ZERO_VALUE;
+
+	if((ptr_s8_heading == NULL) || (ptr_u8_cm == NULL)){
+		enu_return_state = SCAN_NOK;
+	}else if(gs_enu_state != SCAN_STATE_IDLE){
+		enu_return_state = SCAN_BUSY;
+	}else{
+		for(u8_index = 0; u8_index < SCAN_ANGLES_COUNT; u8_index++){
+			if((gs_str_profile.u8_valid & SCAN_BIT(u8_index)) != U8_ZERO_VALUE){
+				u8_offset = (u8_index > SCAN_CENTER_INDEX) ? (uint8_t)(u8_index - SCAN_CENTER_INDEX) : (uint8_t)(SCAN_CENTER_INDEX - u8_index);
+				if((gs_str_profile.arr_u8_cm[u8_index] > u8_best_cm) ||
+				   ((gs_str_profile.arr_u8_cm[u8_index] == u8_best_cm) && (u8_offset < u8_best_offset))){
+					u8_best_cm = gs_str_profile.arr_u8_cm[u8_index];
+					u8_best_offset = u8_offset;
+					u8_best_index = u8_index;
+				}
+				enu_return_state = SCAN_OK;
+			}
+		}
+		if(enu_return_state == SCAN_OK){
+			*ptr_s8_heading = (sint8_t)SCAN_HEADING(u8_best_index);
+			*ptr_u8_cm = u8_best_cm;
+		}
+	}
+
+	return enu_return_state;
+}
+
+/**
+ * @brief Follow a rotation of the car on the spot.
+ *
+ * An object at heading h is seen at h - s16_degrees after the rotation, so entry i takes the
+ * distance of entry i + steps.
+ *
+ * @param s16_degrees Rotation of the car in degrees, positive to the left.
+ */
+void SCAN_vidRotate(sint16_t s16_degrees)
+{
+	scan_str_profile_t str_shifted;
+	sint16_t s16_steps;
+	sint16_t s16_source;
+	uint8_t u8_index;
+
+	/* Nearest number of steps */
+	if(s16_degrees >= 0){
+		s16_steps = (sint16_t)((s16_degrees + (SCAN_STEP_DEG / 2)) / SCAN_STEP_DEG);
+	}else{
+		s16_steps = (sint16_t)(-((-s16_degrees + (SCAN_STEP_DEG / 2)) / SCAN_STEP_DEG));
+	}
+
+	str_shifted.u8_valid = U8_ZERO_VALUE;
+	for(u8_index = 0; u8_index < SCAN_ANGLES_COUNT; u8_index++){
+		s16_source = (sint16_t)u8_index + s16_steps;
+		str_shifted.arr_u8_cm[u8_index] = U8_ZERO_VALUE;
+		str_shifted.arr_u16_tick[u8_index] = U8_ZERO_VALUE;
+		if((s16_source >= 0) && (s16_source < SCAN_ANGLES_COUNT) &&
+		   ((gs_str_profile.u8_valid & SCAN_BIT(s16_source)) != U8_ZERO_VALUE)){
+			str_shifted.arr_u8_cm[u8_index] = gs_str_profile.arr_u8_cm[s16_source];
+			str_shifted.arr_u16_tick[u8_index] = gs_str_profile.arr_u16_tick[s16_source];
+			str_shifted.u8_valid |= SCAN_BIT(u8_index);
+		}
+	}
+	gs_str_profile = str_shifted;
+}
+
+/**
+ * @brief Drop the whole profile, for when the car moves.
+ */
+void SCAN_vidInvalidate(void)
+{
+	gs_str_profile.u8_valid = U8_ZERO_VALUE;
+}
@@ -0,0 +1,15 @@
+/**
+ * @file SCHEDULER_config.h
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef SCHEDULER_CONFIG_H_
+#define SCHEDULER_CONFIG_H_
+
+/** @brief Maximum number of tasks in the table given to SCHED_enuInit. */
+#define SCHED_MAX_TASKS             7
+
+#endif /* SCHEDULER_CONFIG_H_ */
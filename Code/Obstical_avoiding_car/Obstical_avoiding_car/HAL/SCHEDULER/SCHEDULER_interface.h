@@ -0,0 +1,96 @@
+/**
+ * @file SCHEDULER_interface.h
+ * @brief Cooperative scheduler running a static task table on the timing_init tick.
+ *
+ * Every task is released once per period, at its offset within the period, counted in timing_init
+ * ticks (about 1 ms each). SCHED_vidRun releases the due tasks and runs the released ones to
+ * completion in table order, so the first entries have the highest priority. Per task it records
+ * the run count, the worst-case execution time and the deadline misses.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef SCHEDULER_INTERFACE_H_
+#define SCHEDULER_INTERFACE_H_
+
+#include "../../STD_LIB/std_types.h"
+#include "../TIMING/TIMING_interface.h"
+#include "SCHEDULER_config.h"
+
+/************************************************************************************************/
+/*									User Defined types									*/
+/************************************************************************************************/
+
+typedef enum{
+	SCHED_OK = 0,
+	SCHED_NOK
+}sched_enu_return_state_t;
+
+/**
+ * @brief One entry of the task table.
+ */
+typedef struct{
+	void (*ptr_task)(void);         /**< Task body, must return without waiting. */
+	uint16_t u16_period;            /**< Release period in ticks, at least 1. */
+	uint16_t u16_offset;            /**< First release in ticks after SCHED_enuInit, spreads tasks with the same period. */
+	uint16_t u16_deadline;          /**< Ticks after its release by which a run must end, 0 for the period. */
+}sched_str_task_t;
+
+/**
+ * @brief Run statistics of one task.
+ *
+ * Execution times are measured with timing_get_time_us(), 16 us resolution. In the host simulator only
+ * register accesses, declared delays and the computation charged with its -c option take time, so with
+ * the default -c 0 most runs last 0 us.
+ */
+typedef struct{
+	uint32_t u32_runs;              /**< Completed runs. */
+	uint32_t u32_wcet_us;           /**< Longest run in microseconds. */
+	uint32_t u32_deadline_misses;   /**< Runs that ended after their deadline plus releases that never ran. */
+}sched_str_task_stats_t;
+
+/************************************************************************************************/
+/*									Function Prototypes											*/
+/************************************************************************************************/
+
+/**
+ * @brief Initialize the scheduler with a task table.
+ *
+ * The table is used in place and must stay valid. The statistics are cleared and the offsets
+ * count from this call. The timing_init tick must run.
+ *
+ * @param ptr_str_tasks Task table, in priority order.
+ * @param u8_count Number of tasks, at most SCHED_MAX_TASKS.
+ * @return SCHED_OK, or SCHED_NOK for a NULL table, a bad count, a NULL task or a zero period.
+ */
+sched_enu_return_state_t SCHED_enuInit(const sched_str_task_t *ptr_str_tasks, uint8_t u8_count);
+
+/**
+ * @brief Release the due tasks and run every released task once.
+ *
+ * Meant to be called from the main loop over and over. Returns at once when no task is due.
+ */
+void SCHED_vidRun(void);
+
+/**
+ * @brief Copy the statistics of one task.
+ *
+ * @param u8_task Index of the task in the table.
+ * @param ptr_str_stats Destination.
+ * @return SCHED_OK, or SCHED_NOK for a bad index or a NULL destination.
+ */
+sched_enu_return_state_t SCHED_enuGetStats(uint8_t u8_task, sched_str_task_stats_t *ptr_str_stats);
+
+/**
+ * @brief Share of the time spent in tasks since SCHED_enuInit.
+ *
+ * 100 minus this value is the CPU headroom left to the main loop. Valid for about 71 minutes
+ * after SCHED_enuInit. Summed from the execution times, see sched_str_task_stats_t.
+ *
+ * @return Load in percent.
+ */
+uint8_t SCHED_u8GetLoadPercent(void);
+
+#endif /* SCHEDULER_INTERFACE_H_ */
@@ -0,0 +1,180 @@
+/**
+ * @file SCHEDULER_prog.c
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+#include "SCHEDULER_interface.h"
+#include "../../MCAL/AVR_ARCH/CPU_interface.h"
+
+/************************************************************************************************/
+/*									Macro Declarations											*/
+/************************************************************************************************/
+
+#define SCHED_PERCENT               100UL
+
+/************************************************************************************************/
+/*									User Defined types									*/
+/************************************************************************************************/
+
+/* Release state of one task */
+typedef struct{
+	uint32_t u32_next_release;      /* tick of the next release */
+	uint32_t u32_release;           /* tick of the pending release */
+	uint8_t u8_ready;               /* released and not run yet */
+}sched_str_task_state_t;
+
+/************************************************************************************************/
+/*									Global variables											*/
+/************************************************************************************************/
+
+/* Task table given to SCHED_enuInit */
+static const sched_str_task_t *gs_ptr_str_tasks = NULL;
+static uint8_t gs_u8_tasks_count = U8_ZERO_VALUE;
+
+/* Per task release state and statistics */
+static sched_str_task_state_t gs_arr_str_task_state[SCHED_MAX_TASKS];
+static sched_str_task_stats_t gs_arr_str_task_stats[SCHED_MAX_TASKS];
+
+/* Time spent in tasks and start of the measurement, in microseconds */
+static uint32_t gs_u32_busy_us = U8_ZERO_VALUE;
+static uint32_t gs_u32_start_us = U8_ZERO_VALUE;
+
+/************************************************************************************************/
+/*									Function Implementation										*/
+/************************************************************************************************/
+
+/**
+ * @brief Initialize the scheduler with a task table.
+ *
+ * @param ptr_str_tasks Task table, in priority order.
+ * @param u8_count Number of tasks, at most SCHED_MAX_TASKS.
+ * @return SCHED_OK, or SCHED_NOK for an invalid table.
+ */
+sched_enu_return_state_t SCHED_enuInit(const sched_str_task_t *ptr_str_tasks, uint8_t u8_count)
+{
+	sched_enu_return_state_t enu_return_state = SCHED_OK;
+	uint32_t u32_now = timing_get_tick_count();
+
+	if((ptr_str_tasks == NULL) || (u8_count == U8_ZERO_VALUE) || (u8_count > SCHED_MAX_TASKS)){
+		enu_return_state = SCHED_NOK;
+	}else{
+		for(uint8_t u8_task = U8_ZERO_VALUE; u8_task < u8_count; u8_task++){
+			if((ptr_str_tasks[u8_task].ptr_task == NULL) || (ptr_str_tasks[u8_task].u16_period == U8_ZERO_VALUE)){
+				enu_return_state = SCHED_NOK;
+			}
+		}
+	}
+	if(enu_return_state == SCHED_OK){
+		gs_ptr_str_tasks = ptr_str_tasks;
+		gs_u8_tasks_count = u8_count;
+		for(uint8_t u8_task = U8_ZERO_VALUE; u8_task < u8_count; u8_task++){
+			gs_arr_str_task_state[u8_task].u32_next_release = u32_now + ptr_str_tasks[u8_task].u16_offset;
+			gs_arr_str_task_state[u8_task].u32_release = U8_ZERO_VALUE;
+			gs_arr_str_task_state[u8_task].u8_ready = U8_ZERO_VALUE;
+			gs_arr_str_task_stats[u8_task].u32_runs = U8_ZERO_VALUE;
+			gs_arr_str_task_stats[u8_task].u32_wcet_us = U8_ZERO_VALUE;
+			gs_arr_str_task_stats[u8_task].u32_deadline_misses = U8_ZERO_VALUE;
+		}
+		gs_u32_busy_us = U8_ZERO_VALUE;
+		gs_u32_start_us = timing_get_time_us();
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Release the due tasks and run every released task once.
+ *
+ * A release that finds the previous one still pending counts as a deadline miss, as do the
+ * releases skipped when the main loop fell behind by more than a period. Without a released
+ * task there is nothing to do until the next interrupt.
+ */
+void SCHED_vidRun(void)
+{
+	uint32_t u32_now = timing_get_tick_count();
+	uint32_t u32_start_us;
+	uint32_t u32_spent_us;
+	uint16_t u16_deadline;
+	sched_str_task_state_t *ptr_str_state;
+	const sched_str_task_t *ptr_str_task;
+	uint8_t u8_released = U8_ZERO_VALUE;
+
+	for(uint8_t u8_task = U8_ZERO_VALUE; u8_task < gs_u8_tasks_count; u8_task++){
+		ptr_str_task = &gs_ptr_str_tasks[u8_task];
+		ptr_str_state = &gs_arr_str_task_state[u8_task];
+		if((sint32_t)(u32_now - ptr_str_state->u32_next_release) >= 0){
+			if(ptr_str_state->u8_ready == U8_ONE_VALUE){
+				gs_arr_str_task_stats[u8_task].u32_deadline_misses++;
+			}
+			while((u32_now - ptr_str_state->u32_next_release) >= ptr_str_task->u16_period){
+				ptr_str_state->u32_next_release += ptr_str_task->u16_period;
+				gs_arr_str_task_stats[u8_task].u32_deadline_misses++;
+			}
+			ptr_str_state->u32_release = ptr_str_state->u32_next_release;
+			ptr_str_state->u32_next_release += ptr_str_task->u16_period;
+			ptr_str_state->u8_ready = U8_ONE_VALUE;
+			u8_released = U8_ONE_VALUE;
+		}
+	}
+
+	if(u8_released == U8_ZERO_VALUE){
+		cpu_idle();
+	}
+
+	for(uint8_t u8_task = U8_ZERO_VALUE; u8_task < gs_u8_tasks_count; u8_task++){
+		ptr_str_task = &gs_ptr_str_tasks[u8_task];
+		ptr_str_state = &gs_arr_str_task_state[u8_task];
+		if(ptr_str_state->u8_ready == U8_ONE_VALUE){
+			ptr_str_state->u8_ready = U8_ZERO_VALUE;
+			u32_start_us = timing_get_time_us();
+			ptr_str_task->ptr_task();
+			u32_spent_us = timing_get_time_us() - u32_start_us;
+
+			gs_u32_busy_us += u32_spent_us;
+			gs_arr_str_task_stats[u8_task].u32_runs++;
+			if(u32_spent_us > gs_arr_str_task_stats[u8_task].u32_wcet_us){
+				gs_arr_str_task_stats[u8_task].u32_wcet_us = u32_spent_us;
+			}
+			u16_deadline = (ptr_str_task->u16_deadline == U8_ZERO_VALUE) ? ptr_str_task->u16_period : ptr_str_task->u16_deadline;
+			if((timing_get_tick_count() - ptr_str_state->u32_release) > u16_deadline){
+				gs_arr_str_task_stats[u8_task].u32_deadline_misses++;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Copy the statistics of one task.
+ *
+ * @param u8_task Index of the task in the table.
+ * @param ptr_str_stats Destination.
+ * @return SCHED_OK, or SCHED_NOK for a bad index or a NULL destination.
+ */
+sched_enu_return_state_t SCHED_enuGetStats(uint8_t u8_task, sched_str_task_stats_t *ptr_str_stats)
+{
+	sched_enu_return_state_t enu_return_state = SCHED_OK;
+
+	if((u8_task >= gs_u8_tasks_count) || (ptr_str_stats == NULL)){
+		enu_return_state = SCHED_NOK;
+	}else{
+		*ptr_str_stats = gs_arr_str_task_stats[u8_task];
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Share of the time spent in tasks since SCHED_enuInit.
+ *
+ * @return Load in percent.
+ */
+uint8_t SCHED_u8GetLoadPercent(void)
+{
+	uint32_t u32_elapsed_us = timing_get_time_us() - gs_u32_start_us;
+	uint8_t u8_load = U8_ZERO_VALUE;
+
+	if(u32_elapsed_us != U8_ZERO_VALUE){
+		u8_load = (uint8_t)(((uint64_t)gs_u32_busy_us * SCHED_PERCENT) / u32_elapsed_us);
+	}
+	return u8_load;
+}
@@ -0,0 +1,30 @@
+/**
+ * @file SERVO_config.h
+ * @brief Servo Configuration Header File
+ *
+ * This header file provides configuration macros for the hobby servo: the signal pin, the frame
+ * period, the pulse widths of both ends of the travel and the speed used to tell when it settled.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef SERVO_CONFIG_H_
+#define SERVO_CONFIG_H_
+
+
+
+#define SERVO_PIN                    PORTD, PIN7  /**< Signal pin of the servo. */
+#define SERVO_FRAME_MS               20       /**< Period at which the application calls SERVO_vidTick, one pulse per call. */
+#define SERVO_MIN_PULSE_US           1000     /**< Pulse width of angle 0, the servo turned fully clockwise. */
+#define SERVO_MAX_PULSE_US           2000     /**< Pulse width of angle SERVO_RANGE_DEG, fully counterclockwise. */
+#define SERVO_RANGE_DEG              180      /**< Travel between the two pulse widths, in degrees (at most 255). */
+#define SERVO_MS_PER_60_DEG          100      /**< Time the servo takes for 60 degrees (0.1 s for an SG90). */
+#define SERVO_SETTLE_MS              40       /**< Added to the travel time before the servo counts as settled. */
+#define SERVO_PRESCALLER             TIMER_PRESCALLER_64  /**< Timer 1 clock when the ranging engine does not start it. */
+#define SERVO_PRESCALLER_DIV         64       /**< Division of SERVO_PRESCALLER, and of ULTRASONIC_ICP_PRESCALLER with the ICP engine. */
+
+
+
+#endif
@@ -0,0 +1,82 @@
+/**
+ * @file SERVO_interface.h
+ * @brief Hobby servo driven from the Timer 1 compare unit B.
+ *
+ * SERVO_vidTick starts one pulse per frame: it raises the signal pin and arms compare unit B on the
+ * free running Timer 1 counter, whose interrupt lowers the pin again. The pulse width is therefore
+ * exact to one timer count (4 us at 16 MHz) whatever the timing tick does, and costs one interrupt
+ * per frame. Timer 1 is shared with the ICP ranging engine, which only uses the input capture and
+ * compare unit A, so the Timer 1 PWM backend cannot be used with the servo.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef SERVO_INTERFACE_H_
+#define SERVO_INTERFACE_H_
+#include "SERVO_config.h"
+#include "../../STD_LIB/std_types.h"
+
+#if SERVO_RANGE_DEG > 255
+#error "SERVO_RANGE_DEG must fit a uint8_t angle"
+#endif
+
+#if SERVO_MAX_PULSE_US <= SERVO_MIN_PULSE_US
+#error "SERVO_MAX_PULSE_US must be above SERVO_MIN_PULSE_US"
+#endif
+
+
+/************************************************************************************************/
+/*									Enumerated Datatypes										*/
+/************************************************************************************************/
+
+/**
+ * @brief Enumeration for servo return states.
+ */
+typedef enum {
+	SERVO_OK,           /**< Function executed successfully. */
+	SERVO_NOK           /**< Angle beyond SERVO_RANGE_DEG, or the servo is not initialized. */
+} servo_enu_return_state_t;
+
+
+/************************************************************************************************/
+/*									Function Prototypes     									*/
+/************************************************************************************************/
+
+/**
+ * @brief Initialize the servo pin and Timer 1, and command a first angle.
+ *
+ * With the EXTI ranging engine Timer 1 is started here, with the ICP engine the ultrasonic driver
+ * starts it. The servo counts as settled once it had the time to cross the whole travel.
+ *
+ * @param u8_angle Angle in degrees, 0 to SERVO_RANGE_DEG.
+ * @return SERVO_OK, or SERVO_NOK if the angle is out of range.
+ */
+servo_enu_return_state_t SERVO_enuInit(uint8_t u8_angle);
+
+/**
+ * @brief Command a new angle, applied from the next pulse on.
+ *
+ * @param u8_angle Angle in degrees, 0 to SERVO_RANGE_DEG.
+ * @return SERVO_OK, or SERVO_NOK if the angle is out of range or the servo is not initialized.
+ */
+servo_enu_return_state_t SERVO_enuSetAngle(uint8_t u8_angle);
+
+/**
+ * @brief Whether the servo had the time to reach the commanded angle.
+ *
+ * Estimated from SERVO_MS_PER_60_DEG and SERVO_SETTLE_MS, the servo gives no feedback.
+ *
+ * @return 1 once settled, 0 while moving.
+ */
+uint8_t SERVO_u8IsSettled(void);
+
+/**
+ * @brief Start the pulse of one frame, to be called every SERVO_FRAME_MS.
+ */
+void SERVO_vidTick(void);
+
+
+
+#endif /* SERVO_INTERFACE_H_ */
@@ -0,0 +1,157 @@
+/**
+ * @file SERVO_prog.c
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#include "../../MCAL/DIO/DIO_interface.h"
+#include "../../MCAL/TIMER/TIMER_interface.h"
+#include "../TIMING/TIMING_interface.h"
+#include "../PWM/PWM_config.h"
+#include "../ULTRASONIC/ULTRASONIC_config.h"
+#include "SERVO_interface.h"
+#include "SERVO_config.h"
+
+#if PWM_BACKEND == PWM_BACKEND_TIMER1
+#error "The servo times its pulses on Timer 1, select PWM_BACKEND_SOFTWARE in PWM_config.h"
+#endif
+
+/* Timer 1 counts in a number of microseconds */
+#define SERVO_US_TO_COUNTS(US)       ((uint16_t)(((uint32_t)(US) * (MCU_CLOCK / 1000000UL)) / SERVO_PRESCALLER_DIV))
+
+/* Pulse width of an angle, in Timer 1 counts */
+#define SERVO_ANGLE_TO_COUNTS(DEG)   SERVO_US_TO_COUNTS(SERVO_MIN_PULSE_US + \
+                                     (((uint32_t)(SERVO_MAX_PULSE_US - SERVO_MIN_PULSE_US) * (DEG)) / SERVO_RANGE_DEG))
+
+/* Travel time of a number of degrees, in timing ticks */
+#define SERVO_TRAVEL_MS(DEG)         ((((uint32_t)(DEG) * SERVO_MS_PER_60_DEG) / 60UL) + SERVO_SETTLE_MS)
+
+/* Pulse width of the next frames, and start and width of the running pulse, read by the interrupt */
+static uint16_t gs_u16_pulse_counts = U8_ZERO_VALUE;
+static volatile uint16_t gs_v_u16_pulse_start = U8_ZERO_VALUE;
+static volatile uint16_t gs_v_u16_pulse_width = U8_ZERO_VALUE;
+
+/* Commanded angle, and start and length of the last move in timing ticks */
+static uint8_t gs_u8_angle = U8_ZERO_VALUE;
+static uint32_t gs_u32_move_tick = U8_ZERO_VALUE;
+static uint32_t gs_u32_move_ticks = U8_ZERO_VALUE;
+
+static uint8_t gs_u8_initialized = U8_ZERO_VALUE;
+
+/**
+ * @brief Compare match B interrupt: ends the pulse.
+ *
+ * A match flag left over from before the arming can fire right away, the pulse only ends once
+ * its width really elapsed on the counter.
+ */
+static void SERVO_vidPulseEnd(void)
+{
+	uint16_t u16_now = U8_ZERO_VALUE;
+
+	(void) timer1_icu_get_counter(&u16_now);
+	if((uint16_t)(u16_now - gs_v_u16_pulse_start) >= gs_v_u16_pulse_width){
+		DIO_write_pin_fast(SERVO_PIN, DIO_PIN_LOW_LEVEL);
+		timer1_icu_disarm_compare_b();
+	}
+}
+
+/**
+ * @brief Command an angle and time its travel from the angle commanded before.
+ */
+static void SERVO_vidMove(uint8_t u8_angle)
+{
+	uint32_t u32_now = timing_get_tick_count();
+	uint32_t u32_elapsed = u32_now - gs_u32_move_tick;
+	uint32_t u32_left = U8_ZERO_VALUE;
+	uint8_t u8_degrees;
+
+	/* A move still under way ends before the new one is timed */
+	if(u32_elapsed < gs_u32_move_ticks){
+		u32_left = gs_u32_move_ticks - u32_elapsed;
+	}
+	u8_degrees = (u8_angle > gs_u8_angle) ? (uint8_t)(u8_angle - gs_u8_angle) : (uint8_t)(gs_u8_angle - u8_angle);
+
+	gs_u8_angle = u8_angle;
+	gs_u16_pulse_counts = SERVO_ANGLE_TO_COUNTS(u8_angle);
+	gs_u32_move_tick = u32_now;
+	gs_u32_move_ticks = u32_left + SERVO_TRAVEL_MS(u8_degrees);
+}
+
+/**
+ * @brief Initialize the servo pin and Timer 1, and command a first angle.
+ *
+ * @param u8_angle Angle in degrees, 0 to SERVO_RANGE_DEG.
+ * @return SERVO_OK, or SERVO_NOK if the angle is out of range.
+ */
+servo_enu_return_state_t SERVO_enuInit(uint8_t u8_angle)
+{
+	servo_enu_return_state_t enu_return_state = SERVO_OK;
+
+	if(u8_angle > SERVO_RANGE_DEG){
+		enu_return_state = SERVO_NOK;
+	}else{
+		DIO_init(SERVO_PIN, DIO_PIN_OUTPUT);
+		DIO_write_pin(SERVO_PIN, DIO_PIN_LOW_LEVEL);
+#if ULTRASONIC_ENGINE != ULTRASONIC_ENGINE_ICP
+		(void) timer1_icu_initialization(SERVO_PRESCALLER, U8_ZERO_VALUE);
+#endif
+		(void) timer1_initialize_callback_COMPB(SERVO_vidPulseEnd);
+
+		/* The position at power up is unknown, allow for the whole travel */
+		gs_u8_angle = (u8_angle < (SERVO_RANGE_DEG / 2u)) ? SERVO_RANGE_DEG : U8_ZERO_VALUE;
+		gs_u32_move_ticks = U8_ZERO_VALUE;
+		SERVO_vidMove(u8_angle);
+		gs_u8_initialized = U8_ONE_VALUE;
+	}
+
+	return enu_return_state;
+}
+
+/**
+ * @brief Command a new angle, applied from the next pulse on.
+ *
+ * @param u8_angle Angle in degrees, 0 to SERVO_RANGE_DEG.
+ * @return SERVO_OK, or SERVO_NOK if the angle is out of range or the servo is not initialized.
+ */
+servo_enu_return_state_t SERVO_enuSetAngle(uint8_t u8_angle)
+{
+	servo_enu_return_state_t enu_return_state = SERVO_OK;
+
+	if((u8_angle > SERVO_RANGE_DEG) || (gs_u8_initialized == U8_ZERO_VALUE)){
+		enu_return_state = SERVO_NOK;
+	}else if(u8_angle != gs_u8_angle){
+		SERVO_vidMove(u8_angle);
+	}else{
+		/* already commanded */
+	}
+
+	return enu_return_state;
+}
+
+/**
+ * @brief Whether the servo had the time to reach the commanded angle.
+ *
+ * @return 1 once settled, 0 while moving.
+ */
+uint8_t SERVO_u8IsSettled(void)
+{
+	return ((timing_get_tick_count() - gs_u32_move_tick) >= gs_u32_move_ticks) ? U8_ONE_VALUE : U8_ZERO_VALUE;
+}
+
+/**
+ * @brief Start the pulse of one frame, to be called every SERVO_FRAME_MS.
+ */
+void SERVO_vidTick(void)
+{
+	uint16_t u16_now = U8_ZERO_VALUE;
+
+	if(gs_u8_initialized == U8_ONE_VALUE){
+		gs_v_u16_pulse_width = gs_u16_pulse_counts;
+		(void) timer1_icu_get_counter(&u16_now);
+		DIO_write_pin_fast(SERVO_PIN, DIO_PIN_HIGH_LEVEL);
+		gs_v_u16_pulse_start = u16_now;
+		timer1_icu_arm_compare_b((uint16_t)(u16_now + gs_v_u16_pulse_width));
+	}
+}
@@ -16,6 +16,20 @@
  */
 #define MCU_CLOCK 16000000UL // CPU frequency
 
+/** @brief Maximum number of extra callbacks that can subscribe to the timing_init tick.
+ *
+ * Besides the callback given to timing_init, other modules (the LCD flusher for instance)
+ * can hook on the same tick with timing_add_tick_callback.
+ */
+#define TIMING_MAX_TICK_CALLBACKS   3
+
+/** @brief Number of slots of the software timer wheel, a power of two.
+ *
+ * Timers are hashed on their expiry tick modulo the slot count, so one slot holds about
+ * (running timers / slots) of them. Longer delays just wrap around the wheel more often.
+ */
+#define TIMING_WHEEL_SLOTS          16
+
 #endif // TIMING_CONFIG_H
 
 
@@ -7,7 +7,7 @@
 
 #ifndef TIMING_INTERFACE_H_
 #define TIMING_INTERFACE_H_
-#include "Timing_config.h"
+#include "TIMING_config.h"
 #include "../../MCAL/TIMER/TIMER_interface.h"
 #include "../../STD_LIB/std_types.h"
 #include "../../STD_LIB/bit_math.h"
@@ -31,6 +31,16 @@
 /* Value representing 1 second in milliseconds */
 #define TIMING_1_SEC_VALUE_IN_MS        1000
 
+/* Slot numbers of the timer wheel */
+#define TIMING_WHEEL_SLOTS_MASK         (TIMING_WHEEL_SLOTS - 1)
+
+#if (TIMING_WHEEL_SLOTS & TIMING_WHEEL_SLOTS_MASK) != 0 || TIMING_WHEEL_SLOTS > 128
+#error "TIMING_WHEEL_SLOTS must be a power of two up to 128"
+#endif
+
+/* Longest timeout whose expiry survives the wrap of the millisecond clock */
+#define TIMING_MAX_TIMEOUT_MS           0x7FFFFFFFUL
+
 /************************************************************************************************/
 /*									Enumerated Datatypes										*/
 /************************************************************************************************/
@@ -53,6 +63,26 @@ typedef enum {
 	TIMING_NOK
 } timing_enu_return_state_t;
 
+/************************************************************************************************/
+/*									Structures Datatypes										*/
+/************************************************************************************************/
+
+/* Independent timeout on the millisecond clock, any number of them can run at once */
+typedef struct {
+	uint32_t u32_start_ms;     /* timing_now_ms at timing_timeout_start */
+	uint32_t u32_duration_ms;  /* Time until the timeout expires */
+} timing_str_timeout_t;
+
+/* Software timer of the timer wheel. The caller owns the memory, the fields belong to the wheel */
+typedef struct timing_str_timer_s {
+	struct timing_str_timer_s *ptr_next;  /* Neighbours in the list of the wheel slot */
+	struct timing_str_timer_s *ptr_prev;
+	void (*ptr_callback)(void);           /* Called when the timer expires */
+	uint32_t u32_period_ticks;            /* Reload in ticks, 0 for a one-shot timer */
+	uint32_t u32_rounds;                  /* Turns of the wheel left before the timer expires */
+	uint8_t u8_slot;                      /* Wheel slot holding the timer, or not running */
+} timing_str_timer_t;
+
 
 
 
@@ -90,14 +120,135 @@ void timing_start(void);
  */
 void timing_stop(void);
 
+/**
+ * @brief Subscribes an extra callback to the tick configured with timing_init.
+ *
+ * The subscribed callbacks are called from the timer interrupt, after the timing_init callback
+ * and after the timer has been reloaded, so their run time does not stretch the tick period.
+ * They must be short. Subscribing the same callback twice has no effect.
+ *
+ * @param callback A pointer to the callback function to be called on every tick.
+ * @return The status of the subscription:
+ *         - TIMING_OK if the callback is subscribed.
+ *         - TIMING_NOK if the callback is NULL or TIMING_MAX_TICK_CALLBACKS are already subscribed.
+ */
+timing_enu_return_state_t timing_add_tick_callback(void (*callback)(void));
+
+/**
+ * @brief Returns the number of ticks of the timing_init tick since start-up.
+ *
+ * With the 1 ms tick set up by the PWM module one count is about one millisecond
+ * (the real period depends on the timer reload value). Safe from interrupt context.
+ *
+ * @return The tick count, wrapping after 2^32 ticks.
+ */
+uint32_t timing_get_tick_count(void);
+
+/**
+ * @brief Returns the time since start-up in microseconds, for measuring short durations.
+ *
+ * Counts whole timing_init ticks plus the Timer 0 counts of the running tick, so the resolution
+ * is one timer count (16 us at 16 MHz). Wraps after about 71 minutes; differences of two readings
+ * stay valid across the wrap. Call it with interrupts enabled.
+ *
+ * @return The time in microseconds.
+ */
+uint32_t timing_get_time_us(void);
+
+/**
+ * @brief Returns the monotonic time since start-up in milliseconds.
+ *
+ * The milliseconds are counted from the actual tick period rather than one per tick, so the
+ * clock does not drift with a tick that is not exactly 1 ms, and the running tick is included
+ * for a resolution of 1 ms. Wraps after about 49.7 days; differences of two readings stay valid
+ * across the wrap. Call it with interrupts enabled.
+ *
+ * @return The time in milliseconds.
+ */
+uint32_t timing_now_ms(void);
+
+/**
+ * @brief Starts (or restarts) a timeout from now.
+ *
+ * @param[out] ptr_str_timeout The timeout handle, owned by the caller.
+ * @param[in] u32_duration_ms Time until the timeout expires, at most 2^31 - 1 ms.
+ * @return The status:
+ *         - TIMING_OK if the timeout is started.
+ *         - TIMING_NOK if the handle is NULL or the duration is too long to survive the wrap.
+ */
+timing_enu_return_state_t timing_timeout_start(timing_str_timeout_t *ptr_str_timeout, uint32_t u32_duration_ms);
+
+/**
+ * @brief Returns the time since a timeout was started.
+ *
+ * @param[in] ptr_str_timeout The timeout handle.
+ * @return The elapsed time in milliseconds, 0 if the handle is NULL.
+ */
+uint32_t timing_timeout_elapsed_ms(const timing_str_timeout_t *ptr_str_timeout);
+
+/**
+ * @brief Checks whether a timeout has expired.
+ *
+ * Unlike timing_time_out the handle is not rearmed, the timeout stays expired until restarted.
+ *
+ * @param[in] ptr_str_timeout The timeout handle.
+ * @return The timeout state:
+ *         - TIMING_TIME_OUT if the duration has passed (or the handle is NULL).
+ *         - TIMING_NOT_TIME_OUT otherwise.
+ */
+timing_enu_timeout_state_t timing_timeout_expired(const timing_str_timeout_t *ptr_str_timeout);
+
+/**
+ * @brief Prepares a software timer of the timer wheel, once before its first use.
+ *
+ * @param[out] ptr_str_timer The timer.
+ * @return TIMING_OK, or TIMING_NOK if the timer is NULL.
+ */
+timing_enu_return_state_t timing_timer_init(timing_str_timer_t *ptr_str_timer);
+
+/**
+ * @brief Starts a one-shot or periodic software timer on the timer wheel.
+ *
+ * The delays are rounded up to whole ticks of timing_init, the callback never comes early.
+ * Any number of timers can run, each costs only its own memory; starting and cancelling take
+ * constant time. A running timer is restarted. Call it from the main loop or from a timer
+ * callback, not from an interrupt.
+ *
+ * @param[inout] ptr_str_timer The timer, prepared with timing_timer_init.
+ * @param[in] u32_delay_ms Time until the first expiry in milliseconds, at least one tick is used.
+ * @param[in] u32_period_ms Time between later expiries in milliseconds, 0 for a one-shot timer.
+ * @param[in] callback The function called (from timing_wheel_process) on every expiry.
+ * @return The status:
+ *         - TIMING_OK if the timer runs.
+ *         - TIMING_NOK if the timer or the callback is NULL.
+ */
+timing_enu_return_state_t timing_timer_start(timing_str_timer_t *ptr_str_timer, uint32_t u32_delay_ms,
+                                             uint32_t u32_period_ms, void (*callback)(void));
+
+/**
+ * @brief Cancels a software timer; its callback is not called any more.
+ *
+ * @param[inout] ptr_str_timer The timer.
+ * @return TIMING_OK, or TIMING_NOK if the timer is NULL or does not run.
+ */
+timing_enu_return_state_t timing_timer_cancel(timing_str_timer_t *ptr_str_timer);
+
+/**
+ * @brief Turns the timer wheel to the current tick and calls the callbacks of the expired timers.
+ *
+ * To be called from the main loop (a scheduler task) at least every few ticks; ticks missed in
+ * between are caught up in order. The callbacks run in the caller's context and may start or
+ * cancel any timer.
+ */
+void timing_wheel_process(void);
 
 
 
 /**
- * @brief Initializes the timing module with a specified time in milliseconds.
+ * @brief Initializes the system tick with a specified period in milliseconds.
  *
- * This function initializes the timing module with the specified time in milliseconds. It calculates
- * the appropriate timer initialization value and configures the timer accordingly. If the specified time
+ * The system tick is counted from the timing_init tick, so Timer 1 stays free for other uses
+ * (hardware PWM). It only advances while the timing_init tick runs. If the specified time
  * is less than 1000 milliseconds, the function returns a TIMING_NOK state, indicating an error.
  *
  * @param u16_time_ms The time in milliseconds for the timing module.
@@ -106,17 +257,16 @@ void timing_stop(void);
 timing_enu_return_state_t timing_init_1(uint16_t u16_time_ms);
 
 /**
- * @brief Starts the timer for timing module 1.
+ * @brief Starts the system tick of timing module 1.
  *
- * This function starts the timer associated with timing module 1 using the configured timer
- * configuration parameters.
+ * This function lets the system tick count again from where it stopped.
  */
 void timing_start_1(void);
 
 /**
- * @brief Stops the timer for timing module 1.
+ * @brief Stops the system tick of timing module 1.
  *
- * This function stops the timer associated with timing module 1.
+ * This function freezes the system tick count.
  */
 void timing_stop_1(void);
 
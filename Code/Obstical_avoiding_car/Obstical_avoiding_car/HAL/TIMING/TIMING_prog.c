@@ -13,15 +13,32 @@
 /* Global variable to hold the configuration settings for a timer */
 timer_configuration_t timer_configuration;
 
-/* Global variable to hold the configuration settings for another timer */
-timer_configuration_t timer_configuration_1;
-
 /* Global variable to hold the configuration settings for yet another timer */
 timer_configuration_t timer_configuration_2;
 
 /* Global variable to store the current system tick count */
 static volatile uint16_t gs_u16_sys_tick = U8_ZERO_VALUE;
 
+/* Number of timing_init ticks since start-up */
+static volatile uint32_t gs_u32_tick_count = U8_ZERO_VALUE;
+
+/* Actual period of the timing_init tick in microseconds */
+static uint16_t gs_u16_tick_us = U8_ZERO_VALUE;
+
+/* Duration of one Timer 0 count of the timing_init tick in microseconds */
+static uint16_t gs_u16_count_us = U8_ZERO_VALUE;
+
+/* Whole milliseconds since start-up and the microseconds past the last one, at the last tick */
+static volatile uint32_t gs_u32_ms_count = U8_ZERO_VALUE;
+static volatile uint16_t gs_u16_ms_remainder_us = U8_ZERO_VALUE;
+
+/* System tick period and the time accumulated towards the next system tick, in microseconds */
+static uint32_t gs_u32_sys_tick_period_us = U8_ZERO_VALUE;
+static uint32_t gs_u32_sys_tick_elapsed_us = U8_ZERO_VALUE;
+
+/* Whether the system tick counts (timing_start_1 / timing_stop_1) */
+static volatile uint8_t gs_u8_sys_tick_running = U8_ZERO_VALUE;
+
 /* Global variable indicating the state of catching a timestamp */
 static timing_enu_take_timestamp_state_t gs_enu_catch_state = TIMING_CATCH;
 
@@ -29,26 +46,110 @@ static timing_enu_take_timestamp_state_t gs_enu_catch_state = TIMING_CATCH;
 static uint16_t gs_u16_timestamp = (uint16_t)U8_ZERO_VALUE;
 
 
+/* Slot of a timer that does not run, and pseudo slot of the timers expired in this tick */
+#define TIMING_WHEEL_SLOT_NONE          0xFF
+#define TIMING_WHEEL_SLOT_EXPIRED       0xFE
+
+/* Timer wheel: one list per slot, the list of expired timers and the tick the wheel stands at */
+static timing_str_timer_t *gs_arr_ptr_wheel_slots[TIMING_WHEEL_SLOTS];
+static timing_str_timer_t *gs_ptr_wheel_expired = NULL;
+static uint32_t gs_u32_wheel_tick = U8_ZERO_VALUE;
+
+
 /* Pointer to a callback function */
 void (*tmp_callBack)(void);
 
+/* Extra callbacks subscribed to the same tick */
+static void (*volatile gs_arr_ptr_tick_callbacks[TIMING_MAX_TICK_CALLBACKS])(void);
+
+/* Number of subscribed extra callbacks */
+static volatile uint8_t gs_u8_tick_callbacks_count = U8_ZERO_VALUE;
+
 
 
 
 
+/* Returns the head of the list a running timer is linked in */
+static timing_str_timer_t **timing_wheel_list(uint8_t u8_slot)
+{
+	return (u8_slot == TIMING_WHEEL_SLOT_EXPIRED) ? &gs_ptr_wheel_expired : &gs_arr_ptr_wheel_slots[u8_slot];
+}
+
+/* Links a timer at the head of a list */
+static void timing_wheel_link(timing_str_timer_t *ptr_str_timer, uint8_t u8_slot)
+{
+	timing_str_timer_t **ptr_ptr_head = timing_wheel_list(u8_slot);
+
+	ptr_str_timer->u8_slot = u8_slot;
+	ptr_str_timer->ptr_prev = NULL;
+	ptr_str_timer->ptr_next = *ptr_ptr_head;
+	if(*ptr_ptr_head != NULL){
+		(*ptr_ptr_head)->ptr_prev = ptr_str_timer;
+	}
+	*ptr_ptr_head = ptr_str_timer;
+}
+
+/* Unlinks a running timer from its list */
+static void timing_wheel_unlink(timing_str_timer_t *ptr_str_timer)
+{
+	if(ptr_str_timer->ptr_prev != NULL){
+		ptr_str_timer->ptr_prev->ptr_next = ptr_str_timer->ptr_next;
+	}else{
+		*timing_wheel_list(ptr_str_timer->u8_slot) = ptr_str_timer->ptr_next;
+	}
+	if(ptr_str_timer->ptr_next != NULL){
+		ptr_str_timer->ptr_next->ptr_prev = ptr_str_timer->ptr_prev;
+	}
+	ptr_str_timer->ptr_next = NULL;
+	ptr_str_timer->ptr_prev = NULL;
+	ptr_str_timer->u8_slot = TIMING_WHEEL_SLOT_NONE;
+}
+
+/* Hashes a timer into the slot of the tick u32_ticks (at least 1) after the wheel position */
+static void timing_wheel_insert(timing_str_timer_t *ptr_str_timer, uint32_t u32_ticks)
+{
+	ptr_str_timer->u32_rounds = (u32_ticks - U8_ONE_VALUE) / TIMING_WHEEL_SLOTS;
+	timing_wheel_link(ptr_str_timer, (uint8_t)((gs_u32_wheel_tick + u32_ticks) & TIMING_WHEEL_SLOTS_MASK));
+}
+
+/* Converts milliseconds to ticks of timing_init, rounded up; q * tick + r keeps the product in 32 bits */
+static uint32_t timing_ms_to_ticks(uint32_t u32_ms)
+{
+	uint32_t u32_ticks = U8_ONE_VALUE;
+
+	if(gs_u16_tick_us != U8_ZERO_VALUE){
+		u32_ticks = ((u32_ms / gs_u16_tick_us) * TIMING_1000_TO_CONVERT_TO_MS) +
+		            ((((u32_ms % gs_u16_tick_us) * TIMING_1000_TO_CONVERT_TO_MS) + gs_u16_tick_us - U8_ONE_VALUE) / gs_u16_tick_us);
+		if(u32_ticks == U8_ZERO_VALUE){
+			u32_ticks = U8_ONE_VALUE;
+		}
+	}
+	return u32_ticks;
+}
+
 /* Callback function for a timer interrupt */
 static void function_callback(void)
 {
 	(*tmp_callBack)(); // Call the user-defined callback function
 	timer_set_tcnt(&timer_configuration); // Reset the timer counter value
+	gs_u32_tick_count++;
+	gs_u16_ms_remainder_us += gs_u16_tick_us;
+	while(gs_u16_ms_remainder_us >= TIMING_1000_TO_CONVERT_TO_MS){
+		gs_u16_ms_remainder_us -= TIMING_1000_TO_CONVERT_TO_MS;
+		gs_u32_ms_count++;
+	}
+	if(gs_u8_sys_tick_running == U8_ONE_VALUE){
+		gs_u32_sys_tick_elapsed_us += gs_u16_tick_us;
+		if(gs_u32_sys_tick_elapsed_us >= gs_u32_sys_tick_period_us){
+			gs_u32_sys_tick_elapsed_us -= gs_u32_sys_tick_period_us;
+			gs_u16_sys_tick++; // Increment the system tick count
+		}
+	}
+	for(uint8_t u8_counter = U8_ZERO_VALUE; u8_counter < gs_u8_tick_callbacks_count; u8_counter++){
+		(*gs_arr_ptr_tick_callbacks[u8_counter])(); // Call the subscribed callbacks
+	}
 }
 
-/* Callback function for another timer interrupt */
-static void function_callback_1(void)
-{
-	gs_u16_sys_tick++; // Increment the system tick count
-	timer1_set_tcnt(&timer_configuration_1); // Reset the timer counter value
-}
 
 
 
@@ -78,6 +179,8 @@ timing_enu_return_state_t timing_init(uint16_t time_us , void (*callback)(void))
 	}else{
 		if(MCU_CLOCK ==0)
 			enu_return_state = TIMING_NOK;
+		gs_u16_tick_us = (uint16_t)((prscaller_max_regiter - timer_init_value) * cycle_time);
+		gs_u16_count_us = (uint16_t)cycle_time;
 		timer_configuration.OCR=timer_init_value;
 		timer_configuration.timer_mode = TIMER_MODE_NORMAL;
 		timer_configuration.timer_prescaller=TIMER_PRESCALLER_256;
@@ -116,12 +219,279 @@ void timing_stop(void) {
 }
 
 
+/**
+ * @brief Subscribes an extra callback to the tick configured with timing_init.
+ *
+ * The subscribed callbacks are called from the timer interrupt, after the timing_init callback
+ * and after the timer has been reloaded, so their run time does not stretch the tick period.
+ * They must be short. Subscribing the same callback twice has no effect.
+ *
+ * @param callback A pointer to the callback function to be called on every tick.
+ * @return The status of the subscription:
+ *         - TIMING_OK if the callback is subscribed.
+ *         - TIMING_NOK if the callback is NULL or TIMING_MAX_TICK_CALLBACKS are already subscribed.
+ */
+timing_enu_return_state_t timing_add_tick_callback(void (*callback)(void)){
+	timing_enu_return_state_t enu_return_state = TIMING_OK;
+	uint8_t u8_counter;
+
+	if(callback == NULL){
+		enu_return_state = TIMING_NOK;
+	}else{
+		for(u8_counter = U8_ZERO_VALUE; u8_counter < gs_u8_tick_callbacks_count; u8_counter++){
+			if(gs_arr_ptr_tick_callbacks[u8_counter] == callback){
+				break; // Already subscribed
+			}
+		}
+		if(u8_counter < gs_u8_tick_callbacks_count){
+			/* do nothing */
+		}else if(gs_u8_tick_callbacks_count >= TIMING_MAX_TICK_CALLBACKS){
+			enu_return_state = TIMING_NOK;
+		}else{
+			/* The slot is filled before the count is published, the ISR never sees an empty slot */
+			gs_arr_ptr_tick_callbacks[gs_u8_tick_callbacks_count] = callback;
+			gs_u8_tick_callbacks_count++;
+		}
+	}
+	return enu_return_state;
+}
+
+
+
+/**
+ * @brief Returns the number of ticks of the timing_init tick since start-up.
+ *
+ * The 32-bit counter is written by the timer interrupt, so it is read until two reads agree
+ * rather than with interrupts disabled; the function is safe from interrupt context as well.
+ *
+ * @return The tick count.
+ */
+uint32_t timing_get_tick_count(void){
+	uint32_t u32_count;
+	do{
+		u32_count = gs_u32_tick_count;
+	}while(u32_count != gs_u32_tick_count);
+	return u32_count;
+}
+
+/**
+ * @brief Returns the time since start-up in microseconds, for measuring short durations.
+ *
+ * The tick count is read again after the timer so that an overflow in between is not missed.
+ * The counter briefly holds values below the reload value right after an overflow, they count as
+ * the start of the tick.
+ *
+ * @return The time in microseconds.
+ */
+uint32_t timing_get_time_us(void){
+	uint32_t u32_count;
+	uint8_t u8_tcnt;
+	uint8_t u8_elapsed;
+	do{
+		u32_count = timing_get_tick_count();
+		timer_get_tcnt(&timer_configuration, &u8_tcnt);
+	}while(u32_count != timing_get_tick_count());
+	u8_elapsed = (u8_tcnt > (uint8_t)timer_configuration.OCR) ? (uint8_t)(u8_tcnt - (uint8_t)timer_configuration.OCR) : U8_ZERO_VALUE;
+	return (u32_count * gs_u16_tick_us) + ((uint32_t)u8_elapsed * gs_u16_count_us);
+}
+
+/**
+ * @brief Returns the monotonic time since start-up in milliseconds.
+ *
+ * The interrupt keeps whole milliseconds and the leftover microseconds of the tick periods;
+ * the Timer 0 counts of the running tick are added to the leftover here. Both variables and the
+ * timer are read again if a tick happened in between.
+ *
+ * @return The time in milliseconds.
+ */
+uint32_t timing_now_ms(void){
+	uint32_t u32_count;
+	uint32_t u32_ms;
+	uint16_t u16_us;
+	uint8_t u8_tcnt;
+	uint8_t u8_elapsed;
+	do{
+		u32_count = timing_get_tick_count();
+		u32_ms = gs_u32_ms_count;
+		u16_us = gs_u16_ms_remainder_us;
+		timer_get_tcnt(&timer_configuration, &u8_tcnt);
+	}while(u32_count != timing_get_tick_count());
+	u8_elapsed = (u8_tcnt > (uint8_t)timer_configuration.OCR) ? (uint8_t)(u8_tcnt - (uint8_t)timer_configuration.OCR) : U8_ZERO_VALUE;
+	u16_us += (uint16_t)u8_elapsed * gs_u16_count_us;
+	while(u16_us >= TIMING_1000_TO_CONVERT_TO_MS){
+		u16_us -= TIMING_1000_TO_CONVERT_TO_MS;
+		u32_ms++;
+	}
+	return u32_ms;
+}
+
+/**
+ * @brief Starts (or restarts) a timeout from now.
+ *
+ * @param[out] ptr_str_timeout The timeout handle, owned by the caller.
+ * @param[in] u32_duration_ms Time until the timeout expires, at most 2^31 - 1 ms.
+ * @return The status:
+ *         - TIMING_OK if the timeout is started.
+ *         - TIMING_NOK if the handle is NULL or the duration is too long to survive the wrap.
+ */
+timing_enu_return_state_t timing_timeout_start(timing_str_timeout_t *ptr_str_timeout, uint32_t u32_duration_ms){
+	timing_enu_return_state_t enu_return_state = TIMING_OK;
+
+	if((ptr_str_timeout == NULL) || (u32_duration_ms > TIMING_MAX_TIMEOUT_MS)){
+		enu_return_state = TIMING_NOK;
+	}else{
+		ptr_str_timeout->u32_start_ms = timing_now_ms();
+		ptr_str_timeout->u32_duration_ms = u32_duration_ms;
+	}
+	return enu_return_state;
+}
 
 /**
- * @brief Initializes the timing module with a specified time in milliseconds.
+ * @brief Returns the time since a timeout was started.
  *
- * This function initializes the timing module with the specified time in milliseconds. It calculates
- * the appropriate timer initialization value and configures the timer accordingly. If the specified time
+ * The unsigned difference is correct across the wrap of the millisecond clock.
+ *
+ * @param[in] ptr_str_timeout The timeout handle.
+ * @return The elapsed time in milliseconds, 0 if the handle is NULL.
+ */
+uint32_t timing_timeout_elapsed_ms(const timing_str_timeout_t *ptr_str_timeout){
+	uint32_t u32_elapsed = U8_ZERO_VALUE;
+
+	if(ptr_str_timeout != NULL){
+		u32_elapsed = timing_now_ms() - ptr_str_timeout->u32_start_ms;
+	}
+	return u32_elapsed;
+}
+
+/**
+ * @brief Checks whether a timeout has expired.
+ *
+ * @param[in] ptr_str_timeout The timeout handle.
+ * @return The timeout state:
+ *         - TIMING_TIME_OUT if the duration has passed (or the handle is NULL).
+ *         - TIMING_NOT_TIME_OUT otherwise.
+ */
+timing_enu_timeout_state_t timing_timeout_expired(const timing_str_timeout_t *ptr_str_timeout){
+	timing_enu_timeout_state_t enu_time_state = TIMING_TIME_OUT;
+
+	if((ptr_str_timeout != NULL) &&
+	   (timing_timeout_elapsed_ms(ptr_str_timeout) < ptr_str_timeout->u32_duration_ms)){
+		enu_time_state = TIMING_NOT_TIME_OUT;
+	}
+	return enu_time_state;
+}
+
+/**
+ * @brief Prepares a software timer of the timer wheel, once before its first use.
+ *
+ * @param[out] ptr_str_timer The timer.
+ * @return TIMING_OK, or TIMING_NOK if the timer is NULL.
+ */
+timing_enu_return_state_t timing_timer_init(timing_str_timer_t *ptr_str_timer){
+	timing_enu_return_state_t enu_return_state = TIMING_OK;
+
+	if(ptr_str_timer == NULL){
+		enu_return_state = TIMING_NOK;
+	}else{
+		ptr_str_timer->ptr_next = NULL;
+		ptr_str_timer->ptr_prev = NULL;
+		ptr_str_timer->ptr_callback = NULL;
+		ptr_str_timer->u32_period_ticks = U8_ZERO_VALUE;
+		ptr_str_timer->u32_rounds = U8_ZERO_VALUE;
+		ptr_str_timer->u8_slot = TIMING_WHEEL_SLOT_NONE;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Starts a one-shot or periodic software timer on the timer wheel.
+ *
+ * The ticks the wheel lags behind the tick count are added to the delay, so the timer counts
+ * from now even if timing_wheel_process has not caught up yet.
+ *
+ * @param[inout] ptr_str_timer The timer, prepared with timing_timer_init.
+ * @param[in] u32_delay_ms Time until the first expiry in milliseconds, at least one tick is used.
+ * @param[in] u32_period_ms Time between later expiries in milliseconds, 0 for a one-shot timer.
+ * @param[in] callback The function called (from timing_wheel_process) on every expiry.
+ * @return The status:
+ *         - TIMING_OK if the timer runs.
+ *         - TIMING_NOK if the timer or the callback is NULL.
+ */
+timing_enu_return_state_t timing_timer_start(timing_str_timer_t *ptr_str_timer, uint32_t u32_delay_ms,
+                                             uint32_t u32_period_ms, void (*callback)(void)){
+	timing_enu_return_state_t enu_return_state = TIMING_OK;
+
+	if((ptr_str_timer == NULL) || (callback == NULL)){
+		enu_return_state = TIMING_NOK;
+	}else{
+		if(ptr_str_timer->u8_slot != TIMING_WHEEL_SLOT_NONE){
+			timing_wheel_unlink(ptr_str_timer);
+		}
+		ptr_str_timer->ptr_callback = callback;
+		ptr_str_timer->u32_period_ticks = (u32_period_ms == U8_ZERO_VALUE) ? U8_ZERO_VALUE : timing_ms_to_ticks(u32_period_ms);
+		timing_wheel_insert(ptr_str_timer, timing_ms_to_ticks(u32_delay_ms) + (timing_get_tick_count() - gs_u32_wheel_tick));
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Cancels a software timer; its callback is not called any more.
+ *
+ * @param[inout] ptr_str_timer The timer.
+ * @return TIMING_OK, or TIMING_NOK if the timer is NULL or does not run.
+ */
+timing_enu_return_state_t timing_timer_cancel(timing_str_timer_t *ptr_str_timer){
+	timing_enu_return_state_t enu_return_state = TIMING_OK;
+
+	if((ptr_str_timer == NULL) || (ptr_str_timer->u8_slot == TIMING_WHEEL_SLOT_NONE)){
+		enu_return_state = TIMING_NOK;
+	}else{
+		timing_wheel_unlink(ptr_str_timer);
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Turns the timer wheel to the current tick and calls the callbacks of the expired timers.
+ *
+ * Per tick only the slot of that tick is visited: its timers either lose one round or move to
+ * the expired list. The callbacks are then called one timer at a time from that list, so a
+ * callback may cancel or restart any timer, including one that expired in the same tick.
+ * Periodic timers are reinserted relative to the tick they were due, so they do not drift.
+ */
+void timing_wheel_process(void){
+	timing_str_timer_t *ptr_str_timer;
+	timing_str_timer_t *ptr_str_next;
+
+	while(gs_u32_wheel_tick != timing_get_tick_count()){
+		gs_u32_wheel_tick++;
+		ptr_str_timer = gs_arr_ptr_wheel_slots[gs_u32_wheel_tick & TIMING_WHEEL_SLOTS_MASK];
+		while(ptr_str_timer != NULL){
+			ptr_str_next = ptr_str_timer->ptr_next;
+			if(ptr_str_timer->u32_rounds == U8_ZERO_VALUE){
+				timing_wheel_unlink(ptr_str_timer);
+				timing_wheel_link(ptr_str_timer, TIMING_WHEEL_SLOT_EXPIRED);
+			}else{
+				ptr_str_timer->u32_rounds--;
+			}
+			ptr_str_timer = ptr_str_next;
+		}
+		while(gs_ptr_wheel_expired != NULL){
+			ptr_str_timer = gs_ptr_wheel_expired;
+			timing_wheel_unlink(ptr_str_timer);
+			if(ptr_str_timer->u32_period_ticks != U8_ZERO_VALUE){
+				timing_wheel_insert(ptr_str_timer, ptr_str_timer->u32_period_ticks);
+			}
+			(*ptr_str_timer->ptr_callback)();
+		}
+	}
+}
+
+/**
+ * @brief Initializes the system tick with a specified period in milliseconds.
+ *
+ * The system tick is counted from the timing_init tick, so Timer 1 stays free for other uses
+ * (hardware PWM). It only advances while the timing_init tick runs. If the specified time
  * is less than 1000 milliseconds, the function returns a TIMING_NOK state, indicating an error.
  *
  * @param u16_time_ms The time in milliseconds for the timing module.
@@ -129,24 +499,14 @@ void timing_stop(void) {
  */
 timing_enu_return_state_t timing_init_1( uint16_t u16_time_ms){
 	
-	volatile uint16_t timer_init_value = U8_ZERO_VALUE;
-	volatile double cycle_time= U8_ZERO_VALUE;
-	volatile uint32_t prescaller = TIMING_PRESCALLER_1024;
-	volatile uint64_t prscaller_max_regiter = TIMING_MAX_U16_VALUE;
 	timing_enu_return_state_t enu_return_state = TIMING_OK;
 
-	cycle_time = ((double)prescaller)/(MCU_CLOCK/TIMING_1000_TO_CONVERT_TO_MS);
-	timer_init_value = ((double)prscaller_max_regiter - ((double)u16_time_ms/cycle_time));
-	
 	if(u16_time_ms < TIMING_1_SEC_VALUE_IN_MS ){
 		enu_return_state =TIMING_NOK;
 	}else{
-		timer_configuration_1.OCR = timer_init_value;
-		timer_configuration_1.timer_mode = TIMER_MODE_NORMAL;
-		timer_configuration_1.timer_prescaller = TIMER_PRESCALLER_1024;
-		timer_configuration_1.timer_of_interrupt =TIMER_OVERFLOW_INTERRUPT_ENABLE;
-		timer1_initialize_callback_OVF(function_callback_1);
-		timer1_initialization(&timer_configuration_1);
+		gs_u8_sys_tick_running = U8_ZERO_VALUE;
+		gs_u32_sys_tick_period_us = (uint32_t)u16_time_ms * TIMING_1000_TO_CONVERT_TO_MS;
+		gs_u32_sys_tick_elapsed_us = U8_ZERO_VALUE;
 	}
 
 	return enu_return_state;
@@ -154,22 +514,21 @@ timing_enu_return_state_t timing_init_1( uint16_t u16_time_ms){
 }
 
 /**
- * @brief Starts the timer for timing module 1.
+ * @brief Starts the system tick of timing module 1.
  *
- * This function starts the timer associated with timing module 1 using the configured timer
- * configuration parameters.
+ * This function lets the system tick count again from where it stopped.
  */
 void timing_start_1(void) {
-	timer1_start(&timer_configuration_1);
+	gs_u8_sys_tick_running = U8_ONE_VALUE;
 }
 
 /**
- * @brief Stops the timer for timing module 1.
+ * @brief Stops the system tick of timing module 1.
  *
- * This function stops the timer associated with timing module 1.
+ * This function freezes the system tick count.
  */
 void timing_stop_1(void){
-	timer1_stop(&timer_configuration_1);
+	gs_u8_sys_tick_running = U8_ZERO_VALUE;
 }
 
 
@@ -229,11 +588,17 @@ void timing_break_time_out(void){
  *
  * This function blocks the program execution for the specified duration in seconds.
  *
+ * It runs on its own timeout handle, so it neither needs the system tick of timing_init_1
+ * nor disturbs a pending timing_time_out.
+ *
  * @param copy_u16_delay The delay duration in seconds.
  */
 void delay_s(uint16_t copy_u16_delay) {
+    timing_str_timeout_t str_delay;
+
+    (void) timing_timeout_start(&str_delay, (uint32_t)copy_u16_delay * TIMING_1_SEC_VALUE_IN_MS);
     // Loop until the specified delay time has passed
-    while (timing_time_out(copy_u16_delay) != TIMING_TIME_OUT) {
+    while (timing_timeout_expired(&str_delay) != TIMING_TIME_OUT) {
         // Do nothing, waiting for the delay to complete
     }
 }
@@ -0,0 +1,21 @@
+/**
+ * @file TTC_config.h
+ * @brief Time-to-collision configuration: slope window, sample gap and closing speed deadband.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef TTC_CONFIG_H_
+#define TTC_CONFIG_H_
+
+
+
+#define TTC_WINDOW_SIZE              4        /**< Samples the closing speed is taken across, oldest to newest (2..8). */
+#define TTC_MAX_GAP_MS               250      /**< Longer gaps between two samples restart the window. */
+#define TTC_MIN_CLOSING_CM_PER_S     3        /**< Slower closing counts as holding the distance. */
+
+
+
+#endif
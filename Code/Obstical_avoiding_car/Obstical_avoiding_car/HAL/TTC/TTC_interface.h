@@ -0,0 +1,102 @@
+/**
+ * @file TTC_interface.h
+ * @brief Closing speed and time-to-collision from timestamped distances.
+ *
+ * Each filtered distance enters a window of TTC_WINDOW_SIZE samples. The closing speed is the
+ * slope between the oldest and the newest sample of the window, over the time between their
+ * timestamps, and the time-to-collision the time the distance needs at that speed to fall to a
+ * margin. Integer math only, one division for the speed and one for the time.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef TTC_INTERFACE_H_
+#define TTC_INTERFACE_H_
+#include "TTC_config.h"
+#include "../ULTRASONIC/ULTRASONIC_interface.h"
+
+#if (TTC_WINDOW_SIZE < 2) || (TTC_WINDOW_SIZE > 8)
+#error "TTC_WINDOW_SIZE must be within 2..8"
+#endif
+
+/** @brief Time-to-collision of a distance that is not closing in. */
+#define TTC_NEVER                    0xFFFFu
+
+
+/************************************************************************************************/
+/*									Enumerated Datatypes										*/
+/************************************************************************************************/
+
+/**
+ * @brief Enumeration for time-to-collision return states.
+ */
+typedef enum {
+	TTC_OK,             /**< Function executed successfully. */
+	TTC_NOK             /**< Invalid argument. */
+} ttc_enu_return_state_t;
+
+/**
+ * @brief Enumeration for the validity of an estimate.
+ */
+typedef enum {
+	TTC_ESTIMATE_NONE,  /**< Fewer than two samples since the window (re)started, the outputs are 0 and TTC_NEVER. */
+	TTC_ESTIMATE_VALID  /**< Closing speed and time-to-collision follow the samples of the window. */
+} ttc_enu_estimate_t;
+
+
+/************************************************************************************************/
+/*									Structure Datatypes											*/
+/************************************************************************************************/
+
+/**
+ * @brief Estimator state, one per sensor. The caller owns the memory, the fields belong to the estimator.
+ */
+typedef struct {
+	hultrasonic_distance_t arr_distance[TTC_WINDOW_SIZE];     /**< Last samples, oldest at u8_index once full. */
+	uint32_t arr_u32_timestamp[TTC_WINDOW_SIZE];              /**< Timing tick of each sample. */
+	uint8_t u8_index;                                         /**< Window slot of the next sample. */
+	uint8_t u8_count;                                         /**< Samples in the window, up to TTC_WINDOW_SIZE. */
+} ttc_str_t;
+
+/**
+ * @brief Result of one estimator step.
+ */
+typedef struct {
+	sint16_t s16_closing_cm_per_s;      /**< Closing speed, negative while the distance grows. */
+	uint16_t u16_ttc_ms;                /**< Time until the margin is reached, 0 once it is, TTC_NEVER if not closing in. */
+	ttc_enu_estimate_t enu_estimate;    /**< Whether the outputs can be acted on. */
+} ttc_str_output_t;
+
+
+/************************************************************************************************/
+/*									Function Prototypes     									*/
+/************************************************************************************************/
+
+/**
+ * @brief Empty an estimator.
+ *
+ * @param ptr_str_ttc Pointer to the estimator state.
+ * @return TTC_OK, or TTC_NOK if ptr_str_ttc is NULL.
+ */
+ttc_enu_return_state_t TTC_enuInit(ttc_str_t *ptr_str_ttc);
+
+/**
+ * @brief Feed one distance and estimate the closing speed and the time-to-collision.
+ *
+ * @param ptr_str_ttc Pointer to the estimator state.
+ * @param distance The filtered distance.
+ * @param u32_timestamp Timing tick of the measurement.
+ * @param margin Distance the time-to-collision counts down to.
+ * @param ptr_str_output Receives the estimate.
+ * @return TTC_OK, or TTC_NOK if a pointer is NULL.
+ *
+ * @note A sample more than TTC_MAX_GAP_MS after the previous one restarts the window.
+ */
+ttc_enu_return_state_t TTC_enuUpdate(ttc_str_t *ptr_str_ttc, hultrasonic_distance_t distance, uint32_t u32_timestamp,
+                                     hultrasonic_distance_t margin, ttc_str_output_t *ptr_str_output);
+
+
+
+#endif /* TTC_INTERFACE_H_ */
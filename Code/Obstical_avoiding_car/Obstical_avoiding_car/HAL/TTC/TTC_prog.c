@@ -0,0 +1,109 @@
+/**
+ * @file TTC_prog.c
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#include "TTC_interface.h"
+#include "TTC_config.h"
+
+/* Milliseconds per second, the timing ticks are about 1 ms each */
+#define TTC_MS_PER_S                 1000L
+
+/* Largest time-to-collision below TTC_NEVER */
+#define TTC_MAX_MS                   (TTC_NEVER - 1u)
+
+/* Distances in Q8.8 centimetres, whatever the distance representation */
+#define TTC_Q8_8_ONE                 256L
+
+#if ULTRASONIC_FIXED_POINT_DISTANCE
+#define TTC_Q8_8(D)                  ((sint32_t)(D))
+#else
+#define TTC_Q8_8(D)                  ((sint32_t)((D) * (hultrasonic_distance_t)TTC_Q8_8_ONE))
+#endif
+
+/**
+ * @brief Empty an estimator.
+ *
+ * @param ptr_str_ttc Pointer to the estimator state.
+ * @return TTC_OK, or TTC_NOK if ptr_str_ttc is NULL.
+ */
+ttc_enu_return_state_t TTC_enuInit(ttc_str_t *ptr_str_ttc)
+{
+	ttc_enu_return_state_t enu_return_state = TTC_OK;
+
+	if(ptr_str_ttc != NULL) {
+		ptr_str_ttc->u8_index = 0;
+		ptr_str_ttc->u8_count = 0;
+	} else {
+		enu_return_state = TTC_NOK;
+	}
+
+	return enu_return_state;
+}
+
+/**
+ * @brief Feed one distance and estimate the closing speed and the time-to-collision.
+ *
+ * @param ptr_str_ttc Pointer to the estimator state.
+ * @param distance The filtered distance.
+ * @param u32_timestamp Timing tick of the measurement.
+ * @param margin Distance the time-to-collision counts down to.
+ * @param ptr_str_output Receives the estimate.
+ * @return TTC_OK, or TTC_NOK if a pointer is NULL.
+ */
+ttc_enu_return_state_t TTC_enuUpdate(ttc_str_t *ptr_str_ttc, hultrasonic_distance_t distance, uint32_t u32_timestamp,
+                                     hultrasonic_distance_t margin, ttc_str_output_t *ptr_str_output)
+{
+	ttc_enu_return_state_t enu_return_state = TTC_OK;
+	sint32_t s32_closing;
+	sint32_t s32_ttc;
+	uint32_t u32_span;
+	uint8_t u8_slot;
+
+	if((ptr_str_ttc != NULL) && (ptr_str_output != NULL)) {
+		/* A gap (the car stopped ranging this sensor) makes the old samples meaningless */
+		if(ptr_str_ttc->u8_count != 0u) {
+			u8_slot = (uint8_t)((ptr_str_ttc->u8_index + TTC_WINDOW_SIZE - 1u) % TTC_WINDOW_SIZE);
+			if((u32_timestamp - ptr_str_ttc->arr_u32_timestamp[u8_slot]) > TTC_MAX_GAP_MS) {
+				ptr_str_ttc->u8_count = 0;
+			}
+		}
+
+		ptr_str_ttc->arr_distance[ptr_str_ttc->u8_index] = distance;
+		ptr_str_ttc->arr_u32_timestamp[ptr_str_ttc->u8_index] = u32_timestamp;
+		ptr_str_ttc->u8_index = (ptr_str_ttc->u8_index + 1u < TTC_WINDOW_SIZE) ? (ptr_str_ttc->u8_index + 1u) : U8_ZERO_VALUE;
+		if(ptr_str_ttc->u8_count < TTC_WINDOW_SIZE) {
+			ptr_str_ttc->u8_count++;
+		}
+
+		ptr_str_output->s16_closing_cm_per_s = 0;
+		ptr_str_output->u16_ttc_ms = TTC_NEVER;
+		ptr_str_output->enu_estimate = TTC_ESTIMATE_NONE;
+
+		/* Slope from the oldest sample of the window to the new one */
+		u8_slot = (uint8_t)((ptr_str_ttc->u8_index + TTC_WINDOW_SIZE - ptr_str_ttc->u8_count) % TTC_WINDOW_SIZE);
+		u32_span = u32_timestamp - ptr_str_ttc->arr_u32_timestamp[u8_slot];
+		if((ptr_str_ttc->u8_count >= 2u) && (u32_span != 0u)) {
+			/* Q8.8 cm/s */
+			s32_closing = ((TTC_Q8_8(ptr_str_ttc->arr_distance[u8_slot]) - TTC_Q8_8(distance)) * TTC_MS_PER_S) / (sint32_t)u32_span;
+			ptr_str_output->s16_closing_cm_per_s = (sint16_t)(s32_closing / TTC_Q8_8_ONE);
+			ptr_str_output->enu_estimate = TTC_ESTIMATE_VALID;
+
+			if(s32_closing >= (TTC_MIN_CLOSING_CM_PER_S * TTC_Q8_8_ONE)) {
+				if(distance <= margin) {
+					ptr_str_output->u16_ttc_ms = 0;
+				} else {
+					s32_ttc = ((TTC_Q8_8(distance) - TTC_Q8_8(margin)) * TTC_MS_PER_S) / s32_closing;
+					ptr_str_output->u16_ttc_ms = (s32_ttc > (sint32_t)TTC_MAX_MS) ? TTC_MAX_MS : (uint16_t)s32_ttc;
+				}
+			}
+		}
+	} else {
+		enu_return_state = TTC_NOK;
+	}
+
+	return enu_return_state;
+}
@@ -7,11 +7,54 @@
 #ifndef ULTRASONIC_CONFIG_H_
 #define ULTRASONIC_CONFIG_H_
 
-/* Configuration for the Trigger pin of the ultrasonic sensor */
-#define TRIG_PIN        PORTB, PIN3
+/* Ranging engines:
+ * - ULTRASONIC_ENGINE_EXTI: echo edges on INT1 (PD3), echo length counted in Timer 2 overflows
+ *   (one interrupt every 16 us while the echo is high).
+ * - ULTRASONIC_ENGINE_ICP: both echo edges timestamped by the Timer 1 input capture unit on ICP1 (PD6),
+ *   two interrupts per measurement. Timer 1 is then owned by the sensor: ULTRASONIC_ENGINE_ICP and
+ *   PWM_BACKEND_TIMER1 (PWM_config.h) are mutually exclusive, selecting both is a build error.
+ */
+#define ULTRASONIC_ENGINE_EXTI      0
+#define ULTRASONIC_ENGINE_ICP       1
+
+/* Selected ranging engine */
+#define ULTRASONIC_ENGINE           ULTRASONIC_ENGINE_ICP
+
+/* Timer 1 clock for the ICP engine: 4 us per count at 16 MHz, the counter wraps after 262 ms,
+   well above the 38 ms no-echo pulse of the HC-SR04 */
+#define ULTRASONIC_ICP_PRESCALLER   TIMER_PRESCALLER_64
+
+/* Distance representation returned by HULTRASONIC_u8Read:
+ * 1: Q8.8 fixed-point centimetres in a uint16_t (1/256 cm steps, saturates at 255.996 cm), integer math only.
+ * 0: float64_t centimetres (soft-float on the AVR, partly inside the echo interrupt).
+ */
+#define ULTRASONIC_FIXED_POINT_DISTANCE     1
+
+/* Maximum range in whole centimetres (1 .. 255): an echo still high after the time sound needs for this
+   distance and back ends the measurement early as beyond range, with the distance set to this range, and
+   the sensor is released at once. 100 cm gives up after about 5.8 ms instead of the 38 ms no-echo pulse.
+   0 waits for every echo to end */
+#define ULTRASONIC_MAX_RANGE_CM             100UL
+
+/* Shortest time between two triggers, in timing ticks (about 1 ms each); a measurement still missing after
+   this time is dropped. The echoes of one ping must die out before the next. The datasheet asks for 60 ms;
+   25 ms is enough here because no trigger goes out while the shared echo line is high, and the HC-SR04 holds
+   it high for its whole listening window, up to 38 ms without an echo, even after a beyond range measurement
+   ended early (see ULTRASONIC_MAX_RANGE_CM). An echo arriving after 25 ms has travelled beyond 4.3 m, past
+   the 4 m rated range, and is faint; a single false reading from it is dropped by the median filter of the
+   application */
+#define ULTRASONIC_MIN_CYCLE_TICKS          25UL
+
+/* Largest number of sensors registered with HULTRASONIC_enuInitSensor, each with its own trigger pin */
+#define ULTRASONIC_MAX_SENSORS      3
 
-/* Configuration for the Signal pin of the ultrasonic sensor */
+/* Configuration for the Signal pin of the ultrasonic sensors: the ECHO outputs of all sensors are combined
+   on it (diode OR), only the sensor triggered last drives it high */
+#if ULTRASONIC_ENGINE == ULTRASONIC_ENGINE_ICP
+#define SIG_PIN         PORTD, PIN6
+#else
 #define SIG_PIN         PORTD, PIN3
+#endif
 
 /* Configuration for an LED indicator */
 #define LED             PORTD, PIN7
@@ -10,15 +10,92 @@
 #ifndef ULTRASONIC_INTERFACE_H_
 #define ULTRASONIC_INTERFACE_H_
 
+#include "../../STD_LIB/std_types.h"
+#include "../../MCAL/TIMER/TIMER_interface.h"
+#include "../../MCAL/DIO/DIO_interface.h"
+#include "ULTRASONIC_config.h"
+
 #define DELAY_10_U     10
 #define CONSTANT_TO_DISTANCE  0.0010718
+/* ICP engine: 4 us per Timer 1 count -> 17150 cm/s * 4e-6 s */
+#define ICP_CONSTANT_TO_DISTANCE  0.0686
+
+/* Fixed-point factors, Q8.8 cm per count scaled by 2^8 so that Q8.8 = (counts * factor) >> 8 */
+#define CONSTANT_TO_DISTANCE_Q8_8       281UL   /* per 4 Timer 2 ticks: 0.0042875 * 256 * 256, EXTI engine */
+#define ICP_CONSTANT_TO_DISTANCE_Q8_8   4496UL  /* per Timer 1 count:   0.0686 * 256 * 256, ICP engine */
+
+/* Largest Q8.8 distance */
+#define HULTRASONIC_Q8_8_MAX            0xFFFFUL
+
+/* Number of fractional bits of a Q8.8 distance */
+#define HULTRASONIC_Q8_8_SHIFT          8
+
+#if ULTRASONIC_MAX_RANGE_CM > 255
+#error "ULTRASONIC_MAX_RANGE_CM must fit the 255 cm of a Q8.8 distance"
+#endif
+
+#if (ULTRASONIC_MAX_SENSORS < 1) || (ULTRASONIC_MAX_SENSORS > 8)
+#error "ULTRASONIC_MAX_SENSORS must be within 1..8"
+#endif
 
 /************************************************************************************************/
 /*									User Defined types									*/
 /************************************************************************************************/
 typedef void(*HULTRASONIC_ptr_func)(void);
 
+#if ULTRASONIC_FIXED_POINT_DISTANCE
+
+/* Distance in Q8.8 fixed-point centimetres */
+typedef uint16_t hultrasonic_distance_t;
+
+/* Distance constant from whole centimetres (0 .. 255) */
+#define HULTRASONIC_DISTANCE_CM(CM)     ((hultrasonic_distance_t)((CM) << HULTRASONIC_Q8_8_SHIFT))
+
+/* Whole centimetres of a distance, truncated */
+#define HULTRASONIC_DISTANCE_TO_CM(D)   ((uint8_t)((D) >> HULTRASONIC_Q8_8_SHIFT))
+
+#else
+
+/* Distance in centimetres */
+typedef float64_t hultrasonic_distance_t;
+
+/* Distance constant from whole centimetres */
+#define HULTRASONIC_DISTANCE_CM(CM)     ((hultrasonic_distance_t)(CM))
+
+/* Whole centimetres of a distance, truncated */
+#define HULTRASONIC_DISTANCE_TO_CM(D)   ((uint8_t)(D))
+
+#endif
 
+/* Return states of the asynchronous ranging API */
+typedef enum{
+	HULTRASONIC_OK = 0,         /* measurement started */
+	HULTRASONIC_BUSY,           /* the previous measurement is still in flight */
+	HULTRASONIC_RATE_LIMITED,   /* less than ULTRASONIC_MIN_CYCLE_TICKS since the previous trigger */
+	HULTRASONIC_NOK             /* NULL or unregistered sensor, or no room to register one */
+}hultrasonic_enu_return_state_t;
+
+/*
+ * One HC-SR04. The sensors take turns on the single ranging engine: each one has its own trigger pin
+ * and their ECHO outputs share SIG_PIN (ULTRASONIC_config.h). One ping is in the air at a time, so
+ * a sensor never hears the ping of another one.
+ */
+typedef struct{
+	dio_enu_port_t enu_trig_port;       /* port of the TRIG pin */
+	dio_enu_pin_t enu_trig_pin;         /* TRIG pin */
+}hultrasonic_str_config_t;
+
+/* Result of one completed measurement */
+typedef struct{
+	const hultrasonic_str_config_t *ptr_str_sensor; /* sensor that measured */
+	hultrasonic_distance_t distance;    /* measured distance */
+	uint16_t u16_seq;                   /* incremented for every completed measurement, wraps */
+	uint32_t u32_timestamp;             /* timing_get_tick_count() at the end of the echo */
+	uint8_t u8_beyond_range;            /* 1 if no echo came back within ULTRASONIC_MAX_RANGE_CM */
+}hultrasonic_str_measurement_t;
+
+/* Completion callback, called from the echo interrupt */
+typedef void(*HULTRASONIC_ptr_complete_func)(const hultrasonic_str_measurement_t *ptr_str_measurement);
 
 
 /************************************************************************************************/
@@ -26,30 +103,61 @@ typedef void(*HULTRASONIC_ptr_func)(void);
 /************************************************************************************************/
 
 /**
- * @brief Initialize the ultrasonic sensor.
+ * @brief Initialize the ranging engine shared by the ultrasonic sensors.
  *
- * This function initializes the ultrasonic sensor by configuring the necessary pins
- * and setting up external interrupt and timing for signal detection and measurement.
+ * This function configures the signal pin and sets up external interrupt and timing for signal
+ * detection and measurement. With the ICP engine (ULTRASONIC_config.h) Timer 1 is started as the
+ * capture time base instead. The sensors themselves are added with HULTRASONIC_enuInitSensor.
  */
 void HULTRASONIC_vidInit(void);
 
+/**
+ * @brief Register an ultrasonic sensor.
+ *
+ * The trigger pin becomes an output driven low. Up to ULTRASONIC_MAX_SENSORS sensors can be registered.
+ *
+ * @param ptr_str_sensor Sensor configuration, must stay valid after the call: measurements refer to it.
+ * @return HULTRASONIC_OK, or HULTRASONIC_NOK for a NULL configuration or a full sensor table.
+ */
+hultrasonic_enu_return_state_t HULTRASONIC_enuInitSensor(const hultrasonic_str_config_t *ptr_str_sensor);
+
+
+/**
+ * @brief Start a measurement without waiting for it.
+ *
+ * The sensor is triggered unless a measurement of any sensor is in flight, the cycle
+ * (ULTRASONIC_MIN_CYCLE_TICKS) since the previous trigger has not elapsed or the echo of a measurement
+ * ended as beyond range is still high; a measurement whose echo has not ended within that cycle is
+ * dropped. An echo longer than ULTRASONIC_MAX_RANGE_CM completes the measurement as beyond range.
+ * When the echo ends, ptr_complete is called from the echo interrupt with the distance, a sequence
+ * number and a timestamp, so it must be short.
+ * Requires the timing_init tick to run.
+ *
+ * @param ptr_str_sensor Registered sensor to trigger.
+ * @param ptr_complete Completion callback, may be NULL to only refresh the value returned by HULTRASONIC_u8Read.
+ * @return HULTRASONIC_OK if the sensor was triggered, HULTRASONIC_BUSY or HULTRASONIC_RATE_LIMITED otherwise,
+ *         HULTRASONIC_NOK for a sensor that was not registered.
+ */
+hultrasonic_enu_return_state_t HULTRASONIC_enuStartMeasurement(const hultrasonic_str_config_t *ptr_str_sensor, HULTRASONIC_ptr_complete_func ptr_complete);
 
 /**
  * @brief Read the distance from the ultrasonic sensor.
  *
- * This function triggers the ultrasonic sensor to measure distance and returns
- * the calculated distance value in centimeters.
+ * This function starts a measurement (subject to the same rate limit as HULTRASONIC_enuStartMeasurement)
+ * and returns the last distance the sensor measured in centimeters, which may be older than the call.
  *
- * @return The calculated distance in centimeters.
+ * @param ptr_str_sensor Registered sensor.
+ * @return The calculated distance in centimeters (Q8.8 fixed point with ULTRASONIC_FIXED_POINT_DISTANCE),
+ *         0 for a sensor that was not registered or has not measured yet.
  */
-float64_t HULTRASONIC_u8Read(void);
+hultrasonic_distance_t HULTRASONIC_u8Read(const hultrasonic_str_config_t *ptr_str_sensor);
 
 
 /**
  * @brief Enable the external interrupt for the ultrasonic sensor.
  *
  * This function enables the external interrupt for the ultrasonic sensor with
- * the specified configuration.
+ * the specified configuration (the Timer 1 capture interrupt with the ICP engine).
  */
 void HULTRASONIC_vidInterruptEnable(void);
 
@@ -58,7 +166,7 @@ void HULTRASONIC_vidInterruptEnable(void);
  * @brief Disable the external interrupt for the ultrasonic sensor.
  *
  * This function disables the external interrupt for the ultrasonic sensor and
- * stops the associated timing.
+ * stops the associated timing (the Timer 1 capture interrupt with the ICP engine).
  */
 void HULTRASONIC_vidInterruptDisable(void);
 
@@ -12,15 +12,82 @@
 #include "../EXTI_manager/EXTI_manager_interface.h"
 #include "../../STD_LIB/std_types.h"
 #include "../../STD_LIB/bit_math.h"
+#include "../../MCAL/TIMER/TIMER_interface.h"
+#include "../../MCAL/AVR_ARCH/CPU_interface.h"
+#include "../PWM/PWM_config.h"
 #include "ULTRASONIC_interface.h"
 #include "ULTRASONIC_config.h"
 
+#if (ULTRASONIC_ENGINE == ULTRASONIC_ENGINE_ICP) && (PWM_BACKEND == PWM_BACKEND_TIMER1)
+#error "ULTRASONIC_ENGINE_ICP and PWM_BACKEND_TIMER1 both need Timer 1, select PWM_BACKEND_SOFTWARE in PWM_config.h or ULTRASONIC_ENGINE_EXTI"
+#endif
+
+#if ULTRASONIC_MAX_RANGE_CM
+/* Echo length of the maximum range, in Timer 2 overflows of 256 CPU clocks (EXTI engine)
+   and in Timer 1 counts (ICP engine), from the Q8.8 factors of ULTRASONIC_interface.h */
+#define ULTRASONIC_MAX_RANGE_OVERFLOWS  ((ULTRASONIC_MAX_RANGE_CM << 10) / CONSTANT_TO_DISTANCE_Q8_8)
+#define ULTRASONIC_MAX_RANGE_COUNTS     ((ULTRASONIC_MAX_RANGE_CM << 16) / ICP_CONSTANT_TO_DISTANCE_Q8_8)
+#endif
+
 
 
 
 /************************************************************************************************/
 /*									Global variables											*/
 /************************************************************************************************/
+/**
+ * @brief Flag to indicate if the ultrasonic sensor measurement is in progress.
+ *
+ * This flag is used to keep track of the state of the ultrasonic sensor measurement process.
+ */
+volatile uint8_t g_v_u8_flag = 0;
+
+/**
+ * @brief Global variable to store calculated distance.
+ *
+ * This variable holds the distance calculated by the engine for the measurement in flight.
+ */
+static volatile hultrasonic_distance_t global_distance;
+
+/**
+ * @brief Registered sensor and the last distance it measured.
+ */
+typedef struct{
+	const hultrasonic_str_config_t *ptr_str_config;
+	hultrasonic_distance_t distance;
+}hultrasonic_str_sensor_t;
+
+/**
+ * @brief Sensors registered with HULTRASONIC_enuInitSensor, and the one whose measurement is in flight.
+ */
+static hultrasonic_str_sensor_t g_arr_str_sensors[ULTRASONIC_MAX_SENSORS];
+static uint8_t g_u8_sensorsCount = 0;
+static hultrasonic_str_sensor_t *g_ptr_str_active = NULL;
+
+/**
+ * @brief Global variable to store ticks for timing measurements.
+ *
+ * This variable holds the number of ticks used for timing measurements.
+ */
+uint32_t global_u32Ticks;
+
+/**
+ * @brief Measurement state of the asynchronous API.
+ *
+ * g_v_u8_busy is set by the trigger and cleared by the echo interrupt, g_u32_triggerTick holds the
+ * timing tick of the last trigger and g_ptr_complete the callback of the measurement in flight.
+ */
+static volatile uint8_t g_v_u8_busy = 0;
+static uint32_t g_u32_triggerTick;
+static HULTRASONIC_ptr_complete_func g_ptr_complete = NULL;
+
+/**
+ * @brief Sequence number of the last completed measurement.
+ */
+static volatile uint16_t g_v_u16_seq = 0;
+
+#if ULTRASONIC_ENGINE == ULTRASONIC_ENGINE_EXTI
+
 /**
  * @brief Global variable to store overflow counts for timing.
  *
@@ -35,13 +102,6 @@ volatile uint32_t g_v_u16_ovfCounts = 0;
  */
 volatile uint16_t g_v_u16_ovf;
 
-/**
- * @brief Flag to indicate if the ultrasonic sensor measurement is in progress.
- *
- * This flag is used to keep track of the state of the ultrasonic sensor measurement process.
- */
-volatile uint8_t g_v_u8_flag = 0;
-
 /**
  * @brief Variable to store capture value.
  *
@@ -49,19 +109,16 @@ volatile uint8_t g_v_u8_flag = 0;
  */
 static uint8_t g_v_u8_cap;
 
-/**
- * @brief Global variable to store calculated distance.
- *
- * This variable holds the calculated distance value based on ultrasonic sensor measurements.
- */
-static double global_f64distance;
+#elif ULTRASONIC_ENGINE == ULTRASONIC_ENGINE_ICP
 
 /**
- * @brief Global variable to store ticks for timing measurements.
- *
- * This variable holds the number of ticks used for timing measurements.
+ * @brief Timer 1 value captured on the rising edge of the echo.
  */
-uint32_t global_u32Ticks;
+static uint16_t g_v_u16_riseCapture;
+
+#else
+#error "ULTRASONIC_ENGINE must be ULTRASONIC_ENGINE_EXTI or ULTRASONIC_ENGINE_ICP"
+#endif
 
 /************************************************************************************************/
 /*										STATIC Function 										*/
@@ -78,14 +135,60 @@ static void delay_10u(void);
  * @brief Signal Calculation Function for Ultrasonic Sensor.
  *
  * This function is used to calculate the signal response time of the ultrasonic sensor.
- * It utilizes the external interrupt and timer to measure the signal time.
+ * It utilizes the external interrupt and timer to measure the signal time
+ * (the Timer 1 input capture unit with the ICP engine).
  */
 static void HULTRASONIC_vidSigCalc(void);
 
+/**
+ * @brief Publish a completed measurement.
+ *
+ * Called by the engines from the echo interrupt once global_distance is updated: advances the
+ * sequence number, releases the sensor and calls the completion callback.
+ *
+ * @param u8_beyond_range 1 if the echo outlasted ULTRASONIC_MAX_RANGE_CM, 0 otherwise.
+ */
+static void HULTRASONIC_vidComplete(uint8_t u8_beyond_range);
+
+/**
+ * @brief Drop a measurement in flight and wait for the rising edge of the next echo.
+ */
+static void HULTRASONIC_vidRearm(void);
+
+/**
+ * @brief Look up a registered sensor.
+ *
+ * @param ptr_str_config Sensor configuration.
+ * @return The entry of the sensor table, NULL if the sensor was not registered.
+ */
+static hultrasonic_str_sensor_t *HULTRASONIC_ptrFind(const hultrasonic_str_config_t *ptr_str_config);
+
+#if ULTRASONIC_MAX_RANGE_CM
+/**
+ * @brief End the measurement in flight as beyond range.
+ *
+ * Called from the interrupt that detects an echo longer than ULTRASONIC_MAX_RANGE_CM: waits for
+ * the rising edge of the next echo again and publishes the maximum range as the distance.
+ */
+static void HULTRASONIC_vidBeyondRange(void);
+#endif
+
+#if ULTRASONIC_FIXED_POINT_DISTANCE
+/**
+ * @brief Clamp a centimetre value to the Q8.8 range.
+ *
+ * @param u32_q8_8 Distance in Q8.8 centimetres, possibly above the 16-bit range.
+ * @return The distance, or HULTRASONIC_Q8_8_MAX if it does not fit.
+ */
+static hultrasonic_distance_t HULTRASONIC_u16Q8_8Saturate(uint32_t u32_q8_8);
+#endif
+
 /************************************************************************************************/
 /*									Functions for CBF										*/
 /************************************************************************************************/
 
+#if ULTRASONIC_ENGINE == ULTRASONIC_ENGINE_EXTI
+
 /**
  * @brief Timer Callback Function for Ultrasonic Sensor.
  *
@@ -95,6 +198,12 @@ static void HULTRASONIC_vidSigCalc(void);
 static void HULTRASONIC_vidTimerCBF(void)
 {
 	g_v_u16_ovfCounts++;
+#if ULTRASONIC_MAX_RANGE_CM
+	if (g_v_u16_ovfCounts >= ULTRASONIC_MAX_RANGE_OVERFLOWS)
+	{
+		HULTRASONIC_vidBeyondRange();
+	}
+#endif
 }
 
 
@@ -104,14 +213,18 @@ static void HULTRASONIC_vidTimerCBF(void)
  * This function calculates the time it takes for the signal from the ultrasonic sensor
  * to travel to an object and back, based on the captured ticks. It uses external interrupt
  * to capture the signal changes and calculates the distance using the sound velocity and
- * tick time.
+ * tick time. Edges while no measurement is in flight are ignored.
  */
 void HULTRASONIC_vidSigCalc(void)
 {
 	extim_str_config_t ptr_str_extim_config;
 	ptr_str_extim_config.enu_exti_interrupt_no= EXTI_1;
 	
-	if (g_v_u8_flag == 0)
+	if ((g_v_u8_busy == 0) || (g_ptr_str_active == NULL))
+	{
+		/* No measurement in flight: a stray edge on the shared echo line, INT1 stays armed for a rising edge */
+	}
+	else if (g_v_u8_flag == 0)
 	{
 		g_v_u8_flag = 1;
 		g_v_u16_ovfCounts = 0;
@@ -134,7 +247,11 @@ void HULTRASONIC_vidSigCalc(void)
 			 total_time = t_ticks * 6.25e-8 sec
 			 distance = (sound_velocity * total_time)/2 -> (343000 * total_time)/2 -> (17150 * t_ticks * 6.25*e-8) -> (t_ticks * 0.0010718)
 		 */		
-		global_f64distance = (double)global_u32Ticks * CONSTANT_TO_DISTANCE;
+#if ULTRASONIC_FIXED_POINT_DISTANCE
+		global_distance = HULTRASONIC_u16Q8_8Saturate(((global_u32Ticks >> 2) * CONSTANT_TO_DISTANCE_Q8_8) >> HULTRASONIC_Q8_8_SHIFT);
+#else
+		global_distance = (double)global_u32Ticks * CONSTANT_TO_DISTANCE;
+#endif
 
 		/*********************  reset global ovf counts and flag    *******************************************/
 		g_v_u16_ovf = 0; g_v_u16_ovfCounts = 0;  g_v_u8_flag = 0;
@@ -145,21 +262,181 @@ void HULTRASONIC_vidSigCalc(void)
 		extim_init(&ptr_str_extim_config, HULTRASONIC_vidSigCalc);
 		extim_enable(&ptr_str_extim_config);
 
+		HULTRASONIC_vidComplete(0);
 	}
 }
 
 /**
- * @brief Disable the external interrupt for the ultrasonic sensor.
+ * @brief Drop a measurement in flight and wait for the rising edge of the next echo.
+ */
+void HULTRASONIC_vidRearm(void)
+{
+	extim_str_config_t ptr_str_extim_config = {.enu_exti_interrupt_no= EXTI_1, .enu_edge_detection= EXTI_RISING_EDGE};
+	timing_stop_2();
+	g_v_u16_ovfCounts = 0;
+	g_v_u8_flag = 0;
+	extim_init(&ptr_str_extim_config, HULTRASONIC_vidSigCalc);
+	extim_enable(&ptr_str_extim_config);
+}
+
+#else
+
+/**
+ * @brief Calculate the signal time of the ultrasonic sensor.
  *
- * This function disables the external interrupt for the ultrasonic sensor and
- * stops the associated timing.
+ * Called from the Timer 1 capture interrupt. The rising edge of the echo stores its timestamp
+ * and arms the capture for the falling edge; the falling edge converts the difference of the two
+ * timestamps to a distance and re-arms the capture for the next rising edge. The hardware latches
+ * the counter on the edge itself, so interrupt latency does not affect the result. Edges while no
+ * measurement is in flight are ignored.
+ */
+void HULTRASONIC_vidSigCalc(void)
+{
+	uint16_t u16_capture = 0;
+
+	(void) timer1_icu_get_capture(&u16_capture);
+	if ((g_v_u8_busy == 0) || (g_ptr_str_active == NULL))
+	{
+		/* No measurement in flight: a stray edge on the shared echo line, the capture stays armed for a rising edge */
+	}
+	else if (g_v_u8_flag == 0)
+	{
+		g_v_u16_riseCapture = u16_capture;
+		g_v_u8_flag = 1;
+		(void) timer1_icu_set_edge(TIMER1_ICU_FALLING_EDGE);
+#if ULTRASONIC_MAX_RANGE_CM
+		timer1_icu_arm_timeout((uint16_t)(u16_capture + ULTRASONIC_MAX_RANGE_COUNTS));
+#endif
+	}
+	else
+	{
+#if ULTRASONIC_MAX_RANGE_CM
+		timer1_icu_disarm_timeout();
+#endif
+		/* The counter may wrap once during the echo, the 16-bit difference stays correct */
+		global_u32Ticks = (uint16_t)(u16_capture - g_v_u16_riseCapture);
+#if ULTRASONIC_FIXED_POINT_DISTANCE
+		global_distance = HULTRASONIC_u16Q8_8Saturate((global_u32Ticks * ICP_CONSTANT_TO_DISTANCE_Q8_8) >> HULTRASONIC_Q8_8_SHIFT);
+#else
+		global_distance = (double)global_u32Ticks * ICP_CONSTANT_TO_DISTANCE;
+#endif
+		g_v_u8_flag = 0;
+		(void) timer1_icu_set_edge(TIMER1_ICU_RISING_EDGE);
+		HULTRASONIC_vidComplete(0);
+	}
+}
+
+#if ULTRASONIC_MAX_RANGE_CM
+/**
+ * @brief Echo timeout of the ICP engine.
+ *
+ * Called from the Timer 1 compare match A interrupt ULTRASONIC_MAX_RANGE_COUNTS after the rising
+ * edge of the echo. The capture interrupt has the higher priority, so an echo that ended at the
+ * same time has already disarmed the timeout. A match flag still pending from an earlier wrap of
+ * the counter may fire as soon as the timeout is armed, so the echo length is checked again.
+ */
+static void HULTRASONIC_vidTimeoutCBF(void)
+{
+	uint16_t u16_count = 0;
+
+	(void) timer1_icu_get_counter(&u16_count);
+	if (g_v_u8_flag == 0)
+	{
+		timer1_icu_disarm_timeout();
+	}
+	else if ((uint16_t)(u16_count - g_v_u16_riseCapture) >= ULTRASONIC_MAX_RANGE_COUNTS)
+	{
+		HULTRASONIC_vidBeyondRange();
+	}
+	else
+	{
+		/* early match, the armed one is still ahead */
+	}
+}
+#endif
+
+/**
+ * @brief Drop a measurement in flight and wait for the rising edge of the next echo.
+ */
+void HULTRASONIC_vidRearm(void)
+{
+#if ULTRASONIC_MAX_RANGE_CM
+	timer1_icu_disarm_timeout();
+#endif
+	g_v_u8_flag = 0;
+	(void) timer1_icu_set_edge(TIMER1_ICU_RISING_EDGE);
+}
+
+#endif
+
+/**
+ * @brief Publish a completed measurement.
+ *
+ * Advances the sequence number, releases the sensor and calls the completion callback
+ * of the measurement, from the echo interrupt. Nothing is published while no measurement is in flight.
+ */
+void HULTRASONIC_vidComplete(uint8_t u8_beyond_range)
+{
+	hultrasonic_str_measurement_t str_measurement;
+
+	if ((g_v_u8_busy == 1) && (g_ptr_str_active != NULL))
+	{
+		g_v_u16_seq++;
+		g_ptr_str_active->distance = global_distance;
+		str_measurement.ptr_str_sensor = g_ptr_str_active->ptr_str_config;
+		str_measurement.distance = global_distance;
+		str_measurement.u16_seq = g_v_u16_seq;
+		str_measurement.u32_timestamp = timing_get_tick_count();
+		str_measurement.u8_beyond_range = u8_beyond_range;
+		g_v_u8_busy = 0;
+		if (g_ptr_complete != NULL)
+		{
+			g_ptr_complete(&str_measurement);
+		}
+	}
+}
+
+#if ULTRASONIC_MAX_RANGE_CM
+/**
+ * @brief End the measurement in flight as beyond range.
+ *
+ * The echo is still high, so the capture or external interrupt armed for the rising edge only
+ * fires again for the echo of the next trigger.
  */
-static void HULTRASONIC_vidTrigger(void)
+void HULTRASONIC_vidBeyondRange(void)
+{
+	HULTRASONIC_vidRearm();
+	global_distance = HULTRASONIC_DISTANCE_CM(ULTRASONIC_MAX_RANGE_CM);
+	HULTRASONIC_vidComplete(1);
+}
+#endif
+
+/**
+ * @brief Send the 10 us trigger pulse of a sensor.
+ *
+ * @param ptr_str_config Sensor to trigger.
+ */
+static void HULTRASONIC_vidTrigger(const hultrasonic_str_config_t *ptr_str_config)
 {
 	
-	(void) DIO_write_pin(TRIG_PIN, DIO_PIN_HIGH_LEVEL);
+	DIO_write_pin(ptr_str_config->enu_trig_port, ptr_str_config->enu_trig_pin, DIO_PIN_HIGH_LEVEL);
 	delay_10u();
-	(void) DIO_write_pin(TRIG_PIN, DIO_PIN_LOW_LEVEL);
+	DIO_write_pin(ptr_str_config->enu_trig_port, ptr_str_config->enu_trig_pin, DIO_PIN_LOW_LEVEL);
+}
+
+hultrasonic_str_sensor_t *HULTRASONIC_ptrFind(const hultrasonic_str_config_t *ptr_str_config)
+{
+	hultrasonic_str_sensor_t *ptr_str_sensor = NULL;
+
+	for (uint8_t u8_index = 0; u8_index < g_u8_sensorsCount; u8_index++)
+	{
+		if (g_arr_str_sensors[u8_index].ptr_str_config == ptr_str_config)
+		{
+			ptr_str_sensor = &g_arr_str_sensors[u8_index];
+			break;
+		}
+	}
+	return ptr_str_sensor;
 }
 
 /************************************************************************************************/
@@ -168,20 +445,22 @@ static void HULTRASONIC_vidTrigger(void)
 
 
 /**
- * @brief Initialize the ultrasonic sensor.
+ * @brief Initialize the ranging engine shared by the ultrasonic sensors.
  *
- * This function initializes the ultrasonic sensor by configuring the necessary pins
- * and setting up external interrupt and timing for signal detection and measurement.
+ * This function configures the signal pin and sets up external interrupt
+ * and timing for signal detection and measurement.
  */
+#if ULTRASONIC_ENGINE == ULTRASONIC_ENGINE_EXTI
+
 void HULTRASONIC_vidInit(void)
 {
 	extim_str_config_t ptr_str_extim_config={.enu_exti_interrupt_no= EXTI_1, .enu_edge_detection = EXTI_RISING_EDGE};
 	
-	DIO_init(TRIG_PIN, DIO_PIN_OUTPUT);
 	DIO_init(SIG_PIN, DIO_PIN_INPUT);
-	DIO_write_pin(TRIG_PIN, DIO_PIN_LOW_LEVEL);
 	extim_init(&ptr_str_extim_config, HULTRASONIC_vidSigCalc);
 	timing_init_2(HULTRASONIC_vidTimerCBF);
+	g_v_u8_busy = 0;
+	g_u32_triggerTick = timing_get_tick_count() - ULTRASONIC_MIN_CYCLE_TICKS;
 	
 
 }
@@ -214,27 +493,161 @@ void HULTRASONIC_vidInterruptDisable(void)
 	extim_disable(&ptr_str_extim_config);
 }
 
+#else
+
+void HULTRASONIC_vidInit(void)
+{
+	DIO_init(SIG_PIN, DIO_PIN_INPUT);
+	g_v_u8_flag = 0;
+	(void) timer1_icu_initialize_callback(HULTRASONIC_vidSigCalc);
+#if ULTRASONIC_MAX_RANGE_CM
+	(void) timer1_initialize_callback_COMP(HULTRASONIC_vidTimeoutCBF);
+#endif
+	(void) timer1_icu_initialization(ULTRASONIC_ICP_PRESCALLER, U8_ONE_VALUE);
+	g_v_u8_busy = 0;
+	g_u32_triggerTick = timing_get_tick_count() - ULTRASONIC_MIN_CYCLE_TICKS;
+}
 
 
 
+/**
+ * @brief Enable the external interrupt for the ultrasonic sensor.
+ *
+ * This function arms the Timer 1 capture for the rising edge of the next echo
+ * and enables the capture interrupt.
+ */
+void HULTRASONIC_vidInterruptEnable(void)
+{
+	g_v_u8_flag = 0;
+	(void) timer1_icu_set_edge(TIMER1_ICU_RISING_EDGE);
+	timer1_icu_enable_interrupt();
+}
+
+/**
+ * @brief Disable the external interrupt for the ultrasonic sensor.
+ *
+ * This function disables the Timer 1 capture interrupt, an echo in progress is dropped.
+ */
+void HULTRASONIC_vidInterruptDisable(void)
+{
+	timer1_icu_disable_interrupt();
+#if ULTRASONIC_MAX_RANGE_CM
+	timer1_icu_disarm_timeout();
+#endif
+	g_v_u8_flag = 0;
+}
+
+
+
+
+#endif
+
+/**
+ * @brief Register an ultrasonic sensor.
+ *
+ * @param ptr_str_sensor Sensor configuration, kept by reference.
+ * @return HULTRASONIC_OK, or HULTRASONIC_NOK for a NULL configuration or a full sensor table.
+ */
+hultrasonic_enu_return_state_t HULTRASONIC_enuInitSensor(const hultrasonic_str_config_t *ptr_str_sensor)
+{
+	hultrasonic_enu_return_state_t enu_return_state = HULTRASONIC_OK;
+
+	if ((ptr_str_sensor == NULL) || (g_u8_sensorsCount >= ULTRASONIC_MAX_SENSORS))
+	{
+		enu_return_state = HULTRASONIC_NOK;
+	}
+	else
+	{
+		DIO_init(ptr_str_sensor->enu_trig_port, ptr_str_sensor->enu_trig_pin, DIO_PIN_OUTPUT);
+		DIO_write_pin(ptr_str_sensor->enu_trig_port, ptr_str_sensor->enu_trig_pin, DIO_PIN_LOW_LEVEL);
+		if (HULTRASONIC_ptrFind(ptr_str_sensor) == NULL)
+		{
+			g_arr_str_sensors[g_u8_sensorsCount].ptr_str_config = ptr_str_sensor;
+			g_arr_str_sensors[g_u8_sensorsCount].distance = 0;
+			g_u8_sensorsCount++;
+		}
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Start a measurement without waiting for it.
+ *
+ * The sensor is triggered unless a measurement of any sensor is in flight or the cycle since the previous
+ * trigger has not elapsed. A measurement still in flight after a full cycle lost its echo and is dropped.
+ * While the echo of a measurement ended as beyond range is still high the sensor is still ranging and
+ * would ignore the trigger, so the call reports HULTRASONIC_BUSY.
+ *
+ * @param ptr_str_sensor Registered sensor to trigger.
+ * @param ptr_complete Completion callback called from the echo interrupt, may be NULL.
+ * @return HULTRASONIC_OK if the sensor was triggered, HULTRASONIC_BUSY or HULTRASONIC_RATE_LIMITED otherwise,
+ *         HULTRASONIC_NOK for a sensor that was not registered.
+ */
+hultrasonic_enu_return_state_t HULTRASONIC_enuStartMeasurement(const hultrasonic_str_config_t *ptr_str_sensor, HULTRASONIC_ptr_complete_func ptr_complete)
+{
+	hultrasonic_enu_return_state_t enu_return_state = HULTRASONIC_OK;
+	hultrasonic_str_sensor_t *ptr_str_entry = HULTRASONIC_ptrFind(ptr_str_sensor);
+	uint32_t u32_elapsed = timing_get_tick_count() - g_u32_triggerTick;
+
+	if (ptr_str_entry == NULL)
+	{
+		enu_return_state = HULTRASONIC_NOK;
+	}
+	else if (u32_elapsed < ULTRASONIC_MIN_CYCLE_TICKS)
+	{
+		enu_return_state = (g_v_u8_busy == 1) ? HULTRASONIC_BUSY : HULTRASONIC_RATE_LIMITED;
+	}
+	else if ((g_v_u8_busy == 0) && (DIO_read_pin_fast(SIG_PIN) == DIO_PIN_HIGH_LEVEL))
+	{
+		enu_return_state = HULTRASONIC_BUSY;
+	}
+	else
+	{
+		if (g_v_u8_busy == 1)
+		{
+			HULTRASONIC_vidRearm();
+		}
+		g_ptr_str_active = ptr_str_entry;
+		g_ptr_complete = ptr_complete;
+		g_u32_triggerTick += u32_elapsed;
+		g_v_u8_busy = 1;
+		HULTRASONIC_vidTrigger(ptr_str_sensor);
+	}
+	return enu_return_state;
+}
+
 /**
  * @brief Read the distance from the ultrasonic sensor.
  *
- * This function triggers the ultrasonic sensor to measure distance and returns
- * the calculated distance value in centimeters.
+ * This function starts a measurement if the sensor is ready and returns
+ * the last distance value the sensor measured in centimeters.
  *
- * @return The calculated distance in centimeters.
+ * @param ptr_str_sensor Registered sensor.
+ * @return The calculated distance in centimeters (Q8.8 fixed point with ULTRASONIC_FIXED_POINT_DISTANCE).
  */
-float64_t HULTRASONIC_u8Read(void)
+hultrasonic_distance_t HULTRASONIC_u8Read(const hultrasonic_str_config_t *ptr_str_sensor)
 {
-	HULTRASONIC_vidTrigger();
-	
-	return global_f64distance;
+	hultrasonic_distance_t distance = 0;
+	hultrasonic_str_sensor_t *ptr_str_entry = HULTRASONIC_ptrFind(ptr_str_sensor);
+
+	(void) HULTRASONIC_enuStartMeasurement(ptr_str_sensor, NULL);
+	if (ptr_str_entry != NULL)
+	{
+		distance = ptr_str_entry->distance;
+	}
+	return distance;
+}
+
+#if ULTRASONIC_FIXED_POINT_DISTANCE
+hultrasonic_distance_t HULTRASONIC_u16Q8_8Saturate(uint32_t u32_q8_8){
+	return (u32_q8_8 > HULTRASONIC_Q8_8_MAX) ? (hultrasonic_distance_t)HULTRASONIC_Q8_8_MAX : (hultrasonic_distance_t)u32_q8_8;
 }
+#endif
 
 void delay_10u(void){
 	volatile uint16_t u16_counter;
 	for(u16_counter= U8_ZERO_VALUE; u16_counter < DELAY_10_U; u16_counter++);
+	cpu_spin_us(10);
 }
 
 
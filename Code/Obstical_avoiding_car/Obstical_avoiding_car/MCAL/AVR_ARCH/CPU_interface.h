@@ -0,0 +1,37 @@
+/**
+ * @file CPU_interface.h
+ * @brief Idle and busy-wait hooks of the CPU core.
+ *
+ * On the target both cost nothing: the main loop keeps polling when it has nothing to do, and a
+ * counted busy-wait loop takes its time by itself. On the host simulator (HOST_SIM) neither loop
+ * touches a register, so the hooks tell the simulated clock where the time goes.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef CPU_INTERFACE_H_
+#define CPU_INTERFACE_H_
+
+#ifdef HOST_SIM
+
+#include "../../SIM/SIM_interface.h"
+
+/** Nothing to do until the next interrupt, the simulated clock moves on to the next event. */
+#define cpu_idle() SIM_vidIdle()
+
+/** A counted busy-wait loop of about US microseconds just ran, the simulated clock is charged for it. */
+#define cpu_spin_us(US) SIM_vidSpinUs(US)
+
+#else
+
+/** Nothing to do until the next interrupt, the main loop polls again. */
+#define cpu_idle() ((void)0)
+
+/** A counted busy-wait loop of about US microseconds just ran, it took its time by itself. */
+#define cpu_spin_us(US) ((void)0)
+
+#endif /* HOST_SIM */
+
+#endif /* CPU_INTERFACE_H_ */
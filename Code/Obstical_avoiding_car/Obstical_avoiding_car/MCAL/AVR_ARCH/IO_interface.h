@@ -0,0 +1,39 @@
+/**
+ * @file IO_interface.h
+ * @brief Access macros for the ATmega32 memory-mapped I/O registers.
+ *
+ * All MCAL private headers describe their registers through these macros instead of
+ * dereferencing raw addresses, so the same drivers can be built for the target or for
+ * the host simulator (HOST_SIM), where the register file lives in RAM.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef IO_INTERFACE_H_
+#define IO_INTERFACE_H_
+
+#include "../../STD_LIB/std_types.h"
+
+#ifdef HOST_SIM
+
+#include "../../SIM/SIM_interface.h"
+
+/** 8-bit register at data-space address ADD, served by the simulated register file. */
+#define IO_REG8(ADD)            (*(SIM_pu8IoReg(ADD)))
+
+/** 16-bit register pair (low byte at ADD), served by the simulated register file. */
+#define IO_REG16(ADD)           (*((volatile uint16_t *)SIM_pu8IoReg(ADD)))
+
+#else
+
+/** 8-bit register at data-space address ADD. */
+#define IO_REG8(ADD)            (*((volatile uint8_t *)(ADD)))
+
+/** 16-bit register pair (low byte at ADD). */
+#define IO_REG16(ADD)           (*((volatile uint16_t *)(ADD)))
+
+#endif /* HOST_SIM */
+
+#endif /* IO_INTERFACE_H_ */
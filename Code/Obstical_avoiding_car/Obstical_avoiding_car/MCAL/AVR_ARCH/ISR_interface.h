@@ -13,12 +13,26 @@
 #ifndef ISR_INTERFACE_H_
 #define ISR_INTERFACE_H_
 
+#ifdef HOST_SIM
+
+#include "../../SIM/SIM_interface.h"
+
+/** Enable global interrupts (sets the I bit of the simulated SREG). */
+#define sei() SIM_vidSei()
+
+/** Disable global interrupts (clears the I bit of the simulated SREG). */
+#define cli() SIM_vidCli()
+
+#else
+
 /** Enable global interrupts. */
 #define sei() __asm__ __volatile__("sei" ::: "memory")
 
 /** Disable global interrupts. */
 #define cli() __asm__ __volatile__("cli" ::: "memory")
 
+#endif /* HOST_SIM */
+
 // Interrupt vectors
 
 /** External Interrupt Request 0 */
@@ -92,7 +106,13 @@
  *     // ISR code here
  * }
  */
+#ifdef HOST_SIM
+/* On the host a vector is a plain function, called by the simulator's interrupt dispatcher */
+#define ISR(INT_VECT) void INT_VECT(void);\
+void INT_VECT(void)
+#else
 #define ISR(INT_VECT) void INT_VECT(void) __attribute__((signal,used));\
 void INT_VECT(void)
+#endif /* HOST_SIM */
 
 #endif /* ISR_INTERFACE_H_ */
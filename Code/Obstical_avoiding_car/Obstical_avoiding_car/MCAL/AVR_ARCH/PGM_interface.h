@@ -0,0 +1,33 @@
+/**
+ * @file PGM_interface.h
+ * @brief Access to constants kept in program memory (flash) instead of SRAM.
+ *
+ * On the AVR, const data is still copied into SRAM at startup unless it is placed in flash with
+ * PROGMEM, from where it must then be read with pgm_read_byte (LPM). The host simulator
+ * (HOST_SIM) has a single address space, there both macros reduce to plain const data.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef PGM_INTERFACE_H_
+#define PGM_INTERFACE_H_
+
+#include "../../STD_LIB/std_types.h"
+
+#ifdef HOST_SIM
+
+/** Places a const object in program memory. */
+#define PROGMEM
+
+/** Reads the byte at address ADD of program memory. */
+#define pgm_read_byte(ADD)      (*((const uint8_t *)(ADD)))
+
+#else
+
+#include <avr/pgmspace.h>
+
+#endif /* HOST_SIM */
+
+#endif /* PGM_INTERFACE_H_ */
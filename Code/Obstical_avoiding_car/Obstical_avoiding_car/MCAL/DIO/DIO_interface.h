@@ -12,6 +12,7 @@
 
 #include "../../STD_LIB/bit_math.h"
 #include "../../STD_LIB/std_types.h"
+#include "../AVR_ARCH/IO_interface.h"
 
 /**
  * @brief Enumeration of available port options.
@@ -82,6 +83,16 @@ typedef enum{
 
 }dio_u8_enu_direction_t;
 
+/**
+ * @brief Data-space addresses of the registers of a port.
+ *
+ * The ATmega32 places PINx, DDRx and PORTx of each port in three consecutive bytes, PORTA highest,
+ * so the addresses follow from the port number. With a constant port they are constants.
+ */
+#define DIO_PIN_REG_ADDRESS(PORT)		(0x39u - (3u * (uint8_t)(PORT)))
+#define DIO_DDR_REG_ADDRESS(PORT)		(0x3Au - (3u * (uint8_t)(PORT)))
+#define DIO_PORT_REG_ADDRESS(PORT)		(0x3Bu - (3u * (uint8_t)(PORT)))
+
 
 
 
@@ -135,4 +146,65 @@ dio_enu_return_state_t DIO_write_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_
  */
 dio_enu_return_state_t DIO_read_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_t copy_enu_pin, dio_enu_level_t	*ptr_enu_state);
 
+/**
+ * @brief Writes several pins of a port at once.
+ *
+ * The pins selected by the mask take the levels of the matching value bits in a single register
+ * write; the other pins keep their levels. Interrupts are masked during the read-modify-write, so
+ * an interrupt writing other pins of the same port is never undone.
+ *
+ * @param copy_enu_port The port to write (PORTA, PORTB, PORTC, or PORTD).
+ * @param copy_u8_mask The pins to write, one bit per pin.
+ * @param copy_u8_value The levels of the pins, one bit per pin (bits outside the mask are ignored).
+ * @return dio_enu_return_state_t The return state of the write operation.
+ *                                Possible values:
+ *                                - DIO_OK: The write operation was successful.
+ *                                - DIO_INVALID_PORT: The specified port is not valid.
+ */
+dio_enu_return_state_t DIO_write_port_masked (dio_enu_port_t copy_enu_port, uint8_t copy_u8_mask, uint8_t copy_u8_value);
+
+/************************************************************************************************/
+/*									Compile-time pin access										*/
+/************************************************************************************************/
+
+/**
+ * @brief Writes a digital value to a pin known at compile time.
+ *
+ * Meant for constant arguments, such as a pin macro of the form `PORTB, PIN3`: the call is inlined
+ * and reduces to a single SBI or CBI instruction, which cannot be interrupted halfway. The arguments
+ * are not checked. Use DIO_write_pin for pins that come from a runtime configuration.
+ *
+ * @param copy_enu_port The port to which the pin belongs (PORTA, PORTB, PORTC, or PORTD).
+ * @param copy_enu_pin The pin number to write to.
+ * @param copy_enu_state The desired output state (DIO_PIN_HIGH_LEVEL or DIO_PIN_LOW_LEVEL).
+ */
+static inline void DIO_write_pin_fast (dio_enu_port_t copy_enu_port, dio_enu_pin_t copy_enu_pin, dio_enu_level_t copy_enu_state) __attribute__((always_inline));
+static inline void DIO_write_pin_fast (dio_enu_port_t copy_enu_port, dio_enu_pin_t copy_enu_pin, dio_enu_level_t copy_enu_state)
+{
+	if (copy_enu_state == DIO_PIN_HIGH_LEVEL)
+	{
+		IO_REG8(DIO_PORT_REG_ADDRESS(copy_enu_port)) |= (uint8_t)(U8_ONE_VALUE << copy_enu_pin);
+	}
+	else
+	{
+		IO_REG8(DIO_PORT_REG_ADDRESS(copy_enu_port)) &= (uint8_t)~(U8_ONE_VALUE << copy_enu_pin);
+	}
+}
+
+/**
+ * @brief Reads the digital value of a pin known at compile time.
+ *
+ * Meant for constant arguments: the call is inlined and reduces to a single SBIC/SBIS test.
+ * The arguments are not checked. Use DIO_read_pin for pins that come from a runtime configuration.
+ *
+ * @param copy_enu_port The port to which the pin belongs (PORTA, PORTB, PORTC, or PORTD).
+ * @param copy_enu_pin The pin number to read from.
+ * @return The level of the pin.
+ */
+static inline dio_enu_level_t DIO_read_pin_fast (dio_enu_port_t copy_enu_port, dio_enu_pin_t copy_enu_pin) __attribute__((always_inline));
+static inline dio_enu_level_t DIO_read_pin_fast (dio_enu_port_t copy_enu_port, dio_enu_pin_t copy_enu_pin)
+{
+	return ((IO_REG8(DIO_PIN_REG_ADDRESS(copy_enu_port)) & (uint8_t)(U8_ONE_VALUE << copy_enu_pin)) != U8_ZERO_VALUE) ? DIO_PIN_HIGH_LEVEL : DIO_PIN_LOW_LEVEL;
+}
+
 #endif /* DIO_H_ */
\ No newline at end of file
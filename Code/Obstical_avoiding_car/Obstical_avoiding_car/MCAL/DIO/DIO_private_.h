@@ -10,27 +10,46 @@
 #define DIO_PRIVATE_H_
 
 //#include <avr/io.h>
+#include "../AVR_ARCH/IO_interface.h"
+#include "../AVR_ARCH/ISR_interface.h"
 
 #define DIO_MAX_PINS	8
 #define DIO_MAX_PORTS	4
 
-#define  DATA_DIRECTION_PORTA	    (*((volatile uint8_t *) 0x3A))
-#define  DATA_DIRECTION_PORTB	    (*((volatile uint8_t *) 0x37))
-#define  DATA_DIRECTION_PORTC	    (*((volatile uint8_t *) 0x34))
-#define  DATA_DIRECTION_PORTD	    (*((volatile uint8_t *) 0x31))
+#define  DATA_DIRECTION_PORTA	    (IO_REG8(0x3A))
+#define  DATA_DIRECTION_PORTB	    (IO_REG8(0x37))
+#define  DATA_DIRECTION_PORTC	    (IO_REG8(0x34))
+#define  DATA_DIRECTION_PORTD	    (IO_REG8(0x31))
 
 
-#define  WR_PORT_A					(*((volatile uint8_t *) 0x3B))
-#define  WR_PORT_B					(*((volatile uint8_t *) 0x38))
-#define  WR_PORT_C					(*((volatile uint8_t *) 0x35))
-#define  WR_PORT_D					(*((volatile uint8_t *) 0x32))
+#define  WR_PORT_A					(IO_REG8(0x3B))
+#define  WR_PORT_B					(IO_REG8(0x38))
+#define  WR_PORT_C					(IO_REG8(0x35))
+#define  WR_PORT_D					(IO_REG8(0x32))
 
 
 
 
-#define  RE_PORT_A					(*((volatile uint8_t *) 0x39))
-#define  RE_PORT_B					(*((volatile uint8_t *) 0x36))
-#define  RE_PORT_C					(*((volatile uint8_t *) 0x33))
-#define  RE_PORT_D					(*((volatile uint8_t *) 0x30))
+#define  RE_PORT_A					(IO_REG8(0x39))
+#define  RE_PORT_B					(IO_REG8(0x36))
+#define  RE_PORT_C					(IO_REG8(0x33))
+#define  RE_PORT_D					(IO_REG8(0x30))
+
+
+/* Register addresses of one port, an entry of the port lookup table */
+typedef struct
+{
+	uint8_t u8_pin_address;
+	uint8_t u8_ddr_address;
+	uint8_t u8_port_address;
+}dio_str_port_registers_t;
+
+/* Status register, saved and restored around the masked port writes */
+#define  DIO_SREG					(IO_REG8(0x5F))
+
+/* Replaces the mask bits of a port register with the value bits, interrupts masked meanwhile */
+#define  DIO_WRITE_MASKED(REG, MASK, VALUE)		do{ uint8_t u8_sreg = DIO_SREG; cli(); \
+												(REG) = (uint8_t)(((REG) & (uint8_t)~(MASK)) | ((VALUE) & (MASK))); \
+												DIO_SREG = u8_sreg; }while(0)
 
 #endif /* DIO_PRIVATE_REG_H_ */
\ No newline at end of file
@@ -11,6 +11,16 @@
 #include "DIO_private_.h"
 
 
+/* Register addresses of each port, indexed by dio_enu_port_t: one lookup instead of a branch per port */
+static const dio_str_port_registers_t gs_arr_str_port_registers[DIO_MAX_PORTS] =
+{
+	{DIO_PIN_REG_ADDRESS(PORTA), DIO_DDR_REG_ADDRESS(PORTA), DIO_PORT_REG_ADDRESS(PORTA)},
+	{DIO_PIN_REG_ADDRESS(PORTB), DIO_DDR_REG_ADDRESS(PORTB), DIO_PORT_REG_ADDRESS(PORTB)},
+	{DIO_PIN_REG_ADDRESS(PORTC), DIO_DDR_REG_ADDRESS(PORTC), DIO_PORT_REG_ADDRESS(PORTC)},
+	{DIO_PIN_REG_ADDRESS(PORTD), DIO_DDR_REG_ADDRESS(PORTD), DIO_PORT_REG_ADDRESS(PORTD)}
+};
+
+
 
 
 /**
@@ -32,37 +42,22 @@ dio_enu_return_state_t DIO_init (dio_enu_port_t copy_enu_port, dio_enu_pin_t cop
 {
 	dio_enu_return_state_t enu_return_state = DIO_OK;
 
-	if (copy_enu_pin < DIO_MAX_PINS)
+	if (copy_enu_pin >= DIO_MAX_PINS)
 	{
-		if (copy_enu_port == PORTA)
-		{
-			DATA_DIRECTION_PORTA |= copy_enu_direction << copy_enu_pin;
-			
-		}
-		else if (copy_enu_port == PORTB)
-		{
-			DATA_DIRECTION_PORTB |= copy_enu_direction << copy_enu_pin;
-			
-		}
-		else if (copy_enu_port == PORTC)
-		{
-			DATA_DIRECTION_PORTC |= copy_enu_direction << copy_enu_pin;
-			
-		}
-		else if (copy_enu_port == PORTD)
-		{
-			DATA_DIRECTION_PORTD |= copy_enu_direction << copy_enu_pin;
-			
-		}
-		else
-		{
-			enu_return_state = DIO_INVALID_PORT;
-		}
-		
-	}
-	else{
 		enu_return_state = DIO_INVALID_PIN;
 	}
+	else if (copy_enu_port >= DIO_MAX_PORTS)
+	{
+		enu_return_state = DIO_INVALID_PORT;
+	}
+	else if (copy_enu_direction == DIO_PIN_OUTPUT)
+	{
+		IO_REG8(gs_arr_str_port_registers[copy_enu_port].u8_ddr_address) |= (uint8_t)(U8_ONE_VALUE << copy_enu_pin);
+	}
+	else
+	{
+		IO_REG8(gs_arr_str_port_registers[copy_enu_port].u8_ddr_address) &= (uint8_t)~(U8_ONE_VALUE << copy_enu_pin);
+	}
 
 	return enu_return_state;
 }
@@ -85,66 +80,24 @@ dio_enu_return_state_t DIO_init (dio_enu_port_t copy_enu_port, dio_enu_pin_t cop
 
 dio_enu_return_state_t DIO_write_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_t copy_enu_pin, dio_enu_level_t copy_enu_state)
 {
-
 	dio_enu_return_state_t enu_return_state = DIO_OK;
 
-	if (copy_enu_pin < DIO_MAX_PINS)
+	if (copy_enu_pin >= DIO_MAX_PINS)
 	{
-		if (copy_enu_port == PORTA)
-		{
-			if (copy_enu_state == DIO_PIN_HIGH_LEVEL)
-			{
-				WR_PORT_A |= (U8_ONE_VALUE << copy_enu_pin);
-			}
-			else{
-				WR_PORT_A &= ~(U8_ONE_VALUE << copy_enu_pin);
-			}
-
-		}
-		else if (copy_enu_port == PORTB)
-		{
-			if (copy_enu_state == DIO_PIN_HIGH_LEVEL)
-			{
-				WR_PORT_B |= (U8_ONE_VALUE << copy_enu_pin);
-			}
-			else{
-				WR_PORT_B &= ~(U8_ONE_VALUE << copy_enu_pin);
-			}
-
-		}
-		else if (copy_enu_port == PORTC)
-		{
-			if (copy_enu_state == DIO_PIN_HIGH_LEVEL)
-			{
-				WR_PORT_C |= (U8_ONE_VALUE << copy_enu_pin);
-			}
-			else{
-				WR_PORT_C &= ~(U8_ONE_VALUE << copy_enu_pin);
-			}
-
-		}
-		else if (copy_enu_port == PORTD)
-		{
-			if (copy_enu_state == DIO_PIN_HIGH_LEVEL)
-			{
-				WR_PORT_D |= (U8_ONE_VALUE << copy_enu_pin);
-			}
-			else{
-				WR_PORT_D &= ~(U8_ONE_VALUE << copy_enu_pin);
-			}
-
-		}
-		else
-		{
-			enu_return_state = DIO_INVALID_PORT;
-		}
-		
-	}
-	else{
 		enu_return_state = DIO_INVALID_PIN;
 	}
-
-
+	else if (copy_enu_port >= DIO_MAX_PORTS)
+	{
+		enu_return_state = DIO_INVALID_PORT;
+	}
+	else if (copy_enu_state == DIO_PIN_HIGH_LEVEL)
+	{
+		IO_REG8(gs_arr_str_port_registers[copy_enu_port].u8_port_address) |= (uint8_t)(U8_ONE_VALUE << copy_enu_pin);
+	}
+	else
+	{
+		IO_REG8(gs_arr_str_port_registers[copy_enu_port].u8_port_address) &= (uint8_t)~(U8_ONE_VALUE << copy_enu_pin);
+	}
 
 	return enu_return_state;
 }
@@ -166,40 +119,51 @@ dio_enu_return_state_t DIO_write_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_
  */
 dio_enu_return_state_t DIO_read_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_t copy_enu_pin, dio_enu_level_t	*ptr_enu_state)
 {
+	dio_enu_return_state_t enu_return_state = DIO_OK;
+
+	if (copy_enu_pin >= DIO_MAX_PINS)
+	{
+		enu_return_state = DIO_INVALID_PIN;
+	}
+	else if (copy_enu_port >= DIO_MAX_PORTS)
+	{
+		enu_return_state = DIO_INVALID_PORT;
+	}
+	else
+	{
+		*ptr_enu_state = ((IO_REG8(gs_arr_str_port_registers[copy_enu_port].u8_pin_address) >> copy_enu_pin) & U8_ONE_VALUE);
+	}
 
+	return enu_return_state;
+}
+
+/**
+ * @brief Writes several pins of a port at once.
+ *
+ * The pins selected by the mask take the levels of the matching value bits in a single register
+ * write; the other pins keep their levels. Interrupts are masked during the read-modify-write, so
+ * an interrupt writing other pins of the same port is never undone.
+ *
+ * @param copy_enu_port The port to write (PORTA, PORTB, PORTC, or PORTD).
+ * @param copy_u8_mask The pins to write, one bit per pin.
+ * @param copy_u8_value The levels of the pins, one bit per pin (bits outside the mask are ignored).
+ * @return dio_enu_return_state_t The return state of the write operation.
+ *                                Possible values:
+ *                                - DIO_OK: The write operation was successful.
+ *                                - DIO_INVALID_PORT: The specified port is not valid.
+ */
+dio_enu_return_state_t DIO_write_port_masked (dio_enu_port_t copy_enu_port, uint8_t copy_u8_mask, uint8_t copy_u8_value)
+{
 	dio_enu_return_state_t enu_return_state = DIO_OK;
 
-	if (copy_enu_pin < DIO_MAX_PINS)
+	if (copy_enu_port >= DIO_MAX_PORTS)
 	{
-		if (copy_enu_port == PORTA)
-		{
-			*ptr_enu_state = ((RE_PORT_A & (U8_ONE_VALUE<<copy_enu_pin))>>copy_enu_pin);
-			
-		}
-		else if (copy_enu_port == PORTB)
-		{
-			*ptr_enu_state = ((RE_PORT_B & (U8_ONE_VALUE<<copy_enu_pin))>>copy_enu_pin);
-			
-		}
-		else if (copy_enu_port == PORTC)
-		{
-			*ptr_enu_state = ((RE_PORT_C & (U8_ONE_VALUE<<copy_enu_pin))>>copy_enu_pin);
-			
-		}
-		else if (copy_enu_port == PORTD)
-		{
-			*ptr_enu_state = ((RE_PORT_D & (U8_ONE_VALUE<<copy_enu_pin))>>copy_enu_pin);
-			
-		}
-		else
-		{
-			enu_return_state = DIO_INVALID_PORT;
-		}
-		
+		enu_return_state = DIO_INVALID_PORT;
 	}
-	else{
-		enu_return_state = DIO_INVALID_PIN;
+	else
+	{
+		DIO_WRITE_MASKED(IO_REG8(gs_arr_str_port_registers[copy_enu_port].u8_port_address), copy_u8_mask, copy_u8_value);
 	}
 
 	return enu_return_state;
-}
\ No newline at end of file
+}
@@ -66,7 +66,6 @@ exti_enu_return_state_t ext_interrupt_enable(exti_interrupt_no_t copy_enu_exti_i
     exti_enu_return_state_t ret_val=EXTI_E_OK;
     switch (copy_enu_exti_interrupt_no)
     {
-		sei();
     case EXTI_0:
         GICR_ADD |= (1<<INT0_Globle);
         break;
@@ -83,6 +82,7 @@ exti_enu_return_state_t ext_interrupt_enable(exti_interrupt_no_t copy_enu_exti_i
     default:
         break;
     }
+    sei();
     return ret_val;
 }
 
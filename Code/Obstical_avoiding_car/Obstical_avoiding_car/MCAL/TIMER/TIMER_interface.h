@@ -27,6 +27,9 @@
 // Definition of clock settings to clear the timer clock prescaler bits
 #define TIMER_CLEAR_CLOCK_SETTING						0b00000111
 
+// TOP of Timer 1 in 10-bit fast PWM mode, the PWM period is (TIMER1_PWM_TOP + 1) timer clocks
+#define TIMER1_PWM_TOP									0x3FF
+
 // Enumeration of possible return states for timer functions
 typedef enum{
 	TIMER_OK,     // Timer operation was successful
@@ -59,6 +62,18 @@ typedef enum{
 	TIMER_EXT_CLK_RISING_EDGE     // External clock source, rising edge
 } timer_prescaller_t;
 
+// Enumeration of the Timer 1 compare outputs
+typedef enum{
+	TIMER1_CHANNEL_A,             // OC1A (PD5), compared with OCR1A
+	TIMER1_CHANNEL_B              // OC1B (PD4), compared with OCR1B
+} timer1_enu_channel_t;
+
+// Enumeration of the Timer 1 input capture edges (ICP1, PD6)
+typedef enum{
+	TIMER1_ICU_FALLING_EDGE,      // Capture on a falling edge
+	TIMER1_ICU_RISING_EDGE        // Capture on a rising edge
+} timer1_enu_icu_edge_t;
+
 // Configuration structure for timer settings
 typedef struct{
 	timer_mode_t timer_mode;      // Timer mode (normal, PWM, CTC)
@@ -161,6 +176,20 @@ timer_enu_return_state_t timer_initialize_callback_COMP(void (*ptr_func)(void));
  */
 timer_enu_return_state_t timer_set_tcnt(timer_configuration_t *ptr_timer_config);
 
+/**
+ * @brief Retrieves the Timer/Counter (TCNT) value of Timer 0.
+ *
+ * This function retrieves the Timer/Counter (TCNT) value of Timer 0 and stores it in the provided pointer.
+ *
+ * @param ptr_timer_config Pointer to the timer configuration structure (not used in this function).
+ * @param ptr_u8_tcnt_value Pointer to store the retrieved TCNT value.
+ * @return timer_enu_return_state_t The return state of the timer get TCNT operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The timer get TCNT operation was successful.
+ *                                - TIMER_NOK: The provided timer configuration pointer is NULL.
+ */
+timer_enu_return_state_t timer_get_tcnt(timer_configuration_t *ptr_timer_config, uint8_t *ptr_u8_tcnt_value);
+
 
 /************************************************************************************************/
 /************************************************************************************************/
@@ -266,6 +295,172 @@ timer_enu_return_state_t timer1_initialize_callback_OVF(void (*ptr_func)(void));
  */
 timer_enu_return_state_t timer1_initialize_callback_COMP(void (*ptr_func)(void));
 
+/**
+ * @brief Initializes the compare match B callback function for Timer 1.
+ *
+ * @param ptr_func Pointer to the function called from the compare match B interrupt.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The callback was stored.
+ *                                - TIMER_NOK: The provided function pointer is NULL.
+ */
+timer_enu_return_state_t timer1_initialize_callback_COMPB(void (*ptr_func)(void));
+
+/**
+ * @brief Starts Timer 1 in 10-bit fast PWM mode.
+ *
+ * The counter runs from 0 to TIMER1_PWM_TOP and wraps, so the PWM frequency is
+ * F_CPU / (prescaler * (TIMER1_PWM_TOP + 1)). Both compare outputs start disconnected with
+ * a compare value of 0; no interrupt is enabled. ICR1 is not used, it stays free for input capture.
+ *
+ * @param enu_prescaller Clock prescaler of the timer (TIMER_PRESCALLER_0 ... TIMER_PRESCALLER_1024).
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The timer was started.
+ *                                - TIMER_NOK: The prescaler is not an internal clock setting.
+ */
+timer_enu_return_state_t timer1_pwm_initialization(timer_prescaller_t enu_prescaller);
+
+/**
+ * @brief Sets the compare value of a Timer 1 PWM output.
+ *
+ * In fast PWM mode the new value is double buffered by the hardware and takes effect at the
+ * next TOP, so the running period is never cut.
+ *
+ * @param enu_channel Compare output to update.
+ * @param u16_compare Compare value, 0 ... TIMER1_PWM_TOP.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The compare value was set.
+ *                                - TIMER_NOK: Invalid channel or compare value above TIMER1_PWM_TOP.
+ */
+timer_enu_return_state_t timer1_pwm_set_compare(timer1_enu_channel_t enu_channel, uint16_t u16_compare);
+
+/**
+ * @brief Connects or disconnects a Timer 1 compare output from its pin.
+ *
+ * When connected (non-inverting mode) the pin is set at BOTTOM and cleared on compare match,
+ * which gives a high time of (compare + 1) timer clocks. When disconnected the pin follows its PORT bit.
+ * The pin must be configured as an output for the signal to appear.
+ *
+ * @param enu_channel Compare output to update.
+ * @param u8_connect U8_ONE_VALUE to connect, U8_ZERO_VALUE to disconnect.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The output mode was set.
+ *                                - TIMER_NOK: Invalid channel.
+ */
+timer_enu_return_state_t timer1_pwm_connect(timer1_enu_channel_t enu_channel, uint8_t u8_connect);
+
+/**
+ * @brief Starts Timer 1 as a free running 16-bit counter for the input capture unit.
+ *
+ * The counter runs in normal mode from 0 to 0xFFFF, so the difference of two captures taken
+ * less than one wrap apart is their distance in timer clocks, computed modulo 2^16.
+ * The capture edge starts as rising and the capture interrupt starts disabled.
+ *
+ * @param enu_prescaller Clock prescaler of the timer (TIMER_PRESCALLER_0 ... TIMER_PRESCALLER_1024).
+ * @param u8_noise_canceller U8_ONE_VALUE to require four equal samples on ICP1 before an edge is accepted
+ *                           (the capture is then delayed by four CPU cycles), U8_ZERO_VALUE otherwise.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The timer was started.
+ *                                - TIMER_NOK: The prescaler is not an internal clock setting.
+ *
+ * @note The compare outputs are disconnected, Timer 1 cannot be used for PWM at the same time.
+ */
+timer_enu_return_state_t timer1_icu_initialization(timer_prescaller_t enu_prescaller, uint8_t u8_noise_canceller);
+
+/**
+ * @brief Selects the ICP1 edge that triggers the next capture.
+ *
+ * The capture flag raised by the edge change itself is cleared.
+ *
+ * @param enu_edge Capture edge.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The edge was set.
+ *                                - TIMER_NOK: Invalid edge.
+ */
+timer_enu_return_state_t timer1_icu_set_edge(timer1_enu_icu_edge_t enu_edge);
+
+/**
+ * @brief Retrieves the counter value latched by the last capture event.
+ *
+ * @param ptr_u16_capture Pointer to store the captured value (ICR1).
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The value was read.
+ *                                - TIMER_NOK: The provided pointer is NULL.
+ */
+timer_enu_return_state_t timer1_icu_get_capture(uint16_t *ptr_u16_capture);
+
+/**
+ * @brief Retrieves the running 16-bit counter value of Timer 1 (TCNT1).
+ *
+ * @param ptr_u16_count Pointer to store the counter value.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The value was read.
+ *                                - TIMER_NOK: The provided pointer is NULL.
+ */
+timer_enu_return_state_t timer1_icu_get_counter(uint16_t *ptr_u16_count);
+
+/**
+ * @brief Initializes the input capture callback function for Timer 1.
+ *
+ * @param ptr_func Pointer to the function called from the capture interrupt.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The callback was stored.
+ *                                - TIMER_NOK: The provided function pointer is NULL.
+ */
+timer_enu_return_state_t timer1_icu_initialize_callback(void (*ptr_func)(void));
+
+/**
+ * @brief Enables the Timer 1 input capture interrupt (and global interrupts).
+ *
+ * A capture pending from before the call is discarded.
+ */
+void timer1_icu_enable_interrupt(void);
+
+/**
+ * @brief Disables the Timer 1 input capture interrupt.
+ */
+void timer1_icu_disable_interrupt(void);
+
+/**
+ * @brief Arms the Timer 1 compare match A interrupt as a timeout of the input capture unit.
+ *
+ * The callback set with timer1_initialize_callback_COMP runs when TCNT1 reaches u16_compare,
+ * typically a capture plus a duration in timer clocks. A match pending from before the call is
+ * discarded. The counter runs freely, so the match repeats every wrap until disarmed.
+ *
+ * @param u16_compare Counter value of the match (OCR1A).
+ */
+void timer1_icu_arm_timeout(uint16_t u16_compare);
+
+/**
+ * @brief Disarms the Timer 1 compare match A interrupt.
+ */
+void timer1_icu_disarm_timeout(void);
+
+/**
+ * @brief Arms the Timer 1 compare match B interrupt on the free running counter.
+ *
+ * Like timer1_icu_arm_timeout for compare unit B, whose callback is set with
+ * timer1_initialize_callback_COMPB. The compare output stays disconnected. A match pending from
+ * before the call is discarded; the match repeats every wrap until disarmed.
+ *
+ * @param u16_compare Counter value of the match (OCR1B).
+ */
+void timer1_icu_arm_compare_b(uint16_t u16_compare);
+
+/**
+ * @brief Disarms the Timer 1 compare match B interrupt.
+ */
+void timer1_icu_disarm_compare_b(void);
+
 
 
 
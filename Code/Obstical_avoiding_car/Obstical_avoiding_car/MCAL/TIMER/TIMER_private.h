@@ -9,37 +9,47 @@
 #ifndef TIMER_PRIVATE_H
 #define TIMER_PRIVATE_H
 
+#include "../AVR_ARCH/IO_interface.h"
+
 /****************************************TIMER0_REGISTERS **********************************************/
 
 // Timer/Counter Control Register 0 (TCCR0)
-#define TCCR0_ADD			 (*((volatile uint8_t *) 0x53))
+#define TCCR0_ADD			 (IO_REG8(0x53))
 #define WGM00_bit			 6
 #define WGM01_bit			 3
 
 // Timer/Counter Register 0 (TCNT0)
-#define TCNT0_ADD			 (*((volatile uint8_t *) 0x52))
+#define TCNT0_ADD			 (IO_REG8(0x52))
 
 // Timer Interrupt Mask Register (TIMSK)
-#define TIMSK_ADD			 (*((volatile uint8_t *) 0x59))
+#define TIMSK_ADD			 (IO_REG8(0x59))
 #define TOIE0_bit			 0
 #define OCIE0_bit			 1
 
 /****************************************TIMER1_REGISTERS **********************************************/
 
 // Timer/Counter 1 Control Registers A and B (TCCR1A and TCCR1B)
-#define TCCR1A_ADD   (*(volatile uint8_t*)0x4F)
-#define TCCR1B_ADD   (*(volatile uint8_t*)0x4E)
+#define TCCR1A_ADD   (IO_REG8(0x4F))
+#define TCCR1B_ADD   (IO_REG8(0x4E))
 
 // Timer/Counter 1 Register (TCNT1)
-#define TCNT1_ADD   (*(volatile uint16_t*)0x4C)
-#define TCNT1H_ADD   (*(volatile uint8_t*)0x4D)
-#define TCNT1L_ADD   (*(volatile uint8_t*)0x4C)
+#define TCNT1_ADD   (IO_REG16(0x4C))
+#define TCNT1H_ADD   (IO_REG8(0x4D))
+#define TCNT1L_ADD   (IO_REG8(0x4C))
 
 // Output Compare Registers 1A and 1B (OCR1A and OCR1B)
-#define OCR1AH_ADD   (*(volatile uint8_t*)0x4B)
-#define OCR1AL_ADD   (*(volatile uint8_t*)0x4A)
-#define OCR1BH_ADD  (*(volatile uint8_t*)0x49)
-#define OCR1BL_ADD   (*(volatile uint8_t*)0x48)
+#define OCR1AH_ADD   (IO_REG8(0x4B))
+#define OCR1AL_ADD   (IO_REG8(0x4A))
+#define OCR1BH_ADD  (IO_REG8(0x49))
+#define OCR1BL_ADD   (IO_REG8(0x48))
+#define OCR1A_ADD    (IO_REG16(0x4A))
+#define OCR1B_ADD    (IO_REG16(0x48))
+
+// Input Capture Register 1 (ICR1)
+#define ICR1_ADD     (IO_REG16(0x46))
+
+// Timer Interrupt Flag Register (TIFR)
+#define TIFR_ADD     (IO_REG8(0x58))
 
 // Bit positions in TCCR1A and TCCR1B
 #define COM1A0_BIT		6
@@ -63,19 +73,21 @@
 #define OCF1A_BIT		4
 #define OCF1B_BIT		3
 #define TOV1_BIT		2
+#define TICIE1_BIT		5
+#define ICF1_BIT		5
 
 /****************************************TIMER2_REGISTERS **********************************************/
 
 // Timer/Counter 2 Control Register (TCCR2)
-#define TCCR2_ADD   (*(volatile uint8_t*)0x45)
+#define TCCR2_ADD   (IO_REG8(0x45))
 #define WGM20_BIT	6
 #define WGM21_BIT	3
 
 // Timer/Counter Register 2 (TCNT2)
-#define TCNT2_ADD   (*(volatile uint8_t*)0x44)
+#define TCNT2_ADD   (IO_REG8(0x44))
 
 // Output Compare Register 2 (OCR2)
-#define OCR2_ADD    (*(volatile uint8_t*)0x43)
+#define OCR2_ADD    (IO_REG8(0x43))
 
 // Bit positions in TCCR2
 #define FOC2		7
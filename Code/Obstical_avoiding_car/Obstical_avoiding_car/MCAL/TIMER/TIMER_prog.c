@@ -24,6 +24,12 @@ static void (*timer1_callback_OVF)(void) = NULL;
 // Pointer to a function that represents the callback for Timer1 compare match interrupt
 static void (*timer1_callback_COMP)(void) = NULL;
 
+// Pointer to a function that represents the callback for Timer1 compare match B interrupt
+static void (*timer1_callback_COMPB)(void) = NULL;
+
+// Pointer to a function that represents the callback for Timer1 input capture interrupt
+static void (*timer1_callback_CAPT)(void) = NULL;
+
 // Pointer to a function that represents the callback for Timer2 overflow interrupt
 static void (*timer2_callback_OVF)(void) = NULL;
 
@@ -129,6 +135,31 @@ timer_enu_return_state_t timer_set_tcnt(timer_configuration_t *ptr_timer_config)
 	
 }
 
+/**
+ * @brief Retrieves the Timer/Counter (TCNT) value of Timer 0.
+ *
+ * This function retrieves the Timer/Counter (TCNT) value of Timer 0 and stores it in the provided pointer.
+ *
+ * @param ptr_timer_config Pointer to the timer configuration structure (not used in this function).
+ * @param ptr_u8_tcnt_value Pointer to store the retrieved TCNT value.
+ * @return timer_enu_return_state_t The return state of the timer get TCNT operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The timer get TCNT operation was successful.
+ *                                - TIMER_NOK: The provided timer configuration pointer is NULL.
+ */
+timer_enu_return_state_t timer_get_tcnt(timer_configuration_t *ptr_timer_config, uint8_t *ptr_u8_tcnt_value){
+	timer_enu_return_state_t enu_return_state = TIMER_OK;
+	if((ptr_timer_config == NULL) || (ptr_u8_tcnt_value == NULL)){
+		enu_return_state =TIMER_NOK;
+	}
+	else{
+		*ptr_u8_tcnt_value = TCNT0_ADD;
+	}
+
+	return enu_return_state;
+	
+}
+
 
 /**
  * @brief Initializes the overflow callback function for Timer 0.
@@ -414,6 +445,301 @@ timer_enu_return_state_t timer1_initialize_callback_COMP(void (*ptr_func)(void))
 	return enu_return_state;
 }
 
+/**
+ * @brief Initializes the compare match B callback function for Timer 1.
+ *
+ * @param ptr_func Pointer to the function called from the compare match B interrupt.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The callback was stored.
+ *                                - TIMER_NOK: The provided function pointer is NULL.
+ */
+timer_enu_return_state_t timer1_initialize_callback_COMPB(void (*ptr_func)(void)){
+	timer_enu_return_state_t enu_return_state = TIMER_OK;
+	if(ptr_func == NULL ){
+		enu_return_state =TIMER_NOK;
+	}
+	else{
+		timer1_callback_COMPB = ptr_func;
+	}
+
+	return enu_return_state;
+}
+
+/**
+ * @brief Starts Timer 1 in 10-bit fast PWM mode.
+ *
+ * The counter runs from 0 to TIMER1_PWM_TOP and wraps, so the PWM frequency is
+ * F_CPU / (prescaler * (TIMER1_PWM_TOP + 1)). Both compare outputs start disconnected with
+ * a compare value of 0; no interrupt is enabled. ICR1 is not used, it stays free for input capture.
+ *
+ * @param enu_prescaller Clock prescaler of the timer (TIMER_PRESCALLER_0 ... TIMER_PRESCALLER_1024).
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The timer was started.
+ *                                - TIMER_NOK: The prescaler is not an internal clock setting.
+ */
+timer_enu_return_state_t timer1_pwm_initialization(timer_prescaller_t enu_prescaller){
+	timer_enu_return_state_t enu_return_state = TIMER_OK;
+	if((enu_prescaller < TIMER_PRESCALLER_0) || (enu_prescaller > TIMER_PRESCALLER_1024)){
+		enu_return_state =TIMER_NOK;
+	}
+	else{
+		// Mode 7: WGM13:0 = 0111, outputs disconnected
+		TCCR1A_ADD = (U8_ONE_VALUE<<WGM11_BIT) | (U8_ONE_VALUE<<WGM10_BIT);
+		OCR1A_ADD = 0;
+		OCR1B_ADD = 0;
+		TCNT1_ADD = 0;
+		TCCR1B_ADD = (U8_ONE_VALUE<<WGM12_BIT) | enu_prescaller;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Sets the compare value of a Timer 1 PWM output.
+ *
+ * In fast PWM mode the new value is double buffered by the hardware and takes effect at the
+ * next TOP, so the running period is never cut.
+ *
+ * @param enu_channel Compare output to update.
+ * @param u16_compare Compare value, 0 ... TIMER1_PWM_TOP.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The compare value was set.
+ *                                - TIMER_NOK: Invalid channel or compare value above TIMER1_PWM_TOP.
+ */
+timer_enu_return_state_t timer1_pwm_set_compare(timer1_enu_channel_t enu_channel, uint16_t u16_compare){
+	timer_enu_return_state_t enu_return_state = TIMER_OK;
+	if(u16_compare > TIMER1_PWM_TOP){
+		enu_return_state =TIMER_NOK;
+	}
+	else if(enu_channel == TIMER1_CHANNEL_A){
+		OCR1A_ADD = u16_compare;
+	}
+	else if(enu_channel == TIMER1_CHANNEL_B){
+		OCR1B_ADD = u16_compare;
+	}
+	else{
+		enu_return_state =TIMER_NOK;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Connects or disconnects a Timer 1 compare output from its pin.
+ *
+ * When connected (non-inverting mode) the pin is set at BOTTOM and cleared on compare match,
+ * which gives a high time of (compare + 1) timer clocks. When disconnected the pin follows its PORT bit.
+ * The pin must be configured as an output for the signal to appear.
+ *
+ * @param enu_channel Compare output to update.
+ * @param u8_connect U8_ONE_VALUE to connect, U8_ZERO_VALUE to disconnect.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The output mode was set.
+ *                                - TIMER_NOK: Invalid channel.
+ */
+timer_enu_return_state_t timer1_pwm_connect(timer1_enu_channel_t enu_channel, uint8_t u8_connect){
+	timer_enu_return_state_t enu_return_state = TIMER_OK;
+	uint8_t u8_com_bit = COM1A1_BIT;
+	if(enu_channel == TIMER1_CHANNEL_A){
+		u8_com_bit = COM1A1_BIT;
+	}
+	else if(enu_channel == TIMER1_CHANNEL_B){
+		u8_com_bit = COM1B1_BIT;
+	}
+	else{
+		enu_return_state =TIMER_NOK;
+	}
+	if(enu_return_state == TIMER_OK){
+		// COM1x1:0 = 10 non-inverting, 00 disconnected
+		if(u8_connect == U8_ONE_VALUE){
+			SET_BIT(TCCR1A_ADD, u8_com_bit);
+		}
+		else{
+			CLEAR_BIT(TCCR1A_ADD, u8_com_bit);
+		}
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Starts Timer 1 as a free running 16-bit counter for the input capture unit.
+ *
+ * The counter runs in normal mode from 0 to 0xFFFF, so the difference of two captures taken
+ * less than one wrap apart is their distance in timer clocks, computed modulo 2^16.
+ * The capture edge starts as rising and the capture interrupt starts disabled.
+ *
+ * @param enu_prescaller Clock prescaler of the timer (TIMER_PRESCALLER_0 ... TIMER_PRESCALLER_1024).
+ * @param u8_noise_canceller U8_ONE_VALUE to enable the input capture noise canceller.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The timer was started.
+ *                                - TIMER_NOK: The prescaler is not an internal clock setting.
+ */
+timer_enu_return_state_t timer1_icu_initialization(timer_prescaller_t enu_prescaller, uint8_t u8_noise_canceller){
+	timer_enu_return_state_t enu_return_state = TIMER_OK;
+	if((enu_prescaller < TIMER_PRESCALLER_0) || (enu_prescaller > TIMER_PRESCALLER_1024)){
+		enu_return_state =TIMER_NOK;
+	}
+	else{
+		// Mode 0: WGM13:0 = 0000, outputs disconnected
+		CLEAR_BIT(TIMSK_ADD, TICIE1_BIT);
+		TCCR1A_ADD = 0;
+		TCNT1_ADD = 0;
+		TCCR1B_ADD = ((u8_noise_canceller == U8_ONE_VALUE) << ICNC1_BIT) | (U8_ONE_VALUE<<ICES1_BIT) | enu_prescaller;
+		TIFR_ADD = (U8_ONE_VALUE<<ICF1_BIT);
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Selects the ICP1 edge that triggers the next capture.
+ *
+ * @param enu_edge Capture edge.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The edge was set.
+ *                                - TIMER_NOK: Invalid edge.
+ */
+timer_enu_return_state_t timer1_icu_set_edge(timer1_enu_icu_edge_t enu_edge){
+	timer_enu_return_state_t enu_return_state = TIMER_OK;
+	if(enu_edge == TIMER1_ICU_RISING_EDGE){
+		SET_BIT(TCCR1B_ADD, ICES1_BIT);
+	}
+	else if(enu_edge == TIMER1_ICU_FALLING_EDGE){
+		CLEAR_BIT(TCCR1B_ADD, ICES1_BIT);
+	}
+	else{
+		enu_return_state =TIMER_NOK;
+	}
+	if(enu_return_state == TIMER_OK){
+		// Changing ICES1 may raise ICF1, the flag is cleared by writing one to it
+		TIFR_ADD = (U8_ONE_VALUE<<ICF1_BIT);
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Retrieves the counter value latched by the last capture event.
+ *
+ * @param ptr_u16_capture Pointer to store the captured value (ICR1).
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The value was read.
+ *                                - TIMER_NOK: The provided pointer is NULL.
+ */
+timer_enu_return_state_t timer1_icu_get_capture(uint16_t *ptr_u16_capture){
+	timer_enu_return_state_t enu_return_state = TIMER_OK;
+	if(ptr_u16_capture == NULL ){
+		enu_return_state =TIMER_NOK;
+	}
+	else{
+		*ptr_u16_capture = ICR1_ADD;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Retrieves the running 16-bit counter value of Timer 1 (TCNT1).
+ *
+ * @param ptr_u16_count Pointer to store the counter value.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The value was read.
+ *                                - TIMER_NOK: The provided pointer is NULL.
+ */
+timer_enu_return_state_t timer1_icu_get_counter(uint16_t *ptr_u16_count){
+	timer_enu_return_state_t enu_return_state = TIMER_OK;
+	if(ptr_u16_count == NULL ){
+		enu_return_state =TIMER_NOK;
+	}
+	else{
+		*ptr_u16_count = TCNT1_ADD;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Initializes the input capture callback function for Timer 1.
+ *
+ * @param ptr_func Pointer to the function called from the capture interrupt.
+ * @return timer_enu_return_state_t The return state of the operation.
+ *                                Possible values:
+ *                                - TIMER_OK: The callback was stored.
+ *                                - TIMER_NOK: The provided function pointer is NULL.
+ */
+timer_enu_return_state_t timer1_icu_initialize_callback(void (*ptr_func)(void)){
+	timer_enu_return_state_t enu_return_state = TIMER_OK;
+	if(ptr_func == NULL ){
+		enu_return_state =TIMER_NOK;
+	}
+	else{
+		timer1_callback_CAPT = ptr_func;
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Enables the Timer 1 input capture interrupt (and global interrupts).
+ */
+void timer1_icu_enable_interrupt(void){
+	TIFR_ADD = (U8_ONE_VALUE<<ICF1_BIT);
+	SET_BIT(TIMSK_ADD, TICIE1_BIT);
+	sei();
+}
+
+/**
+ * @brief Disables the Timer 1 input capture interrupt.
+ */
+void timer1_icu_disable_interrupt(void){
+	CLEAR_BIT(TIMSK_ADD, TICIE1_BIT);
+}
+
+/**
+ * @brief Arms the Timer 1 compare match A interrupt as a timeout of the input capture unit.
+ *
+ * @param u16_compare Counter value of the match (OCR1A).
+ */
+void timer1_icu_arm_timeout(uint16_t u16_compare){
+	OCR1A_ADD = u16_compare;
+	TIFR_ADD = (U8_ONE_VALUE<<OCF1A_BIT);
+	SET_BIT(TIMSK_ADD, OCIE1A_BIT);
+}
+
+/**
+ * @brief Disarms the Timer 1 compare match A interrupt.
+ */
+void timer1_icu_disarm_timeout(void){
+	CLEAR_BIT(TIMSK_ADD, OCIE1A_BIT);
+}
+
+/**
+ * @brief Arms the Timer 1 compare match B interrupt on the free running counter.
+ *
+ * @param u16_compare Counter value of the match (OCR1B).
+ */
+void timer1_icu_arm_compare_b(uint16_t u16_compare){
+	OCR1B_ADD = u16_compare;
+	TIFR_ADD = (U8_ONE_VALUE<<OCF1B_BIT);
+	SET_BIT(TIMSK_ADD, OCIE1B_BIT);
+}
+
+/**
+ * @brief Disarms the Timer 1 compare match B interrupt.
+ */
+void timer1_icu_disarm_compare_b(void){
+	CLEAR_BIT(TIMSK_ADD, OCIE1B_BIT);
+}
+
+// Timer 1 input capture interrupt
+ISR(TIMER1_CAPT) {
+	// Call the Timer 1 input capture callback function
+	if(timer1_callback_CAPT != NULL){
+		(*timer1_callback_CAPT)();
+	}
+}
+
 // Timer 1 overflow interrupt
 ISR(TIMER1_OVF) {
 	// Call the Timer 1 overflow callback function
@@ -425,6 +751,14 @@ ISR(TIMER1_COMPA) {
 	// Call the Timer 1 compare match A callback function
 	(*timer1_callback_COMP)();
 }
+
+// Timer 1 compare match B interrupt
+ISR(TIMER1_COMPB) {
+	// Call the Timer 1 compare match B callback function
+	if(timer1_callback_COMPB != NULL){
+		(*timer1_callback_COMPB)();
+	}
+}
 /************************************************************************************************/
 /************************************************************************************************/
 /************************************************************************************************/
@@ -0,0 +1,38 @@
+/**
+ * @file SIM_config.h
+ * @brief Configuration of the host simulation of the ATmega32 (HOST_SIM builds only).
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef SIM_CONFIG_H_
+#define SIM_CONFIG_H_
+
+/** @brief Simulated CPU frequency in Hertz, must match MCU_CLOCK of the firmware. */
+#define SIM_CPU_CLOCK_HZ                16000000UL
+
+/** @brief Cycles charged for every access to an I/O register (LDS/STS take 2 cycles). */
+#define SIM_IO_ACCESS_CYCLES            2u
+
+/** @brief Cycles charged for entering plus leaving an interrupt (vector jump, prologue, RETI). */
+#define SIM_ISR_OVERHEAD_CYCLES         10u
+
+/**
+ * @brief Default cost of firmware computation between two register accesses,
+ *        in simulated cycles per microsecond of host CPU time.
+ *
+ * 0 charges register accesses and the busy-wait loops the firmware declares only, so identical
+ * runs give identical results. Host time (-c on the command line) is only a rough stand-in for
+ * AVR cycles and varies from run to run.
+ */
+#define SIM_DEFAULT_CYCLES_PER_HOST_US  0u
+
+/** @brief Cap on the host time charged for one gap (hides preemption and page faults), in ns. */
+#define SIM_MAX_CHARGED_HOST_NS         50000u
+
+/** @brief Maximum number of pending scheduled stimuli. */
+#define SIM_MAX_EVENTS                  16u
+
+#endif /* SIM_CONFIG_H_ */
@@ -0,0 +1,174 @@
+/**
+ * @file SIM_interface.h
+ * @brief Interface of the host simulation of the ATmega32 (HOST_SIM builds only).
+ *
+ * The simulator owns a RAM copy of the I/O register file, a virtual cycle clock, models of
+ * Timer0/1/2 and of INT0/1/2, and a dispatcher that calls the firmware's ISR vectors at the
+ * simulated time they become due. The unchanged MCAL reaches it through IO_REG8/IO_REG16 and
+ * sei()/cli(); the harness (SIM_main.c) drives input pins and observes output ports.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef SIM_INTERFACE_H_
+#define SIM_INTERFACE_H_
+
+#include "../STD_LIB/std_types.h"
+
+/*****************************************************************************************************************/
+/*											Type Definitions													 */
+/*****************************************************************************************************************/
+
+typedef enum{
+	SIM_OK = 0,
+	SIM_NOK
+}sim_enu_return_state_t;
+
+/** @brief Simulated ports, numbered like the DIO ports. */
+typedef enum{
+	SIM_PORT_A = 0,
+	SIM_PORT_B,
+	SIM_PORT_C,
+	SIM_PORT_D,
+	SIM_PORT_MAX
+}sim_enu_port_t;
+
+/** @brief Timer 1 output compare pins. */
+typedef enum{
+	SIM_OC1A = 0,   /**< PD5 */
+	SIM_OC1B,       /**< PD4 */
+	SIM_OC_MAX
+}sim_enu_oc_t;
+
+/** @brief Number of interrupt vectors including the reset vector. */
+#define SIM_VECTOR_MAX          21u
+
+/**
+ * @brief Harness configuration.
+ */
+typedef struct{
+	uint64_t u64_stop_cycle;        /**< Simulation ends when the clock reaches this cycle. */
+	uint32_t u32_cycles_per_host_us;/**< Charge for host computation, 0 (deterministic) to charge register accesses and declared loops only. */
+	/** Called whenever the firmware changes an output port (after the write, at its cycle). */
+	void (*ptr_port_write)(sim_enu_port_t enu_port, uint8_t u8_old, uint8_t u8_new);
+	/** Called once when the stop cycle is reached, before the process exits. The clock stands still
+	    from then on, so the callback may call firmware functions that read registers. */
+	void (*ptr_stop)(void);
+}sim_str_config_t;
+
+/**
+ * @brief Run statistics.
+ */
+typedef struct{
+	uint64_t u64_cycles;                            /**< Current simulated cycle. */
+	uint64_t u64_io_accesses;                       /**< Number of register accesses. */
+	uint64_t u64_compute_cycles;                    /**< Cycles charged for busy-wait loops and host computation. */
+	uint64_t u64_skipped_cycles;                    /**< Cycles skipped while the firmware idled. */
+	uint64_t u64_isr_cycles;                        /**< Cycles spent inside ISRs (all vectors). */
+	uint32_t au32_isr_count[SIM_VECTOR_MAX];        /**< Dispatches per vector. */
+	uint64_t au64_isr_cycles[SIM_VECTOR_MAX];       /**< Cycles per vector, including overhead. */
+	uint32_t au32_isr_max_cycles[SIM_VECTOR_MAX];   /**< Longest single dispatch per vector. */
+}sim_str_stats_t;
+
+/*****************************************************************************************************************/
+/*											Function Prototypes													 */
+/*****************************************************************************************************************/
+
+/**
+ * @brief Returns the simulated register at a data-space address.
+ *
+ * Every call is one register access: pending writes of the previous access are applied,
+ * the clock is advanced (interrupts that become due are dispatched) and readable registers
+ * such as PINx and TCNTx are refreshed before the pointer is returned.
+ *
+ * @param u16_address Data-space address (0x20..0x5F).
+ * @return Pointer to the register inside the simulated register file.
+ */
+volatile uint8_t *SIM_pu8IoReg(uint16_t u16_address);
+
+/** @brief Sets the I bit of SREG, the host replacement of the sei instruction. */
+void SIM_vidSei(void);
+
+/** @brief Clears the I bit of SREG, the host replacement of the cli instruction. */
+void SIM_vidCli(void);
+
+/**
+ * @brief Lets the firmware declare that it has nothing to do until the next interrupt.
+ *
+ * The clock jumps to the next timer or stimulus event and the due interrupts are dispatched,
+ * the counterpart of the SLEEP instruction in idle mode.
+ */
+void SIM_vidIdle(void);
+
+/**
+ * @brief Lets the firmware declare a counted busy-wait loop.
+ *
+ * The loop touches no register and takes no time on the host, so its duration is charged to the
+ * clock here, with the interrupts that become due on the way dispatched.
+ *
+ * @param u32_us Duration of the loop on the target in microseconds.
+ */
+void SIM_vidSpinUs(uint32_t u32_us);
+
+/**
+ * @brief Initializes the simulated MCU with all registers at their reset values.
+ *
+ * @param ptr_str_config Harness configuration, copied.
+ * @return SIM_OK, or SIM_NOK if ptr_str_config is NULL.
+ */
+sim_enu_return_state_t SIM_enuInit(const sim_str_config_t *ptr_str_config);
+
+/**
+ * @brief Starts the clock model, to be called right before entering the firmware.
+ *
+ * Host time spent in the harness set-up is not charged to the firmware.
+ */
+void SIM_vidStart(void);
+
+/**
+ * @brief Drives an input pin from outside the MCU.
+ *
+ * The level takes effect at the current cycle and may raise an external interrupt.
+ *
+ * @param enu_port Port of the pin.
+ * @param u8_pin Pin number 0..7.
+ * @param u8_level HIGH or LOW.
+ */
+void SIM_vidSetPin(sim_enu_port_t enu_port, uint8_t u8_pin, uint8_t u8_level);
+
+/**
+ * @brief Schedules a harness callback at an absolute cycle.
+ *
+ * @param u64_cycle Cycle at which ptr_callback is called (clamped to the current cycle).
+ * @param ptr_callback Function to call.
+ * @param ptr_arg Argument passed to ptr_callback.
+ * @return SIM_OK, or SIM_NOK if the callback is NULL or the event queue is full.
+ */
+sim_enu_return_state_t SIM_enuSchedule(uint64_t u64_cycle, void (*ptr_callback)(void *), void *ptr_arg);
+
+/** @brief Returns the current simulated cycle. */
+uint64_t SIM_u64GetCycles(void);
+
+/**
+ * @brief Copies the run statistics.
+ *
+ * @param ptr_str_stats Destination.
+ */
+void SIM_vidGetStats(sim_str_stats_t *ptr_str_stats);
+
+/**
+ * @brief Returns the duty cycle a Timer 1 output compare pin currently produces.
+ *
+ * Only the non-inverting PWM output (COM1x1:0 = 2) is modelled: the pin is high for
+ * OCR1x + 1 of every TOP + 1 timer counts.
+ *
+ * @param enu_oc Output compare pin.
+ * @param ptr_f64_duty Receives the duty cycle, 0.0 .. 1.0.
+ * @return SIM_OK, or SIM_NOK if the pin is not driven by the timer (compare output disconnected,
+ *         pin configured as input) or an argument is invalid.
+ */
+sim_enu_return_state_t SIM_enuGetOcDuty(sim_enu_oc_t enu_oc, float64_t *ptr_f64_duty);
+
+#endif /* SIM_INTERFACE_H_ */
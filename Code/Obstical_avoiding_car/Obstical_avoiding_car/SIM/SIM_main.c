@@ -0,0 +1,754 @@
+/**
+ * @file SIM_main.c
+ * @brief Host harness: runs the unchanged firmware against the simulated ATmega32 inside a
+ *        simple world model and reports timing, interrupt load and obstacle reaction figures.
+ *
+ * World model:
+ * - a differential drive car in a rectangular room, motor 1 (PA3/PA4) drives the left wheel,
+ *   motor 2 (PA0/PA1) the right wheel. The wheel speed follows the Timer 1 PWM on OC1A (PD5, left)
+ *   and OC1B (PD4, right) while a compare output is connected, else PA2, the common enable driven
+ *   by the software PWM.
+ * - three HC-SR04, on the car front and looking left and right, TRIG on PB3, PB0 and PB1. Their ECHO
+ *   outputs are ORed onto both PD3 (INT1) and PD6 (ICP1), so either ranging engine sees them. Each
+ *   ranges the nearest wall along its axis.
+ * - a hobby servo on PD7 turning the front sensor: the width of each pulse (1-2 ms for 0-180 degrees,
+ *   90 straight ahead) sets the target, which the servo reaches at SIM_MAIN_SERVO_DEG_PER_S.
+ * - the start/stop button PB2 on PD2 and the direction button PB1 on PD1, both active low.
+ * - an HD44780 2x16 LCD on port C (D4..D7 on PC0..PC3, RS PC4, RW PC5, E PC6), decoded to print its final
+ *   content. Reads return the busy flag on D7, writes that arrive while the controller is busy are counted.
+ *
+ * - echo faults (-n): per mille of the pings return a short multipath echo or no echo at all, picked by a
+ *   fixed pseudo-random sequence so that runs are repeatable.
+ *
+ * Usage: obstacle_car_sim [-t seconds] [-c cycles_per_host_us] [-n echo_faults_per_mille]
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "SIM_interface.h"
+#include "SIM_config.h"
+#include "../HAL/SCHEDULER/SCHEDULER_interface.h"
+
+/*****************************************************************************************************************/
+/*											Macro Declarations													 */
+/*****************************************************************************************************************/
+
+#define SIM_MAIN_DEFAULT_SECONDS        60u
+
+#define SIM_MAIN_US_TO_CYCLES(US)       ((uint64_t)((US) * (SIM_CPU_CLOCK_HZ / 1000000.0)))
+#define SIM_MAIN_CYCLES_TO_S(CYC)       ((double)(CYC) / (double)SIM_CPU_CLOCK_HZ)
+
+/* Room and car geometry, millimetres */
+#define SIM_MAIN_ROOM_W                 4000.0
+#define SIM_MAIN_ROOM_H                 2500.0
+#define SIM_MAIN_START_X                800.0
+#define SIM_MAIN_START_Y                1250.0
+#define SIM_MAIN_CAR_RADIUS             90.0
+#define SIM_MAIN_SENSOR_OFFSET          80.0
+#define SIM_MAIN_TRACK                  140.0
+#define SIM_MAIN_WHEEL_MAX_SPEED        600.0       /* mm/s at 100 % duty */
+
+/* HC-SR04 */
+#define SIM_MAIN_ECHO_DELAY_US          200.0
+#define SIM_MAIN_ECHO_US_PER_MM         (2000.0 / 343.0)
+#define SIM_MAIN_ECHO_MAX_RANGE         4000.0
+#define SIM_MAIN_ECHO_TIMEOUT_US        38000.0
+#define SIM_MAIN_MULTIPATH_MIN          50.0        /* mm, range of the false distance of a multipath echo */
+#define SIM_MAIN_MULTIPATH_SPAN         200.0
+#define SIM_MAIN_FAULT_SEED             0x2545F491u
+
+/* Servo: pulse widths of both ends of the travel, travel and speed */
+#define SIM_MAIN_SERVO_MIN_US           1000.0
+#define SIM_MAIN_SERVO_MAX_US           2000.0
+#define SIM_MAIN_SERVO_RANGE_DEG        180.0
+#define SIM_MAIN_SERVO_DEG_PER_S        600.0
+#define SIM_MAIN_SERVO_VALID_US         500.0       /* shorter or longer pulses are ignored */
+#define SIM_MAIN_SERVO_INVALID_US       2500.0
+
+/* Safety figure: reaction to the 30 cm decision threshold */
+#define SIM_MAIN_REACT_DIST             300.0
+
+/* Speed check: duty drops while going forward towards a wall */
+#define SIM_MAIN_DUTY_NEAR              600.0       /* mm, drops closer than this count */
+#define SIM_MAIN_DUTY_DROP              0.02        /* smallest drop counted, timing jitter stays below */
+
+#define SIM_MAIN_WORLD_TICK_US          1000.0
+
+/* Pins */
+#define SIM_MAIN_SENSORS                3u          /* front, left, right */
+#define SIM_MAIN_ECHO_PIN               3           /* PD3 */
+#define SIM_MAIN_ECHO_ICP_PIN           6           /* PD6 */
+#define SIM_MAIN_START_BTN_PIN          2           /* PD2 */
+#define SIM_MAIN_DIR_BTN_PIN            1           /* PD1 */
+#define SIM_MAIN_SERVO_PIN              7           /* PD7 */
+#define SIM_MAIN_M1_PIN1                3           /* PA3 */
+#define SIM_MAIN_M1_PIN2                4           /* PA4 */
+#define SIM_MAIN_M2_PIN1                0           /* PA0 */
+#define SIM_MAIN_M2_PIN2                1           /* PA1 */
+#define SIM_MAIN_EN_PIN                 2           /* PA2 */
+#define SIM_MAIN_LCD_RS_PIN             4           /* PC4 */
+#define SIM_MAIN_LCD_RW_PIN             5           /* PC5 */
+#define SIM_MAIN_LCD_D7_PIN             3           /* PC3 */
+#define SIM_MAIN_LCD_E_PIN              6           /* PC6 */
+#define SIM_MAIN_LCD_DATA_MASK          0x0Fu       /* PC0..PC3 carry D4..D7 */
+
+#define SIM_MAIN_LCD_DDRAM_SIZE         0x80u
+#define SIM_MAIN_LCD_LINE_2             0x40u
+#define SIM_MAIN_LCD_COLS               16u
+
+/* HD44780 execution times */
+#define SIM_MAIN_LCD_EXEC_US            37.0
+#define SIM_MAIN_LCD_HOME_US            1520.0
+
+#define SIM_MAIN_BIT(REG, BIT)          (((REG) >> (BIT)) & 1u)
+
+/*****************************************************************************************************************/
+/*											Type Definitions													 */
+/*****************************************************************************************************************/
+
+typedef struct{
+	double f64_x;
+	double f64_y;
+	double f64_heading;
+	uint8_t u8_porta;               /* last motor/enable outputs */
+	double af64_oc_duty[SIM_OC_MAX];/* Timer 1 PWM duty per wheel, negative while the compare output is off */
+	uint64_t u64_update_cycle;      /* cycle the pose was integrated to */
+	double f64_travelled;
+	uint8_t u8_echo_busy;           /* bit per sensor ranging */
+	uint8_t u8_echo_high;           /* bit per sensor driving its echo high */
+	uint8_t u8_in_contact;
+	uint32_t u32_collisions;
+	uint32_t au32_pings[SIM_MAIN_SENSORS];
+	double f64_prev_front;
+	uint8_t u8_react_armed;         /* threshold crossed, waiting for the firmware to stop going forward */
+	uint64_t u64_react_cross_cycle;
+	uint32_t u32_reactions;
+	double f64_react_sum_ms;
+	double f64_react_max_ms;
+	uint32_t u32_react_missed;
+	double f64_min_front;
+	uint64_t u64_en_rise_cycle;     /* last rising edge of PA2 while going forward, 0 if none */
+	uint64_t u64_en_fall_cycle;
+	double f64_fwd_duty;            /* duty of the last forward PWM period, negative if none */
+	double f64_cmd_duty;            /* duty the firmware had set at the start of the period in progress */
+	uint32_t u32_duty_mismatches;   /* forward PWM periods not run with the duty set at their start */
+	uint32_t u32_duty_drops;        /* forward duty drops near a wall */
+	double f64_min_fwd_duty;
+	uint32_t u32_echo_faults;       /* pings answered with a multipath or a missing echo */
+	uint32_t u32_rotations;         /* manoeuvres started: wheels turning in opposite directions */
+	uint32_t u32_reversals;         /* manoeuvres started: both wheels backward */
+	double f64_servo_deg;           /* servo angle, 90 straight ahead */
+	double f64_servo_target_deg;    /* angle of the last pulse */
+	uint64_t u64_servo_cycle;       /* cycle the servo angle was updated to */
+	uint64_t u64_servo_rise_cycle;  /* start of the pulse on PD7 */
+	uint32_t u32_servo_pulses;
+	double f64_servo_travel_deg;
+}sim_main_str_world_t;
+
+typedef struct{
+	uint8_t u8_trig_pin;            /* on port B */
+	double f64_angle;               /* axis relative to the heading, radians counter-clockwise */
+	uint8_t u8_on_servo;            /* turned by the servo away from f64_angle */
+	const char *pch_name;
+	double f64_width_us;            /* echo of the ping in flight */
+}sim_main_str_sensor_t;
+
+typedef struct{
+	uint8_t au8_ddram[SIM_MAIN_LCD_DDRAM_SIZE];
+	uint8_t u8_address;
+	uint8_t u8_four_bit;            /* interface length, the controller powers up in 8-bit mode */
+	uint8_t u8_half;                /* high nibble received, waiting for the low one */
+	uint8_t u8_high;
+	uint8_t u8_cgram;               /* data writes go to the CGRAM */
+	uint32_t u32_transfers;         /* E pulses */
+	uint32_t u32_data_writes;
+	uint32_t u32_commands;
+	uint64_t u64_busy_until;        /* cycle the running instruction completes */
+	uint32_t u32_busy_reads;        /* E pulses with RW high */
+	uint32_t u32_busy_writes;       /* bytes started while the controller was busy */
+}sim_main_str_lcd_t;
+
+/*****************************************************************************************************************/
+/*											Global variables													 */
+/*****************************************************************************************************************/
+
+static sim_main_str_world_t gs_str_world;
+static sim_main_str_lcd_t gs_str_lcd;
+static struct timespec gs_str_wall_start;
+static uint32_t gs_u32_seconds = SIM_MAIN_DEFAULT_SECONDS;
+static uint32_t gs_u32_cycles_per_host_us = SIM_DEFAULT_CYCLES_PER_HOST_US;
+static uint32_t gs_u32_fault_per_mille = 0u;
+static uint32_t gs_u32_fault_state = SIM_MAIN_FAULT_SEED;
+
+/* The firmware's main(), renamed at compile time */
+int SIM_firmwareMain(void);
+
+/* Worst echo-end to motor-command time the firmware measured itself, from APP_interface.h */
+uint32_t APP_u32GetMaxReactionTicks(void);
+
+/* Duty cycle the firmware last set the motors to, from APP_interface.h */
+uint8_t APP_u8GetCarSpeed(void);
+
+static sim_main_str_sensor_t gs_astr_sensors[SIM_MAIN_SENSORS] = {
+	{3u, 0.0,         1u, "front", 0.0},
+	{0u, M_PI / 2.0,  0u, "left",  0.0},
+	{1u, -M_PI / 2.0, 0u, "right", 0.0},
+};
+
+static const char *const gs_apch_vector_names[SIM_VECTOR_MAX] = {
+	"RESET", "INT0", "INT1", "INT2", "TIMER2_COMP", "TIMER2_OVF", "TIMER1_CAPT", "TIMER1_COMPA",
+	"TIMER1_COMPB", "TIMER1_OVF", "TIMER0_COMP", "TIMER0_OVF", "SPI_STC", "USART_RXC", "USART_UDRE",
+	"USART_TXC", "ADC", "EE_RDY", "ANA_COMP", "TWI", "SPM_RDY"
+};
+
+/*****************************************************************************************************************/
+/*											World model															 */
+/*****************************************************************************************************************/
+
+static sint8_t sim_main_s8WheelDir(uint8_t u8_porta, uint8_t u8_pin1, uint8_t u8_pin2)
+{
+	sint8_t s8_dir = 0;
+	if(SIM_MAIN_BIT(u8_porta, u8_pin1) && !SIM_MAIN_BIT(u8_porta, u8_pin2)){
+		s8_dir = 1;
+	}else if(!SIM_MAIN_BIT(u8_porta, u8_pin1) && SIM_MAIN_BIT(u8_porta, u8_pin2)){
+		s8_dir = -1;
+	}else{
+		/* brake or coast */
+	}
+	return s8_dir;
+}
+
+static uint8_t sim_main_u8Forward(uint8_t u8_porta)
+{
+	return (sim_main_s8WheelDir(u8_porta, SIM_MAIN_M1_PIN1, SIM_MAIN_M1_PIN2) > 0) &&
+	       (sim_main_s8WheelDir(u8_porta, SIM_MAIN_M2_PIN1, SIM_MAIN_M2_PIN2) > 0);
+}
+
+/* Left and right wheel direction packed as one value, to tell manoeuvres apart */
+static sint8_t sim_main_s8Motion(uint8_t u8_porta)
+{
+	return (sint8_t)((sim_main_s8WheelDir(u8_porta, SIM_MAIN_M1_PIN1, SIM_MAIN_M1_PIN2) * 3) +
+	                 sim_main_s8WheelDir(u8_porta, SIM_MAIN_M2_PIN1, SIM_MAIN_M2_PIN2));
+}
+
+/* xorshift32, the fault sequence only depends on the number of pings */
+static uint32_t sim_main_u32Random(void)
+{
+	gs_u32_fault_state ^= gs_u32_fault_state << 13;
+	gs_u32_fault_state ^= gs_u32_fault_state >> 17;
+	gs_u32_fault_state ^= gs_u32_fault_state << 5;
+	return gs_u32_fault_state;
+}
+
+/* Distance from a sensor looking along f64_angle (relative to the heading) to the wall it faces */
+static double sim_main_f64WallDistance(double f64_angle)
+{
+	double f64_axis = gs_str_world.f64_heading + f64_angle;
+	double f64_sx = gs_str_world.f64_x + (SIM_MAIN_SENSOR_OFFSET * cos(f64_axis));
+	double f64_sy = gs_str_world.f64_y + (SIM_MAIN_SENSOR_OFFSET * sin(f64_axis));
+	double f64_dx = cos(f64_axis);
+	double f64_dy = sin(f64_axis);
+	double f64_best = 1e9;
+
+	if(f64_dx > 1e-9)  { f64_best = fmin(f64_best, (SIM_MAIN_ROOM_W - f64_sx) / f64_dx); }
+	if(f64_dx < -1e-9) { f64_best = fmin(f64_best, -f64_sx / f64_dx); }
+	if(f64_dy > 1e-9)  { f64_best = fmin(f64_best, (SIM_MAIN_ROOM_H - f64_sy) / f64_dy); }
+	if(f64_dy < -1e-9) { f64_best = fmin(f64_best, -f64_sy / f64_dy); }
+	return (f64_best < 0.0) ? 0.0 : f64_best;
+}
+
+/* Moves the servo towards the angle of the last pulse and returns its offset from straight ahead, radians */
+static double sim_main_f64ServoOffset(void)
+{
+	uint64_t u64_now = SIM_u64GetCycles();
+	double f64_step = SIM_MAIN_CYCLES_TO_S(u64_now - gs_str_world.u64_servo_cycle) * SIM_MAIN_SERVO_DEG_PER_S;
+	double f64_error = gs_str_world.f64_servo_target_deg - gs_str_world.f64_servo_deg;
+
+	gs_str_world.u64_servo_cycle = u64_now;
+	if(fabs(f64_error) <= f64_step){
+		gs_str_world.f64_servo_travel_deg += fabs(f64_error);
+		gs_str_world.f64_servo_deg = gs_str_world.f64_servo_target_deg;
+	}else{
+		gs_str_world.f64_servo_travel_deg += f64_step;
+		gs_str_world.f64_servo_deg += (f64_error > 0.0) ? f64_step : -f64_step;
+	}
+	return (gs_str_world.f64_servo_deg - (SIM_MAIN_SERVO_RANGE_DEG / 2.0)) * M_PI / 180.0;
+}
+
+/* Distance from the front sensor to the wall straight ahead */
+static double sim_main_f64FrontDistance(void)
+{
+	return sim_main_f64WallDistance(0.0);
+}
+
+/* Records the duty of a forward PWM period, counts it if it is lower than the one before near a wall */
+static void sim_main_vidForwardDuty(double f64_duty)
+{
+	if(fabs(f64_duty - gs_str_world.f64_cmd_duty) > SIM_MAIN_DUTY_DROP){
+		gs_str_world.u32_duty_mismatches++;
+	}
+	if(gs_str_world.f64_prev_front < SIM_MAIN_DUTY_NEAR){
+		if((gs_str_world.f64_fwd_duty >= 0.0) && (f64_duty < (gs_str_world.f64_fwd_duty - SIM_MAIN_DUTY_DROP))){
+			gs_str_world.u32_duty_drops++;
+		}
+		if(f64_duty < gs_str_world.f64_min_fwd_duty){
+			gs_str_world.f64_min_fwd_duty = f64_duty;
+		}
+	}
+	gs_str_world.f64_fwd_duty = f64_duty;
+}
+
+/* Integrates the pose up to the current cycle with the outputs that were active meanwhile */
+static void sim_main_vidWorldUpdate(void)
+{
+	uint64_t u64_now = SIM_u64GetCycles();
+	double f64_dt = SIM_MAIN_CYCLES_TO_S(u64_now - gs_str_world.u64_update_cycle);
+	uint8_t u8_porta = gs_str_world.u8_porta;
+	double f64_en = SIM_MAIN_BIT(u8_porta, SIM_MAIN_EN_PIN) ? 1.0 : 0.0;
+	double f64_en_l = (gs_str_world.af64_oc_duty[SIM_OC1A] >= 0.0) ? gs_str_world.af64_oc_duty[SIM_OC1A] : f64_en;
+	double f64_en_r = (gs_str_world.af64_oc_duty[SIM_OC1B] >= 0.0) ? gs_str_world.af64_oc_duty[SIM_OC1B] : f64_en;
+	double f64_vl = sim_main_s8WheelDir(u8_porta, SIM_MAIN_M1_PIN1, SIM_MAIN_M1_PIN2) * f64_en_l * SIM_MAIN_WHEEL_MAX_SPEED;
+	double f64_vr = sim_main_s8WheelDir(u8_porta, SIM_MAIN_M2_PIN1, SIM_MAIN_M2_PIN2) * f64_en_r * SIM_MAIN_WHEEL_MAX_SPEED;
+	double f64_v = (f64_vl + f64_vr) / 2.0;
+	double f64_w = (f64_vr - f64_vl) / SIM_MAIN_TRACK;
+	double f64_front;
+	sim_enu_oc_t enu_oc;
+
+	gs_str_world.u64_update_cycle = u64_now;
+	/* Compare registers change without a port write: the duty is sampled here, every update
+	   (at least once per ping) */
+	for(enu_oc = SIM_OC1A; enu_oc < SIM_OC_MAX; enu_oc++){
+		if(SIM_enuGetOcDuty(enu_oc, &gs_str_world.af64_oc_duty[enu_oc]) != SIM_OK){
+			gs_str_world.af64_oc_duty[enu_oc] = -1.0;
+		}
+	}
+	if((gs_str_world.af64_oc_duty[SIM_OC1A] >= 0.0) && sim_main_u8Forward(u8_porta)){
+		gs_str_world.f64_cmd_duty = gs_str_world.af64_oc_duty[SIM_OC1A];  /* Timer 1 takes a new duty without a port write */
+		sim_main_vidForwardDuty(gs_str_world.af64_oc_duty[SIM_OC1A]);
+	}
+	if(f64_dt <= 0.0){
+		return;
+	}
+	if(fabs(f64_w) < 1e-9){
+		gs_str_world.f64_x += f64_v * f64_dt * cos(gs_str_world.f64_heading);
+		gs_str_world.f64_y += f64_v * f64_dt * sin(gs_str_world.f64_heading);
+	}else{
+		double f64_h1 = gs_str_world.f64_heading + (f64_w * f64_dt);
+		gs_str_world.f64_x += (f64_v / f64_w) * (sin(f64_h1) - sin(gs_str_world.f64_heading));
+		gs_str_world.f64_y -= (f64_v / f64_w) * (cos(f64_h1) - cos(gs_str_world.f64_heading));
+		gs_str_world.f64_heading = fmod(f64_h1, 2.0 * M_PI);
+	}
+	gs_str_world.f64_travelled += fabs(f64_v) * f64_dt;
+
+	/* Walls stop the car */
+	{
+		double f64_cx = fmin(fmax(gs_str_world.f64_x, SIM_MAIN_CAR_RADIUS), SIM_MAIN_ROOM_W - SIM_MAIN_CAR_RADIUS);
+		double f64_cy = fmin(fmax(gs_str_world.f64_y, SIM_MAIN_CAR_RADIUS), SIM_MAIN_ROOM_H - SIM_MAIN_CAR_RADIUS);
+		if((f64_cx != gs_str_world.f64_x) || (f64_cy != gs_str_world.f64_y)){
+			gs_str_world.f64_x = f64_cx;
+			gs_str_world.f64_y = f64_cy;
+			if(!gs_str_world.u8_in_contact){
+				gs_str_world.u8_in_contact = 1u;
+				gs_str_world.u32_collisions++;
+			}
+		}else{
+			gs_str_world.u8_in_contact = 0u;
+		}
+	}
+
+	/* Reaction latency: from the true distance crossing the threshold to the end of forward drive */
+	f64_front = sim_main_f64FrontDistance();
+	if(f64_front < gs_str_world.f64_min_front){
+		gs_str_world.f64_min_front = f64_front;
+	}
+	if(!gs_str_world.u8_react_armed && sim_main_u8Forward(u8_porta) &&
+	   (gs_str_world.f64_prev_front > SIM_MAIN_REACT_DIST) && (f64_front <= SIM_MAIN_REACT_DIST)){
+		double f64_frac = (gs_str_world.f64_prev_front - SIM_MAIN_REACT_DIST) / (gs_str_world.f64_prev_front - f64_front);
+		gs_str_world.u64_react_cross_cycle = (u64_now - (uint64_t)(f64_dt * SIM_CPU_CLOCK_HZ)) +
+		                                     (uint64_t)(f64_frac * f64_dt * SIM_CPU_CLOCK_HZ);
+		gs_str_world.u8_react_armed = 1u;
+	}
+	if(gs_str_world.u8_react_armed && gs_str_world.u8_in_contact){
+		gs_str_world.u8_react_armed = 0u;
+		gs_str_world.u32_react_missed++;
+	}
+	gs_str_world.f64_prev_front = f64_front;
+}
+
+static void sim_main_vidWorldTick(void *ptr_arg)
+{
+	(void)ptr_arg;
+	sim_main_vidWorldUpdate();
+	SIM_enuSchedule(SIM_u64GetCycles() + SIM_MAIN_US_TO_CYCLES(SIM_MAIN_WORLD_TICK_US), sim_main_vidWorldTick, NULL);
+}
+
+/* The echo outputs are ORed onto the signal pins */
+static void sim_main_vidEchoPins(void)
+{
+	uint8_t u8_level = (gs_str_world.u8_echo_high != 0u) ? HIGH : LOW;
+	SIM_vidSetPin(SIM_PORT_D, SIM_MAIN_ECHO_PIN, u8_level);
+	SIM_vidSetPin(SIM_PORT_D, SIM_MAIN_ECHO_ICP_PIN, u8_level);
+}
+
+static void sim_main_vidEchoEnd(void *ptr_arg)
+{
+	uint8_t u8_mask = (uint8_t)(1u << (uint8_t)((sim_main_str_sensor_t *)ptr_arg - gs_astr_sensors));
+	gs_str_world.u8_echo_high &= (uint8_t)~u8_mask;
+	gs_str_world.u8_echo_busy &= (uint8_t)~u8_mask;
+	sim_main_vidEchoPins();
+}
+
+static void sim_main_vidEchoStart(void *ptr_arg)
+{
+	sim_main_str_sensor_t *ptr_str_sensor = (sim_main_str_sensor_t *)ptr_arg;
+	gs_str_world.u8_echo_high |= (uint8_t)(1u << (uint8_t)(ptr_str_sensor - gs_astr_sensors));
+	sim_main_vidEchoPins();
+	SIM_enuSchedule(SIM_u64GetCycles() + SIM_MAIN_US_TO_CYCLES(ptr_str_sensor->f64_width_us), sim_main_vidEchoEnd, ptr_str_sensor);
+}
+
+/*****************************************************************************************************************/
+/*											LCD model															 */
+/*****************************************************************************************************************/
+
+static void sim_main_vidLcdByte(uint8_t u8_rs, uint8_t u8_byte)
+{
+	double f64_exec_us = SIM_MAIN_LCD_EXEC_US;
+
+	if((u8_rs == 0u) && ((u8_byte & 0xFCu) == 0u) && (u8_byte != 0u)){
+		/* clear and home */
+		f64_exec_us = SIM_MAIN_LCD_HOME_US;
+	}
+	gs_str_lcd.u64_busy_until = SIM_u64GetCycles() + SIM_MAIN_US_TO_CYCLES(f64_exec_us);
+	if(u8_rs){
+		gs_str_lcd.u32_data_writes++;
+		if(!gs_str_lcd.u8_cgram){
+			gs_str_lcd.au8_ddram[gs_str_lcd.u8_address] = u8_byte;
+			gs_str_lcd.u8_address = (gs_str_lcd.u8_address + 1u) & (SIM_MAIN_LCD_DDRAM_SIZE - 1u);
+		}
+		return;
+	}
+	gs_str_lcd.u32_commands++;
+	if(u8_byte & 0x80u){
+		gs_str_lcd.u8_address = u8_byte & 0x7Fu;
+		gs_str_lcd.u8_cgram = 0u;
+	}else if(u8_byte & 0x40u){
+		gs_str_lcd.u8_cgram = 1u;
+	}else if(u8_byte & 0x20u){
+		gs_str_lcd.u8_four_bit = (u8_byte & 0x10u) ? 0u : 1u;
+	}else if(u8_byte == 0x01u){
+		memset(gs_str_lcd.au8_ddram, ' ', sizeof(gs_str_lcd.au8_ddram));
+		gs_str_lcd.u8_address = 0u;
+		gs_str_lcd.u8_cgram = 0u;
+	}else if((u8_byte & 0xFEu) == 0x02u){
+		gs_str_lcd.u8_address = 0u;
+		gs_str_lcd.u8_cgram = 0u;
+	}else{
+		/* entry mode, display control, shift: not modelled */
+	}
+}
+
+/* The HD44780 latches the bus on the falling edge of E, and drives it while E is high in a read */
+static void sim_main_vidLcdPort(uint8_t u8_old, uint8_t u8_new)
+{
+	uint8_t u8_nibble = u8_new & SIM_MAIN_LCD_DATA_MASK;
+	uint8_t u8_rs = SIM_MAIN_BIT(u8_new, SIM_MAIN_LCD_RS_PIN);
+	uint8_t u8_was_four_bit = gs_str_lcd.u8_four_bit;
+
+	if(SIM_MAIN_BIT(u8_new, SIM_MAIN_LCD_RW_PIN)){
+		if(!SIM_MAIN_BIT(u8_old, SIM_MAIN_LCD_E_PIN) && SIM_MAIN_BIT(u8_new, SIM_MAIN_LCD_E_PIN)){
+			/* busy flag on D7, the address counter is not modelled */
+			gs_str_lcd.u32_busy_reads++;
+			SIM_vidSetPin(SIM_PORT_C, SIM_MAIN_LCD_D7_PIN, (SIM_u64GetCycles() < gs_str_lcd.u64_busy_until) ? HIGH : LOW);
+		}
+		return;
+	}
+	if(!SIM_MAIN_BIT(u8_old, SIM_MAIN_LCD_E_PIN) || SIM_MAIN_BIT(u8_new, SIM_MAIN_LCD_E_PIN)){
+		return;
+	}
+	gs_str_lcd.u32_transfers++;
+	if(((gs_str_lcd.u8_four_bit == 0u) || (gs_str_lcd.u8_half == 0u)) && (SIM_u64GetCycles() < gs_str_lcd.u64_busy_until)){
+		gs_str_lcd.u32_busy_writes++;
+	}
+	if(!gs_str_lcd.u8_four_bit){
+		/* 8-bit interface with only D4..D7 wired: the low half reads as zero */
+		sim_main_vidLcdByte(u8_rs, (uint8_t)(u8_nibble << 4));
+	}else if(!gs_str_lcd.u8_half){
+		gs_str_lcd.u8_high = u8_nibble;
+		gs_str_lcd.u8_half = 1u;
+	}else{
+		gs_str_lcd.u8_half = 0u;
+		sim_main_vidLcdByte(u8_rs, (uint8_t)((gs_str_lcd.u8_high << 4) | u8_nibble));
+	}
+	if(gs_str_lcd.u8_four_bit != u8_was_four_bit){
+		gs_str_lcd.u8_half = 0u;
+	}
+}
+
+static void sim_main_vidLcdLine(char *pch_line, uint8_t u8_address)
+{
+	uint8_t u8_col;
+	for(u8_col = 0u; u8_col < SIM_MAIN_LCD_COLS; u8_col++){
+		uint8_t u8_char = gs_str_lcd.au8_ddram[u8_address + u8_col];
+		pch_line[u8_col] = ((u8_char >= 0x20u) && (u8_char < 0x7Fu)) ? (char)u8_char : '*';
+	}
+	pch_line[SIM_MAIN_LCD_COLS] = '\0';
+}
+
+static void sim_main_vidPortWrite(sim_enu_port_t enu_port, uint8_t u8_old, uint8_t u8_new)
+{
+	if(enu_port == SIM_PORT_A){
+		uint64_t u64_now = SIM_u64GetCycles();
+		sim_main_vidWorldUpdate();
+		gs_str_world.u8_porta = u8_new;
+		/* Software PWM: the duty of a period is measured from one rising edge of the enable to the next */
+		if(!sim_main_u8Forward(u8_new) || !sim_main_u8Forward(u8_old)){
+			gs_str_world.u64_en_rise_cycle = 0u;
+			gs_str_world.f64_fwd_duty = -1.0;
+		}else if(!SIM_MAIN_BIT(u8_old, SIM_MAIN_EN_PIN) && SIM_MAIN_BIT(u8_new, SIM_MAIN_EN_PIN)){
+			if((gs_str_world.u64_en_rise_cycle != 0u) && (gs_str_world.u64_en_fall_cycle > gs_str_world.u64_en_rise_cycle)){
+				sim_main_vidForwardDuty((double)(gs_str_world.u64_en_fall_cycle - gs_str_world.u64_en_rise_cycle) /
+				                        (double)(u64_now - gs_str_world.u64_en_rise_cycle));
+			}
+			gs_str_world.u64_en_rise_cycle = u64_now;
+			gs_str_world.f64_cmd_duty = (double)APP_u8GetCarSpeed() / 100.0;
+		}else if(SIM_MAIN_BIT(u8_old, SIM_MAIN_EN_PIN) && !SIM_MAIN_BIT(u8_new, SIM_MAIN_EN_PIN)){
+			gs_str_world.u64_en_fall_cycle = u64_now;
+		}else{
+			/* enable unchanged */
+		}
+		if(sim_main_s8Motion(u8_new) != sim_main_s8Motion(u8_old)){
+			if(sim_main_s8Motion(u8_new) == -4){
+				gs_str_world.u32_reversals++;
+			}else if((sim_main_s8Motion(u8_new) == 2) || (sim_main_s8Motion(u8_new) == -2)){
+				gs_str_world.u32_rotations++;
+			}else{
+				/* forward, stop or a single wheel */
+			}
+		}
+		if(gs_str_world.u8_react_armed && sim_main_u8Forward(u8_old) && !sim_main_u8Forward(u8_new)){
+			double f64_ms = SIM_MAIN_CYCLES_TO_S(SIM_u64GetCycles() - gs_str_world.u64_react_cross_cycle) * 1000.0;
+			gs_str_world.u8_react_armed = 0u;
+			gs_str_world.u32_reactions++;
+			gs_str_world.f64_react_sum_ms += f64_ms;
+			if(f64_ms > gs_str_world.f64_react_max_ms){
+				gs_str_world.f64_react_max_ms = f64_ms;
+			}
+		}
+	}else if(enu_port == SIM_PORT_B){
+		/* HC-SR04 fires on the falling edge of TRIG and ignores triggers while it is ranging */
+		uint8_t u8_sensor;
+		for(u8_sensor = 0u; u8_sensor < SIM_MAIN_SENSORS; u8_sensor++){
+			sim_main_str_sensor_t *ptr_str_sensor = &gs_astr_sensors[u8_sensor];
+			uint8_t u8_mask = (uint8_t)(1u << u8_sensor);
+			if(SIM_MAIN_BIT(u8_old, ptr_str_sensor->u8_trig_pin) && !SIM_MAIN_BIT(u8_new, ptr_str_sensor->u8_trig_pin) &&
+			   ((gs_str_world.u8_echo_busy & u8_mask) == 0u)){
+				double f64_dist;
+				sim_main_vidWorldUpdate();
+				f64_dist = sim_main_f64WallDistance(ptr_str_sensor->f64_angle +
+				                                    (ptr_str_sensor->u8_on_servo ? sim_main_f64ServoOffset() : 0.0));
+				ptr_str_sensor->f64_width_us = (f64_dist > SIM_MAIN_ECHO_MAX_RANGE) ? SIM_MAIN_ECHO_TIMEOUT_US : (f64_dist * SIM_MAIN_ECHO_US_PER_MM);
+				if((gs_u32_fault_per_mille != 0u) && ((sim_main_u32Random() % 1000u) < gs_u32_fault_per_mille)){
+					uint32_t u32_kind = sim_main_u32Random();
+					gs_str_world.u32_echo_faults++;
+					if((u32_kind & 1u) != 0u){
+						/* multipath: a strong reflection from something close */
+						f64_dist = SIM_MAIN_MULTIPATH_MIN + (SIM_MAIN_MULTIPATH_SPAN * (double)((u32_kind >> 1) % 1000u) / 1000.0);
+						ptr_str_sensor->f64_width_us = f64_dist * SIM_MAIN_ECHO_US_PER_MM;
+					}else{
+						/* missed edge: the sensor times out */
+						ptr_str_sensor->f64_width_us = SIM_MAIN_ECHO_TIMEOUT_US;
+					}
+				}
+				gs_str_world.u8_echo_busy |= u8_mask;
+				gs_str_world.au32_pings[u8_sensor]++;
+				SIM_enuSchedule(SIM_u64GetCycles() + SIM_MAIN_US_TO_CYCLES(SIM_MAIN_ECHO_DELAY_US), sim_main_vidEchoStart, ptr_str_sensor);
+			}
+		}
+	}else if(enu_port == SIM_PORT_C){
+		sim_main_vidLcdPort(u8_old, u8_new);
+	}else{
+		/* PD7: servo pulse, the width sets the target angle */
+		if(!SIM_MAIN_BIT(u8_old, SIM_MAIN_SERVO_PIN) && SIM_MAIN_BIT(u8_new, SIM_MAIN_SERVO_PIN)){
+			gs_str_world.u64_servo_rise_cycle = SIM_u64GetCycles();
+		}else if(SIM_MAIN_BIT(u8_old, SIM_MAIN_SERVO_PIN) && !SIM_MAIN_BIT(u8_new, SIM_MAIN_SERVO_PIN)){
+			double f64_width_us = SIM_MAIN_CYCLES_TO_S(SIM_u64GetCycles() - gs_str_world.u64_servo_rise_cycle) * 1e6;
+			if((f64_width_us >= SIM_MAIN_SERVO_VALID_US) && (f64_width_us <= SIM_MAIN_SERVO_INVALID_US)){
+				(void)sim_main_f64ServoOffset();
+				gs_str_world.f64_servo_target_deg = fmin(fmax((f64_width_us - SIM_MAIN_SERVO_MIN_US) * SIM_MAIN_SERVO_RANGE_DEG /
+				                                               (SIM_MAIN_SERVO_MAX_US - SIM_MAIN_SERVO_MIN_US), 0.0), SIM_MAIN_SERVO_RANGE_DEG);
+				gs_str_world.u32_servo_pulses++;
+			}
+		}else{
+			/* the other pins of port D are inputs */
+		}
+	}
+}
+
+/*****************************************************************************************************************/
+/*											Scenario															 */
+/*****************************************************************************************************************/
+
+static void sim_main_vidStartPress(void *ptr_arg)
+{
+	(void)ptr_arg;
+	SIM_vidSetPin(SIM_PORT_D, SIM_MAIN_START_BTN_PIN, LOW);
+}
+
+static void sim_main_vidStartRelease(void *ptr_arg)
+{
+	(void)ptr_arg;
+	SIM_vidSetPin(SIM_PORT_D, SIM_MAIN_START_BTN_PIN, HIGH);
+}
+
+/*****************************************************************************************************************/
+/*											Report																 */
+/*****************************************************************************************************************/
+
+static void sim_main_vidReport(void)
+{
+	sim_str_stats_t str_stats;
+	struct timespec str_wall_end;
+	double f64_wall;
+	double f64_sim;
+	uint8_t u8_vector;
+	char ach_line_1[SIM_MAIN_LCD_COLS + 1u];
+	char ach_line_2[SIM_MAIN_LCD_COLS + 1u];
+
+	sim_main_vidWorldUpdate();
+	SIM_vidGetStats(&str_stats);
+	clock_gettime(CLOCK_MONOTONIC, &str_wall_end);
+	f64_wall = (double)(str_wall_end.tv_sec - gs_str_wall_start.tv_sec) +
+	           ((double)(str_wall_end.tv_nsec - gs_str_wall_start.tv_nsec) / 1e9);
+	f64_sim = SIM_MAIN_CYCLES_TO_S(str_stats.u64_cycles);
+
+	printf("== obstacle_car_sim ==\n");
+	printf("simulated time      : %.3f s (%llu cycles)\n", f64_sim, (unsigned long long)str_stats.u64_cycles);
+	printf("wall time           : %.3f s, speed-up x%.1f\n", f64_wall, (f64_wall > 0.0) ? (f64_sim / f64_wall) : 0.0);
+	printf("cost model          : %u cycles per host us (0 = register accesses only)\n", (unsigned)gs_u32_cycles_per_host_us);
+	printf("register accesses   : %llu\n", (unsigned long long)str_stats.u64_io_accesses);
+	printf("CPU busy            : %.1f %% (compute %.1f %%, ISR %.1f %%, idle/spin skipped %.1f %%)\n",
+	       100.0 * (1.0 - ((double)str_stats.u64_skipped_cycles / (double)str_stats.u64_cycles)),
+	       100.0 * (double)str_stats.u64_compute_cycles / (double)str_stats.u64_cycles,
+	       100.0 * (double)str_stats.u64_isr_cycles / (double)str_stats.u64_cycles,
+	       100.0 * (double)str_stats.u64_skipped_cycles / (double)str_stats.u64_cycles);
+	printf("interrupts          : %-13s %10s %12s %10s\n", "vector", "count", "cycles/call", "max");
+	for(u8_vector = 1u; u8_vector < SIM_VECTOR_MAX; u8_vector++){
+		if(str_stats.au32_isr_count[u8_vector] != 0u){
+			printf("                      %-13s %10u %12.1f %10u\n", gs_apch_vector_names[u8_vector],
+			       (unsigned)str_stats.au32_isr_count[u8_vector],
+			       (double)str_stats.au64_isr_cycles[u8_vector] / (double)str_stats.au32_isr_count[u8_vector],
+			       (unsigned)str_stats.au32_isr_max_cycles[u8_vector]);
+		}
+	}
+	printf("ultrasonic pings    : %u front, %u left, %u right\n", (unsigned)gs_str_world.au32_pings[0],
+	       (unsigned)gs_str_world.au32_pings[1], (unsigned)gs_str_world.au32_pings[2]);
+	printf("distance travelled  : %.0f mm (mean %.1f mm/s)\n", gs_str_world.f64_travelled,
+	       (f64_sim > 0.0) ? (gs_str_world.f64_travelled / f64_sim) : 0.0);
+	printf("closest approach    : %.0f mm\n", gs_str_world.f64_min_front);
+	/* The firmware slows down while closing on a wall: without drops the motors never saw the braking */
+	printf("slowing @ %3.0f mm    : %u forward duty drops, lowest duty %.0f %%, %u periods off the set duty\n", SIM_MAIN_DUTY_NEAR,
+	       (unsigned)gs_str_world.u32_duty_drops, (gs_str_world.f64_min_fwd_duty <= 1.0) ? (100.0 * gs_str_world.f64_min_fwd_duty) : 0.0,
+	       (unsigned)gs_str_world.u32_duty_mismatches);
+	printf("reaction @ %3.0f mm   : %u stops, mean %.2f ms, max %.2f ms, missed %u\n", SIM_MAIN_REACT_DIST,
+	       (unsigned)gs_str_world.u32_reactions,
+	       (gs_str_world.u32_reactions != 0u) ? (gs_str_world.f64_react_sum_ms / gs_str_world.u32_reactions) : 0.0,
+	       gs_str_world.f64_react_max_ms, (unsigned)gs_str_world.u32_react_missed);
+	printf("APP reaction (max)  : %u ticks from echo end to motor command\n", (unsigned)APP_u32GetMaxReactionTicks());
+	if(gs_u32_cycles_per_host_us == 0u){
+		/* The scheduler times tasks with the simulated clock, computation only takes time with -c */
+		printf("scheduler           : WCET and load count register accesses and delays only, run with -c to charge computation\n");
+	}
+	printf("scheduler           : load %u %%, task       runs   WCET us   misses\n", (unsigned)SCHED_u8GetLoadPercent());
+	{
+		sched_str_task_stats_t str_task_stats;
+		uint8_t u8_task;
+		for(u8_task = 0u; SCHED_enuGetStats(u8_task, &str_task_stats) == SCHED_OK; u8_task++){
+			printf("                                  %4u %10u %9u %8u\n", (unsigned)u8_task, (unsigned)str_task_stats.u32_runs,
+			       (unsigned)str_task_stats.u32_wcet_us, (unsigned)str_task_stats.u32_deadline_misses);
+		}
+	}
+	printf("collisions          : %u\n", (unsigned)gs_str_world.u32_collisions);
+	printf("echo faults         : %u injected\n", (unsigned)gs_str_world.u32_echo_faults);
+	printf("manoeuvres          : %u rotations, %u reversals\n", (unsigned)gs_str_world.u32_rotations,
+	       (unsigned)gs_str_world.u32_reversals);
+	printf("servo               : %u pulses, %.0f degrees travelled\n", (unsigned)gs_str_world.u32_servo_pulses,
+	       gs_str_world.f64_servo_travel_deg);
+	sim_main_vidLcdLine(ach_line_1, 0u);
+	sim_main_vidLcdLine(ach_line_2, SIM_MAIN_LCD_LINE_2);
+	printf("LCD bus             : %u transfers (%u commands, %u data bytes)\n", (unsigned)gs_str_lcd.u32_transfers,
+	       (unsigned)gs_str_lcd.u32_commands, (unsigned)gs_str_lcd.u32_data_writes);
+	printf("LCD busy flag       : %u reads, %u bytes written while busy\n", (unsigned)gs_str_lcd.u32_busy_reads,
+	       (unsigned)gs_str_lcd.u32_busy_writes);
+	printf("LCD content         : |%s|\n", ach_line_1);
+	printf("                      |%s|\n", ach_line_2);
+	fflush(stdout);
+}
+
+/*****************************************************************************************************************/
+/*											Entry point															 */
+/*****************************************************************************************************************/
+
+int main(int argc, char **argv)
+{
+	sim_str_config_t str_config;
+	int s32_index;
+
+	for(s32_index = 1; s32_index < argc; s32_index++){
+		if((strcmp(argv[s32_index], "-t") == 0) && ((s32_index + 1) < argc)){
+			gs_u32_seconds = (uint32_t)strtoul(argv[++s32_index], NULL, 10);
+		}else if((strcmp(argv[s32_index], "-c") == 0) && ((s32_index + 1) < argc)){
+			gs_u32_cycles_per_host_us = (uint32_t)strtoul(argv[++s32_index], NULL, 10);
+		}else if((strcmp(argv[s32_index], "-n") == 0) && ((s32_index + 1) < argc)){
+			gs_u32_fault_per_mille = (uint32_t)strtoul(argv[++s32_index], NULL, 10);
+		}else{
+			fprintf(stderr, "usage: %s [-t seconds] [-c cycles_per_host_us] [-n echo_faults_per_mille]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	memset(&gs_str_world, 0, sizeof(gs_str_world));
+	memset(&gs_str_lcd, 0, sizeof(gs_str_lcd));
+	memset(gs_str_lcd.au8_ddram, ' ', sizeof(gs_str_lcd.au8_ddram));
+	gs_str_world.f64_x = SIM_MAIN_START_X;
+	gs_str_world.f64_y = SIM_MAIN_START_Y;
+	gs_str_world.f64_min_front = 1e9;
+	gs_str_world.f64_fwd_duty = -1.0;
+	gs_str_world.f64_min_fwd_duty = 2.0;
+	gs_str_world.af64_oc_duty[SIM_OC1A] = -1.0;
+	gs_str_world.af64_oc_duty[SIM_OC1B] = -1.0;
+	gs_str_world.f64_servo_deg = SIM_MAIN_SERVO_RANGE_DEG / 2.0;
+	gs_str_world.f64_servo_target_deg = SIM_MAIN_SERVO_RANGE_DEG / 2.0;
+
+	str_config.u64_stop_cycle = (uint64_t)gs_u32_seconds * SIM_CPU_CLOCK_HZ;
+	str_config.u32_cycles_per_host_us = gs_u32_cycles_per_host_us;
+	str_config.ptr_port_write = sim_main_vidPortWrite;
+	str_config.ptr_stop = sim_main_vidReport;
+	SIM_enuInit(&str_config);
+	gs_str_world.f64_prev_front = sim_main_f64FrontDistance();
+
+	/* Idle levels: buttons released (pulled high), no echo */
+	SIM_vidSetPin(SIM_PORT_D, SIM_MAIN_START_BTN_PIN, HIGH);
+	SIM_vidSetPin(SIM_PORT_D, SIM_MAIN_DIR_BTN_PIN, HIGH);
+	SIM_vidSetPin(SIM_PORT_D, SIM_MAIN_ECHO_PIN, LOW);
+	SIM_vidSetPin(SIM_PORT_D, SIM_MAIN_ECHO_ICP_PIN, LOW);
+
+	/* Press PB2 once to start the car */
+	SIM_enuSchedule(SIM_MAIN_US_TO_CYCLES(500000.0), sim_main_vidStartPress, NULL);
+	SIM_enuSchedule(SIM_MAIN_US_TO_CYCLES(600000.0), sim_main_vidStartRelease, NULL);
+	SIM_enuSchedule(SIM_MAIN_US_TO_CYCLES(SIM_MAIN_WORLD_TICK_US), sim_main_vidWorldTick, NULL);
+
+	clock_gettime(CLOCK_MONOTONIC, &gs_str_wall_start);
+	SIM_vidStart();
+	SIM_firmwareMain();
+
+	/* The firmware never returns, the run ends from the simulator's stop callback */
+	sim_main_vidReport();
+	return 0;
+}
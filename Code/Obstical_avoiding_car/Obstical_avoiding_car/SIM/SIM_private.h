@@ -0,0 +1,142 @@
+/**
+ * @file SIM_private.h
+ * @brief Register map and internal definitions of the ATmega32 host simulation.
+ *
+ * The simulator keeps its own copy of the addresses it models so that it does not depend
+ * on the MCAL private headers it is standing in for.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+
+#ifndef SIM_PRIVATE_H_
+#define SIM_PRIVATE_H_
+
+#include "../STD_LIB/std_types.h"
+#include "SIM_config.h"
+
+/** @brief Size of the simulated data space: 32 GP registers plus 64 I/O registers. */
+#define SIM_REG_FILE_SIZE       0x60u
+
+/****************************************PORT_REGISTERS *************************************************/
+
+#define SIM_PINA                0x39u
+#define SIM_DDRA                0x3Au
+#define SIM_PORTA               0x3Bu
+#define SIM_PINB                0x36u
+#define SIM_DDRB                0x37u
+#define SIM_PORTB               0x38u
+#define SIM_PINC                0x33u
+#define SIM_DDRC                0x34u
+#define SIM_PORTC               0x35u
+#define SIM_PIND                0x30u
+#define SIM_DDRD                0x31u
+#define SIM_PORTD               0x32u
+
+/****************************************TIMER_REGISTERS ************************************************/
+
+#define SIM_OCR0                0x5Cu
+#define SIM_TCCR0               0x53u
+#define SIM_TCNT0               0x52u
+#define SIM_TCCR1A              0x4Fu
+#define SIM_TCCR1B              0x4Eu
+#define SIM_TCNT1L              0x4Cu
+#define SIM_TCNT1H              0x4Du
+#define SIM_OCR1AL              0x4Au
+#define SIM_OCR1AH              0x4Bu
+#define SIM_OCR1BL              0x48u
+#define SIM_OCR1BH              0x49u
+#define SIM_ICR1L               0x46u
+#define SIM_ICR1H               0x47u
+#define SIM_TCCR2               0x45u
+#define SIM_TCNT2               0x44u
+#define SIM_OCR2                0x43u
+#define SIM_TIMSK               0x59u
+#define SIM_TIFR                0x58u
+
+/* TIMSK / TIFR bits */
+#define SIM_TOV0_BIT            0
+#define SIM_OCF0_BIT            1
+#define SIM_TOV1_BIT            2
+#define SIM_OCF1B_BIT           3
+#define SIM_OCF1A_BIT           4
+#define SIM_ICF1_BIT            5
+#define SIM_TOV2_BIT            6
+#define SIM_OCF2_BIT            7
+
+/* TCCR1B input capture edge select, ICP1 pin (PD6) */
+#define SIM_ICES1_BIT           6
+#define SIM_ICP1_PIN            6
+
+/****************************************INTERRUPT_REGISTERS ********************************************/
+
+#define SIM_GICR                0x5Bu
+#define SIM_GIFR                0x5Au
+#define SIM_MCUCR               0x55u
+#define SIM_MCUCSR              0x54u
+#define SIM_SREG                0x5Fu
+
+/* GICR / GIFR bits */
+#define SIM_INT2_BIT            5
+#define SIM_INT0_BIT            6
+#define SIM_INT1_BIT            7
+
+/* Sense control fields */
+#define SIM_ISC0_INDEX          0
+#define SIM_ISC1_INDEX          2
+#define SIM_ISC2_BIT            6
+#define SIM_ISC_LOW_LEVEL       0u
+#define SIM_ISC_ANY_CHANGE      1u
+#define SIM_ISC_FALLING         2u
+#define SIM_ISC_RISING          3u
+
+#define SIM_SREG_I_BIT          7
+
+/****************************************TIMER_MODEL ****************************************************/
+
+#define SIM_TIMER_COUNT         3u
+#define SIM_TIMER_0             0u
+#define SIM_TIMER_1             1u
+#define SIM_TIMER_2             2u
+
+/** @brief Mask of the clock select bits, the same position for all three timers. */
+#define SIM_CS_MASK             0x07u
+
+/** @brief Marker for a timer that is not counting. */
+#define SIM_NEVER               0xFFFFFFFFFFFFFFFFull
+
+/**
+ * @brief State of one simulated timer/counter.
+ *
+ * The counter value is only materialised in the register file when the firmware accesses
+ * it, between accesses it is derived from the cycle clock.
+ */
+typedef struct{
+	uint32_t u32_count;             /**< Counter value at u64_sync_cycle. */
+	uint64_t u64_sync_cycle;        /**< Cycle the counter value was last brought up to date. */
+	uint16_t u16_prescaler;         /**< Current clock divider, 0 when stopped. */
+}sim_str_timer_t;
+
+/**
+ * @brief One entry of the interrupt vector table, in hardware priority order.
+ */
+typedef struct{
+	uint8_t u8_vector;              /**< Vector number (index into the statistics). */
+	uint8_t u8_flag_reg;            /**< Address of the register holding the request flag. */
+	uint8_t u8_flag_bit;            /**< Request flag bit. */
+	uint8_t u8_enable_reg;          /**< Address of the register holding the enable bit. */
+	uint8_t u8_enable_bit;          /**< Enable bit. */
+	void (*ptr_vector)(void);       /**< Handler to call. */
+}sim_str_vector_t;
+
+/**
+ * @brief A stimulus scheduled by the harness.
+ */
+typedef struct{
+	uint64_t u64_cycle;             /**< Cycle at which the stimulus fires. */
+	void (*ptr_callback)(void *);   /**< Function to call. */
+	void *ptr_arg;                  /**< Argument passed to ptr_callback. */
+}sim_str_event_t;
+
+#endif /* SIM_PRIVATE_H_ */
@@ -0,0 +1,842 @@
+/**
+ * @file SIM_prog.c
+ * @brief Host simulation of the ATmega32 register file, timers, external interrupts and
+ *        interrupt dispatch (HOST_SIM builds only).
+ *
+ * Time model: the simulator owns a cycle clock. Every register access costs
+ * SIM_IO_ACCESS_CYCLES and counted busy-wait loops cost what the firmware declares through
+ * SIM_vidSpinUs. When the firmware idles (SIM_vidIdle) the clock jumps to the next event. The
+ * model is deterministic, firmware computation between two accesses is only charged from host
+ * CPU time when the harness asks for it (u32_cycles_per_host_us). Timer flags and external
+ * interrupt flags are raised at the exact cycle they become due and the pending vectors are
+ * called in hardware priority order.
+ *
+ * Write model: the firmware writes through the pointer returned by SIM_pu8IoReg, so a write
+ * is only seen at the next entry into the simulator. Every entry first compares the register
+ * file against its committed copy and applies what changed (port outputs, timer control,
+ * counter writes) at the cycle of the access that produced it.
+ *
+ * @date 2026-10-16
+ * @author Arafa Arafa
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "SIM_interface.h"
+#include "SIM_private.h"
+#include "../STD_LIB/bit_math.h"
+
+/*****************************************************************************************************************/
+/*											Firmware vectors													 */
+/*****************************************************************************************************************/
+
+/* Vectors the firmware does not implement fall back to these empty handlers */
+#define SIM_WEAK_VECTOR(N)  void __vector_##N(void) __attribute__((weak)); void __vector_##N(void){}
+
+SIM_WEAK_VECTOR(1)
+SIM_WEAK_VECTOR(2)
+SIM_WEAK_VECTOR(3)
+SIM_WEAK_VECTOR(4)
+SIM_WEAK_VECTOR(5)
+SIM_WEAK_VECTOR(6)
+SIM_WEAK_VECTOR(7)
+SIM_WEAK_VECTOR(8)
+SIM_WEAK_VECTOR(9)
+SIM_WEAK_VECTOR(10)
+SIM_WEAK_VECTOR(11)
+
+/** @brief Modelled vectors, highest priority first. */
+static const sim_str_vector_t gs_astr_vectors[] = {
+	{ 1, SIM_GIFR, SIM_INT0_BIT,  SIM_GICR,  SIM_INT0_BIT,  __vector_1  },
+	{ 2, SIM_GIFR, SIM_INT1_BIT,  SIM_GICR,  SIM_INT1_BIT,  __vector_2  },
+	{ 3, SIM_GIFR, SIM_INT2_BIT,  SIM_GICR,  SIM_INT2_BIT,  __vector_3  },
+	{ 4, SIM_TIFR, SIM_OCF2_BIT,  SIM_TIMSK, SIM_OCF2_BIT,  __vector_4  },
+	{ 5, SIM_TIFR, SIM_TOV2_BIT,  SIM_TIMSK, SIM_TOV2_BIT,  __vector_5  },
+	{ 6, SIM_TIFR, SIM_ICF1_BIT,  SIM_TIMSK, SIM_ICF1_BIT,  __vector_6  },
+	{ 7, SIM_TIFR, SIM_OCF1A_BIT, SIM_TIMSK, SIM_OCF1A_BIT, __vector_7  },
+	{ 8, SIM_TIFR, SIM_OCF1B_BIT, SIM_TIMSK, SIM_OCF1B_BIT, __vector_8  },
+	{ 9, SIM_TIFR, SIM_TOV1_BIT,  SIM_TIMSK, SIM_TOV1_BIT,  __vector_9  },
+	{10, SIM_TIFR, SIM_OCF0_BIT,  SIM_TIMSK, SIM_OCF0_BIT,  __vector_10 },
+	{11, SIM_TIFR, SIM_TOV0_BIT,  SIM_TIMSK, SIM_TOV0_BIT,  __vector_11 },
+};
+
+#define SIM_VECTOR_TABLE_SIZE   (sizeof(gs_astr_vectors) / sizeof(gs_astr_vectors[0]))
+
+/*****************************************************************************************************************/
+/*											Global variables													 */
+/*****************************************************************************************************************/
+
+/* Register file seen by the firmware, and the last values the simulator has applied */
+static volatile uint8_t gs_au8_reg[SIM_REG_FILE_SIZE];
+static uint8_t gs_au8_committed[SIM_REG_FILE_SIZE];
+
+/* PINx, DDRx, PORTx addresses per port */
+static const uint8_t gs_au8_pin_add[SIM_PORT_MAX]  = {SIM_PINA,  SIM_PINB,  SIM_PINC,  SIM_PIND};
+static const uint8_t gs_au8_ddr_add[SIM_PORT_MAX]  = {SIM_DDRA,  SIM_DDRB,  SIM_DDRC,  SIM_DDRD};
+static const uint8_t gs_au8_port_add[SIM_PORT_MAX] = {SIM_PORTA, SIM_PORTB, SIM_PORTC, SIM_PORTD};
+
+/* Levels driven onto input pins by the harness */
+static uint8_t gs_au8_ext_level[SIM_PORT_MAX];
+static uint8_t gs_au8_ext_driven[SIM_PORT_MAX];
+static uint8_t gs_au8_pin_level[SIM_PORT_MAX];
+
+/* Clock divider selected by the CS bits, timer 2 has its own table */
+static const uint16_t gs_au16_prescaler_01[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+static const uint16_t gs_au16_prescaler_2[8]  = {0, 1, 8, 32, 64, 128, 256, 1024};
+
+static sim_str_timer_t gs_astr_timer[SIM_TIMER_COUNT];
+static sim_str_event_t gs_astr_events[SIM_MAX_EVENTS];
+static uint8_t gs_u8_event_count;
+
+static sim_str_config_t gs_str_config;
+static sim_str_stats_t gs_str_stats;
+static uint64_t gs_u64_cycle;
+
+/* Set once the stop cycle is reached: the clock stands still while the harness reports */
+static uint8_t gs_u8_stopped = U8_ZERO_VALUE;
+static uint64_t gs_u64_host_mark_ns;
+
+/*****************************************************************************************************************/
+/*											Static Function Prototypes											 */
+/*****************************************************************************************************************/
+
+static uint64_t sim_u64HostNs(void);
+static uint64_t sim_u64Enter(void);
+static void sim_vidMark(void);
+static void sim_vidLeave(void);
+static void sim_vidCommit(void);
+static void sim_vidUpdatePins(sim_enu_port_t enu_port);
+static void sim_vidExtEdge(uint8_t u8_flag_bit, uint8_t u8_sense, uint8_t u8_old, uint8_t u8_new);
+static void sim_vidCapture(uint8_t u8_old, uint8_t u8_new);
+static void sim_vidTimerShape(uint8_t u8_timer, uint32_t *ptr_u32_top, uint32_t *ptr_u32_max, uint8_t *ptr_u8_tov_at_top);
+static uint8_t sim_u8TimerCompares(uint8_t u8_timer, uint8_t *ptr_u8_bits, uint32_t *ptr_u32_values);
+static uint8_t sim_u8TovBit(uint8_t u8_timer);
+static uint64_t sim_u64TicksTo(uint32_t u32_count, uint32_t u32_value, uint32_t u32_top, uint32_t u32_max);
+static uint64_t sim_u64TicksToTov(uint32_t u32_count, uint32_t u32_top, uint32_t u32_max, uint8_t u8_tov_at_top);
+static void sim_vidSyncTimers(uint64_t u64_target);
+static uint64_t sim_u64NextEvent(void);
+static void sim_vidRunStimuli(void);
+static void sim_vidDispatch(void);
+static void sim_vidAdvance(uint64_t u64_target);
+static void sim_vidRefresh(void);
+static void sim_vidStop(void);
+
+/*****************************************************************************************************************/
+/*											Core																 */
+/*****************************************************************************************************************/
+
+static uint64_t sim_u64HostNs(void)
+{
+	struct timespec str_ts;
+	clock_gettime(CLOCK_MONOTONIC, &str_ts);
+	return ((uint64_t)str_ts.tv_sec * 1000000000ull) + (uint64_t)str_ts.tv_nsec;
+}
+
+/* Returns the charge for the firmware computation since the last mark, 0 unless host time is charged */
+static uint64_t sim_u64Enter(void)
+{
+	uint64_t u64_charge = U8_ZERO_VALUE;
+	if(gs_str_config.u32_cycles_per_host_us != U8_ZERO_VALUE){
+		uint64_t u64_now = sim_u64HostNs();
+		uint64_t u64_ns = u64_now - gs_u64_host_mark_ns;
+		if(u64_ns > SIM_MAX_CHARGED_HOST_NS){
+			u64_ns = SIM_MAX_CHARGED_HOST_NS;
+		}
+		u64_charge = (u64_ns * gs_str_config.u32_cycles_per_host_us) / 1000u;
+		gs_str_stats.u64_compute_cycles += u64_charge;
+		gs_u64_host_mark_ns = u64_now;
+	}
+	return u64_charge;
+}
+
+/* Restarts the host time mark, so that simulator time is not charged to the firmware */
+static void sim_vidMark(void)
+{
+	if(gs_str_config.u32_cycles_per_host_us != U8_ZERO_VALUE){
+		gs_u64_host_mark_ns = sim_u64HostNs();
+	}
+}
+
+static void sim_vidLeave(void)
+{
+	sim_vidMark();
+}
+
+/* Applies the writes the firmware made through the last returned pointer */
+static void sim_vidCommit(void)
+{
+	uint8_t u8_port;
+	uint8_t u8_timer;
+	uint8_t u8_new;
+	uint8_t u8_old;
+
+	for(u8_port = U8_ZERO_VALUE; u8_port < SIM_PORT_MAX; u8_port++){
+		uint8_t u8_ddr_add = gs_au8_ddr_add[u8_port];
+		uint8_t u8_port_add = gs_au8_port_add[u8_port];
+		uint8_t u8_changed = U8_ZERO_VALUE;
+
+		if(gs_au8_reg[u8_ddr_add] != gs_au8_committed[u8_ddr_add]){
+			gs_au8_committed[u8_ddr_add] = gs_au8_reg[u8_ddr_add];
+			u8_changed = U8_ONE_VALUE;
+		}
+		u8_new = gs_au8_reg[u8_port_add];
+		u8_old = gs_au8_committed[u8_port_add];
+		if(u8_new != u8_old){
+			gs_au8_committed[u8_port_add] = u8_new;
+			u8_changed = U8_ONE_VALUE;
+			if(gs_str_config.ptr_port_write != NULL){
+				gs_str_config.ptr_port_write((sim_enu_port_t)u8_port, u8_old, u8_new);
+			}
+		}
+		/* PINx is read only */
+		gs_au8_reg[gs_au8_pin_add[u8_port]] = gs_au8_committed[gs_au8_pin_add[u8_port]];
+		if(u8_changed){
+			sim_vidUpdatePins((sim_enu_port_t)u8_port);
+		}
+	}
+
+	/* Counter writes, the timers are already synchronised to the current cycle */
+	if(gs_au8_reg[SIM_TCNT0] != gs_au8_committed[SIM_TCNT0]){
+		gs_astr_timer[SIM_TIMER_0].u32_count = gs_au8_reg[SIM_TCNT0];
+	}
+	if((gs_au8_reg[SIM_TCNT1L] != gs_au8_committed[SIM_TCNT1L]) || (gs_au8_reg[SIM_TCNT1H] != gs_au8_committed[SIM_TCNT1H])){
+		gs_astr_timer[SIM_TIMER_1].u32_count = (uint32_t)gs_au8_reg[SIM_TCNT1L] | ((uint32_t)gs_au8_reg[SIM_TCNT1H] << 8);
+	}
+	if(gs_au8_reg[SIM_TCNT2] != gs_au8_committed[SIM_TCNT2]){
+		gs_astr_timer[SIM_TIMER_2].u32_count = gs_au8_reg[SIM_TCNT2];
+	}
+
+	/* Flag registers are owned by the simulator, write-one-to-clear is not modelled */
+	gs_au8_reg[SIM_TIFR] = gs_au8_committed[SIM_TIFR];
+	gs_au8_reg[SIM_GIFR] = gs_au8_committed[SIM_GIFR];
+
+	/* Everything else (TCCRx, OCRx, TIMSK, GICR, MCUCR, SREG...) is read live from the file */
+	memcpy(gs_au8_committed, (const void *)gs_au8_reg, sizeof(gs_au8_committed));
+
+	/* Clock selects take effect from now on */
+	gs_astr_timer[SIM_TIMER_0].u16_prescaler = gs_au16_prescaler_01[gs_au8_reg[SIM_TCCR0] & SIM_CS_MASK];
+	gs_astr_timer[SIM_TIMER_1].u16_prescaler = gs_au16_prescaler_01[gs_au8_reg[SIM_TCCR1B] & SIM_CS_MASK];
+	gs_astr_timer[SIM_TIMER_2].u16_prescaler = gs_au16_prescaler_2[gs_au8_reg[SIM_TCCR2] & SIM_CS_MASK];
+	for(u8_timer = U8_ZERO_VALUE; u8_timer < SIM_TIMER_COUNT; u8_timer++){
+		gs_astr_timer[u8_timer].u64_sync_cycle = gs_u64_cycle;
+	}
+}
+
+/* Recomputes the pin levels of a port and raises external interrupt flags on edges */
+static void sim_vidUpdatePins(sim_enu_port_t enu_port)
+{
+	uint8_t u8_ddr = gs_au8_committed[gs_au8_ddr_add[enu_port]];
+	uint8_t u8_port = gs_au8_committed[gs_au8_port_add[enu_port]];
+	uint8_t u8_input = (gs_au8_ext_driven[enu_port] & gs_au8_ext_level[enu_port]) |
+	                   ((uint8_t)~gs_au8_ext_driven[enu_port] & u8_port); /* undriven inputs follow the pull-up */
+	uint8_t u8_old = gs_au8_pin_level[enu_port];
+	uint8_t u8_new = (uint8_t)((u8_port & u8_ddr) | (u8_input & (uint8_t)~u8_ddr));
+	uint8_t u8_mcucr = gs_au8_committed[SIM_MCUCR];
+
+	gs_au8_pin_level[enu_port] = u8_new;
+	gs_au8_committed[gs_au8_pin_add[enu_port]] = u8_new;
+	gs_au8_reg[gs_au8_pin_add[enu_port]] = u8_new;
+
+	if(enu_port == SIM_PORT_D){
+		/* INT0 on PD2, INT1 on PD3 */
+		sim_vidExtEdge(SIM_INT0_BIT, (u8_mcucr >> SIM_ISC0_INDEX) & 0x3u, READ_BIT(u8_old, 2), READ_BIT(u8_new, 2));
+		sim_vidExtEdge(SIM_INT1_BIT, (u8_mcucr >> SIM_ISC1_INDEX) & 0x3u, READ_BIT(u8_old, 3), READ_BIT(u8_new, 3));
+		/* ICP1 on PD6 */
+		sim_vidCapture(READ_BIT(u8_old, SIM_ICP1_PIN), READ_BIT(u8_new, SIM_ICP1_PIN));
+	}
+	else if(enu_port == SIM_PORT_B){
+		/* INT2 on PB2, edge triggered only */
+		uint8_t u8_sense = READ_BIT(gs_au8_committed[SIM_MCUCSR], SIM_ISC2_BIT) ? SIM_ISC_RISING : SIM_ISC_FALLING;
+		sim_vidExtEdge(SIM_INT2_BIT, u8_sense, READ_BIT(u8_old, 2), READ_BIT(u8_new, 2));
+	}
+	else{
+		/* no external interrupt pins */
+	}
+}
+
+static void sim_vidExtEdge(uint8_t u8_flag_bit, uint8_t u8_sense, uint8_t u8_old, uint8_t u8_new)
+{
+	uint8_t u8_fire = U8_ZERO_VALUE;
+	if(u8_old != u8_new){
+		switch(u8_sense){
+			case SIM_ISC_ANY_CHANGE: u8_fire = U8_ONE_VALUE;            break;
+			case SIM_ISC_FALLING:    u8_fire = (u8_new == LOW);         break;
+			case SIM_ISC_RISING:     u8_fire = (u8_new == HIGH);        break;
+			default:                 /* low level is polled in dispatch */ break;
+		}
+	}
+	if(u8_fire){
+		SET_BIT(gs_au8_committed[SIM_GIFR], u8_flag_bit);
+		gs_au8_reg[SIM_GIFR] = gs_au8_committed[SIM_GIFR];
+	}
+}
+
+/* Latches Timer 1 into ICR1 and raises ICF1 when ICP1 changes in the direction selected by ICES1
+   (the noise canceller delay of four cycles is not modelled) */
+static void sim_vidCapture(uint8_t u8_old, uint8_t u8_new)
+{
+	if((u8_old != u8_new) && (u8_new == READ_BIT(gs_au8_committed[SIM_TCCR1B], SIM_ICES1_BIT))){
+		uint32_t u32_count;
+		sim_vidSyncTimers(gs_u64_cycle);
+		u32_count = gs_astr_timer[SIM_TIMER_1].u32_count;
+		gs_au8_committed[SIM_ICR1L] = (uint8_t)u32_count;
+		gs_au8_committed[SIM_ICR1H] = (uint8_t)(u32_count >> 8);
+		gs_au8_reg[SIM_ICR1L] = gs_au8_committed[SIM_ICR1L];
+		gs_au8_reg[SIM_ICR1H] = gs_au8_committed[SIM_ICR1H];
+		SET_BIT(gs_au8_committed[SIM_TIFR], SIM_ICF1_BIT);
+		gs_au8_reg[SIM_TIFR] = gs_au8_committed[SIM_TIFR];
+	}
+}
+
+/*****************************************************************************************************************/
+/*											Timers																 */
+/*****************************************************************************************************************/
+
+/* TOP, MAX and where TOV is raised for the current waveform generation mode */
+static void sim_vidTimerShape(uint8_t u8_timer, uint32_t *ptr_u32_top, uint32_t *ptr_u32_max, uint8_t *ptr_u8_tov_at_top)
+{
+	if(u8_timer == SIM_TIMER_1){
+		static const uint32_t au32_fixed_top[16] = {0xFFFFu, 0xFFu, 0x1FFu, 0x3FFu, 0u, 0xFFu, 0x1FFu, 0x3FFu,
+		                                            0u, 0u, 0u, 0u, 0u, 0xFFFFu, 0u, 0u};
+		uint8_t u8_wgm = (gs_au8_committed[SIM_TCCR1A] & 0x3u) | (((gs_au8_committed[SIM_TCCR1B] >> 3) & 0x3u) << 2);
+		uint32_t u32_ocr1a = (uint32_t)gs_au8_committed[SIM_OCR1AL] | ((uint32_t)gs_au8_committed[SIM_OCR1AH] << 8);
+		uint32_t u32_icr1 = (uint32_t)gs_au8_committed[SIM_ICR1L] | ((uint32_t)gs_au8_committed[SIM_ICR1H] << 8);
+		*ptr_u32_max = 0xFFFFu;
+		switch(u8_wgm){
+			case 4: case 9: case 11: case 15: *ptr_u32_top = u32_ocr1a; break;
+			case 8: case 10: case 12: case 14: *ptr_u32_top = u32_icr1; break;
+			default: *ptr_u32_top = au32_fixed_top[u8_wgm]; break;
+		}
+		/* Only the CTC modes keep TOV at MAX, phase correct modes are approximated as single slope */
+		*ptr_u8_tov_at_top = ((u8_wgm != 4) && (u8_wgm != 12));
+	}
+	else{
+		uint8_t u8_tccr = gs_au8_committed[(u8_timer == SIM_TIMER_0) ? SIM_TCCR0 : SIM_TCCR2];
+		uint8_t u8_wgm = READ_BIT(u8_tccr, 6) | (READ_BIT(u8_tccr, 3) << 1);
+		*ptr_u32_max = 0xFFu;
+		if(u8_wgm == 2){
+			*ptr_u32_top = gs_au8_committed[(u8_timer == SIM_TIMER_0) ? SIM_OCR0 : SIM_OCR2];
+			*ptr_u8_tov_at_top = U8_ZERO_VALUE;
+		}else{
+			*ptr_u32_top = 0xFFu;
+			*ptr_u8_tov_at_top = U8_ONE_VALUE;
+		}
+	}
+}
+
+/* Compare match flags of a timer and the values raising them */
+static uint8_t sim_u8TimerCompares(uint8_t u8_timer, uint8_t *ptr_u8_bits, uint32_t *ptr_u32_values)
+{
+	uint8_t u8_count;
+	switch(u8_timer){
+		case SIM_TIMER_0:
+			ptr_u8_bits[0] = SIM_OCF0_BIT;  ptr_u32_values[0] = gs_au8_committed[SIM_OCR0];
+			u8_count = 1u;
+			break;
+		case SIM_TIMER_1:
+			ptr_u8_bits[0] = SIM_OCF1A_BIT;
+			ptr_u32_values[0] = (uint32_t)gs_au8_committed[SIM_OCR1AL] | ((uint32_t)gs_au8_committed[SIM_OCR1AH] << 8);
+			ptr_u8_bits[1] = SIM_OCF1B_BIT;
+			ptr_u32_values[1] = (uint32_t)gs_au8_committed[SIM_OCR1BL] | ((uint32_t)gs_au8_committed[SIM_OCR1BH] << 8);
+			u8_count = 2u;
+			break;
+		default:
+			ptr_u8_bits[0] = SIM_OCF2_BIT;  ptr_u32_values[0] = gs_au8_committed[SIM_OCR2];
+			u8_count = 1u;
+			break;
+	}
+	return u8_count;
+}
+
+static uint8_t sim_u8TovBit(uint8_t u8_timer)
+{
+	static const uint8_t au8_tov[SIM_TIMER_COUNT] = {SIM_TOV0_BIT, SIM_TOV1_BIT, SIM_TOV2_BIT};
+	return au8_tov[u8_timer];
+}
+
+/* Timer clocks until the counter next equals u32_value, SIM_NEVER if it cannot */
+static uint64_t sim_u64TicksTo(uint32_t u32_count, uint32_t u32_value, uint32_t u32_top, uint32_t u32_max)
+{
+	uint64_t u64_ticks;
+	if(u32_count <= u32_top){
+		if(u32_value > u32_top){
+			u64_ticks = SIM_NEVER;
+		}else if(u32_value > u32_count){
+			u64_ticks = u32_value - u32_count;
+		}else{
+			u64_ticks = (uint64_t)(u32_top - u32_count) + 1u + u32_value;
+		}
+	}else{
+		/* above TOP (counter written past it): runs up to MAX and wraps */
+		if(u32_value > u32_count){
+			u64_ticks = u32_value - u32_count;
+		}else if(u32_value <= u32_top){
+			u64_ticks = (uint64_t)(u32_max - u32_count) + 1u + u32_value;
+		}else{
+			u64_ticks = SIM_NEVER;
+		}
+	}
+	return u64_ticks;
+}
+
+/* Timer clocks until the next overflow flag */
+static uint64_t sim_u64TicksToTov(uint32_t u32_count, uint32_t u32_top, uint32_t u32_max, uint8_t u8_tov_at_top)
+{
+	uint64_t u64_ticks;
+	if(u32_count > u32_top){
+		u64_ticks = (uint64_t)(u32_max - u32_count) + 1u;
+	}else if(u8_tov_at_top || (u32_top == u32_max)){
+		u64_ticks = (uint64_t)(u32_top - u32_count) + 1u;
+	}else{
+		u64_ticks = SIM_NEVER;
+	}
+	return u64_ticks;
+}
+
+/* Brings all counters and their flags up to u64_target */
+static void sim_vidSyncTimers(uint64_t u64_target)
+{
+	uint8_t u8_timer;
+	for(u8_timer = U8_ZERO_VALUE; u8_timer < SIM_TIMER_COUNT; u8_timer++){
+		sim_str_timer_t *ptr_str_timer = &gs_astr_timer[u8_timer];
+		uint16_t u16_prescaler = ptr_str_timer->u16_prescaler;
+		if((u16_prescaler != U8_ZERO_VALUE) && (u64_target > ptr_str_timer->u64_sync_cycle)){
+			uint64_t u64_ticks = (u64_target / u16_prescaler) - (ptr_str_timer->u64_sync_cycle / u16_prescaler);
+			if(u64_ticks != U8_ZERO_VALUE){
+				uint32_t u32_top, u32_max;
+				uint8_t u8_tov_at_top;
+				uint8_t au8_bits[2];
+				uint32_t au32_values[2];
+				uint8_t u8_compares;
+				uint8_t u8_index;
+				uint32_t u32_count = ptr_str_timer->u32_count;
+
+				sim_vidTimerShape(u8_timer, &u32_top, &u32_max, &u8_tov_at_top);
+				u8_compares = sim_u8TimerCompares(u8_timer, au8_bits, au32_values);
+				if(sim_u64TicksToTov(u32_count, u32_top, u32_max, u8_tov_at_top) <= u64_ticks){
+					SET_BIT(gs_au8_committed[SIM_TIFR], sim_u8TovBit(u8_timer));
+				}
+				for(u8_index = U8_ZERO_VALUE; u8_index < u8_compares; u8_index++){
+					if(sim_u64TicksTo(u32_count, au32_values[u8_index], u32_top, u32_max) <= u64_ticks){
+						SET_BIT(gs_au8_committed[SIM_TIFR], au8_bits[u8_index]);
+					}
+				}
+				/* new counter value */
+				if(u32_count > u32_top){
+					uint64_t u64_to_wrap = (uint64_t)(u32_max - u32_count) + 1u;
+					if(u64_ticks < u64_to_wrap){
+						u32_count += (uint32_t)u64_ticks;
+						u64_ticks = U8_ZERO_VALUE;
+					}else{
+						u64_ticks -= u64_to_wrap;
+						u32_count = U8_ZERO_VALUE;
+					}
+				}
+				if(u64_ticks != U8_ZERO_VALUE){
+					u32_count = (uint32_t)(((uint64_t)u32_count + u64_ticks) % ((uint64_t)u32_top + 1u));
+				}
+				ptr_str_timer->u32_count = u32_count;
+				gs_au8_reg[SIM_TIFR] = gs_au8_committed[SIM_TIFR];
+			}
+		}
+		ptr_str_timer->u64_sync_cycle = u64_target;
+	}
+}
+
+/*****************************************************************************************************************/
+/*											Events and dispatch													 */
+/*****************************************************************************************************************/
+
+/* Earliest cycle at which an enabled timer interrupt, a stimulus or the end of the run is due */
+static uint64_t sim_u64NextEvent(void)
+{
+	uint64_t u64_next = gs_str_config.u64_stop_cycle;
+	uint8_t u8_timer;
+	uint8_t u8_index;
+	uint8_t u8_timsk = gs_au8_committed[SIM_TIMSK];
+
+	for(u8_index = U8_ZERO_VALUE; u8_index < gs_u8_event_count; u8_index++){
+		if(gs_astr_events[u8_index].u64_cycle < u64_next){
+			u64_next = gs_astr_events[u8_index].u64_cycle;
+		}
+	}
+	for(u8_timer = U8_ZERO_VALUE; u8_timer < SIM_TIMER_COUNT; u8_timer++){
+		sim_str_timer_t *ptr_str_timer = &gs_astr_timer[u8_timer];
+		uint16_t u16_prescaler = ptr_str_timer->u16_prescaler;
+		if(u16_prescaler != U8_ZERO_VALUE){
+			uint32_t u32_top, u32_max;
+			uint8_t u8_tov_at_top;
+			uint8_t au8_bits[2];
+			uint32_t au32_values[2];
+			uint8_t u8_compares;
+			uint64_t u64_ticks = SIM_NEVER;
+			uint64_t u64_candidate;
+
+			sim_vidTimerShape(u8_timer, &u32_top, &u32_max, &u8_tov_at_top);
+			u8_compares = sim_u8TimerCompares(u8_timer, au8_bits, au32_values);
+			if(READ_BIT(u8_timsk, sim_u8TovBit(u8_timer))){
+				u64_ticks = sim_u64TicksToTov(ptr_str_timer->u32_count, u32_top, u32_max, u8_tov_at_top);
+			}
+			for(u8_index = U8_ZERO_VALUE; u8_index < u8_compares; u8_index++){
+				if(READ_BIT(u8_timsk, au8_bits[u8_index])){
+					u64_candidate = sim_u64TicksTo(ptr_str_timer->u32_count, au32_values[u8_index], u32_top, u32_max);
+					if(u64_candidate < u64_ticks){
+						u64_ticks = u64_candidate;
+					}
+				}
+			}
+			if(u64_ticks != SIM_NEVER){
+				u64_candidate = ((ptr_str_timer->u64_sync_cycle / u16_prescaler) + u64_ticks) * u16_prescaler;
+				if(u64_candidate < u64_next){
+					u64_next = u64_candidate;
+				}
+			}
+		}
+	}
+	return u64_next;
+}
+
+static void sim_vidRunStimuli(void)
+{
+	uint8_t u8_index = U8_ZERO_VALUE;
+	while(u8_index < gs_u8_event_count){
+		if(gs_astr_events[u8_index].u64_cycle <= gs_u64_cycle){
+			sim_str_event_t str_event = gs_astr_events[u8_index];
+			gs_u8_event_count--;
+			gs_astr_events[u8_index] = gs_astr_events[gs_u8_event_count];
+			str_event.ptr_callback(str_event.ptr_arg);
+			u8_index = U8_ZERO_VALUE; /* the callback may have changed the queue */
+		}else{
+			u8_index++;
+		}
+	}
+}
+
+/* Calls the pending vectors while global interrupts are enabled */
+static void sim_vidDispatch(void)
+{
+	uint8_t u8_found = U8_ONE_VALUE;
+	while(u8_found && READ_BIT(gs_au8_committed[SIM_SREG], SIM_SREG_I_BIT)){
+		uint8_t u8_index;
+		uint8_t u8_mcucr = gs_au8_committed[SIM_MCUCR];
+		u8_found = U8_ZERO_VALUE;
+
+		/* Low level sensing requests as long as the pin is held low */
+		if((((u8_mcucr >> SIM_ISC0_INDEX) & 0x3u) == SIM_ISC_LOW_LEVEL) && !READ_BIT(gs_au8_pin_level[SIM_PORT_D], 2)){
+			SET_BIT(gs_au8_committed[SIM_GIFR], SIM_INT0_BIT);
+		}
+		if((((u8_mcucr >> SIM_ISC1_INDEX) & 0x3u) == SIM_ISC_LOW_LEVEL) && !READ_BIT(gs_au8_pin_level[SIM_PORT_D], 3)){
+			SET_BIT(gs_au8_committed[SIM_GIFR], SIM_INT1_BIT);
+		}
+
+		for(u8_index = U8_ZERO_VALUE; u8_index < SIM_VECTOR_TABLE_SIZE; u8_index++){
+			const sim_str_vector_t *ptr_str_vector = &gs_astr_vectors[u8_index];
+			if(READ_BIT(gs_au8_committed[ptr_str_vector->u8_flag_reg], ptr_str_vector->u8_flag_bit) &&
+			   READ_BIT(gs_au8_committed[ptr_str_vector->u8_enable_reg], ptr_str_vector->u8_enable_bit)){
+				uint64_t u64_start = gs_u64_cycle;
+				uint64_t u64_spent;
+
+				/* Vector entry clears the request flag and the I bit */
+				CLEAR_BIT(gs_au8_committed[ptr_str_vector->u8_flag_reg], ptr_str_vector->u8_flag_bit);
+				CLEAR_BIT(gs_au8_committed[SIM_SREG], SIM_SREG_I_BIT);
+				gs_au8_reg[ptr_str_vector->u8_flag_reg] = gs_au8_committed[ptr_str_vector->u8_flag_reg];
+				gs_au8_reg[SIM_SREG] = gs_au8_committed[SIM_SREG];
+				sim_vidSyncTimers(gs_u64_cycle + SIM_ISR_OVERHEAD_CYCLES);
+				gs_u64_cycle += SIM_ISR_OVERHEAD_CYCLES;
+				sim_vidRefresh();
+
+				sim_vidMark();
+				ptr_str_vector->ptr_vector();
+
+				/* RETI */
+				sim_vidCommit();
+				SET_BIT(gs_au8_committed[SIM_SREG], SIM_SREG_I_BIT);
+				gs_au8_reg[SIM_SREG] = gs_au8_committed[SIM_SREG];
+
+				u64_spent = gs_u64_cycle - u64_start;
+				gs_str_stats.au32_isr_count[ptr_str_vector->u8_vector]++;
+				gs_str_stats.au64_isr_cycles[ptr_str_vector->u8_vector] += u64_spent;
+				gs_str_stats.u64_isr_cycles += u64_spent;
+				if(u64_spent > gs_str_stats.au32_isr_max_cycles[ptr_str_vector->u8_vector]){
+					gs_str_stats.au32_isr_max_cycles[ptr_str_vector->u8_vector] = (uint32_t)u64_spent;
+				}
+				u8_found = U8_ONE_VALUE;
+				break;
+			}
+		}
+		gs_au8_reg[SIM_GIFR] = gs_au8_committed[SIM_GIFR];
+	}
+}
+
+/* Moves the clock to u64_target, raising flags, running stimuli and dispatching on the way */
+static void sim_vidAdvance(uint64_t u64_target)
+{
+	if(gs_u8_stopped){
+		return;
+	}
+	for(;;){
+		uint64_t u64_next;
+		if(gs_u64_cycle >= gs_str_config.u64_stop_cycle){
+			sim_vidStop();
+		}
+		sim_vidDispatch();
+		u64_next = sim_u64NextEvent();
+		if(u64_next > u64_target){
+			break;
+		}
+		if(u64_next > gs_u64_cycle){
+			sim_vidSyncTimers(u64_next);
+			gs_u64_cycle = u64_next;
+		}
+		sim_vidRunStimuli();
+	}
+	if(u64_target > gs_u64_cycle){
+		sim_vidSyncTimers(u64_target);
+		gs_u64_cycle = u64_target;
+	}
+}
+
+/* Publishes the current counter values into the register file */
+static void sim_vidRefresh(void)
+{
+	gs_au8_committed[SIM_TCNT0] = (uint8_t)gs_astr_timer[SIM_TIMER_0].u32_count;
+	gs_au8_committed[SIM_TCNT1L] = (uint8_t)gs_astr_timer[SIM_TIMER_1].u32_count;
+	gs_au8_committed[SIM_TCNT1H] = (uint8_t)(gs_astr_timer[SIM_TIMER_1].u32_count >> 8);
+	gs_au8_committed[SIM_TCNT2] = (uint8_t)gs_astr_timer[SIM_TIMER_2].u32_count;
+	gs_au8_reg[SIM_TCNT0] = gs_au8_committed[SIM_TCNT0];
+	gs_au8_reg[SIM_TCNT1L] = gs_au8_committed[SIM_TCNT1L];
+	gs_au8_reg[SIM_TCNT1H] = gs_au8_committed[SIM_TCNT1H];
+	gs_au8_reg[SIM_TCNT2] = gs_au8_committed[SIM_TCNT2];
+	gs_au8_reg[SIM_TIFR] = gs_au8_committed[SIM_TIFR];
+	gs_au8_reg[SIM_GIFR] = gs_au8_committed[SIM_GIFR];
+}
+
+static void sim_vidStop(void)
+{
+	gs_str_stats.u64_cycles = gs_u64_cycle;
+	gs_u8_stopped = U8_ONE_VALUE;
+	if(gs_str_config.ptr_stop != NULL){
+		gs_str_config.ptr_stop();
+	}
+	exit(0);
+}
+
+/*****************************************************************************************************************/
+/*											Function Implementation												 */
+/*****************************************************************************************************************/
+
+/**
+ * @brief Returns the simulated register at a data-space address.
+ *
+ * Every call is one register access: pending writes of the previous access are applied,
+ * the clock is advanced (interrupts that become due are dispatched) and readable registers
+ * such as PINx and TCNTx are refreshed before the pointer is returned.
+ *
+ * @param u16_address Data-space address (0x20..0x5F).
+ * @return Pointer to the register inside the simulated register file.
+ */
+volatile uint8_t *SIM_pu8IoReg(uint16_t u16_address)
+{
+	uint64_t u64_charge = sim_u64Enter();
+	sim_vidCommit();
+	gs_str_stats.u64_io_accesses++;
+	sim_vidAdvance(gs_u64_cycle + u64_charge + SIM_IO_ACCESS_CYCLES);
+	sim_vidRefresh();
+	sim_vidLeave();
+	return &gs_au8_reg[u16_address % SIM_REG_FILE_SIZE];
+}
+
+/** @brief Sets the I bit of SREG, the host replacement of the sei instruction. */
+void SIM_vidSei(void)
+{
+	uint64_t u64_charge = sim_u64Enter();
+	sim_vidCommit();
+	sim_vidAdvance(gs_u64_cycle + u64_charge);
+	SET_BIT(gs_au8_committed[SIM_SREG], SIM_SREG_I_BIT);
+	gs_au8_reg[SIM_SREG] = gs_au8_committed[SIM_SREG];
+	sim_vidAdvance(gs_u64_cycle + 1u);
+	sim_vidRefresh();
+	sim_vidLeave();
+}
+
+/** @brief Clears the I bit of SREG, the host replacement of the cli instruction. */
+void SIM_vidCli(void)
+{
+	uint64_t u64_charge = sim_u64Enter();
+	sim_vidCommit();
+	sim_vidAdvance(gs_u64_cycle + u64_charge);
+	CLEAR_BIT(gs_au8_committed[SIM_SREG], SIM_SREG_I_BIT);
+	gs_au8_reg[SIM_SREG] = gs_au8_committed[SIM_SREG];
+	sim_vidSyncTimers(gs_u64_cycle + 1u);
+	gs_u64_cycle++;
+	sim_vidRefresh();
+	sim_vidLeave();
+}
+
+/**
+ * @brief Lets the firmware declare that it has nothing to do until the next interrupt.
+ *
+ * The clock jumps to the next timer or stimulus event and the due interrupts are dispatched,
+ * the counterpart of the SLEEP instruction in idle mode.
+ */
+void SIM_vidIdle(void)
+{
+	uint64_t u64_next;
+	uint64_t u64_charge = sim_u64Enter();
+	sim_vidCommit();
+	sim_vidAdvance(gs_u64_cycle + u64_charge);
+	u64_next = sim_u64NextEvent();
+	gs_str_stats.u64_skipped_cycles += u64_next - gs_u64_cycle;
+	sim_vidAdvance(u64_next);
+	sim_vidRefresh();
+	sim_vidLeave();
+}
+
+/**
+ * @brief Lets the firmware declare a counted busy-wait loop.
+ *
+ * The loop touches no register and takes no time on the host, so its duration is charged to the
+ * clock here, with the interrupts that become due on the way dispatched.
+ *
+ * @param u32_us Duration of the loop on the target in microseconds.
+ */
+void SIM_vidSpinUs(uint32_t u32_us)
+{
+	uint64_t u64_spin = ((uint64_t)u32_us * SIM_CPU_CLOCK_HZ) / 1000000ull;
+	uint64_t u64_charge = sim_u64Enter();
+	sim_vidCommit();
+	gs_str_stats.u64_compute_cycles += u64_spin;
+	sim_vidAdvance(gs_u64_cycle + u64_charge + u64_spin);
+	sim_vidRefresh();
+	sim_vidLeave();
+}
+
+/**
+ * @brief Initializes the simulated MCU with all registers at their reset values.
+ *
+ * @param ptr_str_config Harness configuration, copied.
+ * @return SIM_OK, or SIM_NOK if ptr_str_config is NULL.
+ */
+sim_enu_return_state_t SIM_enuInit(const sim_str_config_t *ptr_str_config)
+{
+	sim_enu_return_state_t enu_return_state = SIM_OK;
+	if(ptr_str_config == NULL){
+		enu_return_state = SIM_NOK;
+	}else{
+		gs_str_config = *ptr_str_config;
+		memset((void *)gs_au8_reg, 0, sizeof(gs_au8_reg));
+		memset(gs_au8_committed, 0, sizeof(gs_au8_committed));
+		memset(gs_au8_ext_level, 0, sizeof(gs_au8_ext_level));
+		memset(gs_au8_ext_driven, 0, sizeof(gs_au8_ext_driven));
+		memset(gs_au8_pin_level, 0, sizeof(gs_au8_pin_level));
+		memset(gs_astr_timer, 0, sizeof(gs_astr_timer));
+		memset(&gs_str_stats, 0, sizeof(gs_str_stats));
+		gs_u8_event_count = U8_ZERO_VALUE;
+		gs_u64_cycle = U8_ZERO_VALUE;
+		gs_u64_host_mark_ns = sim_u64HostNs();
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Starts the clock model, to be called right before entering the firmware.
+ *
+ * Host time spent in the harness set-up is not charged to the firmware.
+ */
+void SIM_vidStart(void)
+{
+	gs_u64_host_mark_ns = sim_u64HostNs();
+}
+
+/**
+ * @brief Drives an input pin from outside the MCU.
+ *
+ * @param enu_port Port of the pin.
+ * @param u8_pin Pin number 0..7.
+ * @param u8_level HIGH or LOW.
+ */
+void SIM_vidSetPin(sim_enu_port_t enu_port, uint8_t u8_pin, uint8_t u8_level)
+{
+	if((enu_port < SIM_PORT_MAX) && (u8_pin < 8u)){
+		SET_BIT(gs_au8_ext_driven[enu_port], u8_pin);
+		if(u8_level == HIGH){
+			SET_BIT(gs_au8_ext_level[enu_port], u8_pin);
+		}else{
+			CLEAR_BIT(gs_au8_ext_level[enu_port], u8_pin);
+		}
+		sim_vidUpdatePins(enu_port);
+	}
+}
+
+/**
+ * @brief Schedules a harness callback at an absolute cycle.
+ *
+ * @param u64_cycle Cycle at which ptr_callback is called (clamped to the current cycle).
+ * @param ptr_callback Function to call.
+ * @param ptr_arg Argument passed to ptr_callback.
+ * @return SIM_OK, or SIM_NOK if the callback is NULL or the event queue is full.
+ */
+sim_enu_return_state_t SIM_enuSchedule(uint64_t u64_cycle, void (*ptr_callback)(void *), void *ptr_arg)
+{
+	sim_enu_return_state_t enu_return_state = SIM_OK;
+	if((ptr_callback == NULL) || (gs_u8_event_count >= SIM_MAX_EVENTS)){
+		enu_return_state = SIM_NOK;
+	}else{
+		gs_astr_events[gs_u8_event_count].u64_cycle = (u64_cycle < gs_u64_cycle) ? gs_u64_cycle : u64_cycle;
+		gs_astr_events[gs_u8_event_count].ptr_callback = ptr_callback;
+		gs_astr_events[gs_u8_event_count].ptr_arg = ptr_arg;
+		gs_u8_event_count++;
+	}
+	return enu_return_state;
+}
+
+/** @brief Returns the current simulated cycle. */
+uint64_t SIM_u64GetCycles(void)
+{
+	return gs_u64_cycle;
+}
+
+/**
+ * @brief Copies the run statistics.
+ *
+ * @param ptr_str_stats Destination.
+ */
+void SIM_vidGetStats(sim_str_stats_t *ptr_str_stats)
+{
+	if(ptr_str_stats != NULL){
+		gs_str_stats.u64_cycles = gs_u64_cycle;
+		*ptr_str_stats = gs_str_stats;
+	}
+}
+
+/**
+ * @brief Returns the duty cycle a Timer 1 output compare pin currently produces.
+ *
+ * @param enu_oc Output compare pin.
+ * @param ptr_f64_duty Receives the duty cycle, 0.0 .. 1.0.
+ * @return SIM_OK, or SIM_NOK if the pin is not driven by the timer or an argument is invalid.
+ */
+sim_enu_return_state_t SIM_enuGetOcDuty(sim_enu_oc_t enu_oc, float64_t *ptr_f64_duty)
+{
+	static const uint8_t au8_com1_bit[SIM_OC_MAX] = {7u, 5u};
+	static const uint8_t au8_pin[SIM_OC_MAX]      = {5u, 4u};
+	static const uint8_t au8_ocr_low[SIM_OC_MAX]  = {SIM_OCR1AL, SIM_OCR1BL};
+	sim_enu_return_state_t enu_return_state = SIM_NOK;
+	uint32_t u32_top;
+	uint32_t u32_max;
+	uint8_t u8_tov_at_top;
+	uint32_t u32_ocr;
+
+	if((enu_oc < SIM_OC_MAX) && (ptr_f64_duty != NULL)
+	   && READ_BIT(gs_au8_committed[SIM_TCCR1A], au8_com1_bit[enu_oc])
+	   && READ_BIT(gs_au8_committed[SIM_DDRD], au8_pin[enu_oc])){
+		sim_vidTimerShape(SIM_TIMER_1, &u32_top, &u32_max, &u8_tov_at_top);
+		u32_ocr = (uint32_t)gs_au8_committed[au8_ocr_low[enu_oc]]
+		        | ((uint32_t)gs_au8_committed[au8_ocr_low[enu_oc] + 1u] << 8);
+		*ptr_f64_duty = (u32_ocr >= u32_top) ? 1.0 : (float64_t)(u32_ocr + 1u) / (float64_t)(u32_top + 1u);
+		enu_return_state = SIM_OK;
+	}
+	return enu_return_state;
+}
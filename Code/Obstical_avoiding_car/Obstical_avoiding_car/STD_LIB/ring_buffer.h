@@ -0,0 +1,143 @@
+/*
+ * ring_buffer.h
+ *
+ * Created: 16/10/2026
+ *  Author: Arafa Arafa
+ */
+
+
+#ifndef RING_BUFFER_H_
+#define RING_BUFFER_H_
+/**********************************  section 1: Includes ********************************************************/
+#include "std_types.h"
+/**********************************  section 2: Macro Declarations ***********************************************/
+
+/* Largest capacity: the free-running 8-bit indexes must tell a full ring from an empty one */
+#define RING_CAPACITY_MAX       128u
+
+/**********************************  section 3: Macro Like Function Declarations *************************** *****/
+
+/*
+ * Keeps the compiler from moving memory accesses across it. The element is copied before the
+ * index that publishes it is written, and read before the index that frees it is written.
+ * An 8-bit AVR needs no fence instruction: one-byte loads and stores are atomic and in order.
+ */
+#define RING_BARRIER()          __asm__ __volatile__("" ::: "memory")
+
+/* Non-zero if CAPACITY is a power of two up to RING_CAPACITY_MAX, for compile-time checks */
+#define RING_CAPACITY_VALID(CAPACITY)   (((CAPACITY) != 0u) && (((CAPACITY) & ((CAPACITY) - 1u)) == 0u) && ((CAPACITY) <= RING_CAPACITY_MAX))
+
+/*
+ * Static initializer of an empty ring on an array of elements, the capacity is the array length:
+ *   static btn_str_event_t gs_arr_str_events[8];
+ *   static ring_str_t gs_str_events = RING_INITIALIZER(gs_arr_str_events);
+ */
+#define RING_INITIALIZER(ARRAY)         {(uint8_t *)(ARRAY), (uint8_t)sizeof((ARRAY)[0]), \
+                                         (uint8_t)((sizeof(ARRAY) / sizeof((ARRAY)[0])) - 1u), 0u, 0u}
+
+/**********************************  section 4: Data Type Declarations  ******************************************/
+
+typedef enum{
+	RING_OK = 0,
+	RING_NOK,       /* invalid argument */
+	RING_EMPTY,     /* nothing to take */
+	RING_FULL       /* no room, the element was not added */
+}ring_enu_return_state_t;
+
+/*
+ * Fixed-capacity ring of equal-sized elements for one producer and one consumer, for example
+ * an ISR and the main loop. Neither side disables interrupts: the producer alone writes u8_head,
+ * the consumer alone writes u8_tail, and both are single bytes. The indexes run freely, their
+ * difference is the number of elements held.
+ */
+typedef struct{
+	uint8_t *ptr_u8_buffer;         /* capacity * element size bytes */
+	uint8_t u8_element_size;        /* bytes per element */
+	uint8_t u8_mask;                /* capacity - 1 */
+	volatile uint8_t u8_head;       /* next slot to write, producer side */
+	volatile uint8_t u8_tail;       /* next slot to read, consumer side */
+}ring_str_t;
+
+/**********************************  section 5: Function Declarations ********************************************/
+
+/*
+ * Sets up an empty ring on a caller-provided buffer of u8_capacity elements. u8_capacity must be
+ * a power of two up to RING_CAPACITY_MAX. Must not run while either side uses the ring.
+ */
+static inline ring_enu_return_state_t RING_enuInit(ring_str_t *ptr_str_ring, void *ptr_buffer, uint8_t u8_element_size, uint8_t u8_capacity)
+{
+	ring_enu_return_state_t enu_return_state = RING_OK;
+
+	if((ptr_str_ring == NULL) || (ptr_buffer == NULL) || (u8_element_size == 0u) || !RING_CAPACITY_VALID(u8_capacity)){
+		enu_return_state = RING_NOK;
+	}else{
+		ptr_str_ring->ptr_u8_buffer = (uint8_t *)ptr_buffer;
+		ptr_str_ring->u8_element_size = u8_element_size;
+		ptr_str_ring->u8_mask = (uint8_t)(u8_capacity - 1u);
+		ptr_str_ring->u8_head = 0u;
+		ptr_str_ring->u8_tail = 0u;
+	}
+
+	return enu_return_state;
+}
+
+/* Producer side: copies one element into the ring, RING_FULL leaves the ring unchanged */
+static inline ring_enu_return_state_t RING_enuPush(ring_str_t *ptr_str_ring, const void *ptr_element)
+{
+	ring_enu_return_state_t enu_return_state = RING_OK;
+	uint8_t u8_head = ptr_str_ring->u8_head;
+	const uint8_t *ptr_u8_src = (const uint8_t *)ptr_element;
+	uint8_t *ptr_u8_dst;
+
+	if((uint8_t)(u8_head - ptr_str_ring->u8_tail) > ptr_str_ring->u8_mask){
+		enu_return_state = RING_FULL;
+	}else{
+		ptr_u8_dst = &ptr_str_ring->ptr_u8_buffer[(uint8_t)(u8_head & ptr_str_ring->u8_mask) * ptr_str_ring->u8_element_size];
+		for(uint8_t u8_index = 0u; u8_index < ptr_str_ring->u8_element_size; u8_index++){
+			ptr_u8_dst[u8_index] = ptr_u8_src[u8_index];
+		}
+		RING_BARRIER();
+		ptr_str_ring->u8_head = (uint8_t)(u8_head + 1u);
+	}
+
+	return enu_return_state;
+}
+
+/* Consumer side: copies the oldest element out of the ring and frees its slot */
+static inline ring_enu_return_state_t RING_enuPop(ring_str_t *ptr_str_ring, void *ptr_element)
+{
+	ring_enu_return_state_t enu_return_state = RING_OK;
+	uint8_t u8_tail = ptr_str_ring->u8_tail;
+	const uint8_t *ptr_u8_src;
+	uint8_t *ptr_u8_dst = (uint8_t *)ptr_element;
+
+	if(u8_tail == ptr_str_ring->u8_head){
+		enu_return_state = RING_EMPTY;
+	}else{
+		RING_BARRIER();
+		ptr_u8_src = &ptr_str_ring->ptr_u8_buffer[(uint8_t)(u8_tail & ptr_str_ring->u8_mask) * ptr_str_ring->u8_element_size];
+		for(uint8_t u8_index = 0u; u8_index < ptr_str_ring->u8_element_size; u8_index++){
+			ptr_u8_dst[u8_index] = ptr_u8_src[u8_index];
+		}
+		RING_BARRIER();
+		ptr_str_ring->u8_tail = (uint8_t)(u8_tail + 1u);
+	}
+
+	return enu_return_state;
+}
+
+/* Consumer side: drops every element held, the producer may go on meanwhile */
+static inline void RING_vidFlush(ring_str_t *ptr_str_ring)
+{
+	ptr_str_ring->u8_tail = ptr_str_ring->u8_head;
+}
+
+/* Number of elements held, a snapshot from either side */
+static inline uint8_t RING_u8Count(const ring_str_t *ptr_str_ring)
+{
+	return (uint8_t)(ptr_str_ring->u8_head - ptr_str_ring->u8_tail);
+}
+
+
+
+#endif /* RING_BUFFER_H_ */
@@ -22,7 +22,9 @@
 #define HIGH        (1u)
 #define LOW         (0u)
 
+#ifndef NULL
 #define NULL    ((void*)0)
+#endif
 
 #define MAX_VALUE_UINT32	4294967295UL
 
@@ -34,8 +36,14 @@ typedef unsigned char         uint8_t;          /*           0 .. 255
 typedef signed char           sint8_t;          /*        -128 .. +127            */
 typedef unsigned short        uint16_t;         /*           0 .. 65535           */
 typedef signed short          sint16_t;         /*      -32768 .. +32767          */
+#ifdef HOST_SIM
+/* long is 64-bit on LP64 hosts, keep the 32-bit types 32-bit in the host simulation */
+typedef unsigned int          uint32_t;         /*           0 .. 4294967295      */
+typedef signed int            sint32_t;         /* -2147483648 .. +2147483647     */
+#else
 typedef unsigned long         uint32_t;         /*           0 .. 4294967295      */
 typedef signed long           sint32_t;         /* -2147483648 .. +2147483647     */
+#endif
 typedef unsigned long long    uint64_t;         /*       0..18446744073709551615  */
 typedef signed long long      sint64_t;
 typedef float                 float32_t;
@@ -0,0 +1,90 @@
+# SRAM report of a target build, run by the sram_report target of CMakeLists.txt:
+#
+#   cmake -DELF=<avr elf> [-DBASELINE_ELF=<avr elf>] -P cmake/sram_report.cmake
+#
+# Prints the statically allocated SRAM of the ATmega32 image (.data, which also holds every
+# const object and string literal not placed in flash with PROGMEM, plus .bss and .noinit),
+# what remains for the stack, and the constants kept in flash according to the linker map
+# next to the ELF. With BASELINE_ELF the change against that build is printed as well.
+
+set(SRAM_REPORT_SRAM_SIZE 2048)
+
+if(NOT ELF OR NOT EXISTS "${ELF}")
+	message(FATAL_ERROR "sram_report: no target image, set AVR_ELF to the .elf of an avr-gcc build (ELF='${ELF}')")
+endif()
+
+find_program(SRAM_REPORT_SIZE NAMES avr-size size)
+if(NOT SRAM_REPORT_SIZE)
+	message(FATAL_ERROR "sram_report: neither avr-size nor size found")
+endif()
+
+# Size in bytes of a section in `size -A` output, 0 if absent
+function(sram_report_section OUTPUT SECTION RESULT)
+	string(REGEX MATCH "\n\\${SECTION}[ \t]+([0-9]+)" MATCH "${OUTPUT}")
+	if(MATCH)
+		set(${RESULT} ${CMAKE_MATCH_1} PARENT_SCOPE)
+	else()
+		set(${RESULT} 0 PARENT_SCOPE)
+	endif()
+endfunction()
+
+# Static SRAM of an image: sets <PREFIX>_DATA, <PREFIX>_BSS and <PREFIX>_TOTAL
+function(sram_report_image IMAGE PREFIX)
+	execute_process(COMMAND "${SRAM_REPORT_SIZE}" -A "${IMAGE}"
+	                OUTPUT_VARIABLE SIZE_OUTPUT RESULT_VARIABLE SIZE_RESULT)
+	if(NOT SIZE_RESULT EQUAL 0)
+		message(FATAL_ERROR "sram_report: ${SRAM_REPORT_SIZE} failed on ${IMAGE}")
+	endif()
+	sram_report_section("${SIZE_OUTPUT}" ".data" DATA)
+	sram_report_section("${SIZE_OUTPUT}" ".bss" BSS)
+	sram_report_section("${SIZE_OUTPUT}" ".noinit" NOINIT)
+	math(EXPR BSS "${BSS} + ${NOINIT}")
+	math(EXPR TOTAL "${DATA} + ${BSS}")
+	set(${PREFIX}_DATA ${DATA} PARENT_SCOPE)
+	set(${PREFIX}_BSS ${BSS} PARENT_SCOPE)
+	set(${PREFIX}_TOTAL ${TOTAL} PARENT_SCOPE)
+endfunction()
+
+# Bytes of PROGMEM objects listed in the linker map next to an image, -1 without a map
+function(sram_report_progmem IMAGE RESULT)
+	get_filename_component(MAP_DIR "${IMAGE}" DIRECTORY)
+	get_filename_component(MAP_NAME "${IMAGE}" NAME_WE)
+	set(MAP "${MAP_DIR}/${MAP_NAME}.map")
+	set(TOTAL -1)
+	if(EXISTS "${MAP}")
+		set(TOTAL 0)
+		file(READ "${MAP}" MAP_TEXT)
+		# Input sections: long names (-fdata-sections) push address and size to the next line
+		string(REGEX MATCHALL "\n \\.progmem\\.data[^ \t\n]*[ \t\n]+0x[0-9a-f]+[ \t]+0x[0-9a-f]+" ENTRIES "${MAP_TEXT}")
+		foreach(ENTRY IN LISTS ENTRIES)
+			string(REGEX MATCH "0x[0-9a-f]+[ \t]+(0x[0-9a-f]+)$" MATCH "${ENTRY}")
+			math(EXPR TOTAL "${TOTAL} + ${CMAKE_MATCH_1}")
+		endforeach()
+	endif()
+	set(${RESULT} ${TOTAL} PARENT_SCOPE)
+endfunction()
+
+sram_report_image("${ELF}" CUR)
+math(EXPR CUR_FREE "${SRAM_REPORT_SRAM_SIZE} - ${CUR_TOTAL}")
+sram_report_progmem("${ELF}" CUR_PROGMEM)
+
+message("== SRAM report (ATmega32, ${SRAM_REPORT_SRAM_SIZE} bytes) ==")
+message("image               : ${ELF}")
+message(".data (initialised) : ${CUR_DATA} bytes")
+message(".bss + .noinit      : ${CUR_BSS} bytes")
+message("static SRAM         : ${CUR_TOTAL} bytes, ${CUR_FREE} left for the stack")
+if(CUR_PROGMEM GREATER_EQUAL 0)
+	message("PROGMEM constants   : ${CUR_PROGMEM} bytes in flash")
+endif()
+
+if(BASELINE_ELF)
+	if(NOT EXISTS "${BASELINE_ELF}")
+		message(FATAL_ERROR "sram_report: baseline image '${BASELINE_ELF}' not found")
+	endif()
+	sram_report_image("${BASELINE_ELF}" BASE)
+	math(EXPR SAVED_DATA "${BASE_DATA} - ${CUR_DATA}")
+	math(EXPR SAVED_TOTAL "${BASE_TOTAL} - ${CUR_TOTAL}")
+	message("baseline            : ${BASELINE_ELF}")
+	message("baseline static SRAM: ${BASE_TOTAL} bytes (.data ${BASE_DATA})")
+	message("SRAM saved          : ${SAVED_TOTAL} bytes (.data ${SAVED_DATA})")
+endif()